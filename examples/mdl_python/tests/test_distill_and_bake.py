@@ -1,5 +1,6 @@
 import unittest
 import os
+import sys
 
 import ctypes
 import numpy
@@ -365,7 +366,58 @@ class MainDistillAndBake(UnittestBase):
 
         canvas2: pymdlsdk.ICanvas = imageApi.create_canvas_from_buffer(buffer, "jpg")
         self.assertIsValidInterface(canvas2)
-        pass
+
+        # zero-copy view of the encoded data
+        view: memoryview = buffer.get_data_view()
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.nbytes, data_size)
+        self.assertEqual(bytes(view[0:2]), b"\xff\xd8")  # jpg start of image marker
+        if sys.version_info >= (3, 12):
+            self.assertEqual(memoryview(buffer).nbytes, data_size)
+
+    def test_buffer_views(self):
+        imageApi: pymdlsdk.IImage_api = self.sdk.neuray.get_api_component(pymdlsdk.IImage_api)
+        self.assertIsValidInterface(imageApi)
+        canvas: pymdlsdk.ICanvas = imageApi.create_canvas("Color", 8, 4)
+        self.assertIsValidInterface(canvas)
+
+        # writable view of the only layer
+        view: memoryview = canvas.get_data_view()
+        self.assertFalse(view.readonly)
+        self.assertEqual(view.shape, (4, 8, 4))
+        self.assertEqual(view.format, "f")
+        view[1, 2, 0] = 0.5
+        tile: pymdlsdk.ITile = canvas.get_tile()
+        self.assertEqual(tile.get_pixel(2, 1).r, 0.5)
+        self.assertIsNone(canvas.get_data_view(1))
+
+        # the view keeps the tile alive (and thereby the pixel data), dropping the canvas and the
+        # tile handles does not invalidate it
+        canvas = None
+        tile = None
+        self.assertEqual(view[1, 2, 0], 0.5)
+
+        # empty buffers yield empty views with the requested format and writability
+        emptyView: memoryview = pymdlsdk._create_buffer_view(None, 0, 0, "f", (0, 8, 4))
+        self.assertFalse(emptyView.readonly)
+        self.assertEqual(emptyView.format, "f")
+        self.assertEqual(emptyView.nbytes, 0)
+        emptyView = pymdlsdk._create_buffer_view(None, 0, 0, readonly=True)
+        self.assertTrue(emptyView.readonly)
+
+        # raw pixel transfer from and to python buffers
+        canvas = imageApi.create_canvas("Rgba", 8, 4)
+        pixels = bytes(range(8 * 4 * 4))
+        self.assertZero(imageApi.write_raw_pixels(8, 4, canvas, 0, 0, 0, pixels, False, "Rgba"))
+        result = bytearray(8 * 4 * 4)
+        self.assertZero(imageApi.read_raw_pixels(8, 4, canvas, 0, 0, 0, result, False, "Rgba"))
+        self.assertEqual(bytes(result), pixels)
+        self.assertEqual(canvas.get_data_view().tobytes(), pixels)
+        if sys.version_info >= (3, 12):
+            self.assertEqual(memoryview(canvas).tobytes(), pixels)
+
+        self.assertException(ValueError, lambda: imageApi.read_raw_pixels(8, 4, canvas, 0, 0, 0, bytearray(10), False, "Rgba"))
+        self.assertException(TypeError, lambda: imageApi.read_raw_pixels(8, 4, canvas, 0, 0, 0, pixels, False, "Rgba"))
 
     def test_image_api(self):
         imageApi: pymdlsdk.IImage_api = self.sdk.neuray.get_api_component(pymdlsdk.IImage_api)
@@ -0,0 +1,96 @@
+import unittest
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+try:  # pragma: no cover
+    # testing from within a package or CI
+    from .setup import SDK, BindingModule
+    from .unittest_base import UnittestBase
+    pymdlsdk = BindingModule
+except ImportError:  # pragma: no cover
+    # local testing
+    from setup import SDK
+    from unittest_base import UnittestBase
+    import pymdlsdk
+
+
+# Purpose is to check that long-running SDK calls release the GIL and can be used from several
+# Python threads concurrently
+class MainThreading(UnittestBase):
+    sdk: SDK = None
+    qualifiedModuleName: str = "::nvidia::sdk_examples::tutorials"
+    functionNameWithSignature: str = "example_material(color,float)"
+
+    @classmethod
+    def setUpClass(self):
+        print(f"Running tests in {__file__} in process with id: {os.getpid()}")
+        self.sdk = SDK()
+        self.sdk.load(addExampleSearchPath=True, loadImagePlugins=False, loadDistillerPlugin=True)
+
+    @classmethod
+    def tearDownClass(self):
+        self.sdk.unload()
+        self.sdk = None
+        print(f"\nFinished tests in {__file__}\n")
+
+    def createMaterialInstance(self) -> pymdlsdk.IMaterial_instance:
+        moduleDbName: str = self.load_module(self.qualifiedModuleName)
+        self.assertNotEqual(moduleDbName, "")
+        qualifiedFunctionName: str = self.qualifiedModuleName + "::" + self.functionNameWithSignature
+        functionDbName: pymdlsdk.IString = self.sdk.mdlFactory.get_db_definition_name(qualifiedFunctionName)
+        definition: pymdlsdk.IFunction_definition = self.sdk.transaction.access_as(pymdlsdk.IFunction_definition, functionDbName.get_c_str())
+        self.assertIsValidInterface(definition)
+        functionCall: pymdlsdk.IFunction_call = definition.create_function_call(None)
+        self.assertIsValidInterface(functionCall)
+        return functionCall.get_interface(pymdlsdk.IMaterial_instance)
+
+    def createDistillerOptions(self) -> pymdlsdk.IMap:
+        # disable the distiller cache explicitly, every call has to run the distiller to measure
+        # concurrent distilling rather than cache hits
+        options: pymdlsdk.IMap = self.sdk.transaction.create_as(pymdlsdk.IMap, "Map<Interface>")
+        cache: pymdlsdk.IBoolean = self.sdk.transaction.create_as(pymdlsdk.IBoolean, "Boolean")
+        cache.set_value(False)
+        options.insert('cache', cache)
+        return options
+
+    def compileAndDistill(self, materialInstance: pymdlsdk.IMaterial_instance, distillerOptions: pymdlsdk.IMap) -> tuple:
+        distillingApi: pymdlsdk.IMdl_distiller_api
+        context: pymdlsdk.IMdl_execution_context
+        with self.sdk.neuray.get_api_component(pymdlsdk.IMdl_distiller_api) as distillingApi, \
+             self.sdk.mdlFactory.create_execution_context() as context:
+            flags = pymdlsdk._pymdlsdk._IMaterial_instance_CLASS_COMPILATION
+            compiledMaterial: pymdlsdk.ICompiled_material = materialInstance.create_compiled_material(flags, context)
+            self.assertIsValidInterface(compiledMaterial)
+            distilledMaterial: pymdlsdk.ICompiled_material = distillingApi.distill_material(compiledMaterial, "ue4", distillerOptions)
+            self.assertIsValidInterface(distilledMaterial)
+            hash: pymdlsdk.Uuid = distilledMaterial.get_hash()
+            return (hash.m_id1, hash.m_id2, hash.m_id3, hash.m_id4)
+
+    def test_parallel_compilation(self):
+        materialInstance: pymdlsdk.IMaterial_instance = self.createMaterialInstance()
+        self.assertIsValidInterface(materialInstance)
+        iterations: int = 32
+        distillerOptions: pymdlsdk.IMap = self.createDistillerOptions()
+
+        # serial reference
+        start: float = time.perf_counter()
+        expected = [self.compileAndDistill(materialInstance, distillerOptions) for _ in range(iterations)]
+        serialTime: float = time.perf_counter() - start
+
+        # the same work spread over several threads has to produce identical results
+        threadCount: int = max(2, min(8, os.cpu_count() or 1))
+        start = time.perf_counter()
+        with ThreadPoolExecutor(max_workers=threadCount) as executor:
+            results = list(executor.map(lambda _: self.compileAndDistill(materialInstance, distillerOptions), range(iterations)))
+        parallelTime: float = time.perf_counter() - start
+
+        self.assertEqual(results, expected)
+        # timings depend on the machine, they are reported but not checked
+        print(f"\ncompiled and distilled {iterations} materials: serial {serialTime:.3f}s, "
+              f"{threadCount} threads {parallelTime:.3f}s (speedup {serialTime / max(parallelTime, 1e-9):.2f}x)")
+
+
+# run all tests of this file
+if __name__ == '__main__':
+    unittest.main()  # pragma: no cover
@@ -0,0 +1,859 @@
+/******************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+// examples/mdl_sdk/benchmark/example_benchmark.cpp
+//
+// Measures latency and throughput of the material pipeline: load, instantiate, compile, distill,
+// translate and execute. Supports single- and multi-threaded runs with a cold or a warm SDK and
+// writes the results optionally as JSON.
+//
+// Optionally, microbenchmarks compare the sampling of measured BSDFs and light profiles in the
+// built-in resource handler via CDFs and via alias tables.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "example_shared.h"
+
+// The phases of the pipeline in the order they are executed.
+enum Phase
+{
+    PHASE_STARTUP,
+    PHASE_LOAD,
+    PHASE_INSTANTIATE,
+    PHASE_COMPILE_INSTANCE,
+    PHASE_COMPILE_CLASS,
+    PHASE_DISTILL,
+    PHASE_TRANSLATE,
+    PHASE_EXECUTE,
+    PHASE_SAMPLE_MBSDF_CDF,
+    PHASE_SAMPLE_MBSDF_ALIAS,
+    PHASE_SAMPLE_LIGHT_PROFILE_CDF,
+    PHASE_SAMPLE_LIGHT_PROFILE_ALIAS,
+    PHASE_COUNT
+};
+
+const char* const phase_names[PHASE_COUNT] = {
+    "startup",
+    "load",
+    "instantiate",
+    "compile_instance",
+    "compile_class",
+    "distill",
+    "translate",
+    "execute",
+    "sample_mbsdf_cdf",
+    "sample_mbsdf_alias",
+    "sample_lp_cdf",
+    "sample_lp_alias"
+};
+
+// The last row is always implied to be (0, 0, 0, 1).
+const mi::Float32_3_4 identity(
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f
+);
+
+// Command line options.
+struct Options
+{
+    // The qualified names of the benchmarked materials.
+    std::vector<std::string> material_names;
+
+    // The number of recorded iterations over all materials.
+    mi::Uint32 iterations = 5;
+
+    // The number of threads processing materials concurrently, 0 uses all hardware threads.
+    mi::Uint32 threads = 1;
+
+    // If true, the SDK is started and shut down for every iteration, otherwise it is started
+    // once and an unrecorded warm-up iteration is run first.
+    bool cold = false;
+
+    // The number of BSDF and EDF samples taken per material in the execute phase.
+    mi::Uint32 samples = 1024;
+
+    // If true, the sampling microbenchmarks are run once per iteration, with the number of
+    // samples given by \c samples per measurement.
+    bool sampling = false;
+
+    // The distilling target, empty to skip the distill phase.
+    std::string distill_target = "ue4";
+
+    // The file the results are written to as JSON, empty for no output file.
+    std::string output_file;
+};
+
+// The latencies of all phases in milliseconds.
+struct Measurements
+{
+    std::vector<double> latencies[PHASE_COUNT];
+
+    // The number of processed materials.
+    mi::Size materials = 0;
+
+    // The number of executed BSDF and EDF samples.
+    mi::Size samples = 0;
+
+    // The wall-clock time of all recorded iterations in milliseconds.
+    double wall_ms = 0.0;
+
+    void merge( const Measurements& other)
+    {
+        for( mi::Size i = 0; i < PHASE_COUNT; ++i)
+            latencies[i].insert(
+                latencies[i].end(), other.latencies[i].begin(), other.latencies[i].end());
+        materials += other.materials;
+        samples += other.samples;
+        wall_ms += other.wall_ms;
+    }
+};
+
+// Records the time between construction and destruction as latency of a phase.
+class Phase_timer
+{
+public:
+    Phase_timer( Measurements* measurements, Phase phase)
+    : m_measurements( measurements)
+    , m_phase( phase)
+    , m_start( std::chrono::steady_clock::now())
+    {
+    }
+
+    ~Phase_timer()
+    {
+        if( !m_measurements)
+            return;
+        std::chrono::duration<double, std::milli> elapsed
+            = std::chrono::steady_clock::now() - m_start;
+        m_measurements->latencies[m_phase].push_back( elapsed.count());
+    }
+
+private:
+    Measurements* m_measurements;
+    Phase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Simple deterministic random number generator in [0, 1) for the sample inputs.
+float rnd( mi::Uint32& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return float( seed >> 8) * (1.0f / float( 1u << 24));
+}
+
+// Starts the SDK including the distiller plugin. The returned interface has to be released
+// with shutdown_sdk().
+mi::neuraylib::INeuray* start_sdk(
+    const mi::examples::mdl::Configure_options& configure_options,
+    const Options& options)
+{
+    mi::base::Handle<mi::neuraylib::INeuray> neuray( mi::examples::mdl::load_and_get_ineuray());
+    if( !neuray.is_valid_interface())
+        exit_failure( "Failed to load the SDK.");
+
+    if( !mi::examples::mdl::configure( neuray.get(), configure_options))
+        exit_failure( "Failed to initialize the SDK.");
+
+    if( !options.distill_target.empty()
+        && mi::examples::mdl::load_plugin(
+            neuray.get(), "mdl_distiller" MI_BASE_DLL_FILE_EXT) != 0)
+        exit_failure( "Failed to load the mdl_distiller plugin.");
+
+    mi::Sint32 ret = neuray->start();
+    if( ret != 0)
+        exit_failure( "Failed to initialize the SDK. Result code: %d", ret);
+
+    neuray->retain();
+    return neuray.get();
+}
+
+// Shuts down and unloads the SDK.
+void shutdown_sdk( mi::neuraylib::INeuray* neuray)
+{
+    if( neuray->shutdown() != 0)
+        exit_failure( "Failed to shutdown the SDK.");
+    neuray->release();
+
+    if( !mi::examples::mdl::unload())
+        exit_failure( "Failed to unload the SDK.");
+}
+
+// Creates a material instance with the default arguments for a material of a loaded module.
+mi::neuraylib::IFunction_call* create_material_call(
+    mi::neuraylib::IMdl_factory* mdl_factory,
+    mi::neuraylib::ITransaction* transaction,
+    const std::string& module_name,
+    const std::string& material_simple_name)
+{
+    mi::base::Handle<const mi::IString> module_db_name(
+        mdl_factory->get_db_module_name( module_name.c_str()));
+    mi::base::Handle<const mi::neuraylib::IModule> module(
+        transaction->access<mi::neuraylib::IModule>( module_db_name->get_c_str()));
+    if( !module)
+        exit_failure( "Failed to access the loaded module.");
+
+    std::string material_db_name
+        = std::string( module_db_name->get_c_str()) + "::" + material_simple_name;
+    material_db_name = mi::examples::mdl::add_missing_material_signature(
+        module.get(), material_db_name);
+    if( material_db_name.empty())
+        exit_failure( "Failed to find the material %s in the module %s.",
+            material_simple_name.c_str(), module_name.c_str());
+
+    mi::base::Handle<const mi::neuraylib::IFunction_definition> material_definition(
+        transaction->access<mi::neuraylib::IFunction_definition>( material_db_name.c_str()));
+    if( !material_definition)
+        exit_failure( "Accessing definition '%s' failed.", material_db_name.c_str());
+
+    mi::Sint32 result;
+    mi::neuraylib::IFunction_call* material_call
+        = material_definition->create_function_call( nullptr, &result);
+    if( result != 0)
+        exit_failure( "Instantiating '%s' failed.", material_db_name.c_str());
+    return material_call;
+}
+
+// Runs the whole pipeline for one material and records the latencies of its phases in
+// \p measurements. Nothing is recorded if \p measurements is \c nullptr.
+void run_pipeline(
+    mi::neuraylib::INeuray* neuray,
+    mi::neuraylib::ITransaction* transaction,
+    mi::neuraylib::IMdl_backend* be_native,
+    const Options& options,
+    const std::string& material_name,
+    mi::Uint32 seed,
+    Measurements* measurements)
+{
+    mi::base::Handle<mi::neuraylib::IMdl_factory> mdl_factory(
+        neuray->get_api_component<mi::neuraylib::IMdl_factory>());
+    mi::base::Handle<mi::neuraylib::IMdl_impexp_api> mdl_impexp_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_impexp_api>());
+    mi::base::Handle<mi::neuraylib::IMdl_execution_context> context(
+        mdl_factory->create_execution_context());
+
+    // split module and material name
+    std::string module_name, material_simple_name;
+    if( !mi::examples::mdl::parse_cmd_argument_material_name(
+            material_name, module_name, material_simple_name, true))
+        exit_failure( "Provided material name '%s' is invalid.", material_name.c_str());
+
+    // Load the module.
+    {
+        Phase_timer timer( measurements, PHASE_LOAD);
+        mdl_impexp_api->load_module( transaction, module_name.c_str(), context.get());
+    }
+    if( !print_messages( context.get()))
+        exit_failure( "Loading module '%s' failed.", module_name.c_str());
+
+    // Create a material instance with the default arguments.
+    mi::base::Handle<mi::neuraylib::IFunction_call> material_call;
+    {
+        Phase_timer timer( measurements, PHASE_INSTANTIATE);
+        material_call = create_material_call(
+            mdl_factory.get(), transaction, module_name, material_simple_name);
+    }
+    mi::base::Handle<const mi::neuraylib::IMaterial_instance> material_instance(
+        material_call->get_interface<mi::neuraylib::IMaterial_instance>());
+
+    // Compile the material instance in instance and in class compilation mode.
+    mi::base::Handle<mi::neuraylib::IType_factory> tf(
+        mdl_factory->create_type_factory( transaction));
+    mi::base::Handle<const mi::neuraylib::IType> standard_material_type(
+        tf->get_predefined_struct( mi::neuraylib::IType_struct::SID_MATERIAL));
+    context->set_option( "target_type", standard_material_type.get());
+
+    mi::base::Handle<mi::neuraylib::ICompiled_material> instance_compiled;
+    {
+        Phase_timer timer( measurements, PHASE_COMPILE_INSTANCE);
+        instance_compiled = material_instance->create_compiled_material(
+            mi::neuraylib::IMaterial_instance::DEFAULT_OPTIONS, context.get());
+    }
+    check_success( print_messages( context.get()));
+
+    mi::base::Handle<mi::neuraylib::ICompiled_material> class_compiled;
+    {
+        Phase_timer timer( measurements, PHASE_COMPILE_CLASS);
+        class_compiled = material_instance->create_compiled_material(
+            mi::neuraylib::IMaterial_instance::CLASS_COMPILATION, context.get());
+    }
+    check_success( print_messages( context.get()));
+
+    // Distill the instance compiled material.
+    if( !options.distill_target.empty()) {
+        mi::base::Handle<mi::neuraylib::IMdl_distiller_api> distiller_api(
+            neuray->get_api_component<mi::neuraylib::IMdl_distiller_api>());
+
+        mi::Sint32 result = 0;
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> distilled_material;
+        {
+            Phase_timer timer( measurements, PHASE_DISTILL);
+            distilled_material = distiller_api->distill_material(
+                instance_compiled.get(), options.distill_target.c_str(), nullptr, &result);
+        }
+        if( result != 0 || !distilled_material)
+            exit_failure( "Distilling '%s' to '%s' failed.",
+                material_name.c_str(), options.distill_target.c_str());
+    }
+
+    // Translate the class compiled material for the native backend.
+    mi::base::Handle<const mi::neuraylib::ITarget_code> target_code;
+    mi::neuraylib::Target_function_description descs[] = {
+        mi::neuraylib::Target_function_description( "init"),
+        mi::neuraylib::Target_function_description( "surface.scattering"),
+        mi::neuraylib::Target_function_description( "surface.emission.emission")
+    };
+    {
+        Phase_timer timer( measurements, PHASE_TRANSLATE);
+
+        mi::base::Handle<mi::neuraylib::ILink_unit> link_unit(
+            be_native->create_link_unit( transaction, context.get()));
+        check_success( print_messages( context.get()));
+        link_unit->add_material(
+            class_compiled.get(), descs, sizeof( descs) / sizeof( descs[0]), context.get());
+        check_success( print_messages( context.get()));
+        target_code = be_native->translate_link_unit( link_unit.get(), context.get());
+    }
+    check_success( print_messages( context.get()));
+    check_success( target_code);
+
+    // Execute the generated code: initialize the state and sample the BSDF and the EDF.
+    // For measured BSDFs and light profiles this exercises the builtin resource handler.
+    {
+        mi::Float32_3_struct texture_coords[1]    = { { 0.5f, 0.5f, 0.0f } };
+        mi::Float32_3_struct texture_tangent_u[1] = { { 1.0f, 0.0f, 0.0f } };
+        mi::Float32_3_struct texture_tangent_v[1] = { { 0.0f, 1.0f, 0.0f } };
+        mi::Float32_4_struct texture_results[16];
+
+        Phase_timer timer( measurements, PHASE_EXECUTE);
+        for( mi::Uint32 i = 0; i < options.samples; ++i) {
+            mi::neuraylib::Shading_state_material state = {
+                /*normal=*/                { 0.0f, 0.0f, 1.0f },
+                /*geom_normal=*/           { 0.0f, 0.0f, 1.0f },
+                /*position=*/              { 0.0f, 0.0f, 0.0f },
+                /*animation_time=*/        0.0f,
+                /*texture_coords=*/        texture_coords,
+                /*tangent_u=*/             texture_tangent_u,
+                /*tangent_v=*/             texture_tangent_v,
+                /*text_results=*/          texture_results,
+                /*ro_data_segment=*/       nullptr,
+                /*world_to_object=*/       &identity[0],
+                /*object_to_world=*/       &identity[0],
+                /*object_id=*/             0,
+                /*meters_per_scene_unit=*/ 1.0f
+            };
+            texture_coords[0].x = rnd( seed);
+            texture_coords[0].y = rnd( seed);
+
+            check_success( target_code->execute_init(
+                descs[0].function_index, state, nullptr, nullptr) == 0);
+
+            mi::neuraylib::Bsdf_sample_data bsdf_data;
+            bsdf_data.ior1 = mi::Float32_3_struct{ 1.0f, 1.0f, 1.0f };
+            bsdf_data.ior2 = mi::Float32_3_struct{
+                MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR,
+                MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR,
+                MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR };
+            bsdf_data.k1 = mi::Float32_3_struct{ 0.0f, 0.0f, 1.0f };
+            bsdf_data.xi = mi::Float32_4_struct{ rnd( seed), rnd( seed), rnd( seed), rnd( seed) };
+            bsdf_data.flags = mi::neuraylib::DF_FLAGS_ALLOW_REFLECT_AND_TRANSMIT;
+            check_success( target_code->execute_bsdf_sample(
+                descs[1].function_index, &bsdf_data, state, nullptr, nullptr) == 0);
+
+            mi::neuraylib::Edf_sample_data edf_data;
+            edf_data.xi = mi::Float32_4_struct{ rnd( seed), rnd( seed), rnd( seed), rnd( seed) };
+            check_success( target_code->execute_edf_sample(
+                descs[2].function_index, &edf_data, state, nullptr, nullptr) == 0);
+        }
+    }
+
+    if( measurements) {
+        measurements->materials += 1;
+        measurements->samples += options.samples;
+    }
+}
+
+// Compares the sampling of measured BSDFs and light profiles in the built-in resource handler via
+// CDFs and via alias tables (backend option "use_alias_sampling"). The same material is
+// translated once per sampling method and sampled with the same random numbers. Only the
+// sample calls are timed, the state is initialized once. Nothing is recorded if \p measurements
+// is \c nullptr.
+void run_sampling_benchmark(
+    mi::neuraylib::INeuray* neuray,
+    mi::neuraylib::ITransaction* transaction,
+    const Options& options,
+    mi::Uint32 seed,
+    Measurements* measurements)
+{
+    struct Sampling_case
+    {
+        const char* material_name;
+        const char* df_path;
+        bool is_edf;
+        Phase cdf_phase;
+        Phase alias_phase;
+    };
+    const Sampling_case cases[] = {
+        { "::nvidia::sdk_examples::tutorials::example_measured_bsdf", "surface.scattering",
+          false, PHASE_SAMPLE_MBSDF_CDF, PHASE_SAMPLE_MBSDF_ALIAS },
+        { "::nvidia::sdk_examples::tutorials::example_measured_edf", "surface.emission.emission",
+          true, PHASE_SAMPLE_LIGHT_PROFILE_CDF, PHASE_SAMPLE_LIGHT_PROFILE_ALIAS }
+    };
+
+    mi::base::Handle<mi::neuraylib::IMdl_factory> mdl_factory(
+        neuray->get_api_component<mi::neuraylib::IMdl_factory>());
+    mi::base::Handle<mi::neuraylib::IMdl_impexp_api> mdl_impexp_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_impexp_api>());
+    mi::base::Handle<mi::neuraylib::IMdl_backend_api> backend_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_backend_api>());
+    mi::base::Handle<mi::neuraylib::IMdl_execution_context> context(
+        mdl_factory->create_execution_context());
+
+    for( const Sampling_case& c : cases) {
+        std::string module_name, material_simple_name;
+        if( !mi::examples::mdl::parse_cmd_argument_material_name(
+                c.material_name, module_name, material_simple_name, true))
+            exit_failure( "Provided material name '%s' is invalid.", c.material_name);
+
+        mdl_impexp_api->load_module( transaction, module_name.c_str(), context.get());
+        if( !print_messages( context.get()))
+            exit_failure( "Loading module '%s' failed.", module_name.c_str());
+
+        mi::base::Handle<mi::neuraylib::IFunction_call> material_call( create_material_call(
+            mdl_factory.get(), transaction, module_name, material_simple_name));
+        mi::base::Handle<const mi::neuraylib::IMaterial_instance> material_instance(
+            material_call->get_interface<mi::neuraylib::IMaterial_instance>());
+        mi::base::Handle<mi::neuraylib::ICompiled_material> compiled_material(
+            material_instance->create_compiled_material(
+                mi::neuraylib::IMaterial_instance::CLASS_COMPILATION, context.get()));
+        check_success( print_messages( context.get()));
+
+        for( bool use_alias_sampling : { false, true}) {
+            mi::base::Handle<mi::neuraylib::IMdl_backend> be_native(
+                backend_api->get_backend( mi::neuraylib::IMdl_backend_api::MB_NATIVE));
+            check_success( be_native->set_option( "num_texture_spaces", "1") == 0);
+            check_success( be_native->set_option( "num_texture_results", "16") == 0);
+            check_success( be_native->set_option(
+                "use_alias_sampling", use_alias_sampling ? "on" : "off") == 0);
+
+            mi::neuraylib::Target_function_description descs[] = {
+                mi::neuraylib::Target_function_description( "init"),
+                mi::neuraylib::Target_function_description( c.df_path)
+            };
+            mi::base::Handle<mi::neuraylib::ILink_unit> link_unit(
+                be_native->create_link_unit( transaction, context.get()));
+            check_success( print_messages( context.get()));
+            link_unit->add_material( compiled_material.get(), descs, 2, context.get());
+            check_success( print_messages( context.get()));
+            mi::base::Handle<const mi::neuraylib::ITarget_code> target_code(
+                be_native->translate_link_unit( link_unit.get(), context.get()));
+            check_success( print_messages( context.get()));
+            check_success( target_code);
+
+            mi::Float32_3_struct texture_coords[1]    = { { 0.5f, 0.5f, 0.0f } };
+            mi::Float32_3_struct texture_tangent_u[1] = { { 1.0f, 0.0f, 0.0f } };
+            mi::Float32_3_struct texture_tangent_v[1] = { { 0.0f, 1.0f, 0.0f } };
+            mi::Float32_4_struct texture_results[16];
+            mi::neuraylib::Shading_state_material state = {
+                /*normal=*/                { 0.0f, 0.0f, 1.0f },
+                /*geom_normal=*/           { 0.0f, 0.0f, 1.0f },
+                /*position=*/              { 0.0f, 0.0f, 0.0f },
+                /*animation_time=*/        0.0f,
+                /*texture_coords=*/        texture_coords,
+                /*tangent_u=*/             texture_tangent_u,
+                /*tangent_v=*/             texture_tangent_v,
+                /*text_results=*/          texture_results,
+                /*ro_data_segment=*/       nullptr,
+                /*world_to_object=*/       &identity[0],
+                /*object_to_world=*/       &identity[0],
+                /*object_id=*/             0,
+                /*meters_per_scene_unit=*/ 1.0f
+            };
+            check_success( target_code->execute_init(
+                descs[0].function_index, state, nullptr, nullptr) == 0);
+
+            // Both sampling methods see the same random numbers.
+            mi::Uint32 local_seed = seed;
+            Phase_timer timer( measurements, use_alias_sampling ? c.alias_phase : c.cdf_phase);
+            for( mi::Uint32 i = 0; i < options.samples; ++i) {
+                mi::Float32_4_struct xi{
+                    rnd( local_seed), rnd( local_seed), rnd( local_seed), rnd( local_seed) };
+                if( c.is_edf) {
+                    mi::neuraylib::Edf_sample_data edf_data;
+                    edf_data.xi = xi;
+                    check_success( target_code->execute_edf_sample(
+                        descs[1].function_index, &edf_data, state, nullptr, nullptr) == 0);
+                } else {
+                    mi::neuraylib::Bsdf_sample_data bsdf_data;
+                    bsdf_data.ior1 = mi::Float32_3_struct{ 1.0f, 1.0f, 1.0f };
+                    bsdf_data.ior2 = mi::Float32_3_struct{
+                        MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR,
+                        MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR,
+                        MI_NEURAYLIB_BSDF_USE_MATERIAL_IOR };
+                    bsdf_data.k1 = mi::Float32_3_struct{ 0.0f, 0.0f, 1.0f };
+                    bsdf_data.xi = xi;
+                    bsdf_data.flags = mi::neuraylib::DF_FLAGS_ALLOW_REFLECT_AND_TRANSMIT;
+                    check_success( target_code->execute_bsdf_sample(
+                        descs[1].function_index, &bsdf_data, state, nullptr, nullptr) == 0);
+                }
+            }
+        }
+    }
+}
+
+// Runs one iteration over all materials, distributed over the requested number of threads.
+// Each thread uses its own transaction and backend. Nothing is recorded if \p measurements is
+// \c nullptr.
+void run_iteration(
+    mi::neuraylib::INeuray* neuray,
+    const Options& options,
+    mi::Uint32 iteration,
+    Measurements* measurements)
+{
+    mi::base::Handle<mi::neuraylib::IDatabase> database(
+        neuray->get_api_component<mi::neuraylib::IDatabase>());
+    mi::base::Handle<mi::neuraylib::IScope> scope( database->get_global_scope());
+    mi::base::Handle<mi::neuraylib::IMdl_backend_api> backend_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_backend_api>());
+
+    std::atomic<mi::Size> next_material( 0);
+    std::vector<Measurements> thread_measurements( options.threads);
+
+    auto worker = [&]( mi::Uint32 thread_index)
+    {
+        mi::base::Handle<mi::neuraylib::ITransaction> transaction( scope->create_transaction());
+
+        mi::base::Handle<mi::neuraylib::IMdl_backend> be_native(
+            backend_api->get_backend( mi::neuraylib::IMdl_backend_api::MB_NATIVE));
+        check_success( be_native->set_option( "num_texture_spaces", "1") == 0);
+        check_success( be_native->set_option( "num_texture_results", "16") == 0);
+
+        Measurements* local = measurements ? &thread_measurements[thread_index] : nullptr;
+        for( mi::Size i = next_material++; i < options.material_names.size();
+                i = next_material++)
+            run_pipeline(
+                neuray, transaction.get(), be_native.get(), options,
+                options.material_names[i], mi::Uint32( iteration * 7919 + i), local);
+
+        transaction->commit();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if( options.threads == 1)
+        worker( 0);
+    else {
+        std::vector<std::thread> threads;
+        for( mi::Uint32 i = 0; i < options.threads; ++i)
+            threads.emplace_back( worker, i);
+        for( std::thread& t : threads)
+            t.join();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    if( measurements) {
+        for( const Measurements& m : thread_measurements)
+            measurements->merge( m);
+        measurements->wall_ms += elapsed.count();
+    }
+
+    // The microbenchmarks run single-threaded and are not included in the wall-clock time.
+    if( options.sampling) {
+        mi::base::Handle<mi::neuraylib::ITransaction> transaction( scope->create_transaction());
+        run_sampling_benchmark(
+            neuray, transaction.get(), options, iteration * 7919, measurements);
+        transaction->commit();
+    }
+}
+
+// Summary statistics of the latencies of a phase in milliseconds.
+struct Phase_statistics
+{
+    mi::Size count = 0;
+    double total = 0.0;
+    double mean = 0.0;
+    double min = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double max = 0.0;
+};
+
+Phase_statistics compute_statistics( std::vector<double> latencies)
+{
+    Phase_statistics stats;
+    if( latencies.empty())
+        return stats;
+
+    std::sort( latencies.begin(), latencies.end());
+    stats.count = latencies.size();
+    for( double l : latencies)
+        stats.total += l;
+    stats.mean = stats.total / double( stats.count);
+    stats.min = latencies.front();
+    stats.max = latencies.back();
+
+    // nearest-rank percentiles
+    auto percentile = [&]( double p)
+    {
+        mi::Size rank = mi::Size( p * double( stats.count) + 0.999999);
+        return latencies[std::min( std::max( rank, mi::Size( 1)), stats.count) - 1];
+    };
+    stats.p50 = percentile( 0.50);
+    stats.p95 = percentile( 0.95);
+    return stats;
+}
+
+// Prints the results as a table.
+void print_results( const Options& options, const Measurements& measurements)
+{
+    std::cout << "\nmode: " << (options.cold ? "cold" : "warm")
+              << ", threads: " << options.threads
+              << ", iterations: " << options.iterations
+              << ", materials: " << options.material_names.size()
+              << ", samples: " << options.samples
+              << (options.sampling ? ", sampling microbenchmarks" : "") << "\n\n";
+
+    std::cout << std::left << std::setw( 18) << "phase" << std::right
+              << std::setw( 8) << "count"
+              << std::setw( 12) << "total ms"
+              << std::setw( 10) << "mean ms"
+              << std::setw( 10) << "min ms"
+              << std::setw( 10) << "p50 ms"
+              << std::setw( 10) << "p95 ms"
+              << std::setw( 10) << "max ms"
+              << std::setw( 12) << "ops/s" << "\n";
+
+    std::cout << std::fixed << std::setprecision( 3);
+    for( mi::Size i = 0; i < PHASE_COUNT; ++i) {
+        Phase_statistics stats = compute_statistics( measurements.latencies[i]);
+        if( stats.count == 0)
+            continue;
+        std::cout << std::left << std::setw( 18) << phase_names[i] << std::right
+                  << std::setw( 8) << stats.count
+                  << std::setw( 12) << stats.total
+                  << std::setw( 10) << stats.mean
+                  << std::setw( 10) << stats.min
+                  << std::setw( 10) << stats.p50
+                  << std::setw( 10) << stats.p95
+                  << std::setw( 10) << stats.max
+                  << std::setw( 12)
+                  << (stats.total > 0.0 ? 1000.0 * double( stats.count) / stats.total : 0.0)
+                  << "\n";
+    }
+
+    double wall_s = measurements.wall_ms / 1000.0;
+    std::cout << "\nwall clock:  " << measurements.wall_ms << " ms\n";
+    if( wall_s > 0.0)
+        std::cout << "throughput:  " << double( measurements.materials) / wall_s
+                  << " materials/s, " << double( measurements.samples) / wall_s
+                  << " samples/s\n";
+    std::cout << std::endl;
+}
+
+// Escapes a string for the use in JSON.
+std::string json_string( const std::string& s)
+{
+    std::string result = "\"";
+    for( char c : s) {
+        if( c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+// Writes the results as JSON to the given file.
+void write_json(
+    const std::string& filename, const Options& options, const Measurements& measurements)
+{
+    std::ofstream file( filename.c_str());
+    if( !file)
+        exit_failure( "Failed to open '%s' for writing.", filename.c_str());
+
+    file << std::setprecision( 6);
+    file << "{\n";
+    file << "    \"mode\": " << json_string( options.cold ? "cold" : "warm") << ",\n";
+    file << "    \"threads\": " << options.threads << ",\n";
+    file << "    \"iterations\": " << options.iterations << ",\n";
+    file << "    \"samples\": " << options.samples << ",\n";
+    file << "    \"sampling\": " << (options.sampling ? "true" : "false") << ",\n";
+    file << "    \"distill_target\": " << json_string( options.distill_target) << ",\n";
+    file << "    \"materials\": [";
+    for( mi::Size i = 0; i < options.material_names.size(); ++i)
+        file << (i > 0 ? ", " : "") << json_string( options.material_names[i]);
+    file << "],\n";
+    file << "    \"wall_ms\": " << measurements.wall_ms << ",\n";
+    double wall_s = measurements.wall_ms / 1000.0;
+    file << "    \"materials_per_second\": "
+         << (wall_s > 0.0 ? double( measurements.materials) / wall_s : 0.0) << ",\n";
+    file << "    \"samples_per_second\": "
+         << (wall_s > 0.0 ? double( measurements.samples) / wall_s : 0.0) << ",\n";
+    file << "    \"phases\": {";
+    bool first = true;
+    for( mi::Size i = 0; i < PHASE_COUNT; ++i) {
+        Phase_statistics stats = compute_statistics( measurements.latencies[i]);
+        if( stats.count == 0)
+            continue;
+        file << (first ? "\n" : ",\n");
+        first = false;
+        file << "        " << json_string( phase_names[i]) << ": {"
+             << "\"count\": " << stats.count
+             << ", \"total_ms\": " << stats.total
+             << ", \"mean_ms\": " << stats.mean
+             << ", \"min_ms\": " << stats.min
+             << ", \"p50_ms\": " << stats.p50
+             << ", \"p95_ms\": " << stats.p95
+             << ", \"max_ms\": " << stats.max
+             << ", \"ops_per_second\": "
+             << (stats.total > 0.0 ? 1000.0 * double( stats.count) / stats.total : 0.0)
+             << "}";
+    }
+    file << "\n    }\n";
+    file << "}\n";
+
+    if( !file)
+        exit_failure( "Failed to write '%s'.", filename.c_str());
+}
+
+void usage( char const *prog_name)
+{
+    std::cout
+        << "Usage: " << prog_name << " [options] [<material_name1> ...]\n"
+        << "Options:\n"
+        << "  --mdl_path <path>       mdl search path, can occur multiple times.\n"
+        << "  --iterations <n>        number of recorded iterations, defaults to 5.\n"
+        << "  --threads <n>           number of threads, 0 for all hardware threads,\n"
+        << "                          defaults to 1.\n"
+        << "  --cold                  restart the SDK for every iteration (cold caches),\n"
+        << "                          otherwise a warm-up iteration is run first.\n"
+        << "  --samples <n>           BSDF and EDF samples per material, defaults to 1024.\n"
+        << "  --sampling              also compare sampling of measured BSDFs and light\n"
+        << "                          profiles via CDFs and alias tables (sample_* phases,\n"
+        << "                          one measurement of <n> samples per iteration).\n"
+        << "  --distill_target <t>    distilling target, \"none\" to skip distilling,\n"
+        << "                          defaults to \"ue4\".\n"
+        << "  -o <filename>           write the results as JSON to the given file.\n"
+        << "  <material_name>         qualified name of materials to use, defaults to the\n"
+        << "                          materials of \"::nvidia::sdk_examples::tutorials\".\n"
+        << std::endl;
+    exit_failure();
+}
+
+int MAIN_UTF8( int argc, char* argv[])
+{
+    // Parse command line options
+    Options options;
+    mi::examples::mdl::Configure_options configure_options;
+
+    for( int i = 1; i < argc; ++i) {
+        char const *opt = argv[i];
+        if( opt[0] == '-') {
+            if( strcmp( opt, "--mdl_path") == 0 && i < argc - 1)
+                configure_options.additional_mdl_paths.emplace_back( argv[++i]);
+            else if( strcmp( opt, "--iterations") == 0 && i < argc - 1)
+                options.iterations = std::max( atoi( argv[++i]), 1);
+            else if( strcmp( opt, "--threads") == 0 && i < argc - 1)
+                options.threads = std::max( atoi( argv[++i]), 0);
+            else if( strcmp( opt, "--cold") == 0)
+                options.cold = true;
+            else if( strcmp( opt, "--samples") == 0 && i < argc - 1)
+                options.samples = std::max( atoi( argv[++i]), 0);
+            else if( strcmp( opt, "--sampling") == 0)
+                options.sampling = true;
+            else if( strcmp( opt, "--distill_target") == 0 && i < argc - 1) {
+                options.distill_target = argv[++i];
+                if( options.distill_target == "none")
+                    options.distill_target.clear();
+            }
+            else if( strcmp( opt, "-o") == 0 && i < argc - 1)
+                options.output_file = argv[++i];
+            else {
+                std::cout << "Unknown option: \"" << opt << "\"" << std::endl;
+                usage( argv[0]);
+            }
+        }
+        else
+            options.material_names.emplace_back( opt);
+    }
+
+    if( options.threads == 0)
+        options.threads = std::max( std::thread::hardware_concurrency(), 1u);
+
+    if( options.material_names.empty()) {
+        const char* tutorials = "::nvidia::sdk_examples::tutorials::";
+        for( const char* name : {
+                "example_material", "example_df", "example_edf", "example_procedural",
+                "example_measured_bsdf", "example_measured_edf" })
+            options.material_names.push_back( std::string( tutorials) + name);
+    }
+
+    Measurements measurements;
+    if( options.cold) {
+        // Start the SDK for every iteration, nothing is cached between the iterations.
+        for( mi::Uint32 i = 0; i < options.iterations; ++i) {
+            mi::neuraylib::INeuray* neuray;
+            {
+                Phase_timer timer( &measurements, PHASE_STARTUP);
+                neuray = start_sdk( configure_options, options);
+            }
+            run_iteration( neuray, options, i, &measurements);
+            shutdown_sdk( neuray);
+        }
+    } else {
+        mi::neuraylib::INeuray* neuray;
+        {
+            Phase_timer timer( &measurements, PHASE_STARTUP);
+            neuray = start_sdk( configure_options, options);
+        }
+
+        // The warm-up iteration loads all modules and fills the caches.
+        run_iteration( neuray, options, 0, nullptr);
+        for( mi::Uint32 i = 0; i < options.iterations; ++i)
+            run_iteration( neuray, options, i + 1, &measurements);
+
+        shutdown_sdk( neuray);
+    }
+
+    print_results( options, measurements);
+    if( !options.output_file.empty())
+        write_json( options.output_file, options, measurements);
+
+    exit_success();
+}
+
+// Convert command line arguments to UTF8 on Windows
+COMMANDLINE_TO_UTF8
@@ -544,8 +544,8 @@ void code_gen(mi::neuraylib::INeuray* neuray, Options& options)
                     dump_metadata(target_code, std::cout);
             }
 
-            // Serialization is not supported by the LLVM-IR backend.
-            if (options.m_backend != "llvm") {
+            // Serialization is not supported by all backends.
+            if (target_code->supports_serialization()) {
                 // If disabled, instance specific data is discarded. this makes sense for applications
                 // that use class compilation and reuse materials that only differ in their parameter
                 // set, meaning that they have the same hash and thereby the same generated code but
@@ -37,10 +37,16 @@
 
 #include <glslang/SPIRV/GlslangToSpv.h>
 #include <glslang/Public/ResourceLimits.h>
+#include <spirv-tools/libspirv.hpp>
 #include <spirv-tools/optimizer.hpp>
 
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <mutex>
 
 namespace
 {
@@ -85,6 +91,111 @@ std::string decode_driver_version(VkPhysicalDeviceProperties physical_device_pro
     return ss.str();
 }
 
+// Process-wide cache of SPIR-V binaries compiled by create_shader_module_from_sources().
+// When materials are reloaded or pipelines are recreated, the same GLSL sources are often
+// compiled again. The cache avoids re-parsing and re-optimizing them with glslang.
+// Entries are keyed by the complete compiler input, so lookups never return the binary of a
+// different shader. Since include files are only known after parsing, each entry also stores
+// the resolved names and contents of the files included during its compilation. An entry whose
+// include files changed is dropped on lookup. The least recently used entry is evicted once the
+// capacity is reached.
+struct Spirv_cache
+{
+    struct Entry
+    {
+        std::string key;
+        std::vector<std::pair<std::string, std::string>> included_files;
+        std::vector<unsigned int> spirv;
+    };
+
+    std::mutex mutex;
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    size_t capacity = 64;
+};
+
+Spirv_cache& get_spirv_cache()
+{
+    static Spirv_cache cache;
+    return cache;
+}
+
+// Serializes all inputs influencing the compilation result into a cache key.
+// Each variable-length part is prefixed with its length to keep the encoding unambiguous.
+std::string compute_spirv_cache_key(
+    const std::vector<std::string_view>& shader_sources,
+    EShLanguage shader_type,
+    const std::vector<std::string>& defines,
+    bool optimize)
+{
+    size_t key_size = 2 + sizeof(size_t) * (2 + defines.size() + shader_sources.size());
+    for (const std::string& define : defines)
+        key_size += define.size();
+    for (const std::string_view& source : shader_sources)
+        key_size += source.size();
+
+    std::string key;
+    key.reserve(key_size);
+    key += static_cast<char>(shader_type);
+    key += optimize ? '1' : '0';
+
+    auto append = [&key](std::string_view part)
+    {
+        size_t size = part.size();
+        key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        key.append(part.data(), part.size());
+    };
+
+    size_t count = defines.size();
+    key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const std::string& define : defines)
+        append(define);
+    count = shader_sources.size();
+    key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const std::string_view& source : shader_sources)
+        append(source);
+    return key;
+}
+
+// Inserts an entry as most recently used and evicts entries exceeding the capacity.
+// The cache mutex has to be held by the caller.
+void insert_spirv_cache_entry(
+    Spirv_cache& cache,
+    std::string&& key,
+    const std::vector<std::pair<std::string, std::string>>& included_files,
+    const std::vector<unsigned int>& spirv)
+{
+    if (cache.capacity == 0 || cache.index.find(key) != cache.index.end())
+        return;
+
+    cache.entries.push_front({ std::move(key), included_files, spirv });
+    cache.index.emplace(cache.entries.front().key, cache.entries.begin());
+
+    while (cache.entries.size() > cache.capacity)
+    {
+        cache.index.erase(cache.entries.back().key);
+        cache.entries.pop_back();
+    }
+}
+
+// Checks whether the files included when compiling a cache entry still have the same contents.
+bool are_included_files_unchanged(
+    const std::vector<std::pair<std::string, std::string>>& included_files)
+{
+    for (const auto& included_file : included_files)
+    {
+        std::ifstream file_stream(included_file.first, std::ios_base::binary);
+        if (!file_stream.is_open())
+            return false;
+
+        std::string content(
+            (std::istreambuf_iterator<char>(file_stream)), std::istreambuf_iterator<char>());
+        if (content != included_file.second)
+            return false;
+    }
+    return true;
+}
+
 } // namespace
 
 namespace mi::examples::vk
@@ -172,7 +283,20 @@ std::vector<unsigned int> Glsl_compiler::link_program(bool optimize)
         spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_0);
         optimizer.RegisterPerformancePasses();
         optimizer.Run(spirv.data(), spirv.size(), &spirv_opt, opt_options);
-        return spirv_opt;
+        spirv.swap(spirv_opt);
+    }
+
+    spvtools::SpirvTools spirv_tools(SPV_ENV_VULKAN_1_0);
+    spirv_tools.SetMessageConsumer(
+        [](spv_message_level_t, const char*, const spv_position_t& position, const char* message)
+        {
+            std::cerr << "SPIR-V validation: " << message
+                << " (word " << position.index << ")\n";
+        });
+    if (!spirv_tools.Validate(spirv))
+    {
+        std::cerr << "Validation of the compiled SPIR-V module failed.\n";
+        terminate();
     }
 
     return spirv;
@@ -209,6 +333,7 @@ glslang::TShader::Includer::IncludeResult* Glsl_compiler::Simple_file_includer::
     char* content = new char[length];
     file_stream.seekg(0, std::ios::beg);
     file_stream.read(content, length);
+    m_included_files.emplace_back(filename, std::string(content, length));
     return new IncludeResult(header_name, content, length, content);
 }
 
@@ -1504,16 +1629,73 @@ VkShaderModule create_shader_module_from_file(
     return create_shader_module_from_sources(device, { shader_source }, shader_type, defines, optimize);
 }
 
-VkShaderModule create_shader_module_from_sources(
-    VkDevice device, const std::vector<std::string_view> shader_sources,
-    EShLanguage shader_type, const std::vector<std::string>& defines, bool optimize)
+std::vector<unsigned int> compile_glsl_to_spirv(
+    const std::vector<std::string_view>& shader_sources, EShLanguage shader_type,
+    const std::vector<std::string>& defines, bool optimize)
 {
+    std::string cache_key = compute_spirv_cache_key(
+        shader_sources, shader_type, defines, optimize);
+
+    Spirv_cache& cache = get_spirv_cache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.index.find(cache_key);
+        if (it != cache.index.end())
+        {
+            if (are_included_files_unchanged(it->second->included_files))
+            {
+                cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+                return it->second->spirv;
+            }
+
+            // An included file was edited, compile again.
+            auto entry = it->second;
+            cache.index.erase(it);
+            cache.entries.erase(entry);
+        }
+    }
+
     mi::examples::vk::Glsl_compiler glsl_compiler(shader_type, "main");
     glsl_compiler.add_defines(defines);
     for (const std::string_view& source : shader_sources)
         glsl_compiler.add_shader(source);
     std::vector<unsigned int> compiled_shader = glsl_compiler.link_program(optimize);
 
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        insert_spirv_cache_entry(
+            cache, std::move(cache_key), glsl_compiler.get_included_files(), compiled_shader);
+    }
+    return compiled_shader;
+}
+
+void set_spirv_cache_capacity(size_t capacity)
+{
+    Spirv_cache& cache = get_spirv_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.capacity = capacity;
+    while (cache.entries.size() > cache.capacity)
+    {
+        cache.index.erase(cache.entries.back().key);
+        cache.entries.pop_back();
+    }
+}
+
+void clear_spirv_cache()
+{
+    Spirv_cache& cache = get_spirv_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.index.clear();
+    cache.entries.clear();
+}
+
+VkShaderModule create_shader_module_from_sources(
+    VkDevice device, const std::vector<std::string_view> shader_sources,
+    EShLanguage shader_type, const std::vector<std::string>& defines, bool optimize)
+{
+    std::vector<unsigned int> compiled_shader = compile_glsl_to_spirv(
+        shader_sources, shader_type, defines, optimize);
+
     VkShaderModuleCreateInfo shader_module_create_info = {};
     shader_module_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
     shader_module_create_info.pCode = compiled_shader.data();
@@ -91,6 +91,13 @@ public:
     // Links all previously added shaders and compiles the linked program to SPIR-V.
     std::vector<unsigned int> link_program(bool optimize = true);
 
+    // Returns the resolved file names and contents of all files included by the shaders
+    // added so far.
+    const std::vector<std::pair<std::string, std::string>>& get_included_files() const
+    {
+        return m_file_includer.get_included_files();
+    }
+
 private:
     class Simple_file_includer : public glslang::TShader::Includer
     {
@@ -102,6 +109,14 @@ private:
         virtual IncludeResult* includeLocal(const char* header_name,
             const char* includer_name, size_t inclusion_depth) override;
         virtual void releaseInclude(IncludeResult* include_result) override;
+
+        const std::vector<std::pair<std::string, std::string>>& get_included_files() const
+        {
+            return m_included_files;
+        }
+
+    private:
+        std::vector<std::pair<std::string, std::string>> m_included_files;
     };
 
 private:
@@ -372,6 +387,30 @@ bool check_validation_layers_support(
 
 
 // Shader compilation helpers
+
+// Compiles and links the given GLSL sources to SPIR-V with glslang and validates the result.
+// The results are cached per process, keyed by the sources, the shader type, the defines and
+// the optimization flag. A cached binary is only reused if the files included by the shaders
+// still have the same contents, so edited include files are recompiled. Compiling unchanged
+// sources again, e.g. when reloading a material or recreating a pipeline, returns the cached
+// SPIR-V binary. The cache keeps the most recently used 64 binaries by default.
+//
+// Note that the SDK does not emit SPIR-V directly. The GLSL back-end only lowers its AST to
+// GLSL text, a SPIR-V emitter would be a separate code generator for the same AST, and the
+// SDK libraries do not depend on glslang or SPIRV-Tools (only the Vulkan examples do).
+// Generated GLSL code is therefore still compiled from text here, the cache only avoids doing
+// so repeatedly for identical inputs.
+std::vector<unsigned int> compile_glsl_to_spirv(
+    const std::vector<std::string_view>& shader_sources, EShLanguage shader_type,
+    const std::vector<std::string>& defines = {}, bool optimize = true);
+
+// Sets the maximum number of SPIR-V binaries kept by compile_glsl_to_spirv().
+// Zero disables caching. Entries exceeding the new capacity are evicted immediately.
+void set_spirv_cache_capacity(size_t capacity);
+
+// Drops all SPIR-V binaries cached by compile_glsl_to_spirv().
+void clear_spirv_cache();
+
 VkShaderModule create_shader_module_from_file(
     VkDevice device, const char* shader_filename, EShLanguage shader_type,
     const std::vector<std::string>& defines = {}, bool optimize = true);
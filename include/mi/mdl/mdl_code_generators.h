@@ -351,7 +351,7 @@ public:
 ///  - If class compilation was used, use the argument block layout of the result to construct an
 ///    argument block from the parameter default values of the used material instance.
 class ILambda_function : public
-    mi::base::Interface_declare<0xd2bd2203,0xc7da,0x4bea,0x8d,0x57,0x46,0xbb,0xd6,0x53,0xab,0xe3,
+    mi::base::Interface_declare<0x27c72282,0x67da,0x4fd6,0xb7,0x80,0x64,0x38,0xd0,0x0a,0xa4,0xe9,
     IDag_builder>
 {
 public:
@@ -379,6 +379,9 @@ public:
     /// Get the DAG_unit of this lambda function.
     virtual DAG_unit const &get_dag_unit() const = 0;
 
+    /// Returns the amount of used memory by this lambda function.
+    virtual size_t get_memory_size() const = 0;
+
     /// Get the type factory of this function.
     virtual IType_factory *get_type_factory() = 0;
 
@@ -1253,6 +1256,9 @@ class ICode_generator_jit : public
     /// The name of the option to enable the HLSL/GLSL resource data struct argument.
     #define MDL_JIT_OPTION_SL_USE_RESOURCE_DATA "jit_sl_use_resource_data"
 
+    /// The name of the option to merge internal functions with identical bodies in GLSL/HLSL.
+    #define MDL_JIT_OPTION_SL_MERGE_FUNCTIONS "jit_sl_merge_functions"
+
     /// The name of the option that sets the name of the Core State struct for GLSL/HLSL.
     #define MDL_JIT_OPTION_SL_CORE_STATE_API_NAME "jit_sl_core_state_api_name"
 
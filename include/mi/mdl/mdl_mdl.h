@@ -181,6 +181,17 @@ public:
     /// The name of the option to keep resource file paths as is.
     #define MDL_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS "keep_original_resource_file_paths"
 
+    /// The maximum number of threads hashing the material slots of a material instance,
+    /// 1 hashes them on the calling thread.
+    ///
+    /// Experimental: parallel slot hashing is off by default (1). Neither the benefit nor a
+    /// suitable default for this option or #MDL_OPTION_INSTANCE_HASH_THRESHOLD has been measured.
+    #define MDL_OPTION_INSTANCE_HASH_THREADS "instance_hash_threads"
+
+    /// The minimum number of DAG nodes of a material instance to hash its material slots on
+    /// several threads. Only used if #MDL_OPTION_INSTANCE_HASH_THREADS is larger than 1.
+    #define MDL_OPTION_INSTANCE_HASH_THRESHOLD "instance_hash_threshold"
+
 public:
     /// Get the type factory of the compiler.
     ///
@@ -32,6 +32,7 @@
 #define MI_NEURAYLIB_IARRAY_H
 
 #include <mi/neuraylib/idata.h>
+#include <mi/neuraylib/type_traits.h>
 
 namespace mi {
 
@@ -56,7 +57,7 @@ namespace mi {
 /// \see #mi::IDynamic_array
 ///
 class IArray :
-    public base::Interface_declare<0x329db537,0x9892,0x488c,0xa2,0xf4,0xf5,0x37,0x1a,0x35,0xcf,0x39,
+    public base::Interface_declare<0x7770767b,0x3fac,0x49b9,0xa5,0xd8,0xb9,0xb0,0xb8,0xb9,0x97,0xdf,
                                    IData_collection>
 {
 public:
@@ -140,6 +141,48 @@ public:
     ///
     /// Equivalent to #get_length() == 0.
     virtual bool empty() const = 0;
+
+    /// Returns a pointer to the contiguous storage of the array elements.
+    ///
+    /// Arrays that are attributes (see #mi::neuraylib::IAttribute_set) and whose element type is
+    /// a number type (except \c "Size" and \c "Difference") or a compound type (e.g., \c "Color"
+    /// or \c "Float32<3>") store their elements contiguously, such that bulk data can be accessed
+    /// without creating interface pointers for each element. Other arrays store one object per
+    /// element and do not provide such access.
+    ///
+    /// The pointer is invalidated by any operation that changes the length of the array.
+    ///
+    /// \param element_type_name   The expected element type name of the array.
+    /// \return                    A pointer to the first element, or \c nullptr if the array is
+    ///                            empty, its elements are not stored contiguously, or
+    ///                            \p element_type_name does not match the element type name of
+    ///                            the array.
+    virtual const void* get_data( const char* element_type_name) const = 0;
+
+    /// Returns a pointer to the contiguous storage of the array elements.
+    ///
+    /// This templated member function is a type-safe wrapper of the non-template variant. The
+    /// element type name is derived from the template parameter via #mi::Type_traits, e.g.,
+    /// \c get_data<mi::Float32>() or \c get_data<mi::Color>().
+    template<class T>
+    const T* get_data() const
+    {
+        return static_cast<const T*>( get_data( Type_traits<T>::get_type_name()));
+    }
+
+    /// Returns a pointer to the contiguous storage of the array elements.
+    ///
+    /// See #get_data(const char*)const for details.
+    virtual void* get_data( const char* element_type_name) = 0;
+
+    /// Returns a pointer to the contiguous storage of the array elements.
+    ///
+    /// See #get_data()const for details.
+    template<class T>
+    T* get_data()
+    {
+        return static_cast<T*>( get_data( Type_traits<T>::get_type_name()));
+    }
 };
 
 /**@}*/ // end group mi_neuray_collections
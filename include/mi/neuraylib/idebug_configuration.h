@@ -44,6 +44,16 @@ namespace neuraylib {
 */
 
 /// This interface represents an interface to set debug options.
+///
+/// The following debug options enable profiling of the main processing phases (module loading,
+/// DAG building, instance compilation, distilling, LLVM optimization, code generation, and
+/// linking). They can be changed at any time:
+/// - \c "profiling": If set to \c 1, per-phase timings and counters are collected. A report is
+///   logged on shutdown. Default: \c 0.
+/// - \c "profiling_trace": If set to \c 1 (and profiling is enabled), individual trace events
+///   are recorded as well. Default: \c 0.
+/// - \c "profiling_trace_file": The (quoted) file name to which the trace events are written on
+///   shutdown in the Chrome trace event format, e.g., \c profiling_trace_file="trace.json".
 class IDebug_configuration : public
     mi::base::Interface_declare<0x7938887b,0x57c6,0x422f,0x84,0x03,0xdc,0x06,0xf2,0x26,0xd6,0x04>
 {
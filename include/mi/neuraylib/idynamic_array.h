@@ -55,7 +55,7 @@ namespace neuraylib { class IFactory; }
 /// \see #mi::IArray
 ///
 class IDynamic_array :
-    public base::Interface_declare<0x575af5ad,0xc7c8,0x44a1,0x92,0xb2,0xe5,0x5d,0x5b,0x9a,0x90,0xff,
+    public base::Interface_declare<0xe9652aec,0xb646,0x4b6b,0x9c,0x77,0x0d,0xef,0x0c,0xbd,0xd1,0x79,
                                    IArray>
 {
 public:
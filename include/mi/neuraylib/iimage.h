@@ -153,6 +153,8 @@ public:
     ///                       -  -5: Failure to open the resolved file.
     ///                       -  -7: The image plugin failed to import the file.
     ///                       - -10: Failure to apply the given selector.
+    ///                       - -13: Failure to execute the concurrent import of the uv-tiles or
+    ///                              frames.
     ///
     /// \see #mi::neuraylib::IMdl_factory::create_texture() for a way to create a texture based
     ///      on an MDL file path instead of a filename.
@@ -241,6 +241,34 @@ public:
     virtual bool write( const ITile* tile, Uint32 z, Uint32 level) = 0;
 };
 
+/// Optional extension of #mi::neuraylib::IImage_file for reading rectangular regions.
+///
+/// Image files obtained from #mi::neuraylib::IImage_plugin::open_for_reading() may additionally
+/// implement this interface. Callers query it via #mi::base::IInterface::get_interface(). Image
+/// plugins that do not implement it are not affected.
+class IImage_file_region_reader
+  : public base::Interface_declare<0x9c90b085,0x985a,0x41ec,0x8f,0xa5,0xe9,0xcb,0xa6,0xf0,0xf5,0x8c>
+{
+public:
+    /// Read pixels of a rectangular region from the image file into a tile.
+    ///
+    /// Allows to read parts of large images without decoding the entire image, e.g., only the
+    /// affected tiles of tiled image formats.
+    ///
+    /// \param x       The x coordinate of the lower left corner of the region.
+    /// \param y       The y coordinate of the lower left corner of the region (in the same
+    ///                bottom-up convention as #mi::neuraylib::ITile).
+    /// \param width   The width of the region.
+    /// \param height  The height of the region.
+    /// \param z       The z layer (for 3d textures or cubemaps).
+    /// \param level   The mipmap level (always 0 if the image is not a mipmap).
+    /// \return        The tile of size \p width x \p height with the read data, or \c nullptr in
+    ///                case of failures (including empty regions or regions that are not contained
+    ///                in the image).
+    virtual ITile* read_region(
+        Uint32 x, Uint32 y, Uint32 width, Uint32 height, Uint32 z, Uint32 level) const = 0;
+};
+
 /**@}*/ // end group mi_neuray_plugins
 
 } // namespace neuraylib
@@ -99,6 +99,11 @@ public:
     /// The following options are supported by the NATIVE backend only:
     /// - \c "use_builtin_resource_handler": Enables/disables the built-in texture runtime.
     ///   Possible values: \c "on", \c "off". Default: \c "on".
+    /// - \c "use_alias_sampling": Enables/disables sampling of light profiles and BSDF
+    ///   measurements in the built-in texture runtime via alias tables instead of CDFs. Alias
+    ///   tables sample in constant time, but do not preserve the stratification of the random
+    ///   numbers. The pdf is the same in both cases. Possible values: \c "on", \c "off".
+    ///   Default: \c "off".
     ///
     /// The following options are supported by the PTX, LLVM-IR, native, GLSL and HLSL backend:
     ///
@@ -187,6 +192,11 @@ public:
     ///   passed to all resource callbacks. This option is currently not supported.
     ///   Possible values:
     ///   \c "on", \c "off". Default: \c "off".
+    /// - \c "hlsl_merge_functions": If enabled, internal functions with identical bodies are
+    ///   merged into one function before the code is written. This reduces the code size for
+    ///   link units containing many materials which share helper functions.
+    ///   Possible values:
+    ///   \c "on", \c "off". Default: \c "off".
     /// - \c "hlsl_remap_functions": Specifies a comma separated remap list of MDL functions. The
     ///                              entries must be specified as &lt;old_name&gt;=&lt;new_name&gt;.
     ///                              Both names have to be in mangled form.
@@ -243,6 +253,11 @@ public:
     ///   passed to all resource callbacks. This option is currently not supported.
     ///   Possible values:
     ///   \c "on", \c "off". Default: \c "off".
+    /// - \c "glsl_merge_functions": If enabled, internal functions with identical bodies are
+    ///   merged into one function before the code is written. This reduces the code size for
+    ///   link units containing many materials which share helper functions.
+    ///   Possible values:
+    ///   \c "on", \c "off". Default: \c "off".
     /// - \c "glsl_remap_functions": Specifies a comma separated remap list of MDL functions. The
     ///                              entries must be specified as &lt;old_name&gt;=&lt;new_name&gt;.
     ///                              Both names have to be in mangled form.
@@ -794,7 +809,7 @@ public:
 
 /// Represents target code of an MDL backend.
 class ITarget_code : public
-    mi::base::Interface_declare<0xefca46ae,0xd530,0x4b97,0x9d,0xab,0x3a,0xdb,0x0c,0x58,0xc3,0xac>
+    mi::base::Interface_declare<0xe673c739,0x61db,0x4c20,0x92,0x45,0xfe,0xec,0xf2,0xa8,0xb0,0xa9>
 {
 public:
     /// The potential state usage properties.
@@ -1140,8 +1155,8 @@ public:
     ///                           identical to the one used to generate this \c ITarget_code.
     /// \param resource_callback  Callback for retrieving resource indices for resource values.
     ///
-    /// \return  the generated target argument block or \c nullptr if no arguments were captured
-    ///          or the index was invalid.
+    /// \return  the generated target argument block or \c nullptr if no arguments were captured,
+    ///          the index was invalid, or the arguments of \p material do not fit to the layout.
     virtual ITarget_argument_block *create_argument_block(
         Size index,
         const ICompiled_material *material,
@@ -1157,6 +1172,69 @@ public:
     /// \return  the layout or \c nullptr if no arguments were captured or the index was invalid.
     virtual const ITarget_value_layout *get_argument_block_layout(Size index) const = 0;
 
+    /// Writes the target argument blocks of several class-compiled materials into a contiguous
+    /// buffer provided by the caller.
+    ///
+    /// The argument block of \c materials[i] is written to \c buffer+i*stride. Each block is
+    /// zero-initialized first, i.e., the result is identical to the data of the target argument
+    /// block returned by #create_argument_block(). The layout of the target argument block is
+    /// flattened once per target code, so this method avoids the per-element layout queries and
+    /// the per-material allocations of repeated #create_argument_block() calls.
+    ///
+    /// \param index              The index of the base target argument block of this target code.
+    /// \param materials          The class-compiled MDL materials which have to fit to this
+    ///                           \c ITarget_code, i.e. the hash of the compiled materials must be
+    ///                           identical to the one used to generate this \c ITarget_code.
+    /// \param count              The number of materials.
+    /// \param resource_callback  Callback for retrieving resource indices for resource values.
+    /// \param buffer             The buffer receiving the target argument blocks. It has to be
+    ///                           at least \c count*stride bytes large.
+    /// \param stride             The distance in bytes between two consecutive target argument
+    ///                           blocks in \p buffer. It has to be at least the size of the
+    ///                           target argument block layout.
+    /// \return
+    ///                           -  0: Success.
+    ///                           - -1: Invalid parameters (\c nullptr or invalid index).
+    ///                           - -2: \p stride is smaller than the size of the layout.
+    ///                           - -3: The parameters of a material do not fit to the layout.
+    ///                           - -4: A parameter value could not be written.
+    virtual Sint32 write_argument_blocks(
+        Size index,
+        const ICompiled_material* const* materials,
+        Size count,
+        ITarget_resource_callback* resource_callback,
+        char* buffer,
+        Size stride) const = 0;
+
+    /// Rewrites selected parameters in an existing target argument block.
+    ///
+    /// Only the values of the given parameters are written, all other data of \p block is left
+    /// unchanged. This allows cheap updates of an argument block after only a few parameters of
+    /// a material have been changed.
+    ///
+    /// \param index              The index of the base target argument block of this target code.
+    /// \param material           The class-compiled MDL material which has to fit to this
+    ///                           \c ITarget_code.
+    /// \param parameter_indices  The indices of the parameters to rewrite.
+    /// \param parameter_count    The number of parameter indices.
+    /// \param resource_callback  Callback for retrieving resource indices for resource values.
+    /// \param block              The target argument block data to update, for instance obtained
+    ///                           via #ITarget_argument_block::get_data() or written by
+    ///                           #write_argument_blocks().
+    /// \return
+    ///                           -  0: Success.
+    ///                           - -1: Invalid parameters (\c nullptr or invalid index).
+    ///                           - -2: A parameter index is out of range.
+    ///                           - -3: The parameters of the material do not fit to the layout.
+    ///                           - -4: A parameter value could not be written.
+    virtual Sint32 update_argument_block(
+        Size index,
+        const ICompiled_material* material,
+        const Size* parameter_indices,
+        Size parameter_count,
+        ITarget_resource_callback* resource_callback,
+        char* block) const = 0;
+
     /// Returns the number of string constants used by the target code.
     virtual Size get_string_constant_count() const = 0;
 
@@ -1530,7 +1608,8 @@ public:
         const = 0;
 
     /// Indicates whether the target code can be serialized.
-    /// Not all back-ends support serialization.
+    /// Not all back-ends support serialization. Target code of the CUDA PTX, LLVM-IR, GLSL, and
+    /// HLSL back-ends can be serialized, target code of the native back-end cannot.
     virtual bool supports_serialization() const = 0;
 
     /// Stores the data of this object in a buffer that can written to an external cache.
@@ -67,7 +67,7 @@ mi_static_assert( sizeof( Baker_resource) == sizeof( Uint32));
 
 /// Provides access to various functionality related to MDL distilling.
 class IMdl_distiller_api : public
-    mi::base::Interface_declare<0x074709ef,0x11b0,0x4196,0x82,0x1c,0xab,0x64,0x1a,0xa2,0x50,0xdb>
+    mi::base::Interface_declare<0xe68e72a4,0xde25,0x4cf8,0x84,0x2a,0x29,0x63,0x8a,0x7a,0xdc,0xa6>
 {
 public:
     /// Returns the number of targets supported for distilling.
@@ -186,6 +186,11 @@ public:
     ///       - \c "layer_normal" of type #mi::IBoolean. If \c true, it enables the aggregation
     ///         of the local normal maps of BSDF layerers to combine them with the global normal
     ///         map. Default: \c true.
+    ///       - \c "cache" of type #mi::IBoolean. If \c true, distilled materials are cached
+    ///         across calls, such that distilling a material with the same hash, arguments,
+    ///         target, and options again reuses the earlier result. The cache is bounded and
+    ///         evicts the least recently used results. It is bypassed if tracing or debug
+    ///         printing is requested. Default: \c false.
     ///
     /// \param errors             An optional pointer to an #mi::Sint32 to which an error code will
     ///                           be written. The error codes have the following meaning:
@@ -200,6 +205,34 @@ public:
         const IMap* distiller_options = nullptr,
         Sint32* errors = nullptr) const = 0;
 
+    /// Distills several materials in parallel.
+    ///
+    /// This method is equivalent to calling #distill_material() for each material, but distills
+    /// the materials in parallel using the thread pool. All materials need to be accessed via the
+    /// same transaction.
+    ///
+    /// \param materials          The materials to be distilled.
+    /// \param count              The number of materials.
+    /// \param target             The target model. See #get_target_count() and #get_target_name().
+    /// \param distiller_options  Options for the distiller, see #distill_material().
+    /// \param[out] results       An array of size \p count that receives the distilled materials,
+    ///                           or \c nullptr for materials that could not be distilled.
+    /// \param[out] errors        An optional array of size \p count that receives the error codes
+    ///                           of the individual materials as for #distill_material().
+    /// \return
+    ///                           -  0: Success.
+    ///                           - -1: Invalid parameters (\c nullptr, or materials from
+    ///                                 different transactions).
+    ///                           - -2: Invalid target model.
+    ///                           - -3: At least one material could not be distilled.
+    virtual Sint32 distill_materials(
+        const ICompiled_material* const* materials,
+        Size count,
+        const char* target,
+        const IMap* distiller_options,
+        ICompiled_material** results,
+        Sint32* errors = nullptr) const = 0;
+
     /// Creates a baker for texture baking.
     ///
     /// \param material           The material of which a subexpression is to be baked.
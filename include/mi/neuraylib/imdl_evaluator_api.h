@@ -47,7 +47,7 @@ class IValue_factory;
 
 /// Provides access to various functions for the evaluation of MDL expressions.
 class IMdl_evaluator_api : public
-    mi::base::Interface_declare<0x1dc8e8c2,0xa19e,0x4dc9,0xa3,0x0f,0xeb,0xb4,0x0a,0xf1,0x08,0x58>
+    mi::base::Interface_declare<0x56136772,0x2a13,0x4542,0xba,0xb0,0x40,0x67,0xf1,0xfc,0x19,0x4a>
 {
 public:
     /// Evaluates if a function call parameter is enabled, i.e., the \c enable_if condition
@@ -73,6 +73,40 @@ public:
         const IFunction_call* call,
         Size index,
         Sint32* errors) const = 0;
+
+    /// Evaluates the \c enable_if conditions of all parameters of a function call in one pass.
+    ///
+    /// Subexpressions shared between the conditions (in particular, the arguments of parameters
+    /// referenced by several conditions) are evaluated only once. If \p changed_indices is
+    /// given, only the conditions that might depend on the arguments of these parameters (see
+    /// #mi::neuraylib::IFunction_definition::get_enable_if_users()) are evaluated, and the other
+    /// elements of \p results are left unchanged. This allows to update the results of a
+    /// previous call after some arguments were changed.
+    ///
+    /// \param[in]  trans            The transaction.
+    /// \param[in]  call             The function call.
+    /// \param[in]  changed_indices  The indices of the parameters whose arguments changed, or
+    ///                              \c nullptr to evaluate the conditions of all parameters.
+    /// \param[in]  changed_count    The number of elements in \p changed_indices.
+    /// \param[out] results          An array with one element per parameter of \p call. An
+    ///                              evaluated element is set to 1 if the parameter is enabled, to
+    ///                              0 if it is disabled, and to one of the negative error codes
+    ///                              -3, -4, or -5 of #is_function_parameter_enabled() if the
+    ///                              condition could not be evaluated. Parameters without
+    ///                              condition are always enabled.
+    /// \param[in]  results_count    The number of elements in \p results.
+    /// \return
+    ///                              -  0: Success.
+    ///                              - -1: An input parameter is \c nullptr.
+    ///                              - -2: \p results_count is smaller than the number of
+    ///                                    parameters, or a changed index is out of bounds.
+    virtual Sint32 are_function_parameters_enabled(
+        ITransaction* trans,
+        const IFunction_call* call,
+        const Size* changed_indices,
+        Size changed_count,
+        Sint32* results,
+        Size results_count) const = 0;
 };
 
 /**@}*/ // end group mi_neuray_mdl_misc
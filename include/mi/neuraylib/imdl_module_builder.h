@@ -53,9 +53,14 @@ class IMdl_execution_context;
 
 /// The module builder allows to create new MDL modules.
 ///
+/// By default, each modification of the module is immediately followed by an analysis of the
+/// entire module (and its export to the DB, if applicable). When adding many entities, this can be
+/// avoided by enabling the deferred analysis mode via #set_deferred_analysis(). In this mode,
+/// modifications are only queued, and the module is analyzed and exported once by #commit().
+///
 /// \see #mi::neuraylib::IMdl_factory::create_module_builder()
 class IMdl_module_builder: public
-    base::Interface_declare<0x2357f2f8,0x4428,0x47e5,0xaa,0x92,0x97,0x98,0x25,0x5d,0x26,0x57>
+    base::Interface_declare<0x8b7c8f51,0x1e2d,0x4a3f,0x9c,0x61,0x2d,0x47,0xe0,0xb3,0x5a,0x16>
 {
 public:
     /// Adds a variant to the module.
@@ -328,6 +333,35 @@ public:
     /// Clears the module, i.e., removes all entities from the module.
     virtual Sint32 clear_module( IMdl_execution_context* context) = 0;
 
+    /// Enables or disables the deferred analysis mode.
+    ///
+    /// In deferred analysis mode, the methods that modify the module do not analyze the module and
+    /// do not export it to the DB. Instead, the modifications are queued until the next call of
+    /// #commit(). Hence, errors that are detected only by the analysis of the module are not
+    /// reported by these methods, but by #commit(). Note that entities added in this mode do not
+    /// exist in the DB before #commit(), i.e., they cannot be used as prototypes or callees of
+    /// other entities until then. Disabling the deferred analysis mode commits pending
+    /// modifications. Pending modifications are discarded if the module builder is destroyed.
+    ///
+    /// \param deferred                Indicates whether the analysis should be deferred.
+    /// \param context                 The execution context can be used to pass options and to
+    ///                                retrieve error and/or warning messages. Can be \c nullptr.
+    /// \return                        0 in case of success, or -1 in case of failure (only
+    ///                                possible when disabling the deferred mode, see #commit()).
+    virtual Sint32 set_deferred_analysis( bool deferred, IMdl_execution_context* context) = 0;
+
+    /// Analyzes the module after modifications in the deferred analysis mode.
+    ///
+    /// The module is analyzed once for all pending modifications, and exported to the DB (if
+    /// applicable). If the analysis fails, then all pending modifications are discarded, i.e., the
+    /// module is reset to its state after the last successful analysis. Does nothing if there are
+    /// no pending modifications.
+    ///
+    /// \param context                 The execution context can be used to pass options and to
+    ///                                retrieve error and/or warning messages. Can be \c nullptr.
+    /// \return                        0 in case of success, or -1 in case of failure.
+    virtual Sint32 commit( IMdl_execution_context* context) = 0;
+
     /// Analyzes which parameters need to be uniform.
     ///
     /// Note that the method can fail if the graph to be analyzed is invalid and/or never uniform
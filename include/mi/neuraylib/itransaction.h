@@ -38,6 +38,7 @@
 namespace mi {
 
 class IArray;
+class IMap;
 
 namespace neuraylib {
 
@@ -102,7 +103,7 @@ class IScope;
 /// committed. \ifnot MDL_SDK_API If needed, the lifetime of transactions can be serialized across
 /// hosts (see #mi::neuraylib::IDatabase::lock() for details). \endif
 class ITransaction : public
-    mi::base::Interface_declare<0x6ca1f0c2,0xb262,0x4f09,0xa6,0xa5,0x05,0xae,0x14,0x45,0xed,0xfa>
+    mi::base::Interface_declare<0xbb7ba26c,0x7a8d,0x46e5,0x8b,0xd7,0x89,0x4e,0xd1,0x0e,0xa6,0x02>
 {
 public:
     /// Symbolic privacy level for the privacy level of the scope of this transaction.
@@ -592,6 +593,47 @@ public:
     virtual bool has_changed_since_time_stamp(
         const char* element, const char* time_stamp) const = 0;
 
+    /// Returns all elements that have been stored or changed in the database since a given time
+    /// stamp, optionally including all elements depending on them.
+    ///
+    /// This method allows to find the changes since the last update of an application-side
+    /// representation of the scene without polling each element individually via
+    /// #has_changed_since_time_stamp(). Its runtime is proportional to the number of changes (and
+    /// their dependents), not to the number of elements in the database.
+    ///
+    /// The keys of the returned map are the names of the changed elements, the values are of type
+    /// #mi::IUint32 and hold the union of the journal flags of all changes of that element. These
+    /// flags are implementation-specific, but they are never zero for changed elements. Elements
+    /// that have not been changed themselves, but (directly or indirectly) reference a changed
+    /// element, have the value zero. Elements without names are not reported.
+    ///
+    /// Dependents are determined from the references between database elements. For example, a
+    /// material instance is reported if a function call connected to one of its arguments
+    /// changes. Compiled materials stored in the database reference the material instance they
+    /// have been created from, hence they are reported as dependents of that instance and its
+    /// arguments.
+    ///
+    /// \note The change journal is disabled by default since it requires additional memory and
+    ///       time. It can be enabled by setting the debug option \c "dblight_journal=1" via
+    ///       #mi::neuraylib::IDebug_configuration::set_option() before \neurayProductName is
+    ///       started.
+    ///
+    /// \note The same restrictions w.r.t. concurrent and overlapping transactions as for
+    ///       #has_changed_since_time_stamp() apply.
+    ///
+    /// \see #get_time_stamp(), #has_changed_since_time_stamp()
+    ///
+    /// \param time_stamp          The time stamp obtained from #get_time_stamp() or
+    ///                            #get_time_stamp(const char*)const.
+    /// \param include_dependents  Indicates whether elements referencing changed elements
+    ///                            (directly or indirectly) should be reported, too.
+    /// \return                    A map from element names to journal flags (see above), or
+    ///                            \c nullptr in case of errors, e.g., invalid time stamps, if the
+    ///                            journal is disabled, or if the journal does no longer contain all
+    ///                            changes since \p time_stamp.
+    virtual IMap* get_changed_elements_since_time_stamp(
+        const char* time_stamp, bool include_dependents) const = 0;
+
     //@}
     /// \name Traversal
     //@{
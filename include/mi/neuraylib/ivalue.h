@@ -422,7 +422,7 @@ public:
 
 /// A value of type array.
 class IValue_array : public
-    mi::base::Interface_declare<0xa17c5f57,0xa647,0x41c4,0x86,0x2f,0x4c,0x0d,0xe1,0x30,0x08,0xfc,
+    mi::base::Interface_declare<0xdf2f52c4,0xe192,0x47da,0xbe,0x87,0xbe,0x76,0xd5,0x8d,0x3a,0x91,
                                 neuraylib::IValue_compound>
 {
 public:
@@ -439,6 +439,56 @@ public:
     ///               -  0: Success.
     ///               - -1: The array is an immediate-sized array.
     virtual Sint32 set_size( Size size) = 0;
+
+    /// \name Bulk access for arrays of atomic types
+    ///
+    /// These methods copy all elements of arrays of type \c bool, \c int, \c float, or
+    /// \c double from or to a contiguous buffer. Arrays of these element types are stored in a
+    /// packed representation until elements are accessed one by one via #get_value() or
+    /// #set_value(), such that these methods are significantly faster than the element-wise
+    /// access.
+    ///
+    /// Element-wise access does not change the semantics: elements returned by #get_value() and
+    /// passed to #set_value() are references to the array elements, and changes via
+    /// \c set_data() are visible through them.
+    ///
+    /// For deferred-sized arrays, use #set_size() to adjust the array size before calling one
+    /// of the \c set_data() methods.
+    ///
+    /// \param values   The buffer to copy the elements to or from.
+    /// \param count    The number of elements in \p values. Needs to match #get_size().
+    /// \return
+    ///                 -  0: Success.
+    ///                 - -1: Invalid parameters (\c nullptr).
+    ///                 - -2: \p count does not match the array size.
+    ///                 - -3: The element type of the array does not match the buffer type.
+    //@{
+
+    /// Copies all elements of an array of type \c bool into \p values.
+    virtual Sint32 get_data( bool* values, Size count) const = 0;
+
+    /// Copies all elements of an array of type \c int into \p values.
+    virtual Sint32 get_data( Sint32* values, Size count) const = 0;
+
+    /// Copies all elements of an array of type \c float into \p values.
+    virtual Sint32 get_data( Float32* values, Size count) const = 0;
+
+    /// Copies all elements of an array of type \c double into \p values.
+    virtual Sint32 get_data( Float64* values, Size count) const = 0;
+
+    /// Sets all elements of an array of type \c bool from \p values.
+    virtual Sint32 set_data( const bool* values, Size count) = 0;
+
+    /// Sets all elements of an array of type \c int from \p values.
+    virtual Sint32 set_data( const Sint32* values, Size count) = 0;
+
+    /// Sets all elements of an array of type \c float from \p values.
+    virtual Sint32 set_data( const Float32* values, Size count) = 0;
+
+    /// Sets all elements of an array of type \c double from \p values.
+    virtual Sint32 set_data( const Float64* values, Size count) = 0;
+
+    //@}
 };
 
 /// A value of type struct.
@@ -35,7 +35,12 @@
 #include "pch.h"
 
 #include <base/lib/config/config.h>
+#include <base/lib/log/i_log_logger.h>
 #include <base/lib/log/i_log_module.h>
+#include <base/lib/profiler/i_profiler.h>
+#include <base/util/registry/i_config_registry.h>
+
+#include <sstream>
 
 #include "neuray_debug_configuration_impl.h"
 #include "neuray_string_impl.h"
@@ -44,6 +49,21 @@ namespace MI {
 
 namespace NEURAY {
 
+namespace {
+
+/// Enables or disables the profiler according to the debug options "profiling" and
+/// "profiling_trace".
+void update_profiler( const CONFIG::Config_registry& registry)
+{
+    bool profiling = PROFILER::is_enabled();
+    bool tracing = PROFILER::is_tracing();
+    CONFIG::update_value( registry, "profiling", profiling);
+    CONFIG::update_value( registry, "profiling_trace", tracing);
+    PROFILER::set_enabled( profiling, tracing);
+}
+
+} // namespace
+
 Debug_configuration_impl::Debug_configuration_impl()
 {
     m_config_module.set();
@@ -59,7 +79,12 @@ mi::Sint32 Debug_configuration_impl::set_option( const char* option)
     if( !option)
         return 0;
 
-    return m_config_module->override( option) ? 0 : -1;
+    if( !m_config_module->override( option))
+        return -1;
+
+    // the profiler can be switched at any time
+    update_profiler( m_config_module->get_configuration());
+    return 0;
 }
 
 const mi::IString* Debug_configuration_impl::get_option( const char* key) const
@@ -84,11 +109,28 @@ mi::Sint32 Debug_configuration_impl::start()
     m_log_module.set();
     m_log_module->configure();
 
+    update_profiler( m_config_module->get_configuration());
+
     return 0;
 }
 
 mi::Sint32 Debug_configuration_impl::shutdown()
 {
+    if( PROFILER::is_enabled()) {
+
+        std::ostringstream report;
+        PROFILER::dump_report( report);
+        LOG::mod_log->info( M_NEURAY_API, LOG::Mod_log::C_MISC,
+            "Profiling report:\n%s", report.str().c_str());
+
+        std::string trace_file;
+        CONFIG::update_value(
+            m_config_module->get_configuration(), "profiling_trace_file", trace_file);
+        if( !trace_file.empty() && !PROFILER::write_chrome_trace( trace_file))
+            LOG::mod_log->error( M_NEURAY_API, LOG::Mod_log::C_MISC,
+                "Failed to write profiling trace to \"%s\".", trace_file.c_str());
+    }
+
     m_log_module.reset();
     return 0;
 }
@@ -324,6 +324,7 @@ mi::neuraylib::ICompiled_material* Function_call_impl::create_compiled_material(
             get_db_transaction(), class_compilation, target_type_int.get(), mdl_context));
     if( !db_instance)
         return nullptr;
+    db_instance->set_instance_tag( get_tag());
 
     auto* api_instance = get_transaction()->create<mi::neuraylib::ICompiled_material>(
         "__Compiled_material");
@@ -34,14 +34,23 @@
 
 #include "neuray_mdl_distiller_api_impl.h"
 
+#include <list>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <boost/functional/hash.hpp>
 #include <mi/neuraylib/icolor.h>
 #include <mi/neuraylib/imap.h>
 #include <mi/neuraylib/inumber.h>
 #include <mi/neuraylib/istring.h>
 #include <mi/neuraylib/ivector.h>
 #include <mdl/distiller/dist/i_dist.h>
+#include <base/data/db/i_db_fragmented_job.h>
+#include <base/data/db/i_db_transaction.h>
 #include <io/scene/mdl_elements/i_mdl_elements_compiled_material.h>
+#include <io/scene/mdl_elements/i_mdl_elements_value.h>
 #include <io/scene/mdl_elements/i_mdl_elements_utilities.h>
 #include <io/scene/mdl_elements/i_mdl_elements_module.h>
 #include <render/baker/baker/i_baker.h>
@@ -93,10 +102,209 @@ void get_option( const mi::IMap* options, const char* name, float& value)
 
 } // anonymous namespace
 
+namespace {
+
+/// Computes a hash of an argument value. Used to speed up cache lookups, equal values yield equal
+/// hashes.
+void hash_value( const MDL::IValue* value, size_t& hash)
+{
+    const MDL::IValue::Kind kind = value->get_kind();
+    boost::hash_combine( hash, static_cast<mi::Uint32>( kind));
+
+    switch( kind) {
+        case MDL::IValue::VK_BOOL:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_bool*>( value)->get_value());
+            return;
+        case MDL::IValue::VK_INT:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_int*>( value)->get_value());
+            return;
+        case MDL::IValue::VK_ENUM:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_enum*>( value)->get_value());
+            return;
+        case MDL::IValue::VK_FLOAT:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_float*>( value)->get_value());
+            return;
+        case MDL::IValue::VK_DOUBLE:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_double*>( value)->get_value());
+            return;
+        case MDL::IValue::VK_STRING: {
+            const char* s = static_cast<const MDL::IValue_string*>( value)->get_value();
+            boost::hash_combine( hash, std::string( s ? s : ""));
+            return;
+        }
+        case MDL::IValue::VK_VECTOR:
+        case MDL::IValue::VK_MATRIX:
+        case MDL::IValue::VK_COLOR:
+        case MDL::IValue::VK_ARRAY:
+        case MDL::IValue::VK_STRUCT: {
+            const auto* compound = static_cast<const MDL::IValue_compound*>( value);
+            const mi::Size n = compound->get_size();
+            boost::hash_combine( hash, n);
+            for( mi::Size i = 0; i < n; ++i) {
+                mi::base::Handle<const MDL::IValue> element( compound->get_value( i));
+                hash_value( element.get(), hash);
+            }
+            return;
+        }
+        case MDL::IValue::VK_TEXTURE:
+        case MDL::IValue::VK_LIGHT_PROFILE:
+        case MDL::IValue::VK_BSDF_MEASUREMENT:
+            boost::hash_combine(
+                hash, static_cast<const MDL::IValue_resource*>( value)->get_value().get_uint());
+            return;
+        case MDL::IValue::VK_INVALID_DF:
+        case MDL::IValue::VK_FORCE_32_BIT:
+            return;
+    }
+}
+
+} // anonymous namespace
+
+/// Caches distilled core material instances across calls.
+///
+/// The key consists of the hash of the compiled material (which covers its DAG and parameter
+/// names), the target, the distiller options that affect the result, and a hash of the arguments
+/// of class-compiled materials. Since the latter is not collision-free, the arguments are compared
+/// on lookup. The cache is bounded and evicts the least recently used entries.
+class Distiller_cache
+{
+public:
+    struct Key {
+        mi::base::Uuid hash;
+        std::string    target;
+        float          top_layer_weight;
+        bool           layer_normal;
+        bool           merge_metal_and_base_color;
+        bool           merge_transmission_and_base_color;
+        bool           target_material_model_mode;
+        size_t         arguments_hash;
+
+        bool operator==( const Key& other) const
+        {
+            return std::tie( hash, target, top_layer_weight, layer_normal,
+                    merge_metal_and_base_color, merge_transmission_and_base_color,
+                    target_material_model_mode, arguments_hash)
+                == std::tie( other.hash, other.target, other.top_layer_weight,
+                    other.layer_normal, other.merge_metal_and_base_color,
+                    other.merge_transmission_and_base_color, other.target_material_model_mode,
+                    other.arguments_hash);
+        }
+    };
+
+    struct Key_hash {
+        size_t operator()( const Key& key) const
+        {
+            size_t hash = key.arguments_hash;
+            boost::hash_combine( hash, key.hash.m_id1);
+            boost::hash_combine( hash, key.hash.m_id2);
+            boost::hash_combine( hash, key.hash.m_id3);
+            boost::hash_combine( hash, key.hash.m_id4);
+            boost::hash_combine( hash, key.target);
+            boost::hash_combine( hash, key.top_layer_weight);
+            boost::hash_combine( hash, key.layer_normal);
+            boost::hash_combine( hash, key.merge_metal_and_base_color);
+            boost::hash_combine( hash, key.merge_transmission_and_base_color);
+            boost::hash_combine( hash, key.target_material_model_mode);
+            return hash;
+        }
+    };
+
+    /// Computes the hash of an argument list for #Key::arguments_hash.
+    static size_t hash_arguments( const MDL::IValue_list* arguments)
+    {
+        size_t hash = 0;
+        const mi::Size n = arguments ? arguments->get_size() : 0;
+        for( mi::Size i = 0; i < n; ++i) {
+            mi::base::Handle<const MDL::IValue> argument( arguments->get_value( i));
+            hash_value( argument.get(), hash);
+        }
+        return hash;
+    }
+
+    /// Returns the cached result for the given key and arguments, or \c nullptr.
+    const mi::mdl::IMaterial_instance* lookup( const Key& key, const MDL::IValue_list* arguments)
+    {
+        mi::base::Handle<MDL::IValue_factory> vf( MDL::get_value_factory());
+
+        std::lock_guard<std::mutex> lock( m_mutex);
+        auto it = m_index.find( key);
+        if( it == m_index.end())
+            return nullptr;
+
+        // hash collision
+        const Entry& entry = *it->second;
+        if( vf->compare( entry.arguments.get(), arguments) != 0)
+            return nullptr;
+
+        m_entries.splice( m_entries.begin(), m_entries, it->second);
+        entry.result->retain();
+        return entry.result.get();
+    }
+
+    /// Adds a result to the cache, evicting the least recently used entry if necessary.
+    void insert(
+        const Key& key,
+        const MDL::IValue_list* arguments,
+        const mi::mdl::IMaterial_instance* result)
+    {
+        std::lock_guard<std::mutex> lock( m_mutex);
+
+        auto it = m_index.find( key);
+        if( it != m_index.end()) {
+            // another thread inserted the same key concurrently, or a hash collision
+            m_entries.erase( it->second);
+            m_index.erase( it);
+        }
+
+        while( m_entries.size() >= max_size) {
+            m_index.erase( m_entries.back().key);
+            m_entries.pop_back();
+        }
+
+        m_entries.push_front(
+            Entry{ key, make_handle_dup( arguments), make_handle_dup( result)});
+        m_index[key] = m_entries.begin();
+    }
+
+    /// Removes all entries.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex);
+        m_index.clear();
+        m_entries.clear();
+    }
+
+private:
+    /// The maximum number of cached results.
+    static const size_t max_size = 256;
+
+    struct Entry {
+        Key                                                 key;
+        mi::base::Handle<const MDL::IValue_list>            arguments;
+        mi::base::Handle<const mi::mdl::IMaterial_instance> result;
+    };
+
+    using Entry_list = std::list<Entry>;
+
+    std::mutex m_mutex;
+
+    /// The entries, most recently used first.
+    Entry_list m_entries;
+
+    /// Index into m_entries.
+    std::unordered_map<Key, Entry_list::iterator, Key_hash> m_index;
+};
+
 Mdl_distiller_api_impl::Mdl_distiller_api_impl( mi::neuraylib::INeuray* neuray)
   : m_neuray( neuray),
     m_dist_module( true),
-    m_baker_module( true)
+    m_baker_module( true),
+    m_cache( std::make_unique<Distiller_cache>())
 {
 }
 
@@ -306,6 +514,163 @@ public:
 
 }  // anonymous
 
+namespace {
+
+/// Reads the distiller options from an IMap.
+///
+/// \param distiller_options  The options passed to the API, can be \c nullptr.
+/// \param[out] options       The distiller options.
+/// \param[out] use_cache     Indicates whether the distiller cache should be used.
+void get_distiller_options(
+    const mi::IMap* distiller_options, mi::mdl::Distiller_options& options, bool& use_cache)
+{
+    get_option( distiller_options, "layer_normal", options.layer_normal);
+    get_option( distiller_options, "top_layer_weight", options.top_layer_weight);
+    get_option( distiller_options, "merge_metal_and_base_color",
+                options.merge_metal_and_base_color);
+    get_option( distiller_options, "merge_transmission_and_base_color",
+                options.merge_transmission_and_base_color);
+    get_option( distiller_options, "target_material_model_mode",
+                options.target_material_model_mode);
+    get_option( distiller_options, "_dbg_quiet", options.quiet);
+    get_option( distiller_options, "_dbg_verbosity", options.verbosity);
+    get_option( distiller_options, "_dbg_trace", options.trace);
+    get_option( distiller_options, "_dbg_debug_print", options.debug_print);
+
+    use_cache = false;
+    get_option( distiller_options, "cache", use_cache);
+
+    // tracing needs the rule matcher events of the actual distilling run
+    if( options.trace != 0 || options.debug_print)
+        use_cache = false;
+}
+
+/// Wraps a distilled core material instance as compiled material.
+///
+/// \param transaction     The transaction of the original material.
+/// \param db_material     The original material.
+/// \param core_instance   The distilled core material instance.
+mi::neuraylib::ICompiled_material* create_compiled_material(
+    Transaction_impl* transaction,
+    const MDL::Mdl_compiled_material* db_material,
+    const mi::mdl::IMaterial_instance* core_instance)
+{
+    auto new_db_material = std::make_shared<MDL::Mdl_compiled_material>(
+        transaction->get_db_transaction(),
+        core_instance,
+        /*module_name*/ nullptr,
+        db_material->get_mdl_meters_per_scene_unit(),
+        db_material->get_mdl_wavelength_min(),
+        db_material->get_mdl_wavelength_max(),
+        db_material->get_resolve_resources());
+
+    mi::neuraylib::ICompiled_material* new_material
+        = transaction->create<mi::neuraylib::ICompiled_material>( "__Compiled_material");
+    Compiled_material_impl* new_material_impl
+        = static_cast<Compiled_material_impl*>( new_material);
+    new_material_impl->swap( *new_db_material);
+
+    return new_material;
+}
+
+/// Distills a batch of compiled materials, one material per fragment.
+class Distill_job final : public DB::Fragmented_job
+{
+public:
+    Distill_job(
+        const Mdl_distiller_api_impl* distiller_api,
+        const std::vector<const MDL::Mdl_compiled_material*>& materials,
+        const char* target,
+        const mi::mdl::Distiller_options& options,
+        bool use_cache)
+      : m_distiller_api( distiller_api),
+        m_materials( materials),
+        m_target( target),
+        m_options( options),
+        m_use_cache( use_cache),
+        m_results( materials.size()),
+        m_errors( materials.size(), 0)
+    {
+    }
+
+    void execute_fragment(
+        DB::Transaction* transaction,
+        size_t index,
+        size_t count,
+        const mi::neuraylib::IJob_execution_context* context) final
+    {
+        // the options are modified by the distiller plugins
+        mi::mdl::Distiller_options options( m_options);
+        m_results[index] = m_distiller_api->distill_core(
+            transaction, m_materials[index], m_target, options, m_use_cache, &m_errors[index]);
+    }
+
+    /// Returns the distilled core material instance of the given fragment (or \c nullptr).
+    const mi::mdl::IMaterial_instance* get_result( size_t index) const
+    { return m_results[index].get(); }
+
+    /// Returns the error code of the given fragment.
+    mi::Sint32 get_error( size_t index) const { return m_errors[index]; }
+
+private:
+    const Mdl_distiller_api_impl* m_distiller_api;
+    const std::vector<const MDL::Mdl_compiled_material*>& m_materials;
+    const char* m_target;
+    const mi::mdl::Distiller_options m_options;
+    bool m_use_cache;
+    std::vector<mi::base::Handle<const mi::mdl::IMaterial_instance>> m_results;
+    std::vector<mi::Sint32> m_errors;
+};
+
+} // anonymous namespace
+
+const mi::mdl::IMaterial_instance* Mdl_distiller_api_impl::distill_core(
+    DB::Transaction* transaction,
+    const MDL::Mdl_compiled_material* db_material,
+    const char* target,
+    mi::mdl::Distiller_options& options,
+    bool use_cache,
+    mi::Sint32* errors) const
+{
+    Distiller_cache::Key key;
+    mi::base::Handle<const MDL::IValue_list> arguments;
+    if( use_cache) {
+        arguments = db_material->get_arguments( transaction);
+        key = Distiller_cache::Key{
+            db_material->get_hash(),
+            target,
+            options.top_layer_weight,
+            options.layer_normal,
+            options.merge_metal_and_base_color,
+            options.merge_transmission_and_base_color,
+            options.target_material_model_mode,
+            Distiller_cache::hash_arguments( arguments.get())};
+        const mi::mdl::IMaterial_instance* result = m_cache->lookup( key, arguments.get());
+        if( result) {
+            *errors = 0;
+            return result;
+        }
+    }
+
+    MDL::Mdl_call_resolver resolver( transaction);
+    Rule_matcher_event event_handler( &options);
+    mi::base::Handle<const mi::mdl::IMaterial_instance> core_material_instance(
+        db_material->get_core_material_instance());
+
+    const mi::mdl::IMaterial_instance* result = m_dist_module->distill(
+        resolver,
+        (options.trace != 0 || options.debug_print) ? &event_handler : nullptr,
+        core_material_instance.get(),
+        target,
+        &options,
+        errors);
+
+    if( use_cache && result)
+        m_cache->insert( key, arguments.get(), result);
+
+    return result;
+}
+
 mi::neuraylib::ICompiled_material* Mdl_distiller_api_impl::distill_material(
     const mi::neuraylib::ICompiled_material* material,
     const char* target,
@@ -322,18 +687,8 @@ mi::neuraylib::ICompiled_material* Mdl_distiller_api_impl::distill_material(
     }
 
     mi::mdl::Distiller_options options;
-    get_option( distiller_options, "layer_normal", options.layer_normal);
-    get_option( distiller_options, "top_layer_weight", options.top_layer_weight);
-    get_option( distiller_options, "merge_metal_and_base_color",
-                options.merge_metal_and_base_color);
-    get_option( distiller_options, "merge_transmission_and_base_color",
-                options.merge_transmission_and_base_color);
-    get_option( distiller_options, "target_material_model_mode",
-                options.target_material_model_mode);
-    get_option( distiller_options, "_dbg_quiet", options.quiet);
-    get_option( distiller_options, "_dbg_verbosity", options.verbosity);
-    get_option( distiller_options, "_dbg_trace", options.trace);
-    get_option( distiller_options, "_dbg_debug_print", options.debug_print);
+    bool use_cache = false;
+    get_distiller_options( distiller_options, options, use_cache);
 
     const Compiled_material_impl* material_impl
         = static_cast<const Compiled_material_impl*>( material);
@@ -345,39 +700,74 @@ mi::neuraylib::ICompiled_material* Mdl_distiller_api_impl::distill_material(
 
     MDL::load_distilling_support_module( db_transaction);
 
-    MDL::Mdl_call_resolver resolver( db_transaction);
-    Rule_matcher_event event_handler( &options);
-    mi::base::Handle<const mi::mdl::IMaterial_instance> core_material_instance(
-        db_material->get_core_material_instance());
-
-    mi::base::Handle<const mi::mdl::IMaterial_instance>
-        new_core_material_instance(
-            m_dist_module->distill(
-                resolver,
-                (options.trace != 0 || options.debug_print) ? &event_handler : nullptr,
-                core_material_instance.get(),
-                target,
-                &options,
-                errors));
+    mi::base::Handle<const mi::mdl::IMaterial_instance> new_core_material_instance(
+        distill_core( db_transaction, db_material, target, options, use_cache, errors));
     if( !new_core_material_instance)
         return nullptr;
 
-    auto new_db_material = std::make_shared<MDL::Mdl_compiled_material>(
-        db_transaction,
-        new_core_material_instance.get(),
-        /*module_name*/ nullptr,
-        db_material->get_mdl_meters_per_scene_unit(),
-        db_material->get_mdl_wavelength_min(),
-        db_material->get_mdl_wavelength_max(),
-        db_material->get_resolve_resources());
+    return create_compiled_material(
+        transaction, db_material, new_core_material_instance.get());
+}
 
-    mi::neuraylib::ICompiled_material* new_material
-        = transaction->create<mi::neuraylib::ICompiled_material>( "__Compiled_material");
-    Compiled_material_impl* new_material_impl
-        = static_cast<Compiled_material_impl*>( new_material);
-    new_material_impl->swap( *new_db_material);
+mi::Sint32 Mdl_distiller_api_impl::distill_materials(
+    const mi::neuraylib::ICompiled_material* const* materials,
+    mi::Size count,
+    const char* target,
+    const mi::IMap* distiller_options,
+    mi::neuraylib::ICompiled_material** results,
+    mi::Sint32* errors) const
+{
+    if( !materials || !target || !results)
+        return -1;
 
-    return new_material;
+    for( mi::Size i = 0; i < count; ++i) {
+        results[i] = nullptr;
+        if( !materials[i])
+            return -1;
+    }
+    if( count == 0)
+        return 0;
+
+    mi::mdl::Distiller_options options;
+    bool use_cache = false;
+    get_distiller_options( distiller_options, options, use_cache);
+
+    // All materials need to stem from the same transaction.
+    Transaction_impl* transaction
+        = static_cast<const Compiled_material_impl*>( materials[0])->get_transaction();
+    std::vector<const MDL::Mdl_compiled_material*> db_materials( count);
+    for( mi::Size i = 0; i < count; ++i) {
+        const Compiled_material_impl* material_impl
+            = static_cast<const Compiled_material_impl*>( materials[i]);
+        if( material_impl->get_transaction() != transaction)
+            return -1;
+        db_materials[i] = material_impl->get_db_element();
+    }
+
+    DB::Transaction* db_transaction = transaction->get_db_transaction();
+    MDL::load_distilling_support_module( db_transaction);
+
+    Distill_job job( this, db_materials, target, options, use_cache);
+    if( db_transaction->execute_fragmented( &job, count) != 0)
+        return -3;
+
+    mi::Sint32 result = 0;
+    for( mi::Size i = 0; i < count; ++i) {
+        mi::Sint32 error = job.get_error( i);
+        const mi::mdl::IMaterial_instance* core_instance = job.get_result( i);
+        if( core_instance)
+            results[i] = create_compiled_material( transaction, db_materials[i], core_instance);
+        else if( error == 0)
+            error = -3;
+        if( errors)
+            errors[i] = error;
+        if( error == -2)
+            result = -2;
+        else if( error != 0 && result == 0)
+            result = -3;
+    }
+
+    return result;
 }
 
 const mi::neuraylib::IBaker* Mdl_distiller_api_impl::create_baker(
@@ -411,6 +801,7 @@ mi::Sint32 Mdl_distiller_api_impl::start()
 
 mi::Sint32 Mdl_distiller_api_impl::shutdown()
 {
+    m_cache->clear();
     m_baker_module.reset();
     m_dist_module.reset();
     return 0;
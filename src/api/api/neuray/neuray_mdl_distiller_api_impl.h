@@ -35,6 +35,7 @@
 
 #include <mi/neuraylib/imdl_distiller_api.h>
 
+#include <memory>
 #include <string>
 #include <boost/core/noncopyable.hpp>
 #include <mi/base/handle.h>
@@ -42,15 +43,19 @@
 #include <base/system/main/access_module.h>
 
 namespace mi { namespace neuraylib { class INeuray; class ITarget_code; } }
+namespace mi { namespace mdl { class IMaterial_instance; class Distiller_options; } }
 
 namespace MI {
 
 namespace DB { class Transaction; }
 namespace DIST  { class Dist_module; }
+namespace MDL { class Mdl_compiled_material; }
 namespace BAKER { class Baker_module; class IBaker_code; }
 
 namespace NEURAY {
 
+class Distiller_cache;
+
 class Mdl_distiller_api_impl final
   : public mi::base::Interface_implement<mi::neuraylib::IMdl_distiller_api>,
     public boost::noncopyable
@@ -76,6 +81,14 @@ public:
         const mi::IMap* distiller_options,
         mi::Sint32* errors) const final;
 
+    mi::Sint32 distill_materials(
+        const mi::neuraylib::ICompiled_material* const* materials,
+        mi::Size count,
+        const char* target,
+        const mi::IMap* distiller_options,
+        mi::neuraylib::ICompiled_material** results,
+        mi::Sint32* errors) const final;
+
     const mi::neuraylib::IBaker* create_baker(
         const mi::neuraylib::ICompiled_material* material,
         const char* path,
@@ -106,10 +119,34 @@ public:
     /// \return           0, in case of success, -1 in case of failure
     mi::Sint32 shutdown();
 
+    /// Distills the core material instance of a compiled material.
+    ///
+    /// Consults the distiller cache first if \p use_cache is set, and adds the result to it.
+    /// Thread-safe.
+    ///
+    /// \param transaction   The DB transaction to use.
+    /// \param db_material   The material to be distilled.
+    /// \param target        The target model.
+    /// \param options       The distiller options (might be modified by the distiller).
+    /// \param use_cache     Indicates whether the distiller cache should be used.
+    /// \param errors        The error code as for #distill_material().
+    /// \return              The distilled core material instance, or \c nullptr in case of
+    ///                      failure.
+    const mi::mdl::IMaterial_instance* distill_core(
+        DB::Transaction* transaction,
+        const MDL::Mdl_compiled_material* db_material,
+        const char* target,
+        mi::mdl::Distiller_options& options,
+        bool use_cache,
+        mi::Sint32* errors) const;
+
 private:
     mi::neuraylib::INeuray* m_neuray;
     SYSTEM::Access_module<DIST::Dist_module>   m_dist_module;
     SYSTEM::Access_module<BAKER::Baker_module> m_baker_module;
+
+    /// Distilled materials, shared by all calls of #distill_material() and #distill_materials().
+    std::unique_ptr<Distiller_cache> m_cache;
 };
 
 class Baker_impl
@@ -34,6 +34,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <mi/base/handle.h>
 #include <mi/neuraylib/iexpression.h>
@@ -125,14 +126,26 @@ public:
     , m_sym_tab(m_arena)
     , m_type_fact(m_arena, *m_compiler, m_sym_tab)
     , m_value_fact(m_arena, m_type_fact)
+    , m_param_cache()
+    , m_call_cache()
     , m_max_size(8*1024*1024)
-    , m_max_cycles(1024)
+    , m_max_cycles(max_cycles)
     , m_error(EC_OK)
     {
         Transaction_impl *transaction_impl = static_cast<Transaction_impl*>(trans);
         m_trans = transaction_impl->get_db_transaction();
     }
 
+    /// Prepare the evaluation of the next top-level expression.
+    ///
+    /// Resets the error code and the cycle limit, but keeps the results of already evaluated
+    /// parameter arguments and function calls such that they are shared between expressions.
+    void start_expression()
+    {
+        m_error      = EC_OK;
+        m_max_cycles = max_cycles;
+    }
+
     /// Evaluate a function call.
     mi::mdl::IValue const *evaluate_call(
         MDL::Mdl_function_definition const *def,
@@ -407,6 +420,40 @@ public:
         return nullptr;
     }
 
+    /// Evaluate the function call with the given tag.
+    mi::mdl::IValue const *evaluate_call_tag(DB::Tag tag)
+    {
+        SERIAL::Class_id class_id = m_trans->get_class_id(tag);
+        if (class_id != MDL::ID_MDL_FUNCTION_CALL) {
+            set_error(EC_NON_FUNCTION_CALL);
+            return m_value_fact.create_bad();
+        }
+
+        DB::Access<MDL::Mdl_function_call> fcall(tag, m_trans);
+        DB::Tag def_tag = fcall->get_function_definition(m_trans);
+        if (!def_tag.is_valid()) {
+            set_error(EC_INVALID_CALL);
+            return m_value_fact.create_bad();
+        }
+
+        DB::Access<MDL::Mdl_function_definition> def(def_tag, m_trans);
+        mi::base::Handle<MDL::IExpression_list const> args(
+            fcall->get_arguments());
+        return evaluate_call(def.get_ptr(), args.get());
+    }
+
+    /// Evaluate the argument of the parameter with the given index.
+    mi::mdl::IValue const *evaluate_parameter(size_t index)
+    {
+        mi::base::Handle<MDL::IExpression const> arg(
+            get_parameter_argument(index));
+        if (arg)
+            return evaluate(arg.get());
+
+        set_error(EC_PARAMETER);
+        return m_value_fact.create_bad();
+    }
+
     /// Evaluate an internal neuray expression.
     mi::mdl::IValue const *evaluate(MDL::IExpression const *expr)
     {
@@ -427,37 +474,15 @@ public:
             {
                 mi::base::Handle<MDL::IExpression_call const> call(
                     expr->get_interface<MDL::IExpression_call>());
-                DB::Tag tag = call->get_call();
-                SERIAL::Class_id class_id = m_trans->get_class_id(tag);
-                if (class_id != MDL::ID_MDL_FUNCTION_CALL) {
-                    set_error(EC_NON_FUNCTION_CALL);
-                    return m_value_fact.create_bad();
-                }
-
-                DB::Access<MDL::Mdl_function_call> fcall(tag, m_trans);
-                DB::Tag def_tag = fcall->get_function_definition(m_trans);
-                if (!def_tag.is_valid()) {
-                    set_error(EC_INVALID_CALL);
-                    return m_value_fact.create_bad();
-                }
-
-                DB::Access<MDL::Mdl_function_definition> def(def_tag, m_trans);
-                mi::base::Handle<MDL::IExpression_list const> args(
-                    fcall->get_arguments());
-                return evaluate_call(def.get_ptr(), args.get());
+                return evaluate_cached(
+                    m_call_cache, call->get_call(), &Evaluator::evaluate_call_tag);
             }
         case MDL::IExpression::EK_PARAMETER:
             {
                 mi::base::Handle<MDL::IExpression_parameter const> param(
                     expr->get_interface<MDL::IExpression_parameter>());
-                size_t index = param->get_index();
-                mi::base::Handle<MDL::IExpression const> arg(
-                    get_parameter_argument(index));
-                if (arg)
-                    return evaluate(arg.get());
-
-                set_error(EC_PARAMETER);
-                return m_value_fact.create_bad();
+                return evaluate_cached(
+                    m_param_cache, param->get_index(), &Evaluator::evaluate_parameter);
             }
             break;
         case MDL::IExpression::EK_DIRECT_CALL:
@@ -797,6 +822,15 @@ public:
     Err_codes get_error() const { return m_error; }
 
 private:
+    /// The maximum number of evaluation cycles per top-level expression.
+    static size_t const max_cycles = 1024;
+
+    /// A cached evaluation result together with the error it caused.
+    struct Cache_entry {
+        mi::mdl::IValue const *value;
+        Err_codes             error;
+    };
+
     /// Set the error code.
     void set_error(Err_codes code)
     {
@@ -804,6 +838,35 @@ private:
             m_error = code;
     }
 
+    /// Evaluate via the given method, or return the result of an earlier evaluation.
+    ///
+    /// Results caused by exhausted limits are not cached, because the limits are reset for
+    /// every top-level expression.
+    template<typename Key>
+    mi::mdl::IValue const *evaluate_cached(
+        std::map<Key, Cache_entry>                    &cache,
+        typename std::map<Key, Cache_entry>::key_type key,
+        mi::mdl::IValue const                         *(Evaluator::*eval)(Key))
+    {
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            if (it->second.error != EC_OK)
+                set_error(it->second.error);
+            return it->second.value;
+        }
+
+        Err_codes outer_error = m_error;
+        m_error = EC_OK;
+        mi::mdl::IValue const *res = (this->*eval)(key);
+        Err_codes error = m_error;
+        m_error = outer_error;
+        set_error(error);
+
+        if (error != EC_MEMORY_EXHAUSTED && error != EC_CYCLES_EXHAUSTED)
+            cache[key] = Cache_entry{res, error};
+        return res;
+    }
+
     /// The compiler
     mi::mdl::MDL *m_compiler;
 
@@ -830,6 +893,12 @@ private:
     /// The map for user types.
     User_type_map m_user_types;
 
+    /// Cached results of parameter arguments, indexed by parameter index.
+    std::map<size_t, Cache_entry> m_param_cache;
+
+    /// Cached results of function calls, indexed by the tag of the call.
+    std::map<DB::Tag, Cache_entry> m_call_cache;
+
     /// Maximum memory size allowed to used.
     size_t m_max_size;
 
@@ -841,6 +910,27 @@ private:
 };
 
 
+/// Convert an evaluator error code into an API error code.
+mi::Sint32 convert_error(Evaluator::Err_codes code)
+{
+    switch (code) {
+    case Evaluator::EC_OK:
+        return 0;
+    case Evaluator::EC_TEMPORARY:
+        return -3;
+    case Evaluator::EC_NOT_CONSTANT:
+    case Evaluator::EC_UNSUPPORTED:
+    case Evaluator::EC_NON_FUNCTION_CALL:
+    case Evaluator::EC_PARAMETER:
+    case Evaluator::EC_INVALID_CALL:
+        return -4;
+    case Evaluator::EC_MEMORY_EXHAUSTED:
+    case Evaluator::EC_CYCLES_EXHAUSTED:
+        return -5;
+    }
+    return -4;
+}
+
 }  // anonymous
 
 
@@ -900,25 +990,7 @@ mi::neuraylib::IValue_bool const *Mdl_evaluator_api_impl::is_function_parameter_
 
     if (!mi::mdl::is<mi::mdl::IValue_bool>(res)) {
         // could not be evaluated
-        switch (eval.get_error()) {
-        case Evaluator::EC_OK:
-            *errors = 0;
-            break;
-        case Evaluator::EC_TEMPORARY:
-            *errors = -3;
-            break;
-        case Evaluator::EC_NOT_CONSTANT:
-        case Evaluator::EC_UNSUPPORTED:
-        case Evaluator::EC_NON_FUNCTION_CALL:
-        case Evaluator::EC_PARAMETER:
-        case Evaluator::EC_INVALID_CALL:
-            *errors = -4;
-            break;
-        case Evaluator::EC_MEMORY_EXHAUSTED:
-        case Evaluator::EC_CYCLES_EXHAUSTED:
-            *errors = -5;
-            break;
-        }
+        *errors = convert_error(eval.get_error());
         return nullptr;
     }
 
@@ -926,6 +998,80 @@ mi::neuraylib::IValue_bool const *Mdl_evaluator_api_impl::is_function_parameter_
     return fact->create_bool(mi::mdl::cast<mi::mdl::IValue_bool>(res)->get_value());
 }
 
+mi::Sint32 Mdl_evaluator_api_impl::are_function_parameters_enabled(
+    mi::neuraylib::ITransaction             *trans,
+    mi::neuraylib::IFunction_call const     *call,
+    mi::Size const                          *changed_indices,
+    mi::Size                                changed_count,
+    mi::Sint32                              *results,
+    mi::Size                                results_count) const
+{
+    if (trans == nullptr || call == nullptr || results == nullptr)
+        return -1;
+
+    MDL::Mdl_function_call const *db_call(
+        static_cast<Function_call_impl const *>(call)->get_db_element());
+
+    mi::Size n_params = db_call->get_parameter_count();
+    if (results_count < n_params)
+        return -2;
+
+    // determine the parameters whose condition must be evaluated
+    std::vector<bool> selected(n_params, changed_indices == nullptr);
+    if (changed_indices != nullptr) {
+        for (mi::Size i = 0; i < changed_count; ++i)
+            if (changed_indices[i] >= n_params)
+                return -2;
+
+        DB::Transaction *db_trans = static_cast<Transaction_impl *>(trans)->get_db_transaction();
+        DB::Tag def_tag = db_call->get_function_definition(db_trans);
+        if (def_tag.is_valid()) {
+            DB::Access<MDL::Mdl_function_definition> def(def_tag, db_trans);
+            for (mi::Size i = 0; i < changed_count; ++i) {
+                mi::Size index = changed_indices[i];
+                for (mi::Size u = 0, n = def->get_enable_if_users(index); u < n; ++u) {
+                    mi::Size user = def->get_enable_if_user(index, u);
+                    if (user < n_params)
+                        selected[user] = true;
+                }
+            }
+        } else {
+            // no dependency information available, evaluate all conditions
+            selected.assign(n_params, true);
+        }
+    }
+
+    mi::base::Handle<MDL::IExpression_list const> conds(db_call->get_enable_if_conditions());
+    mi::base::Handle<mi::mdl::IMDL> compiler(m_mdlc_module->get_mdl());
+
+    // a single evaluator shares the results of common subexpressions between all conditions
+    Parameter_helper helper(db_call);
+    Evaluator eval(compiler.get(), trans, &helper);
+
+    for (mi::Size i = 0; i < n_params; ++i) {
+        if (!selected[i])
+            continue;
+
+        mi::base::Handle<MDL::IExpression const> cond(
+            conds->get_expression(db_call->get_parameter_name(i)));
+        if (!cond) {
+            // the parameter has no condition, always enabled
+            results[i] = 1;
+            continue;
+        }
+
+        eval.start_expression();
+        mi::mdl::IValue const *res = eval.evaluate(cond.get());
+        if (mi::mdl::IValue_bool const *b = mi::mdl::as<mi::mdl::IValue_bool>(res)) {
+            results[i] = b->get_value() ? 1 : 0;
+        } else {
+            mi::Sint32 error = convert_error(eval.get_error());
+            results[i] = error != 0 ? error : -4;
+        }
+    }
+    return 0;
+}
+
 mi::Sint32 Mdl_evaluator_api_impl::start()
 {
     m_mdlc_module.set();
@@ -76,6 +76,14 @@ public:
         mi::Size index,
         mi::Sint32* errors) const final;
 
+    mi::Sint32 are_function_parameters_enabled(
+        mi::neuraylib::ITransaction* trans,
+        const mi::neuraylib::IFunction_call* call,
+        const mi::Size* changed_indices,
+        mi::Size changed_count,
+        mi::Sint32* results,
+        mi::Size results_count) const final;
+
     // internal methods
 
     /// Starts this API component.
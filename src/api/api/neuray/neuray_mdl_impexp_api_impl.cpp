@@ -44,6 +44,7 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <base/data/db/i_db_snapshot_transaction.h>
 #include <base/hal/disk/disk_file_reader_writer_impl.h>
 #include <base/hal/disk/disk_memory_reader_writer_impl.h>
 #include <base/hal/hal/i_hal_ospath.h>
@@ -446,10 +447,11 @@ mi::Sint32 Mdl_impexp_api_impl::export_module_common(
     mi::base::Handle<mi::mdl::IMDL> mdl( mdlc_module->get_mdl());
     mi::base::Handle<mi::mdl::IMDL_exporter> mdl_exporter( mdl->create_exporter());
 
-    // create the resource callback
+    // create the resource callback (the export only reads from the database)
     auto* transaction_impl
         = static_cast<Transaction_impl*>( transaction);
-    DB::Transaction* db_transaction = transaction_impl->get_db_transaction();
+    DB::Snapshot_transaction db_transaction_snapshot( transaction_impl->get_db_transaction());
+    DB::Transaction* db_transaction = &db_transaction_snapshot;
     std::string uri
         = filename ? Impexp_utilities::convert_filename_to_uri( filename) : "";
     mi::base::Handle<mi::neuraylib::IExport_result_ext> export_result_ext(
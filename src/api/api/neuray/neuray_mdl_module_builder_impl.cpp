@@ -380,6 +380,25 @@ mi::Sint32 Mdl_module_builder_impl::clear_module(
     return m_impl->clear_module( context_impl);
 }
 
+mi::Sint32 Mdl_module_builder_impl::set_deferred_analysis(
+    bool deferred,
+    mi::neuraylib::IMdl_execution_context* context)
+{
+    MDL::Execution_context default_context;
+    MDL::Execution_context* context_impl = unwrap_and_clear_context( context, default_context);
+
+    return m_impl->set_deferred_analysis( deferred, context_impl);
+}
+
+mi::Sint32 Mdl_module_builder_impl::commit(
+    mi::neuraylib::IMdl_execution_context* context)
+{
+    MDL::Execution_context default_context;
+    MDL::Execution_context* context_impl = unwrap_and_clear_context( context, default_context);
+
+    return m_impl->commit( context_impl);
+}
+
 const mi::IArray* Mdl_module_builder_impl::analyze_uniform(
     const mi::neuraylib::IExpression* root_expr,
     bool root_expr_uniform,
@@ -143,6 +143,13 @@ public:
     mi::Sint32 clear_module(
         mi::neuraylib::IMdl_execution_context* context) final;
 
+    mi::Sint32 set_deferred_analysis(
+        bool deferred,
+        mi::neuraylib::IMdl_execution_context* context) final;
+
+    mi::Sint32 commit(
+        mi::neuraylib::IMdl_execution_context* context) final;
+
     const mi::IArray* analyze_uniform(
         const mi::neuraylib::IExpression* root_expr,
         bool root_expr_uniform,
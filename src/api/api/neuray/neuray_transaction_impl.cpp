@@ -44,6 +44,8 @@
 
 #include <mi/base/handle.h>
 #include <mi/neuraylib/idynamic_array.h>
+#include <mi/neuraylib/imap.h>
+#include <mi/neuraylib/inumber.h>
 #include <mi/neuraylib/istring.h>
 #include <mi/neuraylib/iuser_class.h>
 
@@ -412,6 +414,62 @@ bool Transaction_impl::has_changed_since_time_stamp(
     return has_changed_since_time_stamp( tag, time_stamp);
 }
 
+mi::IMap* Transaction_impl::get_changed_elements_since_time_stamp(
+    const char* time_stamp, bool include_dependents) const
+{
+    if( !time_stamp || !is_open())
+        return nullptr;
+
+    // Parse time_stamp into transaction id and sequence number
+    mi::Uint32 time_stamp_pod_transaction_id;
+    mi::Sint32 time_stamp_sequence_number;
+    if (2 != sscanf (time_stamp, "%10u::%10d",
+        &time_stamp_pod_transaction_id, &time_stamp_sequence_number))
+        return nullptr;
+    if( time_stamp_sequence_number < -1)
+        return nullptr;
+    DB::Transaction_id time_stamp_transaction_id( time_stamp_pod_transaction_id);
+
+    // The time stamp refers to the last change that happened before, hence the journal query
+    // starts with the next sequence number.
+    std::unique_ptr<DB::Journal_query_result> journal = m_db_transaction->get_journal(
+        time_stamp_transaction_id,
+        static_cast<mi::Uint32>( time_stamp_sequence_number + 1),
+        DB::JOURNAL_ALL,
+        /*lookup_parents*/ true);
+    if( !journal)
+        return nullptr;
+
+    // Merge the journal flags of multiple changes of the same tag.
+    robin_hood::unordered_map<DB::Tag, mi::Uint32> changes;
+    for( const auto& entry: *journal)
+        changes[entry.first] |= entry.second.get_type();
+
+    if( include_dependents) {
+        DB::Tag_set changed_tags;
+        for( const auto& change: changes)
+            changed_tags.insert( change.first);
+        const DB::Tag_set dependents = m_db_transaction->get_referencing_tags( changed_tags);
+        for( const DB::Tag& tag: dependents)
+            changes.emplace( tag, 0);
+    }
+
+    mi::base::Handle<mi::IMap> result(
+        m_class_factory->create_type_instance<mi::IMap>( nullptr, "Map<Uint32>", 0, nullptr));
+
+    for( const auto& change: changes) {
+        const char* name = m_db_transaction->tag_to_name( change.first);
+        if( !name)
+            continue;
+        mi::base::Handle<mi::IUint32> flags(
+            m_class_factory->create_type_instance<mi::IUint32>( nullptr, "Uint32", 0, nullptr));
+        flags->set_value( change.second);
+        result->insert( name, flags.get());
+    }
+
+    return result.extract();
+}
+
 const char* Transaction_impl::get_id() const
 {
     if( m_id_as_string.empty())
@@ -125,6 +125,9 @@ public:
 
     bool has_changed_since_time_stamp( const char* element, const char* time_stamp) const;
 
+    mi::IMap* get_changed_elements_since_time_stamp(
+        const char* time_stamp, bool include_dependents) const;
+
     const char* get_id() const;
 
     mi::neuraylib::IScope* get_scope() const;
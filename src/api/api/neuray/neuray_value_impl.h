@@ -340,6 +340,30 @@ public:
     mi::Sint32 set_value( mi::Size index, mi::neuraylib::IValue* value);
 
     mi::Sint32 set_size( mi::Size size) { return m_value->set_size( size); }
+
+    mi::Sint32 get_data( bool* values, mi::Size count) const
+    { return m_value->get_data( values, count); }
+
+    mi::Sint32 get_data( mi::Sint32* values, mi::Size count) const
+    { return m_value->get_data( values, count); }
+
+    mi::Sint32 get_data( mi::Float32* values, mi::Size count) const
+    { return m_value->get_data( values, count); }
+
+    mi::Sint32 get_data( mi::Float64* values, mi::Size count) const
+    { return m_value->get_data( values, count); }
+
+    mi::Sint32 set_data( const bool* values, mi::Size count)
+    { return m_value->set_data( values, count); }
+
+    mi::Sint32 set_data( const mi::Sint32* values, mi::Size count)
+    { return m_value->set_data( values, count); }
+
+    mi::Sint32 set_data( const mi::Float32* values, mi::Size count)
+    { return m_value->set_data( values, count); }
+
+    mi::Sint32 set_data( const mi::Float64* values, mi::Size count)
+    { return m_value->set_data( values, count); }
 };
 
 
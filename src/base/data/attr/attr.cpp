@@ -117,6 +117,18 @@ static void do_serialize_data(
             int type, count, size;
             eval_typecode(it->get_typecode(), &type, &count, &size);
 
+            // numbers are stored contiguously, write them with a single call
+            const Size n = Size(arraysize) * count;
+            switch(type) {
+              case 'c': serializer->write((const Sint8  *)value, n); continue;
+              case 's': serializer->write((const Sint16 *)value, n); continue;
+              case 'i': serializer->write((const Sint32 *)value, n); continue;
+              case 'q': serializer->write((const Sint64 *)value, n); continue;
+              case 'f': serializer->write((const Scalar *)value, n); continue;
+              case 'd': serializer->write((const Dscalar*)value, n); continue;
+              default:  break;
+            }
+
             for (int a=0; a < arraysize; a++) {
                 for (int i=0; i < count; i++) {
                     switch(type) {
@@ -220,6 +232,18 @@ static void do_deserialize_data(
             int type, count, size;
             eval_typecode(it->get_typecode(), &type, &count, &size);
 
+            // please refer to the corresponding documentation in do_serialize_data()
+            const Size n = Size(arraysize) * count;
+            switch(type) {
+              case 'c': deser->read((Sint8  *)value, n); continue;
+              case 's': deser->read((Sint16 *)value, n); continue;
+              case 'i': deser->read((Sint32 *)value, n); continue;
+              case 'q': deser->read((Sint64 *)value, n); continue;
+              case 'f': deser->read((Scalar *)value, n); continue;
+              case 'd': deser->read((Dscalar*)value, n); continue;
+              default:  break;
+            }
+
             for (int a=0; a < arraysize; a++) {
                 for (int i=0; i < count; i++) {
                     switch(type) {
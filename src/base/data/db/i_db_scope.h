@@ -151,12 +151,20 @@ public:
     ///                                          on the journal type.
     /// \param lookup_parents                    Indicates whether parent scopes should be
     ///                                          considered, too.
+    /// \param[out] errors                       An optional pointer to an #mi::Sint32 to which an
+    ///                                          error code will be written. The error codes have
+    ///                                          the following meaning:
+    ///                                          -  0: Success.
+    ///                                          - -1: The journal is disabled.
+    ///                                          - -2: The queried range is too large for the
+    ///                                                journal capacity.
     /// \return                                  A vector of tag/journal type pairs describing the
     ///                                          changes in the relevant range matching the filter.
-    ///                                          Returns \c nullptr if the queried range is too
-    ///                                          large for the journal capacity. In this case the
-    ///                                          caller should assume that all relevant database
-    ///                                          elements have changed. \n
+    ///                                          Returns \c nullptr if the journal is disabled or
+    ///                                          if the queried range is too large for the journal
+    ///                                          capacity. In the latter case the caller should
+    ///                                          assume that all relevant database elements have
+    ///                                          changed. \n
     ///                                          The same tag might occur multiple times, with
     ///                                          identical or different journal types.
     virtual std::unique_ptr<Journal_query_result> get_journal(
@@ -164,7 +172,8 @@ public:
         mi::Uint32 last_transaction_change_version,
         DB::Transaction_id current_transaction_id,
         Journal_type journal_type,
-        bool lookup_parents) = 0;
+        bool lookup_parents,
+        mi::Sint32* errors = nullptr) = 0;
 };
 
 } // namespace DB
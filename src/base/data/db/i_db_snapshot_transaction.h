@@ -0,0 +1,477 @@
+/***************************************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************************************/
+
+#ifndef BASE_DATA_DB_I_DB_SNAPSHOT_TRANSACTION_H
+#define BASE_DATA_DB_I_DB_SNAPSHOT_TRANSACTION_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "i_db_element.h"
+#include "i_db_info.h"
+#include "i_db_tag.h"
+#include "i_db_transaction_wrapper.h"
+
+#include <base/lib/log/i_log_logger.h>
+#include <base/system/main/i_assert.h>
+
+namespace MI {
+
+namespace DB {
+
+/// A read-only snapshot of another transaction with lock-free lookups.
+///
+/// The snapshot memoizes the results of access_element(), tag_to_name(), name_to_tag(),
+/// get_class_id(), get_tag_privacy_level(), and get_tag_version() in insert-only hash tables.
+/// Once a tag or name has been looked up, further lookups do not touch the wrapped transaction
+/// (and hence do not acquire the database lock). The snapshot can be used concurrently from
+/// several threads.
+///
+/// The snapshot assumes that the view of the wrapped transaction on existing database elements
+/// does \em not change during the lifetime of the snapshot. Therefore, edit_element(),
+/// finish_edit(), localize(), and remove() are fatal errors. Storing new elements is passed
+/// through (e.g., for resources created on demand), since it does not invalidate memoized
+/// results: failed lookups are never memoized.
+///
+/// The tables start small and grow on demand. Lookups beyond the capacity of the tables are
+/// passed through without memoization.
+class Snapshot_transaction : public Transaction_wrapper
+{
+public:
+    /// Constructor
+    ///
+    /// \param transaction   The wrapped transaction. RCS:NEU
+    /// \param capacity      The maximum number of tags and names to memoize, each.
+    Snapshot_transaction( Transaction* transaction, size_t capacity = 4096)
+      : Transaction_wrapper( transaction),
+        m_tags( capacity),
+        m_names( capacity)
+    { }
+
+    /// Destructor
+    ///
+    /// Releases the memoized infos.
+    ~Snapshot_transaction()
+    {
+        m_tags.clear( []( Tag_entry* entry) { entry->m_info->unpin(); });
+    }
+
+    // re-implemented methods from Transaction_wrapper
+
+    Info* access_element( Tag tag)
+    {
+        Tag_lookup lookup( this, tag);
+        const Tag_entry* entry = lookup.get();
+        if( !entry)
+            return m_transaction->access_element( tag);
+
+        entry->m_info->pin();
+        return entry->m_info;
+    }
+
+    Info* edit_element( Tag tag)
+    {
+        LOG::mod_log->fatal( M_DB, LOG::Mod_log::C_DATABASE,
+            "Edit of tag " FMT_TAG " via read-only snapshot transaction", tag.get_uint());
+        return nullptr;
+    }
+
+    void finish_edit( Info* info, Journal_type journal_type)
+    {
+        LOG::mod_log->fatal( M_DB, LOG::Mod_log::C_DATABASE,
+            "Edit of tag " FMT_TAG " via read-only snapshot transaction",
+            info ? info->get_tag().get_uint() : 0);
+    }
+
+    void localize( Tag tag, Privacy_level privacy_level, Journal_type journal_type = JOURNAL_NONE)
+    {
+        LOG::mod_log->fatal( M_DB, LOG::Mod_log::C_DATABASE,
+            "Localization of tag " FMT_TAG " via read-only snapshot transaction", tag.get_uint());
+    }
+
+    bool remove( Tag tag, bool remove_local_copy = false)
+    {
+        LOG::mod_log->fatal( M_DB, LOG::Mod_log::C_DATABASE,
+            "Removal of tag " FMT_TAG " via read-only snapshot transaction", tag.get_uint());
+        return false;
+    }
+
+    const char* tag_to_name( Tag tag)
+    {
+        Tag_lookup lookup( this, tag);
+        const Tag_entry* entry = lookup.get();
+        return entry ? entry->m_info->get_name() : m_transaction->tag_to_name( tag);
+    }
+
+    Tag name_to_tag( const char* name)
+    {
+        if( !name)
+            return {};
+
+        std::string_view key( name);
+        size_t hash = std::hash<std::string_view>()( key);
+        const Name_entry* entry = m_names.find( hash, [&key]( const Name_entry* e) {
+            return e->m_name == key; });
+        if( entry)
+            return entry->m_tag;
+
+        Tag tag = m_transaction->name_to_tag( name);
+        if( !tag)
+            return tag;
+
+        m_names.insert(
+            hash,
+            Name_entry{ std::string( key), tag},
+            [&key]( const Name_entry* e) { return e->m_name == key; },
+            []( Name_entry*) {});
+        return tag;
+    }
+
+    SERIAL::Class_id get_class_id( Tag tag)
+    {
+        Tag_lookup lookup( this, tag);
+        const Tag_entry* entry = lookup.get();
+        return entry ? entry->m_class_id : m_transaction->get_class_id( tag);
+    }
+
+    Privacy_level get_tag_privacy_level( Tag tag)
+    {
+        Tag_lookup lookup( this, tag);
+        const Tag_entry* entry = lookup.get();
+        return entry ? entry->m_info->get_privacy_level()
+                     : m_transaction->get_tag_privacy_level( tag);
+    }
+
+    Tag_version get_tag_version( Tag tag)
+    {
+        Tag_lookup lookup( this, tag);
+        const Tag_entry* entry = lookup.get();
+        if( !entry)
+            return m_transaction->get_tag_version( tag);
+
+        return Tag_version(
+            tag, entry->m_info->get_transaction_id(), entry->m_info->get_version());
+    }
+
+private:
+    /// Memoized information about a tag.
+    struct Tag_entry
+    {
+        /// The tag.
+        Tag m_tag;
+        /// The info of the tag as seen by the wrapped transaction (pinned).
+        Info* m_info;
+        /// The class ID of the element.
+        SERIAL::Class_id m_class_id;
+    };
+
+    /// Memoized result of a name lookup.
+    struct Name_entry
+    {
+        /// The name.
+        std::string m_name;
+        /// The corresponding tag (never invalid).
+        Tag m_tag;
+    };
+
+    /// Insert-only hash table with open addressing and linear probing.
+    ///
+    /// The table consists of levels which are allocated on demand, each level has twice the
+    /// number of slots of the previous one. Lookups probe the allocated levels in order, inserts
+    /// go to the first level that is not yet half full. Concurrent inserts of the same key might
+    /// end up in different levels; such duplicates are harmless.
+    ///
+    /// Lookups are lock-free. Insertions are lock-free and never move existing entries, hence
+    /// pointers to entries stay valid until the table is destroyed.
+    template <typename Entry>
+    class Table
+    {
+    public:
+        /// Constructor.
+        ///
+        /// \param capacity   The maximum number of entries. No memory is allocated up front.
+        Table( size_t capacity) : m_max_size( capacity)
+        {
+            for( auto& level : m_levels)
+                level.store( nullptr, std::memory_order_relaxed);
+        }
+
+        ~Table() { clear( []( Entry*) {}); }
+
+        /// Returns the entry for which \p equal returns \c true, or \c nullptr.
+        template <typename Equal>
+        const Entry* find( size_t hash, Equal equal) const
+        {
+            for( const auto& level_ptr : m_levels) {
+                const Level* level = level_ptr.load( std::memory_order_acquire);
+                if( !level)
+                    return nullptr;
+                const Entry* entry = level->find( hash, equal);
+                if( entry)
+                    return entry;
+            }
+            return nullptr;
+        }
+
+        /// Inserts a copy of \p value unless an equal entry exists or the table is full.
+        ///
+        /// If an equal entry exists, \p discard is invoked on the copy before it is deleted.
+        ///
+        /// \return   The inserted or the already existing entry, or \c nullptr if the table is
+        ///           full (\p discard is not invoked in this case).
+        template <typename Equal, typename Discard>
+        const Entry* insert( size_t hash, const Entry& value, Equal equal, Discard discard)
+        {
+            if( m_size.fetch_add( 1, std::memory_order_relaxed) >= m_max_size) {
+                m_size.fetch_sub( 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            auto* new_entry = new Entry( value);
+            for( size_t i = 0; i < s_max_levels; ++i) {
+                Level* level = get_or_create_level( i);
+                if( !level->reserve())
+                    continue;
+                Entry* entry = level->insert( hash, new_entry, equal);
+                if( entry == new_entry)
+                    return new_entry;
+                // another thread inserted the same key concurrently
+                level->release();
+                m_size.fetch_sub( 1, std::memory_order_relaxed);
+                discard( new_entry);
+                delete new_entry;
+                return entry;
+            }
+
+            MI_ASSERT( !"Snapshot transaction table levels exhausted");
+            m_size.fetch_sub( 1, std::memory_order_relaxed);
+            delete new_entry;
+            return nullptr;
+        }
+
+        /// Invokes \p discard on all entries and deletes them (and all levels).
+        template <typename Discard>
+        void clear( Discard discard)
+        {
+            for( auto& level_ptr : m_levels) {
+                Level* level = level_ptr.exchange( nullptr, std::memory_order_acquire);
+                if( !level)
+                    break;
+                level->clear( discard);
+                delete level;
+            }
+            m_size.store( 0, std::memory_order_relaxed);
+        }
+
+    private:
+        /// One level of the table with a fixed number of slots.
+        class Level
+        {
+        public:
+            /// Constructor. The number of slots is a power of two and twice \p max_size.
+            Level( size_t max_size)
+              : m_slots( std::make_unique<std::atomic<Entry*>[]>( 2*max_size)),
+                m_mask( 2*max_size - 1),
+                m_max_size( max_size)
+            {
+                for( size_t i = 0; i <= m_mask; ++i)
+                    m_slots[i].store( nullptr, std::memory_order_relaxed);
+            }
+
+            template <typename Equal>
+            const Entry* find( size_t hash, Equal equal) const
+            {
+                for( size_t i = hash & m_mask; ; i = (i+1) & m_mask) {
+                    const Entry* entry = m_slots[i].load( std::memory_order_acquire);
+                    if( !entry || equal( entry))
+                        return entry;
+                }
+            }
+
+            /// Reserves space for one entry. Returns \c false if the level is half full.
+            bool reserve()
+            {
+                if( m_size.fetch_add( 1, std::memory_order_relaxed) < m_max_size)
+                    return true;
+                m_size.fetch_sub( 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            /// Releases space reserved via #reserve().
+            void release() { m_size.fetch_sub( 1, std::memory_order_relaxed); }
+
+            /// Inserts \p new_entry into reserved space and returns it, or returns the equal entry
+            /// that is already present.
+            template <typename Equal>
+            Entry* insert( size_t hash, Entry* new_entry, Equal equal)
+            {
+                for( size_t i = hash & m_mask; ; i = (i+1) & m_mask) {
+                    Entry* entry = nullptr;
+                    if( m_slots[i].compare_exchange_strong(
+                            entry, new_entry, std::memory_order_acq_rel, std::memory_order_acquire))
+                        return new_entry;
+                    if( equal( entry))
+                        return entry;
+                }
+            }
+
+            template <typename Discard>
+            void clear( Discard discard)
+            {
+                for( size_t i = 0; i <= m_mask; ++i) {
+                    Entry* entry = m_slots[i].exchange( nullptr, std::memory_order_acquire);
+                    if( entry) {
+                        discard( entry);
+                        delete entry;
+                    }
+                }
+            }
+
+        private:
+            /// The slots (number of slots minus 1 in #m_mask).
+            std::unique_ptr<std::atomic<Entry*>[]> m_slots;
+            /// Mask to map hash values to slot indices.
+            size_t m_mask;
+            /// The maximum number of entries (half the number of slots).
+            size_t m_max_size;
+            /// The number of entries (including reservations).
+            std::atomic<size_t> m_size{ 0};
+        };
+
+        /// Returns level \p i, allocating it if necessary.
+        Level* get_or_create_level( size_t i)
+        {
+            Level* level = m_levels[i].load( std::memory_order_acquire);
+            if( level)
+                return level;
+
+            auto* new_level = new Level( s_min_level_size << i);
+            if( m_levels[i].compare_exchange_strong(
+                    level, new_level, std::memory_order_acq_rel, std::memory_order_acquire))
+                return new_level;
+            // another thread allocated the level concurrently
+            delete new_level;
+            return level;
+        }
+
+        /// The maximum number of entries of the first level.
+        static constexpr size_t s_min_level_size = 8;
+        /// The maximum number of levels.
+        static constexpr size_t s_max_levels = 32;
+
+        /// The levels, allocated in order on demand.
+        std::atomic<Level*> m_levels[s_max_levels];
+        /// The maximum number of entries.
+        size_t m_max_size;
+        /// The number of entries.
+        std::atomic<size_t> m_size{ 0};
+    };
+
+    /// The result of #lookup_tag().
+    ///
+    /// Refers either to a memoized entry or, if the table is full, holds an entry that is not
+    /// memoized. The info of the latter stays pinned until the result is destroyed.
+    class Tag_lookup
+    {
+    public:
+        Tag_lookup( Snapshot_transaction* snapshot, Tag tag)
+          : m_entry( snapshot->lookup_tag( tag, m_unmemoized)) { }
+
+        ~Tag_lookup()
+        {
+            if( m_entry == &m_unmemoized)
+                m_unmemoized.m_info->unpin();
+        }
+
+        Tag_lookup( const Tag_lookup&) = delete;
+        Tag_lookup& operator=( const Tag_lookup&) = delete;
+
+        /// Returns the entry, or \c nullptr for invalid tags and jobs.
+        const Tag_entry* get() const { return m_entry; }
+
+    private:
+        /// Storage for an entry that is not memoized.
+        Tag_entry m_unmemoized{};
+        /// The memoized entry, #m_unmemoized, or \c nullptr.
+        const Tag_entry* m_entry;
+    };
+
+    /// Returns the memoized information about \p tag, creating it on the first lookup.
+    ///
+    /// If the table is full, the information is stored in \p unmemoized instead (with the info
+    /// pinned) and a pointer to it is returned. Returns \c nullptr for invalid tags and for jobs.
+    /// Use via Tag_lookup.
+    const Tag_entry* lookup_tag( Tag tag, Tag_entry& unmemoized)
+    {
+        if( !tag)
+            return nullptr;
+
+        size_t hash = std::hash<mi::Uint32>()( tag.get_uint());
+        auto equal = [tag]( const Tag_entry* e) { return e->m_tag == tag; };
+        const Tag_entry* entry = m_tags.find( hash, equal);
+        if( entry)
+            return entry;
+
+        // Check that the tag is valid for the wrapped transaction before accessing it, since
+        // accessing invalid tags is an error.
+        SERIAL::Class_id class_id = m_transaction->get_class_id( tag);
+        if( class_id == SERIAL::class_id_unknown)
+            return nullptr;
+
+        Info* info = m_transaction->access_element( tag);
+        if( !info)
+            return nullptr;
+        if( info->get_is_job()) {
+            info->unpin();
+            return nullptr;
+        }
+
+        Tag_entry value{ tag, info, class_id};
+        entry = m_tags.insert( hash, value, equal, []( Tag_entry* e) { e->m_info->unpin(); });
+        if( entry)
+            return entry;
+
+        // The table is full, keep the pinned info for the caller instead of looking it up again.
+        unmemoized = value;
+        return &unmemoized;
+    }
+
+    /// Memoized information about tags.
+    Table<Tag_entry> m_tags;
+    /// Memoized results of name lookups.
+    Table<Name_entry> m_names;
+};
+
+} // namespace DB
+
+} // namespace MI
+
+#endif // BASE_DATA_DB_I_DB_SNAPSHOT_TRANSACTION_H
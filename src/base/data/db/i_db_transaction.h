@@ -544,6 +544,22 @@ public:
     /// \name Journal
     //@{
 
+    /// Returns all tags whose elements reference any of the given tags, directly or indirectly.
+    ///
+    /// Only the references of the element versions visible in this transaction are considered.
+    /// The runtime is proportional to the number of references to the returned tags, not to the
+    /// size of the database. Typically used to expand the changed tags reported by #get_journal()
+    /// to all elements depending on them.
+    ///
+    /// \note The reverse references needed for this method are only maintained if the journal is
+    ///       enabled. Otherwise, the method returns the empty set.
+    ///
+    /// \param tags                The tags whose dependents are requested.
+    /// \return                    The tags that reference at least one tag in \p tags, directly
+    ///                            or indirectly. Tags from \p tags are only contained if they
+    ///                            reference another tag from \p tags.
+    virtual Tag_set get_referencing_tags( const Tag_set& tags) = 0;
+
     /// Returns a list of database changes since some point in time.
     ///
     /// The start of the query range is given by the pair of \p last_transaction_id and
@@ -563,19 +579,28 @@ public:
     ///                                          on the journal type.
     /// \param lookup_parents                    Indicates whether parent scopes should be
     ///                                          considered, too.
+    /// \param[out] errors                       An optional pointer to an #mi::Sint32 to which an
+    ///                                          error code will be written. The error codes have
+    ///                                          the following meaning:
+    ///                                          -  0: Success.
+    ///                                          - -1: The journal is disabled.
+    ///                                          - -2: The queried range is too large for the
+    ///                                                journal capacity.
     /// \return                                  A vector of tag/journal type pairs describing the
     ///                                          changes in the relevant range matching the filter.
-    ///                                          Returns \c nullptr if the queried range is too
-    ///                                          large for the journal capacity. In this case the
-    ///                                          caller should assume that all relevant database
-    ///                                          elements have changed. \n
+    ///                                          Returns \c nullptr if the journal is disabled or
+    ///                                          if the queried range is too large for the journal
+    ///                                          capacity. In the latter case the caller should
+    ///                                          assume that all relevant database elements have
+    ///                                          changed. \n
     ///                                          The same tag might occur multiple times, with
     ///                                          identical or different journal types.
     virtual std::unique_ptr<Journal_query_result> get_journal(
         Transaction_id last_transaction_id,
         mi::Uint32 last_transaction_change_version,
         Journal_type journal_type,
-        bool lookup_parents) = 0;
+        bool lookup_parents,
+        mi::Sint32* errors = nullptr) = 0;
 
     //@}
     /// \name Fragmented jobs
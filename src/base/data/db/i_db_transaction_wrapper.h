@@ -214,14 +214,24 @@ public:
 
     bool get_tag_is_removed( Tag tag) { return m_transaction->get_tag_is_removed( tag); }
 
+    Tag_set get_referencing_tags( const Tag_set& tags)
+    {
+        return m_transaction->get_referencing_tags( tags);
+    }
+
     std::unique_ptr<Journal_query_result> get_journal(
         Transaction_id last_transaction_id,
         mi::Uint32 last_transaction_change_version,
         Journal_type journal_type,
-        bool lookup_parents)
+        bool lookup_parents,
+        mi::Sint32* errors = nullptr)
     {
         return m_transaction->get_journal(
-            last_transaction_id, last_transaction_change_version, journal_type, lookup_parents);
+            last_transaction_id,
+            last_transaction_change_version,
+            journal_type,
+            lookup_parents,
+            errors);
     }
 
     mi::Sint32 execute_fragmented( Fragmented_job* job, size_t count)
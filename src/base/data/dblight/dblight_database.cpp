@@ -37,9 +37,7 @@
 #include "dblight_util.h"
 
 // After inclusion of dblight_util.h which might define the macro.
-#ifdef DBLIGHT_ENABLE_STATISTICS
 #include <iostream>
-#endif // DBLIGHT_ENABLE_STATISTICS
 
 #include <base/data/db/i_db_element.h>
 #include <base/data/serial/serial.h>
@@ -47,6 +45,7 @@
 #include <base/hal/host/i_host.h>
 #include <base/lib/config/config.h>
 #include <base/lib/log/i_log_logger.h>
+#include <base/lib/profiler/i_profiler.h>
 #include <base/util/registry/i_config_registry.h>
 #include <base/system/main/access_module.h>
 #include <base/system/main/i_assert.h>
@@ -55,6 +54,16 @@ namespace MI {
 
 namespace DBLIGHT {
 
+namespace {
+
+/// Contention callback for the main database lock.
+void count_lock_wait()
+{
+    PROFILER::increment( PROFILER::COUNTER_DB_LOCK_WAITS);
+}
+
+} // namespace
+
 Database_impl::Database_impl(
     THREAD_POOL::Thread_pool* thread_pool,
     SERIAL::Deserialization_manager* deserialization_manager,
@@ -65,6 +74,10 @@ Database_impl::Database_impl(
     m_next_tag( 1),
     m_journal_enabled( enable_journal)
 {
+#if !defined( DBLIGHT_NO_SHARED_LOCK)
+    m_lock.set_contention_callback( &count_lock_wait);
+#endif
+
     if( thread_pool) {
         m_thread_pool = thread_pool;
         m_independent_thread_pool = false;
@@ -115,8 +128,23 @@ Database_impl::Database_impl(
         LOG::mod_log->info( M_DB, LOG::Mod_log::C_DATABASE,
             "Testing of reference cycles for database elements after edits enabled.");
 
+    bool journal = false;
+    CONFIG::update_value( registry, "dblight_journal", journal);
+    if( journal && !m_journal_enabled) {
+        m_journal_enabled = true;
+        LOG::mod_log->info( M_DB, LOG::Mod_log::C_DATABASE, "Database journal enabled.");
+    }
+
     CONFIG::update_value( registry, "dblight_journal_max_size", m_journal_max_size);
 
+    bool statistics = false;
+    CONFIG::update_value( registry, "dblight_statistics", statistics);
+    if( statistics) {
+        g_statistics_enabled = true;
+        LOG::mod_log->info( M_DB, LOG::Mod_log::C_DATABASE,
+            "Collection of database statistics enabled.");
+    }
+
 #if defined( DBLIGHT_NO_SHARED_LOCK)
     LOG::mod_log->info( M_DB, LOG::Mod_log::C_DATABASE,
         "Using THREAD::Lock class for main database lock.");
@@ -142,9 +170,8 @@ Database_impl::~Database_impl()
    if( m_independent_thread_pool)
        delete m_thread_pool;
 
-#ifdef DBLIGHT_ENABLE_STATISTICS
-    dump_statistics( std::cerr, m_next_tag.load());
-#endif // DBLIGHT_ENABLE_STATISTICS
+    if( g_statistics_enabled)
+        dump_statistics( std::cerr, m_next_tag.load());
 }
 
 DB::Scope* Database_impl::get_global_scope()
@@ -75,7 +75,9 @@ public:
     /// \param deserialization_manager   The deserialization manager to use, or \c nullptr to use
     ///                                  an independent deserialization manager.
     /// \param enable_journal            Indicates whether the enable the journal. Maintaining the
-    ///                                  journal requires memory and time.
+    ///                                  journal requires memory and time. The journal can also
+    ///                                  be enabled via the configuration option
+    ///                                  "dblight_journal".
     Database_impl(
         THREAD_POOL::Thread_pool* thread_pool,
         SERIAL::Deserialization_manager* deserialization_manager,
@@ -260,7 +262,7 @@ private:
     bool m_check_reference_cycles_edit = false;
 
     /// Indicates whether the journal is enabled.
-    const bool m_journal_enabled;
+    bool m_journal_enabled;
 
     /// The maximum journal size.
     size_t m_journal_max_size = 10'000'000;
@@ -401,6 +401,16 @@ void Infos_per_tag::set_removed()
     m_is_removed = true;
 }
 
+void Infos_per_tag::remove_referencing_tag( DB::Tag referencing_tag)
+{
+    auto it = m_referencing_tags.find( referencing_tag);
+    MI_ASSERT( it != m_referencing_tags.end());
+    if( it == m_referencing_tags.end())
+        return;
+    if( --it->second == 0)
+        m_referencing_tags.erase( it);
+}
+
 Minor_page::Minor_page()
 {
     for( auto& infos_per_tag : m_infos_per_tags)
@@ -644,7 +654,7 @@ void Info_manager::store(
     }
 
     // Record DB element references of this info.
-    increment_pin_counts( references);
+    increment_pin_counts( references, tag);
 
     // Create info (destroys references).
     auto* info = new Info_impl(
@@ -764,7 +774,7 @@ void Info_manager::finish_edit( Info_impl* info, Transaction_impl* transaction)
         transaction->check_reference_cycles( new_references, tag, name, /*store*/ false);
     }
 
-    increment_pin_counts( new_references);
+    increment_pin_counts( new_references, info->get_tag());
 
     info->unpin();
 }
@@ -839,6 +849,49 @@ bool Info_manager::remove(
     return true;
 }
 
+DB::Tag_set Info_manager::get_referencing_tags(
+    const DB::Tag_set& tags, DB::Scope* scope, DB::Transaction_id transaction_id)
+{
+    m_database->get_lock().check_is_owned_shared_or_exclusive();
+
+    DB::Tag_set result;
+    std::vector<DB::Tag> queue( tags.begin(), tags.end());
+
+    while( !queue.empty()) {
+
+        DB::Tag tag = queue.back();
+        queue.pop_back();
+
+        Infos_per_tag* infos_per_tag = m_infos_by_tag.find( tag);
+        if( !infos_per_tag)
+            continue;
+
+        // The reverse references cover infos from all scopes and transactions. Check for each
+        // candidate whether the info visible in this transaction actually references the tag.
+        for( const auto& referencing_tag: infos_per_tag->get_referencing_tags()) {
+
+            const DB::Tag candidate = referencing_tag.first;
+            if( result.find( candidate) != result.end())
+                continue;
+
+            Info_impl* info = lookup_info( candidate, scope, transaction_id);
+            if( !info)
+                continue;
+
+            const DB::Tag_set& references = info->get_references();
+            bool is_referencing = references.find( tag) != references.end();
+            info->unpin();
+            if( !is_referencing)
+                continue;
+
+            result.insert( candidate);
+            queue.push_back( candidate);
+        }
+    }
+
+    return result;
+}
+
 void Info_manager::consider_tag_for_gc( DB::Tag tag)
 {
     if( m_gc_method == GC_GENERAL_CANDIDATES_THEN_PIN_COUNT_ZERO)
@@ -1326,29 +1379,38 @@ Infos_per_tag::Infos_per_tag_set::iterator Info_manager::cleanup_info(
         scope->erase_info( info);
 
     const DB::Tag_set& old_references = info->get_references();
-    decrement_pin_counts( old_references, /*from_gc*/ true);
+    decrement_pin_counts( old_references, info->get_tag(), /*from_gc*/ true);
     delete info;
 
     return next;
 }
 
-void Info_manager::increment_pin_counts( const DB::Tag_set& tag_set)
+void Info_manager::increment_pin_counts( const DB::Tag_set& tag_set, DB::Tag referencing_tag)
 {
     m_database->get_lock().check_is_owned();
 
+    // The reverse references are only needed for the journal-based change feed.
+    const bool journal_enabled = m_database->get_journal_enabled();
+
     for( const DB::Tag& tag: tag_set) {
         Infos_per_tag* ipt = m_infos_by_tag.find( tag);
         MI_ASSERT( ipt);
+        if( journal_enabled)
+            ipt->add_referencing_tag( referencing_tag);
         mi::Uint32 pin_count = ipt->pin();
         if( (pin_count == 1) && (m_gc_method != GC_FULL_SWEEPS_ONLY))
             m_gc_candidates_pin_count_zero.erase( tag);
     }
 }
 
-void Info_manager::decrement_pin_counts( const DB::Tag_set& tag_set, bool from_gc)
+void Info_manager::decrement_pin_counts(
+    const DB::Tag_set& tag_set, DB::Tag referencing_tag, bool from_gc)
 {
     m_database->get_lock().check_is_owned();
 
+    // The reverse references are only needed for the journal-based change feed.
+    const bool journal_enabled = m_database->get_journal_enabled();
+
     for( const DB::Tag& tag: tag_set) {
         Infos_per_tag* ipt = m_infos_by_tag.find( tag);
         // With aborted transactions it can happen that the referenced element was already removed
@@ -1357,6 +1419,8 @@ void Info_manager::decrement_pin_counts( const DB::Tag_set& tag_set, bool from_g
         (void) from_gc;
         if( !ipt)
             continue;
+        if( journal_enabled)
+            ipt->remove_referencing_tag( referencing_tag);
         mi::Uint32 pin_count = ipt->unpin();
         if( (pin_count == 0) && (m_gc_method != GC_FULL_SWEEPS_ONLY))
             m_gc_candidates_pin_count_zero.insert( tag);
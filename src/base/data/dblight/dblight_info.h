@@ -390,10 +390,27 @@ public:
     /// Marks the tag for removal in the global scope.
     void set_removed();
 
+    /// The tags of infos referencing this tag, together with the number of such infos per tag.
+    using Referencing_tags = robin_hood::unordered_map<DB::Tag, mi::Uint32>;
+
+    /// Records a reference from an info with tag \p referencing_tag to this tag.
+    ///
+    /// Only used if the journal is enabled, see Info_manager::get_referencing_tags().
+    void add_referencing_tag( DB::Tag referencing_tag) { ++m_referencing_tags[referencing_tag]; }
+
+    /// Removes a reference from an info with tag \p referencing_tag to this tag.
+    void remove_referencing_tag( DB::Tag referencing_tag);
+
+    /// Returns the tags of infos referencing this tag (in any scope or transaction).
+    const Referencing_tags& get_referencing_tags() const { return m_referencing_tags; }
+
 private:
     /// Pin count of this tag.
     std::atomic_uint32_t m_pin_count = 1;
 
+    /// Reverse references, see #get_referencing_tags().
+    Referencing_tags m_referencing_tags;
+
     /// Indicates whether this tag was already marked for removal in the global scope.
     bool m_is_removed = false;
 
@@ -688,6 +705,16 @@ public:
         DB::Tag tag,
         bool remove_local_copy);
 
+    /// Returns all tags whose infos reference any of the given tags, directly or indirectly.
+    ///
+    /// See DB::Transaction::get_referencing_tags() for details.
+    ///
+    /// \param tags             The tags whose dependents are requested.
+    /// \param scope            The scope where to start the look up. RCS:NEU
+    /// \param transaction_id   The transaction ID looking up the infos.
+    DB::Tag_set get_referencing_tags(
+        const DB::Tag_set& tags, DB::Scope* scope, DB::Transaction_id transaction_id);
+
     /// Marks a tag for consideration by the garbage collection.
     void consider_tag_for_gc( DB::Tag tag);
 
@@ -744,11 +771,12 @@ private:
     Infos_per_tag::Infos_per_tag_set::iterator cleanup_info(
         Infos_per_tag* infos_per_tag, Infos_per_tag::Infos_per_tag_set::iterator it);
 
-    /// Increments the pin counts of the given tags.
-    void increment_pin_counts( const DB::Tag_set& tag_set);
+    /// Increments the pin counts of the given tags referenced by \p referencing_tag.
+    void increment_pin_counts( const DB::Tag_set& tag_set, DB::Tag referencing_tag);
 
-    /// Decrements the pin counts of the given tags.
-    void decrement_pin_counts( const DB::Tag_set& tag_set, bool from_gc);
+    /// Decrements the pin counts of the given tags referenced by \p referencing_tag.
+    void decrement_pin_counts(
+        const DB::Tag_set& tag_set, DB::Tag referencing_tag, bool from_gc);
 
     /// Instance of the database this manager belongs to.
     Database_impl* const m_database;
@@ -100,13 +100,17 @@ std::unique_ptr<DB::Journal_query_result> Scope_impl::get_journal(
     mi::Uint32 last_transaction_change_version,
     DB::Transaction_id current_transaction_id,
     DB::Journal_type journal_type,
-    bool lookup_parents)
+    bool lookup_parents,
+    mi::Sint32* errors)
 {
     Statistics_helper helper( g_scope_get_journal);
 
+    mi::Sint32 dummy_errors = 0;
+    if( !errors)
+        errors = &dummy_errors;
+
     if( !m_database->get_journal_enabled()) {
-        LOG::mod_log->error(
-            M_DB, LOG::Mod_log::C_DATABASE, "Journal query with disabled journal.");
+        *errors = -1;
         return {};
     }
 
@@ -120,9 +124,12 @@ std::unique_ptr<DB::Journal_query_result> Scope_impl::get_journal(
         journal_type,
         lookup_parents,
         *result.get());
-    if( !success)
+    if( !success) {
+        *errors = -2;
         return nullptr;
+    }
 
+    *errors = 0;
     return result;
 }
 
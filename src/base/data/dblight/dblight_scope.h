@@ -123,7 +123,8 @@ public:
         mi::Uint32 last_transaction_change_version,
         DB::Transaction_id current_transaction_id,
         DB::Journal_type journal_type,
-        bool lookup_parents) override;
+        bool lookup_parents,
+        mi::Sint32* errors = nullptr) override;
 
     // internal methods
 
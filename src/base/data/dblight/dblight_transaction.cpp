@@ -662,17 +662,40 @@ bool Transaction_impl::get_tag_is_removed( DB::Tag tag)
     return m_database->get_info_manager()->get_tag_is_removed( tag);
 }
 
+DB::Tag_set Transaction_impl::get_referencing_tags( const DB::Tag_set& tags)
+{
+    Statistics_helper helper( g_get_referencing_tags);
+
+    // The reverse references are only maintained together with the journal.
+    if( !m_database->get_journal_enabled())
+        return {};
+
+    THREAD::Block_shared block( &m_database->get_lock());
+
+    if( m_state != OPEN) {
+        LOG::mod_log->error(
+            M_DB, LOG::Mod_log::C_DATABASE, "Use of non-open transaction.");
+        return {};
+    }
+
+    return m_database->get_info_manager()->get_referencing_tags( tags, m_scope, m_id);
+}
+
 std::unique_ptr<DB::Journal_query_result> Transaction_impl::get_journal(
     DB::Transaction_id last_transaction_id,
     mi::Uint32 last_transaction_change_version,
     DB::Journal_type journal_type,
-    bool lookup_parents)
+    bool lookup_parents,
+    mi::Sint32* errors)
 {
     Statistics_helper helper( g_transaction_get_journal);
 
+    mi::Sint32 dummy_errors = 0;
+    if( !errors)
+        errors = &dummy_errors;
+
     if( !m_database->get_journal_enabled()) {
-        LOG::mod_log->error(
-            M_DB, LOG::Mod_log::C_DATABASE, "Journal query with disabled journal.");
+        *errors = -1;
         return {};
     }
 
@@ -705,9 +728,12 @@ std::unique_ptr<DB::Journal_query_result> Transaction_impl::get_journal(
         journal_type,
         lookup_parents,
         *result.get());
-    if( !success)
+    if( !success) {
+        *errors = -2;
         return nullptr;
+    }
 
+    *errors = 0;
     return result;
 }
 
@@ -226,11 +226,14 @@ public:
 
     bool get_tag_is_removed( DB::Tag tag) override;
 
+    DB::Tag_set get_referencing_tags( const DB::Tag_set& tags) override;
+
     std::unique_ptr<DB::Journal_query_result> get_journal(
          DB::Transaction_id last_transaction_id,
          mi::Uint32 last_transaction_change_version,
          DB::Journal_type journal_type,
-         bool lookup_parents) override;
+         bool lookup_parents,
+         mi::Sint32* errors = nullptr) override;
 
     /// Only the scheduling mode LOCAL is supported.
     mi::Sint32 execute_fragmented( DB::Fragmented_job* job, size_t count) override;
@@ -38,6 +38,8 @@ namespace DBLIGHT {
 
 THREAD::Lock g_stats_lock;
 
+std::atomic_bool g_statistics_enabled = false;
+
 Statistics_data g_commit;
 Statistics_data g_abort;
 Statistics_data g_access;
@@ -55,6 +57,7 @@ Statistics_data g_get_tag_reference_count;
 Statistics_data g_get_tag_version;
 Statistics_data g_can_reference_tag;
 Statistics_data g_get_tag_is_removed;
+Statistics_data g_get_referencing_tags;
 Statistics_data g_block_commit_or_abort;
 Statistics_data g_unblock_commit_or_abort;
 Statistics_data g_scope_get_journal;
@@ -71,7 +74,6 @@ Statistics_data g_garbage_collection;
 
 void dump_statistics( std::ostream& s, mi::Uint32 next_tag)
 {
-#ifdef DBLIGHT_ENABLE_STATISTICS
     // Do not include g_lookup_info_by_tag, g_lookup_info_by_name, and g_garbage_collection which
     // are already included in other calls.
     double sum = g_commit.m_time
@@ -91,6 +93,7 @@ void dump_statistics( std::ostream& s, mi::Uint32 next_tag)
                + g_get_tag_version.m_time
                + g_can_reference_tag.m_time
                + g_get_tag_is_removed.m_time
+               + g_get_referencing_tags.m_time
                + g_block_commit_or_abort.m_time
                + g_unblock_commit_or_abort.m_time
                + g_scope_get_journal.m_time
@@ -114,6 +117,7 @@ void dump_statistics( std::ostream& s, mi::Uint32 next_tag)
     dump( "Transaction_impl::get_tag_version():", g_get_tag_version);
     dump( "Transaction_impl::can_reference_tag():", g_can_reference_tag);
     dump( "Transaction_impl::get_tag_is_removed():", g_get_tag_is_removed);
+    dump( "Transaction_impl::get_referencing_tags():", g_get_referencing_tags);
     dump( "Transaction_impl::block_commit_or_abort():", g_block_commit_or_abort);
     dump( "Transaction_impl::unblock_commit_or_abort():", g_unblock_commit_or_abort);
     dump( "Transaction_impl::get_journal():", g_transaction_get_journal);
@@ -127,26 +131,17 @@ void dump_statistics( std::ostream& s, mi::Uint32 next_tag)
 
     s << "sum: " << 1000.0 * sum << "ms" << std::endl;
     s << "next tag: " << next_tag << std::endl;
-#endif // DBLIGHT_ENABLE_STATISTICS
-}
-
-#ifdef DBLIGHT_ENABLE_STATISTICS
-Statistics_helper::Statistics_helper( Statistics_data& data)
-  : m_data( data),
-    m_start_time( std::chrono::system_clock::now())
-{
 }
 
-Statistics_helper::~Statistics_helper()
+void Statistics_helper::record()
 {
-    auto stop_time = std::chrono::system_clock::now();
+    auto stop_time = std::chrono::steady_clock::now();
     double duration = std::chrono::duration<double>( stop_time - m_start_time).count();
     // std::atomic<double> needs C++20, use a lock until then.
     THREAD::Block block( g_stats_lock);
-    ++m_data.m_count;
-    m_data.m_time += duration;
+    ++m_data->m_count;
+    m_data->m_time += duration;
 }
-#endif // DBLIGHT_ENABLE_STATISTICS
 
 } // namespace DBLIGHT
 
@@ -29,6 +29,7 @@
 #ifndef BASE_DATA_DBLIGHT_DBLIGHT_UTIL_H
 #define BASE_DATA_DBLIGHT_DBLIGHT_UTIL_H
 
+#include <atomic>
 #include <chrono>
 #include <iosfwd>
 
@@ -39,11 +40,6 @@
 #include <base/hal/thread/i_thread_lock.h>
 #include <base/hal/thread/i_thread_rw_lock.h>
 
-/// Enable this macro to collect some statistics.
-///
-/// The statistics are dumped when the database is destroyed.
-// #define DBLIGHT_ENABLE_STATISTICS
-
 /// Enable this macro to acquire the shared lock always exclusively.
 // #define DBLIGHT_NO_BLOCK_SHARED
 
@@ -63,6 +59,12 @@ namespace MI {
 
 namespace DBLIGHT {
 
+/// Indicates whether statistics are collected.
+///
+/// Statistics collection is enabled at runtime via the config variable "dblight_statistics". The
+/// statistics are dumped when the database is destroyed.
+extern std::atomic_bool g_statistics_enabled;
+
 /// Dumps the global accumulated statistics and the given tag to the stream.
 void dump_statistics( std::ostream& s, mi::Uint32 next_tag);
 
@@ -72,20 +74,29 @@ struct Statistics_data
     double m_time  = 0.0;
 };
 
+/// Accumulates the time spent in the scope of the helper if statistics are enabled.
 class Statistics_helper : private boost::noncopyable
 {
-#ifdef DBLIGHT_ENABLE_STATISTICS
 public:
-    Statistics_helper( Statistics_data& data);
-    ~Statistics_helper();
+    Statistics_helper( Statistics_data& data)
+      : m_data( g_statistics_enabled.load( std::memory_order_relaxed) ? &data : nullptr)
+    {
+        if( m_data)
+            m_start_time = std::chrono::steady_clock::now();
+    }
+
+    ~Statistics_helper()
+    {
+        if( m_data)
+            record();
+    }
 
 private:
-    Statistics_data& m_data;
-    std::chrono::time_point<std::chrono::system_clock> m_start_time;
-#else // DBLIGHT_ENABLE_STATISTICS
-public:
-    Statistics_helper( Statistics_data& /*data*/) { }
-#endif // DBLIGHT_ENABLE_STATISTICS
+    /// Adds the elapsed time to the statistics data.
+    void record();
+
+    Statistics_data* m_data;
+    std::chrono::time_point<std::chrono::steady_clock> m_start_time;
 };
 
 extern Statistics_data g_commit;
@@ -105,6 +116,7 @@ extern Statistics_data g_get_tag_reference_count;
 extern Statistics_data g_get_tag_version;
 extern Statistics_data g_can_reference_tag;
 extern Statistics_data g_get_tag_is_removed;
+extern Statistics_data g_get_referencing_tags;
 extern Statistics_data g_block_commit_or_abort;
 extern Statistics_data g_unblock_commit_or_abort;
 extern Statistics_data g_scope_get_journal;
@@ -42,7 +42,7 @@ namespace DBLIGHT {
 /// Creates an instance of the database.
 ///
 /// The instances are independent, except for the statistics which are shared by all instances
-/// (but statistics are disabled by default, see DBLIGHT_ENABLE_STATISTICS).
+/// (but statistics are disabled by default, see the config variable "dblight_statistics").
 ///
 /// \param thread_pool               The thread pool to use, or \c nullptr to use an independent
 ///                                  thread pool instance.
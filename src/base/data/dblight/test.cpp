@@ -43,6 +43,7 @@
 #include <sstream>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -57,6 +58,7 @@
 #include <base/data/db/i_db_element.h>
 #include <base/data/db/i_db_fragmented_job.h>
 #include <base/data/db/i_db_scope.h>
+#include <base/data/db/i_db_snapshot_transaction.h>
 #include <base/data/db/i_db_tag.h>
 #include <base/data/db/i_db_transaction.h>
 #include <base/data/db/i_db_transaction_ptr.h>
@@ -1252,6 +1254,113 @@ void test_transaction_get_tag_version()
     transaction1->commit();
 }
 
+void test_snapshot_transaction()
+{
+    Test_db db( __func__, /*compare*/ false); // Empty dump
+    DB::Transaction_ptr transaction = db.m_global_scope->start_transaction();
+
+    std::vector<DB::Tag> tags;
+    for( int i = 0; i < 100; ++i) {
+        std::string name = "elem_" + std::to_string( i);
+        tags.push_back( transaction->store( new My_element( i), name.c_str()));
+    }
+
+    {
+        // Small capacity to exercise lookups beyond the memoized ones.
+        DB::Snapshot_transaction snapshot( transaction.get(), /*capacity*/ 64);
+
+        std::atomic_uint32_t errors = 0;
+        auto worker = [&]() {
+            for( int j = 0; j < 10; ++j)
+                for( int i = 0; i < 100; ++i) {
+                    std::string name = "elem_" + std::to_string( i);
+                    DB::Tag tag = snapshot.name_to_tag( name.c_str());
+                    if( tag != tags[i])
+                        ++errors;
+                    if( snapshot.get_class_id( tag) != My_element::id)
+                        ++errors;
+                    const char* tag_name = snapshot.tag_to_name( tag);
+                    if( !tag_name || name != tag_name)
+                        ++errors;
+                    DB::Access<My_element> access( tag, &snapshot);
+                    if( access->get_value() != i)
+                        ++errors;
+                    if( !(snapshot.get_tag_version( tag) == transaction->get_tag_version( tag)))
+                        ++errors;
+                }
+        };
+
+        std::vector<std::thread> threads;
+        for( int t = 0; t < 4; ++t)
+            threads.emplace_back( worker);
+        for( auto& thread: threads)
+            thread.join();
+        MI_CHECK_EQUAL( errors, 0);
+
+        // Failed lookups are not memoized, new elements become visible.
+        MI_CHECK( !snapshot.name_to_tag( "bar"));
+        MI_CHECK_EQUAL( snapshot.get_class_id( DB::Tag( tags.back()() + 1)),
+            SERIAL::class_id_unknown);
+        DB::Tag tag = snapshot.store( new My_element( 42), "bar");
+        MI_CHECK_EQUAL( snapshot.name_to_tag( "bar"), tag);
+    }
+
+    transaction->commit();
+}
+
+void test_transaction_get_referencing_tags()
+{
+    {
+        // Without journal, the reverse references are not maintained.
+        Test_db db( __func__, /*compare*/ false);
+        DB::Transaction_ptr transaction = db.m_global_scope->start_transaction();
+
+        DB::Tag tag_a = transaction->store( new My_element( 1), "a");
+        transaction->store( new My_element( 2, {tag_a}), "b");
+        MI_CHECK( transaction->get_referencing_tags( {tag_a}).empty());
+
+        mi::Sint32 errors = 0;
+        auto result = transaction->get_journal(
+            transaction->get_id(), 0, DB::JOURNAL_ALL, /*lookup_parents*/ true, &errors);
+        MI_CHECK( !result);
+        MI_CHECK_EQUAL( errors, -1);
+
+        transaction->commit();
+    }
+
+    // Reverse references are not part of the dump
+    Test_db db( __func__, /*compare*/ false, /*enable_journal*/ true);
+    DB::Transaction_ptr transaction = db.m_global_scope->start_transaction();
+
+    DB::Tag tag_a = transaction->store( new My_element( 1), "a");
+    DB::Tag tag_b = transaction->store( new My_element( 2, {tag_a}), "b");
+    DB::Tag tag_c = transaction->store( new My_element( 3, {tag_b}), "c");
+    DB::Tag tag_d = transaction->store( new My_element( 4), "d");
+
+    MI_CHECK( transaction->get_referencing_tags( {tag_a}) == DB::Tag_set( {tag_b, tag_c}));
+    MI_CHECK( transaction->get_referencing_tags( {tag_b}) == DB::Tag_set( {tag_c}));
+    MI_CHECK( transaction->get_referencing_tags( {tag_a, tag_b}) == DB::Tag_set( {tag_b, tag_c}));
+    MI_CHECK( transaction->get_referencing_tags( {tag_c}).empty());
+    MI_CHECK( transaction->get_referencing_tags( {tag_d}).empty());
+
+    {
+        // The previous version of "c" still references "b", but is no longer visible.
+        DB::Edit<My_element> edit( tag_c, transaction.get());
+        edit->set_tag_set( {tag_d});
+    }
+
+    MI_CHECK( transaction->get_referencing_tags( {tag_a}) == DB::Tag_set( {tag_b}));
+    MI_CHECK( transaction->get_referencing_tags( {tag_d}) == DB::Tag_set( {tag_c}));
+
+    transaction->commit();
+    transaction = db.m_global_scope->start_transaction();
+
+    MI_CHECK( transaction->get_referencing_tags( {tag_a}) == DB::Tag_set( {tag_b}));
+    MI_CHECK( transaction->get_referencing_tags( {tag_d}) == DB::Tag_set( {tag_c}));
+
+    transaction->commit();
+}
+
 void test_transaction_remove()
 {
     Test_db db( __func__);
@@ -2955,12 +3064,15 @@ void test_journal_query()
     }
     {
         // From transaction (huge query range, i.e., pruned scope journal).
+        mi::Sint32 errors = 0;
         auto result = transaction->get_journal(
             last_changed_transaction_id-1,
             0,
             journal_a,
-            /*lookup_parents*/ false);
+            /*lookup_parents*/ false,
+            &errors);
         MI_CHECK( !result);
+        MI_CHECK_EQUAL( errors, -2);
     }
 
     // Commit the transaction and query again.
@@ -3515,6 +3627,8 @@ void test( const char* explicit_gc_method)
     test_transaction_get_class_id();
     test_transaction_get_tag_reference_count();
     test_transaction_get_tag_version();
+    test_snapshot_transaction();
+    test_transaction_get_referencing_tags();
 
     test_transaction_remove();
     test_transaction_get_tag_is_removed();
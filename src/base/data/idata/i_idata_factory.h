@@ -293,6 +293,13 @@ public:
     /// arrays).
     static std::string strip_array( const std::string& type_name, mi::Size& length);
 
+    /// Returns the size of one array element if attribute arrays of the given element type provide
+    /// contiguous access to their elements via #mi::IArray::get_data(), or 0 otherwise.
+    ///
+    /// This is the case if the element type is a number type (except \c "Size" and
+    /// \c "Difference") or a compound type.
+    static mi::Size get_packed_element_size( const std::string& element_type_name);
+
     /// Returns the value type name of a map type name, or the empty string in case of failure.
     static std::string strip_map( const std::string& type_name);
 
@@ -557,9 +557,30 @@ mi::Sint32 Array_impl_proxy::set_element(
     return 0;
 }
 
+const void* Array_impl_proxy::get_data( const char* element_type_name) const
+{
+    if( m_length == 0 || !element_type_name || m_element_type_name != element_type_name)
+        return nullptr;
+    if( Factory::get_packed_element_size( m_element_type_name) == 0)
+        return nullptr;
+
+    return m_pointer;
+}
+
+void* Array_impl_proxy::get_data( const char* element_type_name)
+{
+    if( m_length == 0 || !element_type_name || m_element_type_name != element_type_name)
+        return nullptr;
+    if( Factory::get_packed_element_size( m_element_type_name) == 0)
+        return nullptr;
+
+    return m_pointer;
+}
+
 void Array_impl_proxy::set_pointer_and_owner(
     void* pointer, const mi::base::IInterface* owner)
 {
+    m_pointer = pointer;
     m_owner = make_handle_dup( owner);
 }
 
@@ -864,6 +885,26 @@ mi::base::IInterface* Dynamic_array_impl_proxy::front()
     return get_element( 0);
 }
 
+const void* Dynamic_array_impl_proxy::get_data( const char* element_type_name) const
+{
+    if( m_length == 0 || !element_type_name || m_element_type_name != element_type_name)
+        return nullptr;
+    if( Factory::get_packed_element_size( m_element_type_name) == 0)
+        return nullptr;
+
+    return static_cast<ATTR::Dynamic_array*>( m_pointer)->m_value;
+}
+
+void* Dynamic_array_impl_proxy::get_data( const char* element_type_name)
+{
+    if( m_length == 0 || !element_type_name || m_element_type_name != element_type_name)
+        return nullptr;
+    if( Factory::get_packed_element_size( m_element_type_name) == 0)
+        return nullptr;
+
+    return static_cast<ATTR::Dynamic_array*>( m_pointer)->m_value;
+}
+
 void Dynamic_array_impl_proxy::set_pointer_and_owner(
     void* pointer, const mi::base::IInterface* owner)
 {
@@ -104,6 +104,14 @@ public:
 
     bool empty() const final { return m_array.empty(); }
 
+    /// Returns \c nullptr, the elements are stored as individual objects.
+    const void* get_data( const char* element_type_name) const final { return nullptr; }
+
+    /// Returns \c nullptr, the elements are stored as individual objects.
+    void* get_data( const char* element_type_name) final { return nullptr; }
+
+    using mi::IArray::get_data;
+
     // internal methods
 
     /// Returns the embedded transaction.
@@ -323,6 +331,12 @@ public:
 
     bool empty() const final { return m_length == 0; }
 
+    const void* get_data( const char* element_type_name) const final;
+
+    void* get_data( const char* element_type_name) final;
+
+    using mi::IArray::get_data;
+
     using mi::IArray::get_element;
 
     // internal methods (IProxy)
@@ -366,6 +380,9 @@ protected:
     /// The transaction used for array element accesses.
     DB::Transaction* m_transaction = nullptr;
 
+    /// Pointer to the storage
+    void* m_pointer = nullptr;
+
     /// Owner of the storage
     ///
     /// The class uses reference counting on the owner to ensure that the pointer to the storage
@@ -459,6 +476,12 @@ public:
 
     bool empty() const final { return m_length == 0; }
 
+    const void* get_data( const char* element_type_name) const final;
+
+    void* get_data( const char* element_type_name) final;
+
+    using mi::IArray::get_data;
+
     using mi::IArray::get_element;
 
     // public API methods (IDynamic_array)
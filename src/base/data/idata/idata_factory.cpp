@@ -34,6 +34,8 @@
 
 #include "i_idata_factory.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 
 #include <boost/core/ignore_unused.hpp>
@@ -521,6 +523,81 @@ std::string Factory::strip_array( const std::string& type_name, mi::Size& length
     return type_name.substr( 0, left_bracket);
 }
 
+namespace {
+
+/// Returns the size of the given number type, or 0 if the type is not supported as element type
+/// of contiguously stored arrays.
+mi::Size get_number_size( const std::string& type_name)
+{
+    static const std::pair<const char*, mi::Size> number_sizes[] = {
+        { "Boolean", sizeof( bool)        },
+        { "Sint8",   sizeof( mi::Sint8)   },
+        { "Sint16",  sizeof( mi::Sint16)  },
+        { "Sint32",  sizeof( mi::Sint32)  },
+        { "Sint64",  sizeof( mi::Sint64)  },
+        { "Uint8",   sizeof( mi::Uint8)   },
+        { "Uint16",  sizeof( mi::Uint16)  },
+        { "Uint32",  sizeof( mi::Uint32)  },
+        { "Uint64",  sizeof( mi::Uint64)  },
+        { "Float32", sizeof( mi::Float32) },
+        { "Float64", sizeof( mi::Float64) }
+    };
+
+    for( const auto& number_size: number_sizes)
+        if( type_name == number_size.first)
+            return number_size.second;
+
+    return 0;
+}
+
+/// Parses a compound dimension (2, 3, or 4).
+mi::Size parse_compound_dimension( const std::string& s)
+{
+    return (s.size() == 1 && s[0] >= '2' && s[0] <= '4') ? s[0] - '0' : 0;
+}
+
+} // namespace
+
+mi::Size Factory::get_packed_element_size( const std::string& element_type_name)
+{
+    // numbers
+    mi::Size size = get_number_size( element_type_name);
+    if( size > 0)
+        return size;
+
+    // compounds
+    if( element_type_name == "Color")
+        return 4 * sizeof( mi::Float32);
+    if( element_type_name == "Color3" || element_type_name == "Spectrum")
+        return 3 * sizeof( mi::Float32);
+    if( element_type_name == "Bbox3")
+        return 6 * sizeof( mi::Float32);
+
+    // vectors and matrices
+    mi::Size left_angle_bracket = element_type_name.find( '<');
+    if( left_angle_bracket == std::string::npos || element_type_name.back() != '>')
+        return 0;
+
+    std::string number_type_name = element_type_name.substr( 0, left_angle_bracket);
+    if(    number_type_name != "Boolean"
+        && number_type_name != "Sint32"
+        && number_type_name != "Uint32"
+        && number_type_name != "Float32"
+        && number_type_name != "Float64")
+        return 0;
+
+    std::string dimensions = element_type_name.substr(
+        left_angle_bracket+1, element_type_name.size()-left_angle_bracket-2);
+    mi::Size comma = dimensions.find( ',');
+    mi::Size rows = parse_compound_dimension( dimensions.substr( 0, comma));
+    mi::Size columns = comma == std::string::npos
+        ? 1 : parse_compound_dimension( dimensions.substr( comma+1));
+    if( rows == 0 || columns == 0)
+        return 0;
+
+    return rows * columns * get_number_size( number_type_name);
+}
+
 std::string Factory::strip_map( const std::string& type_name)
 {
     if( type_name.substr( 0, 4) != "Map<")
@@ -961,6 +1038,29 @@ mi::Uint32 Factory::assign_from_to(
     return mi::neuraylib::IFactory::NO_CONVERSION;
 }
 
+namespace {
+
+/// Returns the size in bytes of the contiguous storage of \p array, or 0 if the array does not
+/// provide raw access to its elements (see #mi::IArray::get_data()).
+///
+/// \param array               The array, or \c nullptr.
+/// \param[out] data           The contiguous storage of the array (if the return value is not 0).
+mi::Size get_data_size( const mi::IArray* array, const void*& data)
+{
+    if( !array)
+        return 0;
+
+    mi::Size length = 0;
+    std::string element_type_name = Factory::strip_array( array->get_type_name(), length);
+    data = array->get_data( element_type_name.c_str());
+    if( !data)
+        return 0;
+
+    return array->get_length() * Factory::get_packed_element_size( element_type_name);
+}
+
+} // namespace
+
 mi::Uint32 Factory::assign_from_to(
     const mi::IData_collection* source, mi::IData_collection* target, mi::Uint32 options) const
 {
@@ -1071,6 +1171,20 @@ mi::Uint32 Factory::assign_from_to(
         }
     }
 
+    // copy contiguously stored arrays of identical type with a single memcpy()
+    if( source_array && target_array
+        && strcmp( source->get_type_name(), target->get_type_name()) == 0) {
+        const void* source_data = nullptr;
+        const void* target_data = nullptr;
+        mi::Size size = get_data_size( source_array.get(), source_data);
+        if( size > 0 && size == get_data_size( target_array.get(), target_data)) {
+            mi::Size length = 0;
+            std::string element_type_name = strip_array( target->get_type_name(), length);
+            memcpy( target_array->get_data( element_type_name.c_str()), source_data, size);
+            return result;
+        }
+    }
+
     // iterate over keys in source, and try to assign to the corresponding key in target
     mi::Size keys_found_in_target   = 0;
     mi::Size keys_missing_in_target = 0;
@@ -1493,6 +1607,7 @@ mi::IDynamic_array* Factory::clone( const mi::IDynamic_array* source, mi::Uint32
         return nullptr;
 
     mi::Size n = source->get_length();
+
     for( mi::Size i = 0; i < n; ++i) {
 
         // get i-th element
@@ -1530,6 +1645,7 @@ mi::IArray* Factory::clone( const mi::IArray* source, mi::Uint32 options)
         return nullptr;
 
     mi::Size n = source->get_length();
+
     for( mi::Size i = 0; i < n; ++i) {
 
         // get i-th element
@@ -1700,7 +1816,26 @@ mi::Sint32 Factory::compare( const mi::IData_collection* lhs, const mi::IData_co
 
     MI_ASSERT( lhs_n == rhs_n);
 
-    for( mi::Size i = 0; i < lhs_n; ++i) {
+    // skip the common prefix of contiguously stored arrays of identical type
+    mi::Size first = 0;
+    mi::base::Handle lhs_array( lhs->get_interface<mi::IArray>());
+    mi::base::Handle rhs_array( rhs->get_interface<mi::IArray>());
+    const void* lhs_raw = nullptr;
+    const void* rhs_raw = nullptr;
+    mi::Size size = get_data_size( lhs_array.get(), lhs_raw);
+    if( size > 0
+        && strcmp( lhs->get_type_name(), rhs->get_type_name()) == 0
+        && size == get_data_size( rhs_array.get(), rhs_raw)) {
+        const auto* lhs_data = static_cast<const char*>( lhs_raw);
+        const auto* rhs_data = static_cast<const char*>( rhs_raw);
+        if( memcmp( lhs_data, rhs_data, size) == 0)
+            return 0;
+        mi::Size element_size = size / lhs_n;
+        first = (std::mismatch( lhs_data, lhs_data + size, rhs_data).first - lhs_data)
+            / element_size;
+    }
+
+    for( mi::Size i = first; i < lhs_n; ++i) {
 
         // compare keys for index i
         const char* lhs_key = lhs->get_key( i);
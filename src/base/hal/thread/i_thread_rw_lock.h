@@ -107,7 +107,16 @@ public:
     ///   \em some thread, not necessarily by this thread.
     void check_is_owned_shared_or_exclusive();
 
+    /// Sets a function that is called whenever acquiring the lock has to wait.
+    ///
+    /// Useful to collect contention statistics. If a callback is set, #lock() and #lock_shared()
+    /// first try to acquire the lock without blocking. Pass \c nullptr to remove the callback.
+    void set_contention_callback( void (*callback)());
+
 private:
+    /// Called if acquiring the lock has to wait, or \c nullptr.
+    void (*m_contention_callback)() = nullptr;
+
 #ifndef MI_PLATFORM_WINDOWS
     /// The pthread rwlock implementing the lock.
     ///
@@ -200,6 +209,12 @@ inline Shared_lock::~Shared_lock()
 
 inline void Shared_lock::lock_shared()
 {
+    if( m_contention_callback) {
+        if( try_lock_shared())
+            return;
+        m_contention_callback();
+    }
+
 #ifndef MI_PLATFORM_WINDOWS
     pthread_rwlock_rdlock( &m_rwlock);
 #else
@@ -242,6 +257,12 @@ inline void Shared_lock::check_is_owned_shared()
 
 inline void Shared_lock::lock()
 {
+    if( m_contention_callback) {
+        if( try_lock())
+            return;
+        m_contention_callback();
+    }
+
 #ifndef MI_PLATFORM_WINDOWS
     pthread_rwlock_wrlock( &m_rwlock);
 #else
@@ -288,6 +309,11 @@ inline void Shared_lock::check_is_owned_shared_or_exclusive()
     MI_ASSERT( (m_locked_shared > 0) || m_locked_exclusive);
 }
 
+inline void Shared_lock::set_contention_callback( void (*callback)())
+{
+    m_contention_callback = callback;
+}
+
 inline Block_shared::Block_shared( Shared_lock& lock)
   : m_lock( &lock)
 {
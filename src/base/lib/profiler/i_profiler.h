@@ -0,0 +1,271 @@
+/***************************************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************************************/
+
+/// \file
+/// \brief Runtime-switchable profiling of the main processing phases.
+///
+/// The profiler accumulates per-phase timings and counters, and optionally records scoped trace
+/// events. It is disabled by default and enabled at runtime, e.g., via the debug options
+/// \c "profiling" and \c "profiling_trace" (see #MI::NEURAY::Debug_configuration_impl).
+///
+/// The fast paths are inline, but all state lives in profiler.cpp. Hence all users in one binary
+/// share the same counters, and each binary using the profiler has to link base-lib-profiler. If
+/// the profiler is disabled, the overhead of #Scoped_phase and #increment() is a single relaxed
+/// load.
+
+#ifndef BASE_LIB_PROFILER_I_PROFILER_H
+#define BASE_LIB_PROFILER_I_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mi/base/types.h>
+
+namespace MI {
+
+namespace PROFILER {
+
+/// The measured phases.
+///
+/// Phases may nest, e.g., the analysis of a module includes the parsing of its imports. Hence the
+/// accumulated times are inclusive and must not be summed up.
+enum Phase {
+    PHASE_MODULE_PARSE,        ///< Parsing of MDL modules.
+    PHASE_MODULE_ANALYSIS,     ///< Semantic analysis of MDL modules.
+    PHASE_DAG_BUILD,           ///< Creation of the DAG representation of MDL modules.
+    PHASE_INSTANCE_COMPILE,    ///< Compilation of material instances.
+    PHASE_DISTILL,             ///< Distilling of compiled materials.
+    PHASE_LLVM_OPTIMIZE,       ///< Optimization of LLVM modules.
+    PHASE_CODE_GENERATION,     ///< Generation of target code from LLVM modules.
+    PHASE_LINK,                ///< Translation of link units.
+    PHASE_COUNT
+};
+
+/// The available counters.
+enum Counter {
+    COUNTER_MODULE_CACHE_HITS,        ///< Modules found in the module cache.
+    COUNTER_CODE_CACHE_HITS,          ///< Target code found in the code cache.
+    COUNTER_CODE_CACHE_MISSES,        ///< Target code not found in the code cache.
+    COUNTER_DB_LOCK_WAITS,            ///< Acquisitions of the database lock that had to wait.
+    COUNTER_ARENA_CHUNK_ALLOCATIONS,  ///< Chunks allocated by memory arenas.
+    COUNTER_COUNT
+};
+
+/// A recorded trace event.
+struct Trace_event
+{
+    Phase       m_phase;
+    mi::Uint64  m_thread_id;
+    mi::Uint64  m_start_us;     ///< Start time in microseconds since the profiler epoch.
+    mi::Uint64  m_duration_us;  ///< Duration in microseconds.
+};
+
+/// Accumulated data of one phase.
+struct Phase_data
+{
+    mi::Uint64 m_count   = 0;
+    mi::Uint64 m_time_ns = 0;
+};
+
+namespace DETAIL {
+
+struct Phase_counters
+{
+    std::atomic<mi::Uint64> m_count{ 0};
+    std::atomic<mi::Uint64> m_time_ns{ 0};
+};
+
+using Clock = std::chrono::steady_clock;
+
+extern std::atomic<bool>       g_enabled;
+extern std::atomic<bool>       g_tracing;
+extern Phase_counters          g_phases[PHASE_COUNT];
+extern std::atomic<mi::Uint64> g_counters[COUNTER_COUNT];
+extern const Clock::time_point g_epoch;
+
+/// Returns a stable numeric id for the calling thread.
+inline mi::Uint64 get_thread_id()
+{
+    return static_cast<mi::Uint64>( std::hash<std::thread::id>()( std::this_thread::get_id()));
+}
+
+/// Records a trace event (or counts it as dropped if the trace buffer is full).
+void record_trace_event( const Trace_event& event);
+
+} // namespace DETAIL
+
+/// Indicates whether the profiler is enabled.
+inline bool is_enabled()
+{
+    return DETAIL::g_enabled.load( std::memory_order_relaxed);
+}
+
+/// Indicates whether trace events are recorded.
+inline bool is_tracing()
+{
+    return DETAIL::g_tracing.load( std::memory_order_relaxed);
+}
+
+/// Enables or disables the profiler.
+///
+/// \param enabled   Enables the accumulation of phase timings and counters.
+/// \param tracing   Enables the recording of trace events (only if \p enabled is \c true).
+inline void set_enabled( bool enabled, bool tracing)
+{
+    DETAIL::g_tracing.store( enabled && tracing, std::memory_order_relaxed);
+    DETAIL::g_enabled.store( enabled, std::memory_order_relaxed);
+}
+
+/// Returns the current time in microseconds since the profiler epoch, i.e., in the time base of
+/// #Trace_event::m_start_us.
+inline mi::Uint64 get_time_us()
+{
+    return static_cast<mi::Uint64>( std::chrono::duration_cast<std::chrono::microseconds>(
+        DETAIL::Clock::now() - DETAIL::g_epoch).count());
+}
+
+/// Returns the id of the calling thread as used for #Trace_event::m_thread_id.
+inline mi::Uint64 get_thread_id()
+{
+    return DETAIL::get_thread_id();
+}
+
+/// Increments a counter (if the profiler is enabled).
+inline void increment( Counter counter, mi::Uint64 value = 1)
+{
+    if( is_enabled())
+        DETAIL::g_counters[counter].fetch_add( value, std::memory_order_relaxed);
+}
+
+/// Returns the current value of a counter.
+inline mi::Uint64 get_counter( Counter counter)
+{
+    return DETAIL::g_counters[counter].load( std::memory_order_relaxed);
+}
+
+/// Returns the accumulated data of a phase.
+inline Phase_data get_phase_data( Phase phase)
+{
+    Phase_data data;
+    data.m_count   = DETAIL::g_phases[phase].m_count.load( std::memory_order_relaxed);
+    data.m_time_ns = DETAIL::g_phases[phase].m_time_ns.load( std::memory_order_relaxed);
+    return data;
+}
+
+/// Measures the time spent in a phase for the lifetime of the object.
+///
+/// The state of the profiler is sampled on construction, i.e., enabling the profiler does not
+/// affect already running scopes.
+class Scoped_phase
+{
+public:
+    explicit Scoped_phase( Phase phase)
+      : m_phase( phase), m_active( is_enabled())
+    {
+        if( m_active)
+            m_start = DETAIL::Clock::now();
+    }
+
+    ~Scoped_phase()
+    {
+        if( !m_active)
+            return;
+
+        const DETAIL::Clock::time_point stop = DETAIL::Clock::now();
+        const mi::Uint64 duration_ns = static_cast<mi::Uint64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>( stop - m_start).count());
+
+        DETAIL::Phase_counters& counters = DETAIL::g_phases[m_phase];
+        counters.m_count.fetch_add( 1, std::memory_order_relaxed);
+        counters.m_time_ns.fetch_add( duration_ns, std::memory_order_relaxed);
+
+        if( !is_tracing())
+            return;
+
+        Trace_event event;
+        event.m_phase       = m_phase;
+        event.m_thread_id   = DETAIL::get_thread_id();
+        event.m_start_us    = static_cast<mi::Uint64>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                m_start - DETAIL::g_epoch).count());
+        event.m_duration_us = duration_ns / 1000;
+        DETAIL::record_trace_event( event);
+    }
+
+    Scoped_phase( const Scoped_phase&) = delete;
+    Scoped_phase& operator=( const Scoped_phase&) = delete;
+
+private:
+    Phase m_phase;
+    bool m_active;
+    DETAIL::Clock::time_point m_start;
+};
+
+/// Returns the name of a phase.
+const char* get_phase_name( Phase phase);
+
+/// Returns the name of a counter.
+const char* get_counter_name( Counter counter);
+
+/// Resets all phase timings, counters, and recorded trace events.
+void reset();
+
+/// Returns a copy of all recorded trace events.
+std::vector<Trace_event> get_trace_events();
+
+/// Sets the maximum number of recorded trace events.
+///
+/// Further events are dropped and only counted (see #get_dropped_trace_events()). Already
+/// recorded events exceeding a smaller limit are kept. The default is 1000000 events.
+void set_max_trace_events( size_t max_events);
+
+/// Returns the number of trace events dropped since the last #reset() due to the limit.
+mi::Uint64 get_dropped_trace_events();
+
+/// Writes a human-readable report of the phase timings and counters.
+void dump_report( std::ostream& s);
+
+/// Writes the recorded trace events in the Chrome trace event format (JSON).
+///
+/// The output can be loaded into chrome://tracing or Perfetto.
+void write_chrome_trace( std::ostream& s);
+
+/// Writes the recorded trace events in the Chrome trace event format to a file.
+///
+/// \return   \c true in case of success, \c false if the file could not be written.
+bool write_chrome_trace( const std::string& filename);
+
+} // namespace PROFILER
+
+} // namespace MI
+
+#endif // BASE_LIB_PROFILER_I_PROFILER_H
@@ -0,0 +1,206 @@
+/***************************************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************************************/
+
+/// \file
+/// \brief Reporting and export of the profiler data.
+
+#include "pch.h"
+
+#include "i_profiler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+
+namespace MI {
+
+namespace PROFILER {
+
+namespace DETAIL {
+
+std::atomic<bool>       g_enabled{ false};
+std::atomic<bool>       g_tracing{ false};
+Phase_counters          g_phases[PHASE_COUNT];
+std::atomic<mi::Uint64> g_counters[COUNTER_COUNT];
+const Clock::time_point g_epoch = Clock::now();
+
+namespace {
+
+std::mutex               g_trace_lock;
+std::vector<Trace_event> g_trace_events;
+size_t                   g_max_trace_events = 1000000;
+std::atomic<mi::Uint64>  g_dropped_trace_events{ 0};
+
+} // namespace
+
+void record_trace_event( const Trace_event& event)
+{
+    std::lock_guard<std::mutex> lock( g_trace_lock);
+    if( g_trace_events.size() >= g_max_trace_events) {
+        g_dropped_trace_events.fetch_add( 1, std::memory_order_relaxed);
+        return;
+    }
+    g_trace_events.push_back( event);
+}
+
+} // namespace DETAIL
+
+const char* get_phase_name( Phase phase)
+{
+    switch( phase) {
+        case PHASE_MODULE_PARSE:     return "module parse";
+        case PHASE_MODULE_ANALYSIS:  return "module analysis";
+        case PHASE_DAG_BUILD:        return "DAG build";
+        case PHASE_INSTANCE_COMPILE: return "instance compile";
+        case PHASE_DISTILL:          return "distill";
+        case PHASE_LLVM_OPTIMIZE:    return "LLVM optimize";
+        case PHASE_CODE_GENERATION:  return "code generation";
+        case PHASE_LINK:             return "link";
+        case PHASE_COUNT:            break;
+    }
+    return "unknown";
+}
+
+const char* get_counter_name( Counter counter)
+{
+    switch( counter) {
+        case COUNTER_MODULE_CACHE_HITS:       return "module cache hits";
+        case COUNTER_CODE_CACHE_HITS:         return "code cache hits";
+        case COUNTER_CODE_CACHE_MISSES:       return "code cache misses";
+        case COUNTER_DB_LOCK_WAITS:           return "DB lock waits";
+        case COUNTER_ARENA_CHUNK_ALLOCATIONS: return "arena chunk allocations";
+        case COUNTER_COUNT:                   break;
+    }
+    return "unknown";
+}
+
+void reset()
+{
+    for( DETAIL::Phase_counters& phase: DETAIL::g_phases) {
+        phase.m_count.store( 0, std::memory_order_relaxed);
+        phase.m_time_ns.store( 0, std::memory_order_relaxed);
+    }
+    for( std::atomic<mi::Uint64>& counter: DETAIL::g_counters)
+        counter.store( 0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock( DETAIL::g_trace_lock);
+    DETAIL::g_trace_events.clear();
+    DETAIL::g_trace_events.shrink_to_fit();
+    DETAIL::g_dropped_trace_events.store( 0, std::memory_order_relaxed);
+}
+
+std::vector<Trace_event> get_trace_events()
+{
+    std::lock_guard<std::mutex> lock( DETAIL::g_trace_lock);
+    return DETAIL::g_trace_events;
+}
+
+void set_max_trace_events( size_t max_events)
+{
+    std::lock_guard<std::mutex> lock( DETAIL::g_trace_lock);
+    DETAIL::g_max_trace_events = max_events;
+}
+
+mi::Uint64 get_dropped_trace_events()
+{
+    return DETAIL::g_dropped_trace_events.load( std::memory_order_relaxed);
+}
+
+void dump_report( std::ostream& s)
+{
+    char buffer[256];
+
+    for( int i = 0; i < PHASE_COUNT; ++i) {
+        const Phase_data data = get_phase_data( static_cast<Phase>( i));
+        const double time_ms = static_cast<double>( data.m_time_ns) / 1'000'000.0;
+        snprintf( buffer, sizeof( buffer), "%-24s %9llu, %10.3lf ms, %10.3lf us\n",
+            get_phase_name( static_cast<Phase>( i)),
+            static_cast<unsigned long long>( data.m_count),
+            time_ms,
+            data.m_count > 0 ? 1000.0 * time_ms / static_cast<double>( data.m_count) : 0.0);
+        s << buffer;
+    }
+    s << std::endl;
+
+    for( int i = 0; i < COUNTER_COUNT; ++i) {
+        snprintf( buffer, sizeof( buffer), "%-24s %9llu\n",
+            get_counter_name( static_cast<Counter>( i)),
+            static_cast<unsigned long long>( get_counter( static_cast<Counter>( i))));
+        s << buffer;
+    }
+
+    const mi::Uint64 dropped = get_dropped_trace_events();
+    if( dropped > 0) {
+        snprintf( buffer, sizeof( buffer), "%-24s %9llu\n",
+            "dropped trace events", static_cast<unsigned long long>( dropped));
+        s << buffer;
+    }
+}
+
+void write_chrome_trace( std::ostream& s)
+{
+    const std::vector<Trace_event> events = get_trace_events();
+
+    s << "{\"traceEvents\":[";
+    bool first = true;
+    for( const Trace_event& event: events) {
+        if( !first)
+            s << ',';
+        first = false;
+        s << "\n{\"name\":\"" << get_phase_name( event.m_phase) << "\""
+          << ",\"cat\":\"mdl\",\"ph\":\"X\",\"pid\":0"
+          << ",\"tid\":" << event.m_thread_id
+          << ",\"ts\":" << event.m_start_us
+          << ",\"dur\":" << event.m_duration_us << '}';
+    }
+
+    s << "\n],\"otherData\":{";
+    for( int i = 0; i < COUNTER_COUNT; ++i) {
+        if( i > 0)
+            s << ',';
+        s << '"' << get_counter_name( static_cast<Counter>( i)) << "\":"
+          << get_counter( static_cast<Counter>( i));
+    }
+    s << ",\"dropped trace events\":" << get_dropped_trace_events();
+    s << "}}\n";
+}
+
+bool write_chrome_trace( const std::string& filename)
+{
+    std::ofstream file( filename);
+    if( !file)
+        return false;
+
+    write_chrome_trace( file);
+    return static_cast<bool>( file);
+}
+
+} // namespace PROFILER
+
+} // namespace MI
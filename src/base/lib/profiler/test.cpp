@@ -0,0 +1,136 @@
+/***************************************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************************************/
+
+#include "pch.h"
+
+#define MI_TEST_AUTO_SUITE_NAME "Regression Test Suite for base/lib/profiler"
+
+#include <base/system/test/i_test_auto_driver.h>
+#include <base/system/test/i_test_auto_case.h>
+
+#include "i_profiler.h"
+
+#include <sstream>
+
+using namespace MI;
+
+MI_TEST_AUTO_FUNCTION( test_disabled )
+{
+    PROFILER::set_enabled( false, false);
+    PROFILER::reset();
+
+    {
+        PROFILER::Scoped_phase phase( PROFILER::PHASE_DAG_BUILD);
+        PROFILER::increment( PROFILER::COUNTER_CODE_CACHE_HITS);
+    }
+
+    MI_CHECK_EQUAL( PROFILER::get_phase_data( PROFILER::PHASE_DAG_BUILD).m_count, 0);
+    MI_CHECK_EQUAL( PROFILER::get_counter( PROFILER::COUNTER_CODE_CACHE_HITS), 0);
+    MI_CHECK( PROFILER::get_trace_events().empty());
+}
+
+MI_TEST_AUTO_FUNCTION( test_enabled_without_tracing )
+{
+    PROFILER::set_enabled( true, false);
+    PROFILER::reset();
+
+    {
+        PROFILER::Scoped_phase phase( PROFILER::PHASE_LLVM_OPTIMIZE);
+    }
+    {
+        PROFILER::Scoped_phase phase( PROFILER::PHASE_LLVM_OPTIMIZE);
+    }
+    PROFILER::increment( PROFILER::COUNTER_DB_LOCK_WAITS, 3);
+
+    MI_CHECK_EQUAL( PROFILER::get_phase_data( PROFILER::PHASE_LLVM_OPTIMIZE).m_count, 2);
+    MI_CHECK_EQUAL( PROFILER::get_counter( PROFILER::COUNTER_DB_LOCK_WAITS), 3);
+    MI_CHECK( PROFILER::get_trace_events().empty());
+
+    std::ostringstream report;
+    PROFILER::dump_report( report);
+    MI_CHECK( report.str().find( "LLVM optimize") != std::string::npos);
+
+    PROFILER::set_enabled( false, false);
+}
+
+MI_TEST_AUTO_FUNCTION( test_tracing )
+{
+    PROFILER::set_enabled( true, true);
+    PROFILER::reset();
+
+    {
+        PROFILER::Scoped_phase outer( PROFILER::PHASE_MODULE_ANALYSIS);
+        PROFILER::Scoped_phase inner( PROFILER::PHASE_MODULE_PARSE);
+    }
+
+    std::vector<PROFILER::Trace_event> events = PROFILER::get_trace_events();
+    MI_CHECK_EQUAL( events.size(), 2);
+    // the inner scope finishes first
+    MI_CHECK_EQUAL( events[0].m_phase, PROFILER::PHASE_MODULE_PARSE);
+    MI_CHECK_EQUAL( events[1].m_phase, PROFILER::PHASE_MODULE_ANALYSIS);
+    MI_CHECK( events[1].m_start_us <= events[0].m_start_us);
+
+    std::ostringstream trace;
+    PROFILER::write_chrome_trace( trace);
+    const std::string json = trace.str();
+    MI_CHECK( json.find( "\"traceEvents\"") != std::string::npos);
+    MI_CHECK( json.find( "\"name\":\"module parse\"") != std::string::npos);
+    MI_CHECK( json.find( "\"ph\":\"X\"") != std::string::npos);
+
+    PROFILER::reset();
+    MI_CHECK( PROFILER::get_trace_events().empty());
+
+    PROFILER::set_enabled( false, false);
+}
+
+MI_TEST_AUTO_FUNCTION( test_trace_limit )
+{
+    PROFILER::set_enabled( true, true);
+    PROFILER::reset();
+    PROFILER::set_max_trace_events( 2);
+
+    for( int i = 0; i < 5; ++i) {
+        PROFILER::Scoped_phase phase( PROFILER::PHASE_LINK);
+    }
+
+    // all scopes are accounted, but only the first two events are recorded
+    MI_CHECK_EQUAL( PROFILER::get_phase_data( PROFILER::PHASE_LINK).m_count, 5);
+    MI_CHECK_EQUAL( PROFILER::get_trace_events().size(), 2);
+    MI_CHECK_EQUAL( PROFILER::get_dropped_trace_events(), 3);
+
+    std::ostringstream report;
+    PROFILER::dump_report( report);
+    MI_CHECK( report.str().find( "dropped trace events") != std::string::npos);
+    MI_CHECK( report.str().find( " us\n") != std::string::npos);
+
+    PROFILER::reset();
+    MI_CHECK_EQUAL( PROFILER::get_dropped_trace_events(), 0);
+
+    PROFILER::set_max_trace_events( 1000000);
+    PROFILER::set_enabled( false, false);
+}
@@ -35,15 +35,19 @@
 #include <mi/neuraylib/itile.h>
 
 #include <filesystem>
+#include <mutex>
 #include <utility>
 
 #include <boost/core/ignore_unused.hpp>
 
+#include <base/lib/config/config.h>
 #include <base/lib/log/i_log_logger.h>
 #include <base/lib/path/i_path.h>
 #include <base/data/serial/i_serializer.h>
 #include <base/data/db/i_db_access.h>
+#include <base/data/db/i_db_fragmented_job.h>
 #include <base/data/db/i_db_transaction.h>
+#include <base/util/registry/i_config_registry.h>
 #include <base/util/string_utils/i_string_utils.h>
 #include <io/image/image/i_image.h>
 #include <io/image/image/i_image_mipmap.h>
@@ -70,6 +74,136 @@ std::string hash_to_string( const mi::base::Uuid& hash)
     return buffer;
 }
 
+/// Default for the debug option "dbimage_max_concurrent_loads", see Image::reset_image_set().
+///
+/// Loading is mostly I/O bound (opening the file, reading the header), so the limit avoids
+/// flooding the file system when the thread pool is large.
+const mi::Sint32 default_max_concurrent_image_loads = 8;
+
+/// Mipmap of a file-based uvtile that is only created when it is accessed for the first time.
+///
+/// Used for the lazy loading of image sets, see Image::reset_image_set(). Errors can no longer
+/// be reported to the caller of the import at that point. They are logged and result in the dummy
+/// mipmap with a 1x1 pink pixel.
+class Lazy_file_mipmap final : public mi::base::Interface_implement<IMAGE::IMipmap>
+{
+public:
+    Lazy_file_mipmap( const std::string& resolved_filename, const char* selector)
+      : m_resolved_filename( resolved_filename),
+        m_selector( selector ? selector : ""),
+        m_has_selector( selector != nullptr)
+    {
+    }
+
+    mi::Uint32 get_nlevels() const final { return get_mipmap()->get_nlevels(); }
+
+    const mi::neuraylib::ICanvas* get_level( mi::Uint32 level) const final
+    {
+        // use the const overload, the non-const one discards higher miplevels
+        const IMAGE::IMipmap* mipmap = get_mipmap();
+        return mipmap->get_level( level);
+    }
+
+    mi::neuraylib::ICanvas* get_level( mi::Uint32 level) final
+    {
+        return get_mipmap()->get_level( level);
+    }
+
+    bool get_is_cubemap() const final { return get_mipmap()->get_is_cubemap(); }
+
+    mi::Size get_size() const final
+    {
+        // does not trigger loading
+        std::lock_guard<std::mutex> lock( m_mutex);
+        return sizeof( *this)
+            + m_resolved_filename.size() + m_selector.size()
+            + (m_mipmap ? m_mipmap->get_size() : 0);
+    }
+
+private:
+    /// Creates the mipmap on first use.
+    IMAGE::IMipmap* get_mipmap() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex);
+        if( !m_mipmap) {
+            SYSTEM::Access_module<IMAGE::Image_module> image_module( false);
+            mi::Sint32 errors = 0;
+            m_mipmap = image_module->create_mipmap(
+                IMAGE::File_based(),
+                m_resolved_filename,
+                m_has_selector ? m_selector.c_str() : nullptr,
+                /*only_first_level*/ true,
+                &errors);
+            if( errors != 0)
+                LOG::mod_log->error( M_SCENE, LOG::Mod_log::C_IO,
+                    "Failed to load the deferred image file \"%s\" (error %d).",
+                    m_resolved_filename.c_str(), errors);
+        }
+        return m_mipmap.get();
+    }
+
+    const std::string m_resolved_filename;
+    const std::string m_selector;
+    const bool m_has_selector;
+
+    mutable std::mutex m_mutex;
+    mutable mi::base::Handle<IMAGE::IMipmap> m_mipmap;
+};
+
+/// Creates the mipmaps of an image set in parallel, one uvtile per fragment.
+class Create_mipmaps_job final : public DB::Fragmented_job
+{
+public:
+    /// Constructor.
+    ///
+    /// \param image_set   The image set to load.
+    /// \param frames      The frames to fill. Frames and uvtiles need to be allocated already,
+    ///                    only the mipmaps are set.
+    /// \param indices     Frame and uvtile index per fragment.
+    /// \param thread_limit The maximum number of concurrently loaded uvtiles.
+    Create_mipmaps_job(
+        const Image_set* image_set,
+        Frames& frames,
+        const std::vector<std::pair<mi::Size, mi::Size>>& indices,
+        size_t thread_limit)
+      : m_image_set( image_set),
+        m_frames( frames),
+        m_indices( indices),
+        m_thread_limit( thread_limit),
+        m_errors( indices.size(), 0)
+    {
+    }
+
+    size_t get_thread_limit() const final { return m_thread_limit; }
+
+    void execute_fragment(
+        DB::Transaction* transaction,
+        size_t index,
+        size_t count,
+        const mi::neuraylib::IJob_execution_context* context) final
+    {
+        const mi::Size f = m_indices[index].first;
+        const mi::Size i = m_indices[index].second;
+        m_frames[f].m_uvtiles[i].m_mipmap = m_image_set->create_mipmap( f, i, m_errors[index]);
+    }
+
+    /// Returns the error code of the first failed fragment (in index order), or 0.
+    mi::Sint32 get_error() const
+    {
+        for( mi::Sint32 errors: m_errors)
+            if( errors != 0)
+                return errors;
+        return 0;
+    }
+
+private:
+    const Image_set* m_image_set;
+    Frames& m_frames;
+    const std::vector<std::pair<mi::Size, mi::Size>>& m_indices;
+    size_t m_thread_limit;
+    std::vector<mi::Sint32> m_errors;
+};
+
 } // namespace
 
 IMAGE::IMipmap* Image_set::create_mipmap( mi::Size f, mi::Size i, mi::Sint32& errors) const
@@ -531,8 +665,9 @@ mi::Sint32 Image::reset_image_set(
     Frames tmp_frames;
     Frames_filenames tmp_frames_filenames;
     Frame_to_id tmp_frame_to_id;
+    std::vector<std::pair<mi::Size, mi::Size>> tmp_mipmap_indices;
 
-    // Convert data from image set into temporary variables
+    // Convert data from image set into temporary variables (except for the mipmaps)
     for( mi::Size f = 0; f < number_of_frames; ++f) {
 
         const mi::Size number_of_tiles = image_set->get_frame_length( f);
@@ -578,10 +713,7 @@ mi::Sint32 Image::reset_image_set(
             Uvtile& tile = frame.m_uvtiles[i];
             tile.m_u = u;
             tile.m_v = v;
-            mi::Sint32 errors = 0;
-            tile.m_mipmap = image_set->create_mipmap( f, i, errors);
-            if( errors != 0)
-                return errors;
+            tmp_mipmap_indices.emplace_back( f, i);
 
             Uvfilenames& filenames = frame_filenames[i];
             filenames.m_resolved_filename    = image_set->get_resolved_filename( f, i);
@@ -599,6 +731,56 @@ mi::Sint32 Image::reset_image_set(
         tmp_frame_to_id[frame_number] = f;
     }
 
+    // The files of animated textures and uvtiles are independent of each other. Readers and
+    // canvases provided by the caller, and a single MDL container shared by all uvtiles, are only
+    // used from the calling thread.
+    bool all_file_based = !image_set->is_mdl_container();
+    for( const auto& frame_filenames: tmp_frames_filenames)
+        for( const auto& filenames: frame_filenames)
+            if( filenames.m_resolved_filename.empty())
+                all_file_based = false;
+
+    SYSTEM::Access_module<CONFIG::Config_module> config_module( false);
+    const CONFIG::Config_registry& registry = config_module->get_configuration();
+    mi::Sint32 max_concurrent_loads = default_max_concurrent_image_loads;
+    registry.get_value( "dbimage_max_concurrent_loads", max_concurrent_loads);
+    bool lazy_loading = false;
+    registry.get_value( "dbimage_lazy_loading", lazy_loading);
+
+    if( all_file_based && lazy_loading && tmp_mipmap_indices.size() > 1) {
+
+        // Defer the creation of the mipmaps until they are accessed.
+        for( const auto& index: tmp_mipmap_indices) {
+            const std::string& resolved_filename
+                = tmp_frames_filenames[index.first][index.second].m_resolved_filename;
+            tmp_frames[index.first].m_uvtiles[index.second].m_mipmap
+                = new Lazy_file_mipmap( resolved_filename, tmp_selector_cstr);
+        }
+
+    } else if( all_file_based && transaction && (max_concurrent_loads > 1)
+        && (tmp_mipmap_indices.size() > 1)) {
+
+        // Create the mipmaps concurrently on the thread pool.
+        Create_mipmaps_job job(
+            image_set, tmp_frames, tmp_mipmap_indices, static_cast<size_t>( max_concurrent_loads));
+        if( transaction->execute_fragmented( &job, tmp_mipmap_indices.size()) != 0)
+            return -13;
+        const mi::Sint32 errors = job.get_error();
+        if( errors != 0)
+            return errors;
+
+    } else {
+
+        // Create the mipmaps sequentially on the calling thread.
+        for( const auto& index: tmp_mipmap_indices) {
+            mi::Sint32 errors = 0;
+            tmp_frames[index.first].m_uvtiles[index.second].m_mipmap
+                = image_set->create_mipmap( index.first, index.second, errors);
+            if( errors != 0)
+                return errors;
+        }
+    }
+
     reset_shared(
         transaction, tmp_is_animated, tmp_is_uvtile, tmp_frames, tmp_frame_to_id, impl_hash);
 
@@ -306,6 +306,10 @@ public:
     ///                              -  -5: Failure to open the file.
     ///                              -  -7: The image plugin failed to import the file.
     ///                              - -10: Failure to apply the given selector.
+    ///                              - -13: Failure to execute the concurrent import of the
+    ///                                     uvtiles/frames.
+    ///
+    /// See #reset_image_set() for concurrent and lazy loading of uvtiles and frames.
     Sint32 reset_file(
         DB::Transaction* transaction,
         const std::string& original_filename,
@@ -347,8 +351,21 @@ public:
     ///                              -  -7: The image plugin failed to import the data.
     ///                              - -10: Failure to apply the given selector.
     ///                              - -12: Repeated u/v coordinates (per frame).
+    ///                              - -13: Failure to execute the concurrent import of the
+    ///                                     uvtiles/frames, e.g., the transaction is no longer open.
     ///                              - -99: Inconsistent image set (neither file-, nor container-,
     ///                                     nor reader-, nor canvas-based).
+    ///
+    /// If all uvtiles/frames of the image set are file-based (and not in an MDL container), the
+    /// files are imported concurrently on the thread pool of the database. The debug option
+    /// \c "dbimage_max_concurrent_loads" (default 8) limits the number of concurrent imports, a
+    /// value of 1 or less imports the files sequentially. Readers, canvases and MDL containers of
+    /// the image set are always used from the calling thread.
+    ///
+    /// If the debug option \c "dbimage_lazy_loading" is set, file-based uvtiles/frames are not
+    /// imported before they are accessed for the first time (single images are never deferred).
+    /// Import errors are then not reported by this method, but logged later, and the affected
+    /// uvtile/frame holds the dummy mipmap with a 1x1 pink pixel.
     Sint32 reset_image_set(
         DB::Transaction* transaction,
         const Image_set* image_set,
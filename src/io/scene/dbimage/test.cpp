@@ -911,6 +911,74 @@ void check_sharing( DB::Transaction* transaction, const char* simple_filename)
     MI_CHECK_EQUAL( tag2_impl_hash1_shared.get_uint(), tag1_impl_hash1_shared.get_uint());
 }
 
+// Returns resolution and first pixel of all uvtiles of frame 0.
+std::vector<mi::Float32> get_uvtile_data( DB::Transaction* transaction, DB::Tag tag)
+{
+    DB::Access<DBIMAGE::Image> image( tag, transaction);
+    std::vector<mi::Float32> result;
+    for( mi::Size i = 0, n = image->get_frame_length( 0); i < n; ++i) {
+        mi::base::Handle<const IMAGE::IMipmap> mipmap( image->get_mipmap( transaction, 0, i));
+        MI_CHECK( !g_image_module->is_dummy_mipmap( mipmap.get()));
+        mi::base::Handle<const mi::neuraylib::ICanvas> canvas( mipmap->get_level( 0));
+        mi::base::Handle<const mi::neuraylib::ITile> tile( canvas->get_tile());
+        mi::Float32 pixel[4];
+        tile->get_pixel( 0, 0, pixel);
+        result.push_back( static_cast<mi::Float32>( canvas->get_resolution_x()));
+        result.push_back( static_cast<mi::Float32>( canvas->get_resolution_y()));
+        result.insert( result.end(), pixel, pixel + 4);
+    }
+    return result;
+}
+
+void check_concurrent_and_lazy_loading( DB::Transaction* transaction)
+{
+    mi::base::Uuid unknown_hash{0,0,0,0};
+    std::string file_path = TEST::mi_src_path( "io/image/image/tests/test_udim.<UDIM>.png");
+
+    SYSTEM::Access_module<CONFIG::Config_module> config_module( false);
+
+    // sequential
+    config_module->override( "dbimage_max_concurrent_loads=1");
+    auto* image = new DBIMAGE::Image();
+    MI_CHECK_EQUAL( image->reset_file( transaction, file_path, nullptr, unknown_hash), 0);
+    DB::Tag tag = transaction->store_for_reference_counting( image);
+    const std::vector<mi::Float32> expected = get_uvtile_data( transaction, tag);
+    MI_CHECK_EQUAL( expected.size(), 4 * 6);
+
+    // concurrent, more threads than uvtiles and fewer threads than uvtiles
+    const char* limits[] = { "dbimage_max_concurrent_loads=8", "dbimage_max_concurrent_loads=2" };
+    for( const char* limit: limits) {
+        config_module->override( limit);
+        image = new DBIMAGE::Image();
+        MI_CHECK_EQUAL( image->reset_file( transaction, file_path, nullptr, unknown_hash), 0);
+        tag = transaction->store_for_reference_counting( image);
+        MI_CHECK( get_uvtile_data( transaction, tag) == expected);
+    }
+
+    // lazy, without serialization on store (which would load all uvtiles)
+    config_module->override( "check_serializer_store=0");
+    config_module->override( "dbimage_lazy_loading=1");
+    image = new DBIMAGE::Image();
+    MI_CHECK_EQUAL( image->reset_file( transaction, file_path, nullptr, unknown_hash), 0);
+    tag = transaction->store_for_reference_counting( image);
+    size_t size_before = 0;
+    {
+        DB::Access<DBIMAGE::Image> image2( tag, transaction);
+        DB::Access<DBIMAGE::Image_impl> impl( image2->get_impl_tag(), transaction);
+        size_before = impl->get_size();
+    }
+    MI_CHECK( get_uvtile_data( transaction, tag) == expected);
+    {
+        DB::Access<DBIMAGE::Image> image2( tag, transaction);
+        DB::Access<DBIMAGE::Image_impl> impl( image2->get_impl_tag(), transaction);
+        MI_CHECK_GREATER( impl->get_size(), size_before);
+    }
+
+    config_module->override( "dbimage_lazy_loading=0");
+    config_module->override( "dbimage_max_concurrent_loads=8");
+    config_module->override( "check_serializer_store=1");
+}
+
 MI_TEST_AUTO_FUNCTION( test_dbimage )
 {
     Unified_database_access db_access;
@@ -934,6 +1002,7 @@ MI_TEST_AUTO_FUNCTION( test_dbimage )
     check_animated_textures( transaction);
     check_uvtiles( transaction);
     check_animated_uvtiles( transaction);
+    check_concurrent_and_lazy_loading( transaction);
     check_mdle( transaction);
     check_sharing( transaction, "test_simple.png");
 
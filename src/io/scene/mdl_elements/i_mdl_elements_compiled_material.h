@@ -168,6 +168,18 @@ public:
     /// Used by the distiller to pass that setting to the distilled instance.
     bool get_resolve_resources() const { return m_resolve_resources; }
 
+    /// Sets the tag of the material instance this compiled material was created from.
+    ///
+    /// The tag is reported as reference, such that changes of the material instance (or its
+    /// arguments) propagate to this compiled material, e.g., for the change feed of the journal.
+    /// As a consequence, the material instance is not removed from the DB as long as this compiled
+    /// material exists. Pass an invalid tag for compiled materials not created from a DB element.
+    void set_instance_tag( DB::Tag tag) { m_instance_tag = tag; }
+
+    /// Returns the tag of the material instance this compiled material was created from (or an
+    /// invalid tag).
+    DB::Tag get_instance_tag() const { return m_instance_tag; }
+
      /// Returns all arguments as one value list.
      const IValue_list* get_arguments( DB::Transaction* transaction) const;
 
@@ -218,6 +230,9 @@ private:
     /// Indicates whether resources are supposed to be loaded into the DB.
     bool m_resolve_resources = false;
 
+    /// The material instance this compiled material was created from (or invalid).
+    DB::Tag m_instance_tag;
+
     /// The set of all referenced tags (function calls and resources).
     DB::Tag_set m_tags;
 
@@ -210,13 +210,13 @@ public:
         const std::vector<const char*>& parameter_types) const;
 
     /// Does not contain all/any resources if context options
-    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS or MDL_CTX_OPTION_RESOLVE_RESOURCES are
-    /// set.
+    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS, MDL_CTX_OPTION_RESOLVE_RESOURCES, or
+    /// MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION are set.
     mi::Size get_resources_count() const;
 
     /// Does not contain all/any resources if context options
-    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS or MDL_CTX_OPTION_RESOLVE_RESOURCES are
-    /// set.
+    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS, MDL_CTX_OPTION_RESOLVE_RESOURCES, or
+    /// MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION are set.
     const IValue_resource* get_resource( mi::Size index) const;
 
     mi::Sint32 reload(
@@ -301,6 +301,19 @@ public:
     /// Returns the identifier of this module.
     Mdl_ident get_ident() const;
 
+    /// Indicates whether the resolution of resources has been deferred while loading the module.
+    ///
+    /// Deferred resources are resolved on first use by a compiled material, see context option
+    /// MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION.
+    bool has_deferred_resources() const;
+
+    /// Indicates whether the resolution of resources has been deferred for this module or any
+    /// module it imports, directly or indirectly.
+    ///
+    /// Bodies of functions reachable from this module can only contain deferred resources if
+    /// this flag is set.
+    bool reaches_deferred_resources() const;
+
     /// Indicates whether the module supports reloading (or editing).
     ///
     /// Reloading is not supported for standard or builtin modules plus ::base and
@@ -313,8 +326,8 @@ public:
     /// Returns \c nullptr for invalid indices.
     ///
     /// Does not contain all/any resources if context options
-    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS or MDL_CTX_OPTION_RESOLVE_RESOURCES are
-    /// set.
+    /// MDL_CTX_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS, MDL_CTX_OPTION_RESOLVE_RESOURCES, or
+    /// MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION are set.
     ///
     /// \see #get_resource_count(), #get_resource()
     const Resource_tag_tuple_ext* get_resource_tag_tuple( mi::Size index) const;
@@ -461,6 +474,12 @@ private:
     /// Resources of this module.
     std::vector<Resource_tag_tuple_ext> m_resources;
 
+    /// Indicates whether the resolution of resources has been deferred.
+    bool m_deferred_resources = false;
+
+    /// Indicates whether this module or any imported module has deferred resources.
+    bool m_reaches_deferred_resources = false;
+
     /// Maps functions definition DB names to indices as used in #m_functions.
     std::map<std::string, mi::Size> m_function_name_to_index;
 
@@ -78,9 +78,9 @@ class Name_mangler;
 class Symbol_importer;
 
 /// Optimization ideas:
-/// - A mode where DAG creation and export to DB is only done on request.
 /// - An incremental analyze() implementation (would not work for all operations, but for typical
-///   ones).
+///   ones). The deferred analysis mode avoids repeated analysis when adding many entities, but
+///   still analyzes the entire module on commit().
 class Mdl_module_builder
 {
 public:
@@ -189,6 +189,13 @@ public:
     mi::Sint32 clear_module(
         Execution_context* context);
 
+    mi::Sint32 set_deferred_analysis(
+        bool deferred,
+        Execution_context* context);
+
+    mi::Sint32 commit(
+        Execution_context* context);
+
     std::vector<bool> analyze_uniform(
         const IExpression* root_expr,
         bool root_expr_uniform,
@@ -314,6 +321,10 @@ private:
     /// Also exports it to the DB depending on \c m_export_to_db.
     void analyze_module( Execution_context* context);
 
+    /// Analyses the module via analyze_module(), or marks the analysis as pending in the deferred
+    /// analysis mode.
+    void request_analysis( Execution_context* context);
+
     /// Checks that the given name is a valid MDL identifier.
     ///
     /// \param name                      The intended name of the function, variant, annotation,
@@ -395,6 +406,13 @@ private:
     /// Indicates whether the module being worked on needs to be re-initialized from the DB.
     bool m_needs_sync_from_db = false;
 
+    /// Indicates whether the deferred analysis mode is enabled.
+    bool m_deferred_analysis = false;
+
+    /// Indicates whether the module has been modified in the deferred analysis mode, but not yet
+    /// been analyzed.
+    bool m_analysis_pending = false;
+
     std::unique_ptr<Symbol_importer> m_symbol_importer;
     std::unique_ptr<Name_mangler> m_name_mangler;
 
@@ -602,6 +602,7 @@ private:
 #define MDL_CTX_OPTION_MDL_NEXT                            "mdl_next"
 #define MDL_CTX_OPTION_EXPERIMENTAL                        "experimental"
 #define MDL_CTX_OPTION_RESOLVE_RESOURCES                   "resolve_resources"
+#define MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION           "defer_resource_resolution"
 #define MDL_CTX_OPTION_FOLD_TERNARY_ON_DF                  "fold_ternary_on_df"
 #define MDL_CTX_OPTION_IGNORE_NOINLINE                     "ignore_noinline"
 #define MDL_CTX_OPTION_REMOVE_DEAD_PARAMETERS              "remove_dead_parameters"
@@ -771,6 +772,13 @@ void add_warning_message( Execution_context* context, const std::string& message
 /// Does nothing if \p context is \c nullptr.
 void add_info_message( Execution_context* context, const std::string& message);
 
+/// Indicates whether resources are resolved while loading modules.
+///
+/// Returns \c true if the context option MDL_CTX_OPTION_RESOLVE_RESOURCES is set and
+/// MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION is not set. Deferred resources are resolved on first
+/// use by a compiled material (see #Mdl_function_call::create_compiled_material()).
+bool resolve_resources_during_load( const Execution_context* context);
+
 /// Creates a thread context.
 ///
 /// If \p context is not \c nullptr, its relevant options are copied to the thread context. (Not all
@@ -1091,6 +1099,10 @@ public:
     const std::vector<const mi::mdl::IType*>& get_parameter_types() const
     { return m_parameter_types; }
 
+    /// Indicates whether any definition called by the converted expressions stems from a module
+    /// that reaches deferred resources (see Mdl_module::reaches_deferred_resources()).
+    bool reaches_deferred_resources() const { return m_reaches_deferred_resources; }
+
 private:
     const mi::mdl::DAG_node* int_expr_constant_to_core_dag_node(
         const mi::mdl::IType* core_type,
@@ -1137,6 +1149,8 @@ private:
     robin_hood::unordered_set<DB::Tag> m_set_indirect_calls;
     /// Cache of already converted function calls or material instances.
     std::map<DB::Tag, const mi::mdl::DAG_node*> m_converted_call_expressions;
+    /// See #reaches_deferred_resources().
+    bool m_reaches_deferred_resources = false;
 };
 
 
@@ -1537,13 +1551,17 @@ public:
     /// \param owner                    the owner of a resource
     /// \param transaction              the current transaction
     /// \param has_resource_attributes  true, if resource attributes can be folded
+    /// \param skip_unresolved_resources true, if calls on resources without tag are not folded,
+    ///                                  e.g., because their resolution was deferred
     Call_evaluator(
         const T* owner,
         DB::Transaction* transaction,
-        bool has_resource_attributes)
+        bool has_resource_attributes,
+        bool skip_unresolved_resources = false)
       : m_owner( owner),
         m_transaction( transaction),
-        m_has_resource_attributes( has_resource_attributes)
+        m_has_resource_attributes( has_resource_attributes),
+        m_skip_unresolved_resources( skip_unresolved_resources)
     {}
 
     /// Destructor.
@@ -1571,6 +1589,9 @@ public:
         size_t n_arguments) const final;
 
 private:
+    /// Indicates whether \p argument is a resource without tag (except BSDF data textures).
+    bool is_unresolved_resource( const mi::mdl::IValue* argument) const;
+
     /// Folds df::light_profile_power() to a constant, or returns IValue_bad in case of errors.
     const mi::mdl::IValue* fold_df_light_profile_power(
         mi::mdl::IValue_factory* value_factory,
@@ -1661,6 +1682,7 @@ private:
     const T* m_owner;
     DB::Transaction* m_transaction;
     bool m_has_resource_attributes;
+    bool m_skip_unresolved_resources;
 };
 
 // ********** Resource names ***********************************************************************
@@ -307,6 +307,22 @@ public:
     virtual const IType_array* get_type() const = 0;
 
     virtual mi::Sint32 set_size( mi::Size size) = 0;
+
+    virtual mi::Sint32 get_data( bool* values, mi::Size count) const = 0;
+
+    virtual mi::Sint32 get_data( mi::Sint32* values, mi::Size count) const = 0;
+
+    virtual mi::Sint32 get_data( mi::Float32* values, mi::Size count) const = 0;
+
+    virtual mi::Sint32 get_data( mi::Float64* values, mi::Size count) const = 0;
+
+    virtual mi::Sint32 set_data( const bool* values, mi::Size count) = 0;
+
+    virtual mi::Sint32 set_data( const mi::Sint32* values, mi::Size count) = 0;
+
+    virtual mi::Sint32 set_data( const mi::Float32* values, mi::Size count) = 0;
+
+    virtual mi::Sint32 set_data( const mi::Float64* values, mi::Size count) = 0;
 };
 
 class IValue_struct : public
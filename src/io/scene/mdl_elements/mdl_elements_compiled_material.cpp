@@ -423,6 +423,7 @@ void Mdl_compiled_material::swap( Mdl_compiled_material& other)
     std::swap( m_mdl_wavelength_min, other.m_mdl_wavelength_min);
     std::swap( m_mdl_wavelength_max, other.m_mdl_wavelength_max);
     std::swap( m_resolve_resources, other.m_resolve_resources);
+    std::swap( m_instance_tag, other.m_instance_tag);
 
     std::swap( m_tags, other.m_tags);
     std::swap( m_module_idents, other.m_module_idents);
@@ -442,6 +443,7 @@ const SERIAL::Serializable* Mdl_compiled_material::serialize(
     SERIAL::write( serializer, m_mdl_wavelength_min);
     SERIAL::write( serializer, m_mdl_wavelength_max);
     SERIAL::write( serializer, m_resolve_resources);
+    SERIAL::write( serializer, m_instance_tag);
 
     SERIAL::write( serializer, m_tags);
     SERIAL::write( serializer, m_module_idents);
@@ -462,6 +464,7 @@ SERIAL::Serializable* Mdl_compiled_material::deserialize(
     SERIAL::read( deserializer, &m_mdl_wavelength_min);
     SERIAL::read( deserializer, &m_mdl_wavelength_max);
     SERIAL::read( deserializer, &m_resolve_resources);
+    SERIAL::read( deserializer, &m_instance_tag);
 
     SERIAL::read( deserializer, &m_tags);
     SERIAL::read( deserializer, &m_module_idents);
@@ -519,6 +522,9 @@ void Mdl_compiled_material::get_scene_element_references( DB::Tag_set* result) c
 
     result->insert( m_tags.begin(), m_tags.end());
 
+    if( m_instance_tag)
+        result->insert( m_instance_tag);
+
     for( const auto& module_ident: m_module_idents)
         result->insert( module_ident.first);
 }
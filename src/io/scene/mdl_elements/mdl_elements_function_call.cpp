@@ -54,8 +54,8 @@
 #include <base/lib/log/i_log_logger.h>
 #include <base/lib/config/config.h>
 #include <base/data/db/i_db_access.h>
+#include <base/data/db/i_db_snapshot_transaction.h>
 #include <base/data/db/i_db_transaction.h>
-#include <base/data/db/i_db_transaction_wrapper.h>
 #include <base/data/db/i_db_info.h>
 #include <base/data/serial/i_serializer.h>
 #include <base/util/registry/i_config_registry.h>
@@ -769,89 +769,16 @@ mi::mdl::IGenerated_code_lambda_function* Mdl_function_call::create_jitted_funct
     return jitted_func;
 }
 
-/// This transaction wrapper caches results of various methods on DB::Transaction.
-///
-/// The cache assumes that the transaction's view on the database does *not* change during the
-/// caches lifetime. Do *not* use the cache if this not guaranteed.
-///
-/// Cached methods: get_class_id(), name_to_tag(), access_element().
-class Caching_transaction : public DB::Transaction_wrapper
-{
-public:
-    Caching_transaction( DB::Transaction* transaction)
-      : DB::Transaction_wrapper( transaction) { }
-
-    ~Caching_transaction()
-    {
-        for( auto &entry : m_elements)
-            entry.second->unpin();
-    }
-
-    SERIAL::Class_id get_class_id( DB::Tag tag) final
-    {
-        auto it = m_class_ids.find( tag);
-        if( it != m_class_ids.end())
-            return it->second;
-
-        SERIAL::Class_id class_id = m_transaction->get_class_id( tag);
-        m_class_ids[tag] = class_id;
-        return class_id;
-    }
-
-    // Invalid tags are not cached. Unclear if relevant.
-    DB::Tag name_to_tag( const char* name) final
-    {
-        auto it = m_tags.find( name);
-        if( it != m_tags.end())
-            return it->second;
-
-        DB::Tag tag = m_transaction->name_to_tag( name);
-        if( tag)
-            m_tags[name] = tag;
-        return tag;
-    }
-
-    DB::Info* access_element( DB::Tag tag) final
-    {
-        auto it = m_elements.find( tag);
-        if( it != m_elements.end()) {
-            it->second->pin();
-            return it->second;
-        }
-
-        DB::Info* element = m_transaction->access_element( tag);
-        element->pin();
-        m_elements[tag] = element;
-        return element;
-    }
-
-private:
-    // Allow comparisons of C-style string with std::strings to avoid temporaries when searching in
-    // a map.
-    struct String_less
-    {
-        using is_transparent = void;
-        bool operator()( const std::string& lhs, const char* rhs) const
-        { return strcmp( lhs.c_str(), rhs) < 0; }
-        bool operator()( const char* lhs, const std::string& rhs) const
-        { return strcmp( lhs, rhs.c_str()) < 0; }
-        bool operator()( const std::string& lhs, const std::string& rhs) const
-        { return lhs < rhs; }
-    };
-
-    std::map<DB::Tag, SERIAL::Class_id>         m_class_ids;
-    std::map<std::string, DB::Tag, String_less> m_tags;
-    std::map<DB::Tag, DB::Info*>                m_elements;
-};
-
 Mdl_compiled_material* Mdl_function_call::create_compiled_material(
     DB::Transaction* transaction_non_cached,
     bool class_compilation,
     const IType_struct* target_type,
     Execution_context* context) const
 {
-    Caching_transaction transaction_cached( transaction_non_cached);
-    DB::Transaction* transaction = &transaction_cached;
+    // The compilation only reads from the database (apart from resources that might be stored
+    // on demand), so use a snapshot to avoid repeated lookups through the database lock.
+    DB::Snapshot_transaction transaction_snapshot( transaction_non_cached);
+    DB::Transaction* transaction = &transaction_snapshot;
 
     if( !is_valid( transaction, context)) {
         add_error_message( context, "The material instance is invalid.", -1);
@@ -960,6 +887,11 @@ Mdl_function_call::create_dag_material_instance(
     mi::Size n_args = core_code_dag->get_material_parameter_count( material_index);
     std::vector<const mi::mdl::DAG_node*> core_arguments( n_args);
 
+    // Resources without tag from deferred resolution can only be reached via the module of the
+    // definition or the modules of the definitions called by the arguments (including their
+    // imports). If none of them reaches deferred resources, the instance needs no update.
+    bool reaches_deferred_resources = resolve_resources && module->reaches_deferred_resources();
+
     {
         // This builder is a wrapper on the DAG builder of the instance, use an extra scope to
         // restore the optimization settings.
@@ -982,6 +914,9 @@ Mdl_function_call::create_dag_material_instance(
                 return nullptr;
             }
         }
+
+        if( resolve_resources && builder.reaches_deferred_resources())
+            reaches_deferred_resources = true;
     }
 
     // Convert flags.
@@ -1019,7 +954,10 @@ Mdl_function_call::create_dag_material_instance(
     // Create the DAG material instance.
     Mdl_call_resolver resolver( transaction);
     Call_evaluator<mi::mdl::IGenerated_code_dag> call_evaluator(
-        core_code_dag.get(), transaction, resolve_resources);
+        core_code_dag.get(),
+        transaction,
+        resolve_resources,
+        /*skip_unresolved_resources*/ reaches_deferred_resources);
     error_code = instance->initialize(
         &resolver,
         /*resource_modifier*/ nullptr,
@@ -1087,6 +1025,20 @@ Mdl_function_call::create_dag_material_instance(
         return nullptr;
     }
 
+    // Resolve resources whose resolution was deferred while loading their module, restricted to
+    // the resources without tag actually reachable from this instance. Such resources might also
+    // stem from arguments or called functions of other modules than the one of the definition.
+    if( reaches_deferred_resources) {
+        Resource_updater updater(
+            transaction,
+            resolver,
+            instance.get(),
+            module->get_filename(),
+            module->get_mdl_name(),
+            context);
+        updater.update_resource_literals();
+    }
+
     return instance.extract();
 }
 
@@ -695,7 +695,7 @@ mi::Sint32 Mdl_module::create_module_internal(
             annotation_tags[i], db_annotation, annotation_names[i].c_str(), privacy_level);
     }
 
-    bool resolve_resources = context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES);
+    bool resolve_resources = resolve_resources_during_load( context);
 
     // Create DB elements for the function definitions in this module.
     for( mi::Size i = 0; i < function_count; ++i) {
@@ -838,7 +838,18 @@ void Mdl_module::init_module( DB::Transaction* transaction, Execution_context* c
             m_local_types->add_type_unchecked( full_name.c_str(), type_int.get());
     }
 
-    bool resolve_resources = context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES);
+    bool resolve_resources = resolve_resources_during_load( context);
+    m_deferred_resources = context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES)
+        && !resolve_resources;
+
+    // Imported modules exist already in the DB, their flags are final.
+    m_reaches_deferred_resources = m_deferred_resources;
+    for( const auto& import : m_imports) {
+        if( m_reaches_deferred_resources)
+            break;
+        DB::Access<Mdl_module> import_module( import.first, transaction);
+        m_reaches_deferred_resources = import_module->reaches_deferred_resources();
+    }
 
     Mdl_dag_converter converter(
         m_ef.get(),
@@ -1906,7 +1917,7 @@ mi::Sint32 Mdl_module::reload_module_internal(
     init_module( transaction, context);
 
     DB::Privacy_level privacy_level = transaction->get_scope()->get_level();
-    bool resolve_resources = context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES);
+    bool resolve_resources = resolve_resources_during_load( context);
 
     // Update DB elements for the function definitions in this module.
     std::vector<Mdl_tag_ident> new_functions( function_count);
@@ -2123,6 +2134,16 @@ Mdl_ident Mdl_module::get_ident() const
     return m_ident;
 }
 
+bool Mdl_module::has_deferred_resources() const
+{
+    return m_deferred_resources;
+}
+
+bool Mdl_module::reaches_deferred_resources() const
+{
+    return m_reaches_deferred_resources;
+}
+
 const SERIAL::Serializable* Mdl_module::serialize( SERIAL::Serializer* serializer) const
 {
     Scene_element_base::serialize( serializer);
@@ -2154,6 +2175,8 @@ const SERIAL::Serializable* Mdl_module::serialize( SERIAL::Serializer* serialize
     SERIAL::write( serializer, m_materials);
     SERIAL::write( serializer, m_annotation_proxies);
     SERIAL::write( serializer, m_resources);
+    SERIAL::write( serializer, m_deferred_resources);
+    SERIAL::write( serializer, m_reaches_deferred_resources);
     SERIAL::write( serializer, m_function_name_to_index);
     SERIAL::write( serializer, m_material_name_to_index);
     SERIAL::write( serializer, m_annotation_name_to_index);
@@ -2193,6 +2216,8 @@ SERIAL::Serializable* Mdl_module::deserialize( SERIAL::Deserializer* deserialize
     SERIAL::read( deserializer, &m_materials);
     SERIAL::read( deserializer, &m_annotation_proxies);
     SERIAL::read( deserializer, &m_resources);
+    SERIAL::read( deserializer, &m_deferred_resources);
+    SERIAL::read( deserializer, &m_reaches_deferred_resources);
     SERIAL::read( deserializer, &m_function_name_to_index);
     SERIAL::read( deserializer, &m_material_name_to_index);
     SERIAL::read( deserializer, &m_annotation_name_to_index);
@@ -681,7 +681,7 @@ mi::Sint32 Mdl_module_builder::add_function(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -842,7 +842,7 @@ mi::Sint32 Mdl_module_builder::add_annotation(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -913,7 +913,7 @@ mi::Sint32 Mdl_module_builder::add_struct_category(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1039,7 +1039,7 @@ mi::Sint32 Mdl_module_builder::add_enum_type(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1204,7 +1204,7 @@ mi::Sint32 Mdl_module_builder::add_struct_type(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1287,7 +1287,7 @@ mi::Sint32 Mdl_module_builder::add_constant(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1326,7 +1326,7 @@ mi::Sint32 Mdl_module_builder::set_module_annotations(
     static_cast<mi::mdl::Module*>( m_module.get())->replace_declarations(
         declarations.data(), declarations.size());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1460,7 +1460,7 @@ mi::Sint32 Mdl_module_builder::remove_entity(
     static_cast<mi::mdl::Module*>( m_module.get())->replace_declarations(
         declarations.data(), declarations.size());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -1478,6 +1478,37 @@ mi::Sint32 Mdl_module_builder::clear_module(
 
     static_cast<mi::mdl::Module*>( m_module.get())->replace_declarations( nullptr, 0);
 
+    request_analysis( context);
+    if( context->get_error_messages_count() > 0)
+        return -1;
+
+    return 0;
+}
+
+mi::Sint32 Mdl_module_builder::set_deferred_analysis(
+    bool deferred,
+    Execution_context* context)
+{
+    // handle nullptr arguments
+    ASSERT( M_SCENE, context);
+
+    m_deferred_analysis = deferred;
+    if( deferred)
+        return 0;
+
+    return commit( context);
+}
+
+mi::Sint32 Mdl_module_builder::commit(
+    Execution_context* context)
+{
+    // handle nullptr arguments
+    ASSERT( M_SCENE, context);
+
+    if( !m_analysis_pending)
+        return 0;
+
+    m_analysis_pending = false;
     analyze_module( context);
     if( context->get_error_messages_count() > 0)
         return -1;
@@ -1609,7 +1640,8 @@ bool Mdl_module_builder::check_valid( Execution_context* context)
 {
     sync_from_db();
 
-    if( m_module && m_module->is_valid())
+    // In deferred analysis mode the module is not valid (i.e., not analyzed) until commit().
+    if( m_module && (m_module->is_valid() || m_analysis_pending))
         return true;
 
     add_error_message(
@@ -1913,7 +1945,7 @@ mi::Sint32 Mdl_module_builder::add_prototype_based(
     m_symbol_importer->add_imports();
     m_name_mangler->add_namespace_aliases( m_module.get());
 
-    analyze_module( context);
+    request_analysis( context);
     if( context->get_error_messages_count() > 0)
         return -1;
 
@@ -2190,6 +2222,16 @@ void Mdl_module_builder::create_module( Execution_context* context)
     update_module();
 }
 
+void Mdl_module_builder::request_analysis( Execution_context* context)
+{
+    if( m_deferred_analysis) {
+        m_analysis_pending = true;
+        return;
+    }
+
+    analyze_module( context);
+}
+
 void Mdl_module_builder::analyze_module( Execution_context* context)
 {
     // Note that the AST dump is not guaranteed to be valid MDL (even for valid modules), e.g., it
@@ -835,6 +835,20 @@ void collect_references( const IValue* value, DB::Tag_set* result)
             return; //-V1037 PVS
         case IValue::VK_ARRAY:
         case IValue::VK_STRUCT: {
+            if( kind == IValue::VK_ARRAY) {
+                // Avoid creating element values for arrays stored in packed form.
+                mi::base::Handle<const IType_array> type_array(
+                    value->get_type<IType_array>());
+                mi::base::Handle<const IType> element_type( type_array->get_element_type());
+                mi::base::Handle<const IType> element_type_stripped(
+                    element_type->skip_all_type_aliases());
+                IType::Kind element_kind = element_type_stripped->get_kind();
+                if(    element_kind == IType::TK_BOOL
+                    || element_kind == IType::TK_INT
+                    || element_kind == IType::TK_FLOAT
+                    || element_kind == IType::TK_DOUBLE)
+                    return;
+            }
             mi::base::Handle<const IValue_compound> value_compound(
                 value->get_interface<IValue_compound>());
             mi::Size n = value_compound->get_size();
@@ -3060,6 +3074,9 @@ const mi::mdl::DAG_node* Mdl_dag_builder::int_expr_call_to_core_dag_node_shared(
     const char* call_name,
     const IExpression_list* arguments)
 {
+    if( module->reaches_deferred_resources())
+        m_reaches_deferred_resources = true;
+
     mi::base::Handle<const mi::mdl::IGenerated_code_dag> core_code_dag( module->get_code_dag());
     Code_dag code_dag( core_code_dag.get(), is_material);
 
@@ -3615,6 +3632,54 @@ const IType* core_type_to_int_type(
     return nullptr;
 }
 
+namespace {
+
+template <class T, class V>
+bool core_array_to_int_array_data(
+    const mi::mdl::IValue_array* value_array, IValue_array* value_array_int)
+{
+    mi::Size n = value_array->get_component_count();
+    std::unique_ptr<T[]> buffer( new T[n]);
+    for( mi::Size i = 0; i < n; ++i) {
+        const V* component = as<V>( value_array->get_value( static_cast<mi::Uint32>( i)));
+        if( !component)
+            return false;
+        buffer[i] = component->get_value();
+    }
+    return value_array_int->set_data( buffer.get(), n) == 0;
+}
+
+/// Converts the elements of core arrays of type bool, int, float, or double in bulk.
+///
+/// Returns \c false if the element type is not one of these types.
+bool core_array_to_int_array_data(
+    const mi::mdl::IValue_array* value_array, IValue_array* value_array_int)
+{
+    mi::base::Handle<const IType_array> type_array_int( value_array_int->get_type());
+    mi::base::Handle<const IType> element_type_int( type_array_int->get_element_type());
+    mi::base::Handle<const IType> element_type_int_stripped(
+        element_type_int->skip_all_type_aliases());
+
+    switch( element_type_int_stripped->get_kind()) {
+        case IType::TK_BOOL:
+            return core_array_to_int_array_data<bool, mi::mdl::IValue_bool>(
+                value_array, value_array_int);
+        case IType::TK_INT:
+            return core_array_to_int_array_data<mi::Sint32, mi::mdl::IValue_int>(
+                value_array, value_array_int);
+        case IType::TK_FLOAT:
+            return core_array_to_int_array_data<mi::Float32, mi::mdl::IValue_float>(
+                value_array, value_array_int);
+        case IType::TK_DOUBLE:
+            return core_array_to_int_array_data<mi::Float64, mi::mdl::IValue_double>(
+                value_array, value_array_int);
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
 Mdl_dag_converter::Mdl_dag_converter(
     IExpression_factory* ef,
     DB::Transaction* transaction,
@@ -3755,6 +3820,8 @@ IValue* Mdl_dag_converter::core_value_to_int_value(
             mi::Size n = value_array->get_component_count();
             if( !type_array_int->is_immediate_sized())
                 value_array_int->set_size( n);
+            if( core_array_to_int_array_data( value_array, value_array_int))
+                return value_array_int;
             mi::base::Handle<const IType> component_type_int( type_array_int->get_element_type());
             for( mi::Size i = 0; i < n; ++i) {
                 const mi::mdl::IValue* component
@@ -4859,6 +4926,62 @@ const mi::mdl::IValue* int_value_bsdf_measurement_to_core_value(
     return vf->create_bsdf_measurement( core_type, resource_name.c_str(), tag.get_uint(), hash);
 }
 
+const mi::mdl::IValue* create_core_value( mi::mdl::IValue_factory* vf, bool value)
+{ return vf->create_bool( value); }
+
+const mi::mdl::IValue* create_core_value( mi::mdl::IValue_factory* vf, mi::Sint32 value)
+{ return vf->create_int( value); }
+
+const mi::mdl::IValue* create_core_value( mi::mdl::IValue_factory* vf, mi::Float32 value)
+{ return vf->create_float( value); }
+
+const mi::mdl::IValue* create_core_value( mi::mdl::IValue_factory* vf, mi::Float64 value)
+{ return vf->create_double( value); }
+
+template <class T>
+bool int_array_data_to_core_values(
+    mi::mdl::IValue_factory* vf,
+    const IValue_array* value_array,
+    std::vector<const mi::mdl::IValue*>& core_element_values)
+{
+    mi::Size n = value_array->get_size();
+    std::unique_ptr<T[]> buffer( new T[n]);
+    if( value_array->get_data( buffer.get(), n) != 0)
+        return false;
+    for( mi::Size i = 0; i < n; ++i)
+        core_element_values[i] = create_core_value( vf, buffer[i]);
+    return true;
+}
+
+/// Converts the elements of arrays of type bool, int, float, or double in bulk.
+///
+/// Returns \c false if the element type is not one of these types, or does not match the
+/// element type of \p core_type_array.
+bool int_array_data_to_core_values(
+    mi::mdl::IValue_factory* vf,
+    const mi::mdl::IType_array* core_type_array,
+    const IValue_array* value_array,
+    std::vector<const mi::mdl::IValue*>& core_element_values)
+{
+    const mi::mdl::IType* core_element_type = core_type_array->get_element_type();
+    switch( core_element_type->skip_type_alias()->get_kind()) {
+        case mi::mdl::IType::TK_BOOL:
+            return int_array_data_to_core_values<bool>(
+                vf, value_array, core_element_values);
+        case mi::mdl::IType::TK_INT:
+            return int_array_data_to_core_values<mi::Sint32>(
+                vf, value_array, core_element_values);
+        case mi::mdl::IType::TK_FLOAT:
+            return int_array_data_to_core_values<mi::Float32>(
+                vf, value_array, core_element_values);
+        case mi::mdl::IType::TK_DOUBLE:
+            return int_array_data_to_core_values<mi::Float64>(
+                vf, value_array, core_element_values);
+        default:
+            return false;
+    }
+}
+
 } // namespace
 
 const mi::mdl::IValue* int_value_to_core_value(
@@ -4945,7 +5068,13 @@ const mi::mdl::IValue* int_value_to_core_value(
             if( type_n != n)
                 return nullptr;
             std::vector<const mi::mdl::IValue*> core_element_values( n);
-            for( mi::Size i = 0; i < n; ++i) {
+            mi::base::Handle<const IValue_array> value_array(
+                value->get_interface<IValue_array>());
+            const auto* core_type_array = as<mi::mdl::IType_array>( core_type_compound);
+            bool done = value_array && core_type_array
+                && int_array_data_to_core_values(
+                    vf, core_type_array, value_array.get(), core_element_values);
+            for( mi::Size i = 0; !done && i < n; ++i) {
                 mi::base::Handle<const IValue> element_value(
                     value_compound->get_value( i));
                 const mi::mdl::IType* core_element_type
@@ -5975,15 +6104,53 @@ Resource_updater::Resource_updater(
   : m_transaction( transaction),
     m_resolver( resolver),
     m_code_dag( code_dag),
+    m_material_instance( nullptr),
     m_module_filename( module_filename),
     m_module_mdl_name( module_mdl_name),
     m_context( context),
-    m_resolve_resources( context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES))
+    m_resolve_resources( resolve_resources_during_load( context)),
+    m_def_owner( nullptr)
+{
+}
+
+Resource_updater::Resource_updater(
+    DB::Transaction* transaction,
+    mi::mdl::ICall_name_resolver& resolver,
+    mi::mdl::IMaterial_instance* instance,
+    const char* module_filename,
+    const char* module_mdl_name,
+    Execution_context* context)
+  : m_transaction( transaction),
+    m_resolver( resolver),
+    m_code_dag( nullptr),
+    m_material_instance( instance),
+    m_module_filename( module_filename),
+    m_module_mdl_name( module_mdl_name),
+    m_context( context),
+    m_resolve_resources( true),
+    m_def_owner( nullptr)
 {
 }
 
 void Resource_updater::update_resource_literals()
 {
+    if( m_material_instance) {
+
+        // traverse body
+        update_resource_literals( m_material_instance->get_constructor());
+
+        // traverse temporaries
+        mi::Size temporary_count = m_material_instance->get_temporary_count();
+        for( mi::Size i = 0; i < temporary_count; ++i)
+            update_resource_literals( m_material_instance->get_temporary_value( i));
+
+        // traverse parameters (arguments in class compilation mode)
+        mi::Size parameter_count = m_material_instance->get_parameter_count();
+        for( mi::Size i = 0; i < parameter_count; ++i)
+            update_resource_literals( m_material_instance->get_parameter_default( i));
+        return;
+    }
+
     // materials
     mi::Size material_count = m_code_dag->get_material_count();
     for( mi::Size i = 0; i < material_count; ++i) {
@@ -6043,13 +6210,14 @@ void Resource_updater::update_resource_literals( const mi::mdl::DAG_node* node)
     if( !node)
         return;
 
+    if( !m_node_set.insert( node).second)
+        return;
+
     switch( node->get_kind()) {
 
         case mi::mdl::DAG_node::EK_CONSTANT: {
             const auto* constant = cast<mi::mdl::DAG_constant>( node);
-            const mi::mdl::IValue_resource* resource
-                = as<mi::mdl::IValue_resource>( constant->get_value());
-            update_resource_literals( resource);
+            update_resource_literals( constant->get_value());
             return;
         }
 
@@ -6131,6 +6299,22 @@ void Resource_updater::update_resource_literals( const mi::mdl::IDefinition* def
     visit( decl);
 }
 
+void Resource_updater::update_resource_literals( const mi::mdl::IValue* value)
+{
+    if( const auto* resource = as<mi::mdl::IValue_resource>( value)) {
+        update_resource_literals( resource);
+        return;
+    }
+
+    // Compound values occur in material instances, e.g., arrays of textures as arguments.
+    const auto* compound = as<mi::mdl::IValue_compound>( value);
+    if( !compound)
+        return;
+
+    for( int i = 0, n = compound->get_component_count(); i < n; ++i)
+        update_resource_literals( compound->get_value( i));
+}
+
 void Resource_updater::update_resource_literals( const mi::mdl::IValue_resource* resource)
 {
     if( !resource)
@@ -6142,6 +6326,29 @@ void Resource_updater::update_resource_literals( const mi::mdl::IValue_resource*
         return;
     }
 
+    if( m_material_instance) {
+
+        // Skip resources that are already resolved, e.g., arguments set via the API.
+        if( m_material_instance->get_resource_tagger()->get_resource_tag( resource) != 0)
+            return;
+
+        // Skip resources in bodies of modules that resolved their resources while loading, the
+        // resolution of those failed already.
+        if( m_def_owner && !has_deferred_resources( m_def_owner))
+            return;
+
+        auto it = m_resource_tag_map.find( resource);
+        if( it == m_resource_tag_map.end()) {
+            DB::Tag tag = resolve_deferred_resource( resource);
+            it = m_resource_tag_map.insert( Resource_tag_map::value_type( resource, tag)).first;
+        }
+
+        DB::Tag tag = it->second;
+        if( tag)
+            m_material_instance->set_resource_tag( resource, tag.get_uint());
+        return;
+    }
+
     auto it = m_resource_tag_map.find( resource);
     if( it == m_resource_tag_map.end()) {
         DB::Tag tag = DETAIL::core_resource_to_tag(
@@ -6158,6 +6365,97 @@ void Resource_updater::update_resource_literals( const mi::mdl::IValue_resource*
     m_code_dag->set_resource_tag( resource, tag.get_uint());
 }
 
+DB::Tag Resource_updater::resolve_deferred_resource( const mi::mdl::IValue_resource* resource)
+{
+    const char* string_value = resource->get_string_value();
+    if( !string_value || !string_value[0])
+        return {};
+
+    // Unresolved file paths are absolute, except for weak relative paths from modules with MDL
+    // version < 1.6 which carry the MDL name of their owner module as prefix. Resolve the latter
+    // relative to that module.
+    std::string file_path = strip_resource_owner_prefix( string_value);
+    std::string owner_name = get_resource_owner_prefix( string_value);
+
+    const char* module_filename = m_module_filename;
+    const char* module_mdl_name = m_module_mdl_name;
+    std::string owner_filename;
+    if( !owner_name.empty()) {
+        std::string owner_db_name = get_db_name( encode_module_name( owner_name));
+        DB::Tag owner_tag = m_transaction->name_to_tag( owner_db_name.c_str());
+        if( owner_tag && m_transaction->get_class_id( owner_tag) == ID_MDL_MODULE) {
+            DB::Access<Mdl_module> owner( owner_tag, m_transaction);
+            const char* filename = owner->get_filename();
+            owner_filename = filename ? filename : "";
+            module_filename = !owner_filename.empty() ? owner_filename.c_str() : nullptr;
+            module_mdl_name = owner_name.c_str();
+        }
+    }
+
+    switch( resource->get_kind()) {
+
+        case mi::mdl::IValue::VK_TEXTURE: {
+            const auto* texture = cast<mi::mdl::IValue_texture>( resource);
+            const char* selector = texture->get_selector();
+            if( selector && !selector[0])
+                selector = nullptr;
+            return DETAIL::core_texture_to_tag(
+                m_transaction,
+                file_path.c_str(),
+                module_filename,
+                module_mdl_name,
+                /*errors_are_warnings*/ true,
+                texture->get_type()->get_shape(),
+                convert_gamma_enum_to_float( texture->get_gamma_mode()),
+                selector,
+                /*shared*/ true,
+                m_context);
+        }
+
+        case mi::mdl::IValue::VK_LIGHT_PROFILE:
+            return DETAIL::core_light_profile_to_tag(
+                m_transaction,
+                file_path.c_str(),
+                module_filename,
+                module_mdl_name,
+                /*shared*/ true,
+                /*errors_are_warnings*/ true,
+                m_context);
+
+        case mi::mdl::IValue::VK_BSDF_MEASUREMENT:
+            return DETAIL::core_bsdf_measurement_to_tag(
+                m_transaction,
+                file_path.c_str(),
+                module_filename,
+                module_mdl_name,
+                /*shared*/ true,
+                /*errors_are_warnings*/ true,
+                m_context);
+
+        default:
+            ASSERT( M_SCENE, false);
+            return {};
+    }
+}
+
+bool Resource_updater::has_deferred_resources( const mi::mdl::IModule* module)
+{
+    auto it = m_deferred_modules.find( module);
+    if( it != m_deferred_modules.end())
+        return it->second;
+
+    bool result = false;
+    std::string db_name = get_db_name( encode_module_name( module->get_name()));
+    DB::Tag tag = m_transaction->name_to_tag( db_name.c_str());
+    if( tag && m_transaction->get_class_id( tag) == ID_MDL_MODULE) {
+        DB::Access<Mdl_module> db_module( tag, m_transaction);
+        result = db_module->has_deferred_resources();
+    }
+
+    m_deferred_modules[module] = result;
+    return result;
+}
+
 mi::mdl::IExpression* Resource_updater::post_visit( mi::mdl::IExpression_literal* expr)
 {
     const mi::mdl::IValue_resource* resource = as<mi::mdl::IValue_resource>( expr->get_value());
@@ -7350,6 +7648,11 @@ const mi::mdl::IValue* Call_evaluator<T>::evaluate_intrinsic_function(
     if( !m_has_resource_attributes)
         return value_factory->create_bad();
 
+    // Do not fold calls on resources that might still be resolved later, otherwise they would
+    // be folded as invalid resources.
+    if( m_skip_unresolved_resources && n_arguments > 0 && is_unresolved_resource( arguments[0]))
+        return value_factory->create_bad();
+
     switch( semantic) {
         case mi::mdl::IDefinition::DS_INTRINSIC_DF_LIGHT_PROFILE_POWER:
             ASSERT( M_SCENE, arguments && n_arguments == 1);
@@ -7423,6 +7726,20 @@ const mi::mdl::IValue* Call_evaluator<T>::evaluate_intrinsic_function(
     }
 }
 
+template<typename T>
+bool Call_evaluator<T>::is_unresolved_resource( const mi::mdl::IValue* argument) const
+{
+    const auto* res = as<mi::mdl::IValue_resource>( argument);
+    if( !res)
+        return false;
+
+    const auto* tex = as<mi::mdl::IValue_texture>( res);
+    if( tex && tex->get_bsdf_data_kind() != mi::mdl::IValue_texture::BDK_NONE)
+        return false;
+
+    return m_owner->get_resource_tag( res) == 0;
+}
+
 template<typename T>
 const mi::mdl::IValue* Call_evaluator<T>::fold_df_light_profile_power(
     mi::mdl::IValue_factory* value_factory,
@@ -8060,6 +8377,7 @@ Execution_context::Execution_context( bool add_defaults)
     ADD3( MDL_CTX_OPTION_MDL_NEXT, false, false);
     ADD3( MDL_CTX_OPTION_EXPERIMENTAL, false, false);
     ADD3( MDL_CTX_OPTION_RESOLVE_RESOURCES, true, false);
+    ADD3( MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION, false, false);
     ADD3( MDL_CTX_OPTION_FOLD_TERNARY_ON_DF, false, false);
     ADD3( MDL_CTX_OPTION_IGNORE_NOINLINE, false, false);
     ADD3( MDL_CTX_OPTION_REMOVE_DEAD_PARAMETERS, true, false);
@@ -8086,6 +8404,12 @@ void Execution_context::add_default_option( const char* name, const Option& opti
     m_names.emplace_back( name);
 }
 
+bool resolve_resources_during_load( const Execution_context* context)
+{
+    return context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES)
+        && !context->get_option<bool>( MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION);
+}
+
 mi::mdl::IThread_context* create_thread_context( mi::mdl::IMDL* mdl, Execution_context* context)
 {
     mi::mdl::IThread_context* thread_context = mdl->create_thread_context();
@@ -8100,7 +8424,7 @@ mi::mdl::IThread_context* create_thread_context( mi::mdl::IMDL* mdl, Execution_c
             = context->get_option<mi::Sint32>( MDL_CTX_OPTION_OPTIMIZATION_LEVEL);
         options.set_option( MDL_OPTION_OPT_LEVEL, std::to_string( optimization_level).c_str());
 
-        bool resolve_resources = context->get_option<bool>( MDL_CTX_OPTION_RESOLVE_RESOURCES);
+        bool resolve_resources = resolve_resources_during_load( context);
         options.set_option( MDL_OPTION_RESOLVE_RESOURCES, resolve_resources ? "true" : "false");
 
         bool mdl_next = context->get_option<bool>( MDL_CTX_OPTION_MDL_NEXT);
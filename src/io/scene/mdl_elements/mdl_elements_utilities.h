@@ -791,6 +791,9 @@ const mi::mdl::IExpression_reference* signature_to_reference(
 
 /// Helper class to associate all resource literals inside a code DAG with their DB tags.
 /// Handles also bodies of called functions.
+///
+/// Alternatively, associates resource literals reachable from a material instance whose
+/// resolution was deferred during module loading (see MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION).
 class Resource_updater  : private mi::mdl::Module_visitor
 {
 public:
@@ -809,31 +812,70 @@ public:
         const char* module_mdl_name,
         Execution_context* context);
 
-    /// Associates all resource literals inside a code DAG with their DB tags.
+    /// Constructor for deferred resources of a material instance.
+    ///
+    /// Only resources without tag reachable from the instance are resolved. Resources in bodies
+    /// of called functions are skipped if their owner module resolved its resources while
+    /// loading. Weak relative resources with an owner module prefix are resolved relative to
+    /// their owner module, all other resources relative to the given module.
+    ///
+    /// \param transaction            The DB transaction to use.
+    /// \param resolver               The call name resolver.
+    /// \param instance               The material instance to update.
+    /// \param module_filename        The file name of the module of the material definition.
+    /// \param module_mdl_name        The MDL name of the module of the material definition.
+    Resource_updater(
+        DB::Transaction* transaction,
+        mi::mdl::ICall_name_resolver& resolver,
+        mi::mdl::IMaterial_instance* instance,
+        const char* module_filename,
+        const char* module_mdl_name,
+        Execution_context* context);
+
+    /// Associates all resource literals inside the code DAG (or reachable from the material
+    /// instance) with their DB tags.
     void update_resource_literals();
 
 private:
     void update_resource_literals( const mi::mdl::DAG_node* node);
     void update_resource_literals( const mi::mdl::IModule* owner, const mi::mdl::IDefinition* def);
     void update_resource_literals( const mi::mdl::IDefinition* def);
+    void update_resource_literals( const mi::mdl::IValue* value);
     void update_resource_literals( const mi::mdl::IValue_resource* resource);
     mi::mdl::IExpression* post_visit( mi::mdl::IExpression_literal* expr);
     mi::mdl::IExpression* post_visit( mi::mdl::IExpression_call* expr);
 
+    /// Resolves a deferred resource, i.e., a resource with unresolved file path and optional
+    /// owner module prefix.
+    DB::Tag resolve_deferred_resource( const mi::mdl::IValue_resource* resource);
+
+    /// Indicates whether the resolution of resources has been deferred for the given module.
+    bool has_deferred_resources( const mi::mdl::IModule* module);
+
     DB::Transaction* m_transaction;
     mi::mdl::ICall_name_resolver& m_resolver;
     mi::mdl::IGenerated_code_dag* m_code_dag;
+    mi::mdl::IMaterial_instance* m_material_instance;
     const char* m_module_filename;
     const char* m_module_mdl_name;
     Execution_context* m_context;
 
-    /// Value of context option MDL_CTX_OPTION_RESOLVE_RESOURCES.
+    /// Indicates whether resources are resolved (see #resolve_resources_during_load()). Always
+    /// set for material instances.
     bool m_resolve_resources;
 
     /// Keep track of visited definitions to avoid retraversal.
     using Definition_set = std::set<const mi::mdl::IDefinition*>;
     Definition_set m_definition_set;
 
+    /// Keep track of visited DAG nodes to avoid retraversal of shared subgraphs.
+    using Node_set = std::set<const mi::mdl::DAG_node*>;
+    Node_set m_node_set;
+
+    /// Caches has_deferred_resources() per owner module.
+    using Module_map = std::map<const mi::mdl::IModule*, bool>;
+    Module_map m_deferred_modules;
+
     /// Keep track of visited resource literals to avoid re-resolving.
     using Resource_tag_map = std::map<const mi::mdl::IValue_resource*, DB::Tag>;
     Resource_tag_map m_resource_tag_map;
@@ -35,8 +35,11 @@
 #include "mdl_elements_value.h"
 #include "mdl_elements_type.h"
 
+#include <cmath>
 #include <cstring>
+#include <memory>
 #include <sstream>
+#include <type_traits>
 
 #include <boost/core/ignore_unused.hpp>
 
@@ -302,34 +305,192 @@ mi::Size Value_color::get_memory_consumption() const
     return size;
 }
 
+namespace {
+
+/// Returns the size of packed elements of the given kind, or 0 if elements of that kind are not
+/// stored in packed form.
+mi::Size get_packed_element_size( IType::Kind kind)
+{
+    switch( kind) {
+        case IType::TK_BOOL:   return sizeof( bool);
+        case IType::TK_INT:    return sizeof( mi::Sint32);
+        case IType::TK_FLOAT:  return sizeof( mi::Float32);
+        case IType::TK_DOUBLE: return sizeof( mi::Float64);
+        default:               return 0;
+    }
+}
+
+/// Returns the kind of the (stripped) element type of an array value.
+IType::Kind get_element_kind( const IValue_array* value)
+{
+    mi::base::Handle<const IType_array> type( value->get_type());
+    mi::base::Handle<const IType> element_type( type->get_element_type());
+    mi::base::Handle<const IType> element_type_stripped( element_type->skip_all_type_aliases());
+    return element_type_stripped->get_kind();
+}
+
+template <class T>
+void copy_data( const IValue_array* source, IValue_array* target, mi::Size n)
+{
+    std::unique_ptr<T[]> buffer( new T[n]);
+    mi::Sint32 result = source->get_data( buffer.get(), n);
+    ASSERT( M_SCENE, result == 0);
+    result = target->set_data( buffer.get(), n);
+    ASSERT( M_SCENE, result == 0);
+    boost::ignore_unused( result);
+}
+
+/// Copies all elements of \p source to \p target (of the same type and size) in bulk.
+///
+/// Returns \c false if the element type is not stored in packed form.
+bool copy_data( const IValue_array* source, IValue_array* target)
+{
+    mi::Size n = source->get_size();
+    switch( get_element_kind( source)) {
+        case IType::TK_BOOL:   copy_data<bool>( source, target, n);        return true;
+        case IType::TK_INT:    copy_data<mi::Sint32>( source, target, n);  return true;
+        case IType::TK_FLOAT:  copy_data<mi::Float32>( source, target, n); return true;
+        case IType::TK_DOUBLE: copy_data<mi::Float64>( source, target, n); return true;
+        default:               return false;
+    }
+}
+
+template <class T>
+mi::Sint32 compare_data(
+    const IValue_array* lhs, const IValue_array* rhs, mi::Size n, mi::Float64 epsilon)
+{
+    std::unique_ptr<T[]> lhs_data( new T[n]);
+    std::unique_ptr<T[]> rhs_data( new T[n]);
+    lhs->get_data( lhs_data.get(), n);
+    rhs->get_data( rhs_data.get(), n);
+    for( mi::Size i = 0; i < n; ++i) {
+        T lhs_value = lhs_data[i];
+        T rhs_value = rhs_data[i];
+        if( std::is_floating_point<T>::value
+            && epsilon > 0 && std::abs( lhs_value-rhs_value) <= epsilon)
+            continue;
+        if( lhs_value < rhs_value) return -1;
+        if( lhs_value > rhs_value) return +1;
+    }
+    return 0;
+}
+
+/// Compares all elements of \p lhs and \p rhs (of the same type and size) in bulk.
+///
+/// Returns \c false if the element type is not stored in packed form.
+bool compare_data(
+    const IValue_array* lhs, const IValue_array* rhs, mi::Float64 epsilon, mi::Sint32& result)
+{
+    mi::Size n = lhs->get_size();
+    switch( get_element_kind( lhs)) {
+        case IType::TK_BOOL:
+            result = compare_data<bool>( lhs, rhs, n, epsilon); return true;
+        case IType::TK_INT:
+            result = compare_data<mi::Sint32>( lhs, rhs, n, epsilon); return true;
+        case IType::TK_FLOAT:
+            result = compare_data<mi::Float32>( lhs, rhs, n, epsilon); return true;
+        case IType::TK_DOUBLE:
+            result = compare_data<mi::Float64>( lhs, rhs, n, epsilon); return true;
+        default:
+            return false;
+    }
+}
+
+template <class T>
+void serialize_data( SERIAL::Serializer* serializer, const IValue_array* value, mi::Size n)
+{
+    std::unique_ptr<T[]> buffer( new T[n]);
+    value->get_data( buffer.get(), n);
+    serializer->write( buffer.get(), n);
+}
+
+/// Serializes all elements of \p value in bulk.
+///
+/// Returns \c false if the element type is not stored in packed form.
+bool serialize_data( SERIAL::Serializer* serializer, const IValue_array* value)
+{
+    mi::Size n = value->get_size();
+    switch( get_element_kind( value)) {
+        case IType::TK_BOOL:   serialize_data<bool>( serializer, value, n);        return true;
+        case IType::TK_INT:    serialize_data<mi::Sint32>( serializer, value, n);  return true;
+        case IType::TK_FLOAT:  serialize_data<mi::Float32>( serializer, value, n); return true;
+        case IType::TK_DOUBLE: serialize_data<mi::Float64>( serializer, value, n); return true;
+        default:               return false;
+    }
+}
+
+template <class T>
+void deserialize_data( SERIAL::Deserializer* deserializer, IValue_array* value, mi::Size n)
+{
+    std::unique_ptr<T[]> buffer( new T[n]);
+    deserializer->read( buffer.get(), n);
+    value->set_data( buffer.get(), n);
+}
+
+/// Deserializes all elements of \p value in bulk (counterpart of #serialize_data()).
+///
+/// Returns \c false if the element type is not stored in packed form.
+bool deserialize_data( SERIAL::Deserializer* deserializer, IValue_array* value)
+{
+    mi::Size n = value->get_size();
+    switch( get_element_kind( value)) {
+        case IType::TK_BOOL:   deserialize_data<bool>( deserializer, value, n);        return true;
+        case IType::TK_INT:    deserialize_data<mi::Sint32>( deserializer, value, n);  return true;
+        case IType::TK_FLOAT:  deserialize_data<mi::Float32>( deserializer, value, n); return true;
+        case IType::TK_DOUBLE: deserialize_data<mi::Float64>( deserializer, value, n); return true;
+        default:               return false;
+    }
+}
+
+} // namespace
+
 Value_array::Value_array( const Type* type, const IValue_factory* value_factory)
   : Base( type), m_value_factory( value_factory, mi::base::DUP_INTERFACE)
 {
+    mi::base::Handle<const IType> element_type( type->get_element_type());
+    mi::base::Handle<const IType> element_type_stripped( element_type->skip_all_type_aliases());
+    m_element_kind = element_type_stripped->get_kind();
+    m_element_size = get_packed_element_size( m_element_kind);
+    m_packed.store( m_element_size > 0, std::memory_order_relaxed);
+
     if( !type->is_immediate_sized())
         return;
 
-    mi::Size size = type->get_size();
-    m_values.resize( size);
+    // Default-constructed elements of the packed kinds are zero.
+    m_size = type->get_size();
+    if( is_packed()) {
+        m_data.resize( m_size * m_element_size);
+        return;
+    }
 
-    mi::base::Handle<const IType> element_type( type->get_element_type());
-    for( mi::Size i = 0; i < size; ++i)
+    m_values.resize( m_size);
+    for( mi::Size i = 0; i < m_size; ++i)
         m_values[i] = value_factory->create( element_type.get());
 }
 
 const IValue* Value_array::get_value( mi::Size index) const
 {
-    if( index >= m_values.size())
+    if( index >= m_size)
         return nullptr;
 
+    // Hand out the stored element such that later modifications of the array are visible via
+    // the returned element.
+    unpack();
+
     m_values[index]->retain();
     return m_values[index].get();
 }
 
 IValue* Value_array::get_value( mi::Size index)
 {
-    if( index >= m_values.size())
+    if( index >= m_size)
         return nullptr;
 
+    // The caller might modify the element. Switch to the unpacked representation such that
+    // such modifications are reflected in the array.
+    unpack();
+    release_data();
+
     m_values[index]->retain();
     return m_values[index].get();
 }
@@ -338,13 +499,18 @@ mi::Sint32 Value_array::set_value( mi::Size index, IValue* value)
 {
     if( !value)
         return -1;
-    if( index >= m_values.size())
+    if( index >= m_size)
         return -2;
     mi::base::Handle<const IType> actual_type( value->get_type());
     mi::base::Handle<const IType> expected_type( m_type->get_element_type());
     mi::base::Handle<const IType> expected_type_stripped( expected_type->skip_all_type_aliases());
     if( Type_factory::compare_static( actual_type.get(), expected_type_stripped.get()) != 0)
         return -3;
+
+    // Store a reference to the given element, as for all other arrays.
+    unpack();
+    release_data();
+
     m_values[index] = make_handle_dup( value);
     return 0;
 }
@@ -354,7 +520,15 @@ mi::Sint32 Value_array::set_size( mi::Size size)
     if( m_type->is_immediate_sized())
         return -1;
 
-    mi::Size old_size = m_values.size();
+    mi::Size old_size = m_size;
+    m_size = size;
+
+    if( is_packed()) {
+        m_data.resize( size * m_element_size);
+        return 0;
+    }
+
+    release_data();
     m_values.resize( size);
     if( size <= old_size)
         return 0;
@@ -368,12 +542,70 @@ mi::Sint32 Value_array::set_size( mi::Size size)
 mi::Size Value_array::get_memory_consumption() const
 {
     mi::Size size = sizeof( *this)
-        + dynamic_memory_consumption( m_type);
-    for( mi::Size i = 0; i < get_size(); ++i)
+        + dynamic_memory_consumption( m_type)
+        + dynamic_memory_consumption( m_data);
+    if( is_packed())
+        return size;
+    for( mi::Size i = 0; i < m_values.size(); ++i)
         size += dynamic_memory_consumption( m_values[i]);
     return size;
 }
 
+IValue* Value_array::create_packed_element( mi::Size index) const
+{
+    ASSERT( M_SCENE, is_packed() && index < m_size);
+
+    const mi::Uint8* p = &m_data[index * m_element_size];
+    switch( m_element_kind) {
+        case IType::TK_BOOL: {
+            bool b;
+            memcpy( &b, p, sizeof( b));
+            return m_value_factory->create_bool( b);
+        }
+        case IType::TK_INT: {
+            mi::Sint32 i;
+            memcpy( &i, p, sizeof( i));
+            return m_value_factory->create_int( i);
+        }
+        case IType::TK_FLOAT: {
+            mi::Float32 f;
+            memcpy( &f, p, sizeof( f));
+            return m_value_factory->create_float( f);
+        }
+        case IType::TK_DOUBLE: {
+            mi::Float64 d;
+            memcpy( &d, p, sizeof( d));
+            return m_value_factory->create_double( d);
+        }
+        default:
+            ASSERT( M_SCENE, false);
+            return nullptr;
+    }
+}
+
+void Value_array::unpack() const
+{
+    if( !is_packed())
+        return;
+
+    std::lock_guard<std::mutex> lock( m_unpack_mutex);
+    if( !is_packed())
+        return;
+
+    m_values.resize( m_size);
+    for( mi::Size i = 0; i < m_size; ++i)
+        m_values[i] = create_packed_element( i);
+
+    m_packed.store( false, std::memory_order_release);
+}
+
+void Value_array::release_data()
+{
+    ASSERT( M_SCENE, !is_packed());
+    if( !m_data.empty())
+        std::vector<mi::Uint8>().swap( m_data);
+}
+
 Value_struct::Value_struct( const Type* type, const IValue_factory* value_factory)
   : Base( type)
 {
@@ -1103,9 +1335,13 @@ IValue* Value_factory::clone( const IValue* value) const
             auto* result = create<IValue_compound>( type_compound.get());
             mi::Size n = value_compound->get_size();
             if( kind == IValue::VK_ARRAY) {
+                mi::base::Handle<const IValue_array> value_array(
+                    value->get_interface<IValue_array>());
                 mi::base::Handle<IValue_array> result_array(
                     result->get_interface<IValue_array>());
                 result_array->set_size( n);
+                if( copy_data( value_array.get(), result_array.get()))
+                    return result;
             }
             for( mi::Size i = 0; i < n; ++i) {
                 mi::base::Handle<const IValue> element( value_compound->get_value( i));
@@ -1325,6 +1561,15 @@ mi::Sint32 Value_factory::compare_static( const IValue* lhs, const IValue* rhs,
             mi::Size rhs_size = rhs_compound->get_size();
             if( lhs_size < rhs_size) return -1; // for deferred-sized arrays
             if( lhs_size > rhs_size) return +1; // for deferred-sized arrays
+            if( kind == IValue::VK_ARRAY) {
+                mi::base::Handle<const IValue_array> lhs_array(
+                    lhs->get_interface<IValue_array>());
+                mi::base::Handle<const IValue_array> rhs_array(
+                    rhs->get_interface<IValue_array>());
+                mi::Sint32 result = 0;
+                if( compare_data( lhs_array.get(), rhs_array.get(), epsilon, result))
+                    return result;
+            }
             for( mi::Size i = 0; i < lhs_size; ++i) {
                 mi::base::Handle<const IValue> lhs_element(
                     lhs_compound->get_value( i));
@@ -1691,6 +1936,10 @@ void Value_factory::serialize( SERIAL::Serializer* serializer, const IValue* val
                 value->get_interface<IValue_compound>());
             mi::Size n = value_compound->get_size();
             SERIAL::write( serializer, n);
+            mi::base::Handle<const IValue_array> value_array(
+                value->get_interface<IValue_array>());
+            if( serialize_data( serializer, value_array.get()))
+                return;
             for( mi::Size i = 0; i < n; ++i) {
                 mi::base::Handle<const IValue> element( value_compound->get_value( i));
                 serialize( serializer, element.get());
@@ -1842,6 +2091,8 @@ IValue* Value_factory::deserialize( SERIAL::Deserializer* deserializer) const
             mi::Size n;
             SERIAL::read( deserializer, &n);
             result->set_size( n); //-V522 PVS
+            if( deserialize_data( deserializer, result))
+                return result;
             for( mi::Size i = 0; i < n; ++i) {
                 mi::base::Handle<IValue> element( deserialize( deserializer));
                 result->set_value( i, element.get()); //-V522 PVS
@@ -36,6 +36,9 @@
 
 #include "i_mdl_elements_value.h"
 
+#include <atomic>
+#include <cstring>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <base/lib/log/i_log_assert.h>
@@ -267,12 +270,18 @@ private:
 };
 
 
+/// Arrays of bool, int, float, and double elements are stored in packed form in a contiguous
+/// buffer as long as no element value has been handed out. The element accessors (both variants
+/// of get_value(), and set_value()) convert the array permanently into the unpacked
+/// representation (an array of element values), such that they have the same reference semantics
+/// as for all other arrays. The bulk accessors get_data() and set_data() never hand out element
+/// values and work on either representation.
 class Value_array : public Value_base<IValue_array, IType_array>
 {
 public:
     Value_array( const Type* type, const IValue_factory* value_factory);
 
-    mi::Size get_size() const { return m_values.size(); }
+    mi::Size get_size() const { return m_size; }
 
     const IValue* get_value( mi::Size index) const;
 
@@ -284,10 +293,101 @@ public:
 
     mi::Sint32 set_size( mi::Size size);
 
+    mi::Sint32 get_data( bool* values, mi::Size count) const
+    { return get_data_impl<IValue_bool>( IType::TK_BOOL, values, count); }
+
+    mi::Sint32 get_data( mi::Sint32* values, mi::Size count) const
+    { return get_data_impl<IValue_int>( IType::TK_INT, values, count); }
+
+    mi::Sint32 get_data( mi::Float32* values, mi::Size count) const
+    { return get_data_impl<IValue_float>( IType::TK_FLOAT, values, count); }
+
+    mi::Sint32 get_data( mi::Float64* values, mi::Size count) const
+    { return get_data_impl<IValue_double>( IType::TK_DOUBLE, values, count); }
+
+    mi::Sint32 set_data( const bool* values, mi::Size count)
+    { return set_data_impl<IValue_bool>( IType::TK_BOOL, values, count); }
+
+    mi::Sint32 set_data( const mi::Sint32* values, mi::Size count)
+    { return set_data_impl<IValue_int>( IType::TK_INT, values, count); }
+
+    mi::Sint32 set_data( const mi::Float32* values, mi::Size count)
+    { return set_data_impl<IValue_float>( IType::TK_FLOAT, values, count); }
+
+    mi::Sint32 set_data( const mi::Float64* values, mi::Size count)
+    { return set_data_impl<IValue_double>( IType::TK_DOUBLE, values, count); }
+
     mi::Size get_memory_consumption() const;
 
 private:
-    std::vector<mi::base::Handle<IValue> > m_values;
+    /// Indicates whether the elements are stored in #m_data (or in #m_values).
+    bool is_packed() const { return m_packed.load( std::memory_order_acquire); }
+
+    /// Creates an element value for the packed element at \p index.
+    IValue* create_packed_element( mi::Size index) const;
+
+    /// Converts the packed representation into the unpacked one.
+    ///
+    /// Might be called concurrently from const methods. Therefore, #m_data is kept for
+    /// concurrent readers that still see the packed representation, see #release_data().
+    void unpack() const;
+
+    /// Releases #m_data after the conversion into the unpacked representation. Only to be called
+    /// from non-const methods.
+    void release_data();
+
+    template <class V, class T>
+    mi::Sint32 get_data_impl( IType::Kind kind, T* values, mi::Size count) const
+    {
+        if( !values)
+            return -1;
+        if( count != m_size)
+            return -2;
+        if( kind != m_element_kind)
+            return -3;
+        if( is_packed()) {
+            if( count > 0)
+                memcpy( values, m_data.data(), count * sizeof( T));
+            return 0;
+        }
+        for( mi::Size i = 0; i < count; ++i) {
+            mi::base::Handle<const V> element( m_values[i]->template get_interface<V>());
+            values[i] = element->get_value();
+        }
+        return 0;
+    }
+
+    template <class V, class T>
+    mi::Sint32 set_data_impl( IType::Kind kind, const T* values, mi::Size count)
+    {
+        if( !values)
+            return -1;
+        if( count != m_size)
+            return -2;
+        if( kind != m_element_kind)
+            return -3;
+        if( is_packed()) {
+            if( count > 0)
+                memcpy( m_data.data(), values, count * sizeof( T));
+            return 0;
+        }
+        // Update the element values in place such that element values handed out before see
+        // the new values.
+        release_data();
+        for( mi::Size i = 0; i < count; ++i) {
+            mi::base::Handle<V> element( m_values[i]->template get_interface<V>());
+            element->set_value( values[i]);
+        }
+        return 0;
+    }
+
+    mi::Size m_size = 0;
+    mutable std::vector<mi::base::Handle<IValue> > m_values;
+    IType::Kind m_element_kind;
+    mi::Size m_element_size = 0;
+    std::vector<mi::Uint8> m_data;
+    mutable std::atomic<bool> m_packed;
+    mutable std::mutex m_unpack_mutex;
     mi::base::Handle<const IValue_factory> m_value_factory;
 };
 
@@ -39,6 +39,7 @@
 #include <base/system/test/i_test_auto_case.h>
 
 #include <tuple>
+#include <vector>
 
 #include "i_mdl_elements_compiled_material.h"
 #include "i_mdl_elements_function_call.h"
@@ -66,7 +67,12 @@
 #include <base/data/db/i_db_database.h>
 #include <base/data/db/i_db_scope.h>
 #include <base/data/db/i_db_transaction.h>
+#include <mdl/codegenerators/generator_dag/generator_dag_ir.h>
+#include <mdl/codegenerators/generator_dag/generator_dag_unit.h>
 #include <mdl/compiler/compilercore/compilercore_comparator.h>
+#include <mdl/compiler/compilercore/compilercore_mdl.h>
+#include <mdl/compiler/compilercore/compilercore_tools.h>
+#include <mdl/integration/mdlnr/i_mdlnr.h>
 #include <io/image/image/i_image.h>
 #include <io/scene/bsdf_measurement/i_bsdf_measurement.h>
 #include <io/scene/dbimage/i_dbimage.h>
@@ -412,6 +418,48 @@ void get_hash_values(
     hash_cc = cm_cc->get_hash();
 }
 
+// Check that hashing the material slots on several threads yields the serial hashes.
+void test_parallel_instance_hashes(
+    DB::Transaction* transaction, MDL::Execution_context* context)
+{
+    SYSTEM::Access_module<MDLC::Mdlc_module> mdlc_module( false);
+    mi::base::Handle<mi::mdl::IMDL> mdl( mdlc_module->get_mdl());
+    mi::mdl::Options& options = mdl->access_options();
+
+    const char* names[] = {
+        "mdl::mdl_elements::test_misc::mi_body",
+        "mdl::mdl_elements::test_misc::mi_array_literal"
+    };
+
+    for( const char* name : names) {
+        DB::Tag tag = transaction->name_to_tag( name);
+        DB::Access<MDL::Mdl_function_call> mi( tag, transaction);
+
+        for( bool class_compilation : { false, true }) {
+
+            std::vector<mi::base::Uuid> hashes[2];
+            for( int parallel = 0; parallel < 2; ++parallel) {
+
+                // threshold 0 forces the parallel path for these small instances
+                options.set_option( MDL_OPTION_INSTANCE_HASH_THREADS, parallel ? "4" : "1");
+                options.set_option( MDL_OPTION_INSTANCE_HASH_THRESHOLD, parallel ? "0" : "16384");
+
+                std::unique_ptr<MDL::Mdl_compiled_material> cm( mi->create_compiled_material(
+                    transaction, class_compilation, /*target_type*/ nullptr, context));
+                MI_CHECK( cm);
+                hashes[parallel].push_back( cm->get_hash());
+                for( int slot = mi::neuraylib::SLOT_FIRST; slot <= mi::neuraylib::SLOT_LAST; ++slot)
+                    hashes[parallel].push_back(
+                        cm->get_slot_hash( static_cast<mi::neuraylib::Material_slot>( slot)));
+            }
+            MI_CHECK( hashes[0] == hashes[1]);
+        }
+    }
+
+    options.set_option( MDL_OPTION_INSTANCE_HASH_THREADS, "1");
+    options.set_option( MDL_OPTION_INSTANCE_HASH_THRESHOLD, "16384");
+}
+
 // Check that gamma changes of texture are taken into account for hashes (MDL file path still
 // valid).
 void test_resources_and_hashes_edit_gamma(
@@ -2171,6 +2219,8 @@ void test_main( DB::Scope* global_scope)
     test_resources_and_hashes_modify_texture( transaction, &context);
     test_resources_and_hashes_modify_image( transaction, &context);
 
+    test_parallel_instance_hashes( transaction, &context);
+
     test_module_names( transaction, &context);
 
     SYSTEM::Access_module<PATH::Path_module> path_module( false);
@@ -2325,6 +2375,145 @@ void test_resource_maps( DB::Scope* global_scope, bool resolve_resources)
     transaction->commit();
 }
 
+void test_deferred_resources( DB::Scope* global_scope)
+{
+    // Separate scope to avoid interactions with the resources loaded by test_resource_maps().
+
+    DB::Scope* child_scope = global_scope->create_child( 1);
+    DB::Transaction* transaction = child_scope->start_transaction();
+
+    MDL::Execution_context context;
+    context.set_option( MDL_CTX_OPTION_DEFER_RESOURCE_RESOLUTION, true);
+
+    mi::Sint32 result = MDL::Mdl_module::create_module(
+        transaction, "::mdl_elements::test_resource_maps", &context);
+    MI_CHECK_EQUAL( 0, result);
+
+    // The module itself looks like a module loaded without resolving resources.
+    DB::Tag module_tag = transaction->name_to_tag( "mdl::mdl_elements::test_resource_maps");
+    DB::Access<MDL::Mdl_module> module( module_tag, transaction);
+    MI_CHECK( module->has_deferred_resources());
+    check_resource_map( module.get_ptr(), /*resolve_resources*/ false);
+
+    DB::Tag fd_tag = transaction->name_to_tag(
+        "mdl::mdl_elements::test_resource_maps::test_resources(texture_2d,texture_2d)");
+    DB::Access<MDL::Mdl_function_definition> fd( fd_tag, transaction);
+
+    std::unique_ptr<MDL::Mdl_function_call> fc(
+        fd->create_function_call( transaction, /*arguments*/ nullptr));
+
+    // Compiled materials resolve the resources they use, including those in non-inlined calls.
+    for( bool class_compilation : { false, true}) {
+        std::unique_ptr<MDL::Mdl_compiled_material> cm( fc->create_compiled_material(
+            transaction, class_compilation, /*target_type*/ nullptr, &context));
+        MI_CHECK( cm);
+        mi::Size n = cm->get_resources_count();
+        MI_CHECK( n > 0);
+        for( mi::Size i = 0; i < n; ++i) {
+            const MDL::Resource_tag_tuple* rtt = cm->get_resource_tag_tuple( i);
+            MI_CHECK( rtt->m_tag.is_valid());
+        }
+    }
+
+    // Resource attributes of deferred resources are not folded as invalid resources in instance
+    // compilation mode.
+    DB::Tag fd2_tag = transaction->name_to_tag(
+        "mdl::mdl_elements::test_resource_maps::test_texture_isvalid()");
+    DB::Access<MDL::Mdl_function_definition> fd2( fd2_tag, transaction);
+
+    std::unique_ptr<MDL::Mdl_function_call> fc2(
+        fd2->create_function_call( transaction, /*arguments*/ nullptr));
+    std::unique_ptr<MDL::Mdl_compiled_material> cm( fc2->create_compiled_material(
+        transaction, /*class_compilation*/ false, /*target_type*/ nullptr, &context));
+    MI_CHECK( cm);
+
+    mi::base::Handle<const MDL::IExpression> thin_walled(
+        cm->lookup_sub_expression( transaction, "thin_walled"));
+    MI_CHECK( thin_walled);
+    mi::base::Handle<const MDL::IExpression_direct_call> call(
+        thin_walled->get_interface<MDL::IExpression_direct_call>());
+    MI_CHECK( call);
+    MI_CHECK_EQUAL_CSTR( call->get_definition_db_name(), "mdl::tex::texture_isvalid(texture_2d)");
+
+    for( mi::Size i = 0, n = cm->get_resources_count(); i < n; ++i) {
+        const MDL::Resource_tag_tuple* rtt = cm->get_resource_tag_tuple( i);
+        MI_CHECK( rtt->m_tag.is_valid());
+    }
+
+    transaction->commit();
+}
+
+/// A call evaluator that folds math::sin() to a configurable value, and counts its invocations.
+class Test_call_evaluator : public mi::mdl::ICall_evaluator
+{
+public:
+    bool is_evaluate_intrinsic_function_enabled(
+        mi::mdl::IDefinition::Semantics sema) const override
+    {
+        return sema == mi::mdl::IDefinition::DS_INTRINSIC_MATH_SIN;
+    }
+
+    const mi::mdl::IValue* evaluate_intrinsic_function(
+        mi::mdl::IValue_factory* value_factory,
+        mi::mdl::IDefinition::Semantics sema,
+        const mi::mdl::IValue* const arguments[],
+        size_t n_arguments) const override
+    {
+        ++m_calls;
+        if( sema != mi::mdl::IDefinition::DS_INTRINSIC_MATH_SIN)
+            return value_factory->create_bad();
+        return value_factory->create_float( m_result);
+    }
+
+    float m_result = 0.0f;
+    mutable int m_calls = 0;
+};
+
+void test_fold_cache()
+{
+    SYSTEM::Access_module<MDLC::Mdlc_module> mdlc_module( false);
+    mi::base::Handle<mi::mdl::IMDL> mdl( mdlc_module->get_mdl());
+    mi::mdl::MDL* mdl_impl = mi::mdl::impl_cast<mi::mdl::MDL>( mdl.get());
+
+    mi::mdl::DAG_unit unit( mdl_impl, /*enable_debug_info*/ false);
+    mi::mdl::DAG_node_factory_impl factory( mdl_impl, unit, "coordinate_world");
+    mi::mdl::Value_factory& vf = unit.get_value_factory();
+
+    const mi::mdl::IValue* args[] = { vf.create_float( 1.0f) };
+    const auto sema = mi::mdl::IDefinition::DS_INTRINSIC_MATH_SIN;
+
+    Test_call_evaluator evaluator;
+    evaluator.m_result = 2.0f;
+    factory.set_call_evaluator( &evaluator);
+
+    // Repeated folds of the same call are memoized.
+    const mi::mdl::IValue* r1 = factory.evaluate_intrinsic_function( sema, args, 1);
+    const mi::mdl::IValue* r2 = factory.evaluate_intrinsic_function( sema, args, 1);
+    MI_CHECK( r1);
+    MI_CHECK_EQUAL( r1, r2);
+    MI_CHECK_EQUAL( 2.0f, mi::mdl::as<mi::mdl::IValue_float>( r1)->get_value());
+    MI_CHECK_EQUAL( 1, evaluator.m_calls);
+    MI_CHECK_EQUAL( 1, factory.get_fold_cache_size());
+
+    // Setting the same evaluator again after its state changed must not return stale results.
+    evaluator.m_result = 3.0f;
+    factory.set_call_evaluator( &evaluator);
+    MI_CHECK_EQUAL( 0, factory.get_fold_cache_size());
+    const mi::mdl::IValue* r3 = factory.evaluate_intrinsic_function( sema, args, 1);
+    MI_CHECK( r3);
+    MI_CHECK_EQUAL( 3.0f, mi::mdl::as<mi::mdl::IValue_float>( r3)->get_value());
+    MI_CHECK_EQUAL( 2, evaluator.m_calls);
+
+    // Changing the fold settings invalidates the memoized results, too.
+    factory.enable_wavelength_fold( 400.0f, 700.0f);
+    MI_CHECK_EQUAL( 0, factory.get_fold_cache_size());
+    factory.evaluate_intrinsic_function( sema, args, 1);
+    factory.enable_unit_conv_fold( 1.0f);
+    MI_CHECK_EQUAL( 0, factory.get_fold_cache_size());
+
+    factory.set_call_evaluator( nullptr);
+}
+
 void test_multithreading( DB::Database* database, DB::Scope* global_scope)
 {
     DB::Scope* scope = global_scope->create_child( 1);
@@ -2367,11 +2556,15 @@ MI_TEST_AUTO_FUNCTION( test )
 
     test_main( scope);
 
+    test_fold_cache();
+
     test_unresolved_resources( scope);
 
     test_resource_maps( scope, /*resolve_resources*/ true);
     test_resource_maps( scope, /*resolve_resources*/ false);
 
+    test_deferred_resources( scope);
+
     test_multithreading( database, scope);
 }
 
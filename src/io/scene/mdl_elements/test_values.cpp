@@ -545,6 +545,101 @@ void test_deferred_sized_array()
     check_list( vf, arv.get());
 }
 
+void test_packed_array()
+{
+    Type_factory tf;
+    mi::base::Handle<const IType_float> f( tf.create_float());
+    mi::base::Handle<const IType_array> ar(
+        tf.create_deferred_sized_array( f.get(), "N"));
+
+    Value_factory vf( &tf);
+    mi::base::Handle<IValue_array> arv( vf.create_array( ar.get()));
+    MI_CHECK_EQUAL( 0, arv->set_size( 1000));
+
+    std::vector<mi::Float32> data( 1000);
+    for( mi::Size i = 0; i < data.size(); ++i)
+        data[i] = 0.5f * static_cast<mi::Float32>( i);
+
+    // error cases
+    mi::Sint32 ints[1000];
+    MI_CHECK_EQUAL( -1, arv->set_data( static_cast<const mi::Float32*>( nullptr), 1000));
+    MI_CHECK_EQUAL( -2, arv->set_data( data.data(), 999));
+    MI_CHECK_EQUAL( -3, arv->set_data( ints, 1000));
+    MI_CHECK_EQUAL( -3, arv->get_data( ints, 1000));
+
+    // bulk access, serialization, and cloning of the packed representation
+    MI_CHECK_EQUAL( 0, arv->set_data( data.data(), data.size()));
+    arv = serialize_and_deserialize( vf, arv.get());
+    MI_CHECK_EQUAL( arv->get_size(), 1000);
+    std::vector<mi::Float32> result( 1000);
+    MI_CHECK_EQUAL( 0, arv->get_data( result.data(), result.size()));
+    MI_CHECK( result == data);
+
+    // const get_value() hands out the stored element, later bulk updates are visible via it
+    mi::base::Handle<const IValue_array> carv( arv);
+    mi::base::Handle<const IValue_float> cfv( carv->get_value<IValue_float>( 42));
+    MI_CHECK_EQUAL( cfv->get_value(), 21.0f);
+    mi::base::Handle<const IValue_float> cfv2( carv->get_value<IValue_float>( 42));
+    MI_CHECK_EQUAL( cfv.get(), cfv2.get());
+    result = data;
+    result[42] = 5.0f;
+    MI_CHECK_EQUAL( 0, arv->set_data( result.data(), result.size()));
+    MI_CHECK_EQUAL( cfv->get_value(), 5.0f);
+
+    // set_value() stores a reference to the element
+    mi::base::Handle<IValue_float> fv( vf.create_float( 1.0f));
+    MI_CHECK_EQUAL( 0, arv->set_value( 42, fv.get()));
+    fv->set_value( 2.0f);
+    cfv = carv->get_value<IValue_float>( 42);
+    MI_CHECK_EQUAL( cfv.get(), fv.get());
+    MI_CHECK_EQUAL( 0, arv->get_data( result.data(), result.size()));
+    MI_CHECK_EQUAL( result[42], 2.0f);
+
+    // set_data() updates elements passed to set_value() and obtained via mutable get_value()
+    mi::base::Handle<IValue_float> fv2( arv->get_value<IValue_float>( 43));
+    fv2->set_value( 3.0f);
+    MI_CHECK_EQUAL( 0, arv->get_data( result.data(), result.size()));
+    MI_CHECK_EQUAL( result[43], 3.0f);
+    MI_CHECK_EQUAL( 0, arv->set_data( data.data(), data.size()));
+    MI_CHECK_EQUAL( fv->get_value(), 21.0f);
+    MI_CHECK_EQUAL( fv2->get_value(), 21.5f);
+
+    // element accessors on a fresh packed array (clone) have the same semantics
+    mi::base::Handle<IValue_array> arv3( vf.clone( arv.get()));
+    mi::base::Handle<IValue_float> fv3( vf.create_float( 7.0f));
+    MI_CHECK_EQUAL( 0, arv3->set_value( 0, fv3.get()));
+    fv3->set_value( 8.0f);
+    cfv = arv3->get_value<IValue_float>( 0);
+    MI_CHECK_EQUAL( cfv->get_value(), 8.0f);
+    MI_CHECK_EQUAL( 0, arv3->get_data( result.data(), result.size()));
+    MI_CHECK_EQUAL( result[0], 8.0f);
+    MI_CHECK_EQUAL( result[1], 0.5f);
+
+    // comparison of packed and unpacked representation
+    mi::base::Handle<IValue_array> arv2( vf.clone( arv.get()));
+    MI_CHECK_EQUAL( 0, vf.compare( arv.get(), arv2.get()));
+    result = data;
+    result[999] += 1.0f;
+    MI_CHECK_EQUAL( 0, arv2->set_data( result.data(), result.size()));
+    MI_CHECK_EQUAL( -1, vf.compare( arv.get(), arv2.get()));
+    MI_CHECK_EQUAL( 0, vf.compare( arv.get(), arv2.get(), 2.0));
+
+    // bool arrays
+    mi::base::Handle<const IType_bool> b( tf.create_bool());
+    mi::base::Handle<const IType_array> bar(
+        tf.create_immediate_sized_array( b.get(), 3));
+    mi::base::Handle<IValue_array> barv( vf.create_array( bar.get()));
+    bool bools[3] = { true, false, true };
+    MI_CHECK_EQUAL( 0, barv->set_data( bools, 3));
+    barv = serialize_and_deserialize( vf, barv.get());
+    check_dump( /*transaction*/ nullptr, vf, barv.get(),
+        "bool[3] foo = [\n"
+        "    bool 0 = true;\n"
+        "    bool 1 = false;\n"
+        "    bool 2 = true;\n"
+        "]");
+}
+
 void test_struct()
 {
     Type_factory tf;
@@ -1061,6 +1156,7 @@ MI_TEST_AUTO_FUNCTION( test )
 
     test_immediate_sized_array();
     test_deferred_sized_array();
+    test_packed_array();
     test_struct();
 
     test_texture( transaction);
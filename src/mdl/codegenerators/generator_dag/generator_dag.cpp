@@ -32,6 +32,8 @@
 
 #include <mdl/compiler/compilercore/compilercore_checker.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
 #include "generator_dag.h"
 #include "generator_dag_generated_dag.h"
 #include "generator_dag_tools.h"
@@ -266,6 +268,8 @@ char const *Code_generator_dag::get_target_language() const
 
 IGenerated_code_dag *Code_generator_dag::compile(IModule const *imod)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_DAG_BUILD);
+
     Module const *module = impl_cast<Module>(imod);
 
     Generated_code_dag::Compile_options options = 0;
@@ -43,7 +43,12 @@
 
 #include <mdl/codegenerators/generator_code/generator_code.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <thread>
 
 #include "generator_dag_generated_dag.h"
 #include "generator_dag_walker.h"
@@ -3706,6 +3711,8 @@ Generated_code_dag::Error_code Generated_code_dag::Material_instance::initialize
     size_t                    num_fold_params,
     IType const               *target_type)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_INSTANCE_COMPILE);
+
 #if 0
     {
         char buffer[64];
@@ -5355,10 +5362,59 @@ void Generated_code_dag::Material_instance::calc_hashes()
         md5_hasher.final(m_hash.data());
     } else {
         // normal mode: we have slot hashes
+        DAG_node const *roots[MS_LAST + 1];
         for (int i = 0; i <= MS_LAST; ++i) {
-            dag_hasher.hash_instance_slot(this, Slot(i));
+            // might create nodes, so do it before any parallel work
+            roots[i] = Dag_hasher::get_instance_slot_root(this, Slot(i));
+        }
 
-            md5_hasher.final(m_slot_hashes[i].data());
+        // parallel hashing is experimental and off by default (no measured default exists), the
+        // compiler options enable it for instances with at least threshold nodes
+        int max_threads = m_mdl->get_compiler_int_option(
+            /*ctx=*/NULL, MDL::option_instance_hash_threads, 1);
+        int threshold   = m_mdl->get_compiler_int_option(
+            /*ctx=*/NULL, MDL::option_instance_hash_threshold, 16384);
+
+        size_t n_threads = 1;
+        if (max_threads > 1 && m_node_factory.get_next_id() >= size_t(std::max(threshold, 0))) {
+            n_threads = std::min<size_t>(size_t(max_threads), MS_LAST + 1);
+        }
+
+        if (n_threads <= 1) {
+            for (int i = 0; i <= MS_LAST; ++i) {
+                dag_hasher.hash_dag(roots[i]);
+
+                md5_hasher.final(m_slot_hashes[i].data());
+            }
+        } else {
+            // The slots are hashed independently, only reading the DAG. The parameter names
+            // fed above belong to the first slot, so the result is identical to the serial one.
+            IAllocator       *alloc       = get_allocator();
+            DAG_hash         *slot_hashes = m_slot_hashes;
+            std::atomic<int> next_slot(1);
+
+            auto worker = [alloc, &next_slot, &roots, slot_hashes]() {
+                for (int i = next_slot++; i <= MS_LAST; i = next_slot++) {
+                    MD5_hasher slot_hasher;
+                    Dag_hasher slot_dag_hasher(alloc, slot_hasher);
+
+                    slot_dag_hasher.hash_dag(roots[i]);
+                    slot_hasher.final(slot_hashes[i].data());
+                }
+            };
+
+            std::thread threads[MS_LAST];
+            for (size_t t = 1; t < n_threads; ++t) {
+                threads[t - 1] = std::thread(worker);
+            }
+
+            dag_hasher.hash_dag(roots[0]);
+            md5_hasher.final(m_slot_hashes[0].data());
+            worker();
+
+            for (size_t t = 1; t < n_threads; ++t) {
+                threads[t - 1].join();
+            }
         }
 
         for (int i = 0; i <= MS_LAST; ++i) {
@@ -5611,7 +5667,7 @@ size_t Generated_code_dag::Material_instance::get_memory_size() const
 {
     size_t res = sizeof(*this);
 
-    res += m_dag_unit.get_arena().get_chunks_size();
+    res += dynamic_memory_consumption(m_dag_unit.get_arena());
     res += dynamic_memory_consumption(m_messages);
 
     res += dynamic_memory_consumption(m_temporaries);
@@ -5656,12 +5712,45 @@ void Generated_code_dag::Material_instance::set_resource_tag(
     int old_tag = find_resource_tag(res);
 
     if (old_tag == 0) {
-        add_resource_tag(res, tag);
+        // resources of modules loaded without resolving them are already in the map
+        // (copied from the code DAG), but with tag zero: update those entries in place
+        if (!update_unresolved_resource_tag(res, tag)) {
+            add_resource_tag(res, tag);
+        }
     } else {
         MDL_ASSERT(old_tag == tag && "trying to overwrite a set tag value");
     }
 }
 
+// Updates the tag of an unresolved resource map entry.
+bool Generated_code_dag::Material_instance::update_unresolved_resource_tag(
+    IValue_resource const *res,
+    int                   tag)
+{
+    Resource_tag_tuple::Kind kind = kind_from_value(res);
+    char const *url = res->get_string_value();
+    char const *sel = "";
+
+    if (IValue_texture const *tex = as<IValue_texture>(res)) {
+        sel = tex->get_selector();
+    }
+
+    bool found = false;
+    for (size_t i = 0, n = m_resource_tag_map.size(); i < n; ++i) {
+        Resource_tag_tuple &e = m_resource_tag_map[i];
+
+        if (e.m_tag == 0 &&
+            e.m_kind == kind &&
+            strcmp(e.m_url,      url) == 0 &&
+            strcmp(e.m_selector, sel) == 0)
+        {
+            e.m_tag = tag;
+            found = true;
+        }
+    }
+    return found;
+}
+
 // Get the number of resource map entries.
 size_t Generated_code_dag::Material_instance::get_resource_tag_map_entries_count() const
 {
@@ -7572,7 +7661,7 @@ size_t Generated_code_dag::get_memory_size() const
 {
     size_t res = sizeof(*this);
 
-    res += m_dag_unit.get_arena().get_chunks_size();
+    res += dynamic_memory_consumption(m_dag_unit.get_arena());
     res += dynamic_memory_consumption(m_messages);
     res += dynamic_memory_consumption(m_module_imports);
 
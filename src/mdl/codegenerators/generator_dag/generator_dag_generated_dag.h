@@ -1128,6 +1128,16 @@ public:
             IValue_resource const *res,
             int                   tag);
 
+        /// Updates the tag of all map entries of a given resource that have no tag yet.
+        ///
+        /// \param res  the resource
+        /// \param tag  the tag value
+        ///
+        /// \return true if at least one entry was updated
+        bool update_unresolved_resource_tag(
+            IValue_resource const *res,
+            int                   tag);
+
         /// Possible options for the cloning.
         enum Clone_flag {
             CF_DEFAULT     = 0x00,  ///< default flags
@@ -232,13 +232,24 @@ public:
     /// Get the name hash.
     size_t get_name_hash() const MDL_FINAL { return m_name_hash; }
 
+    /// Replace the name and the parameter names by their internalized copies.
+    ///
+    /// \param strings  the table internalizing the names
+    void internalize_names(Shared_string_table &strings)
+    {
+        m_name = strings.internalize(m_name);
+        for (size_t i = 0, n = m_parameter_names.size(); i < n; ++i) {
+            m_parameter_names[i] = strings.internalize(m_parameter_names[i]);
+        }
+    }
+
 private:
     /// Constructor.
     ///
     /// \param id              The unique ID of this node.
     /// \param dbg_info        The debug info for this node if any.
-    /// \param arena           The memory arena use to store parameter names.
-    /// \param name            The name of the called function.
+    /// \param arena           The memory arena use to store the argument lists.
+    /// \param name            The name of the called function, not copied.
     /// \param sema            The semantic of the called function.
     /// \param call_args       The call arguments of the called function.
     /// \param num_call_args   The number of call arguments.
@@ -265,9 +276,8 @@ private:
         m_arguments.resize(num_call_args, NULL);
 
         for (size_t i = 0; i < num_call_args; ++i) {
-            // FIXME: for now, put the string on the arena
-            char *n = Arena_strdup(*arena, call_args[i].param_name);
-            m_parameter_names[i] = n;
+            // not copied, internalize_names() is called before this node is used
+            m_parameter_names[i] = call_args[i].param_name;
             m_arguments[i]       = call_args[i].arg;
         }
 
@@ -282,7 +292,7 @@ private:
     IType const *m_ret_type;
 
     /// The name of the function.
-    char const * const m_name;
+    char const *m_name;
 
     /// The name hash value.
     size_t m_name_hash;
@@ -440,7 +450,8 @@ bool DAG_node_factory_impl::Equal_dag_node::operator()(
                 return false;
             }
 
-            if (strcmp(ca->get_name(), cb->get_name()) != 0) {
+            // names of remembered calls are internalized, but a new call's are not yet
+            if (ca->get_name() != cb->get_name() && strcmp(ca->get_name(), cb->get_name()) != 0) {
                 return false;
             }
 
@@ -477,6 +488,7 @@ DAG_node_factory_impl::DAG_node_factory_impl(
 : m_builder(unit.get_arena())
 , m_mdl(mi::base::make_handle_dup(mdl))
 , m_dag_unit(unit)
+, m_shared_strings(impl_cast<MDL>(mdl)->get_shared_string_table())
 , m_internal_space(Arena_strdup(unit.get_arena(), internal_space))
 , m_call_evaluator(NULL)
 , m_next_id(0)
@@ -504,6 +516,11 @@ DAG_node_factory_impl::DAG_node_factory_impl(
     Value_table::hasher(m_temp_name_map),
     Value_table::key_equal(m_temp_name_map),
     unit.get_arena().get_allocator())
+, m_fold_cache(
+    0,
+    Fold_cache::hasher(),
+    Fold_cache::key_equal(),
+    unit.get_arena().get_allocator())
 {
 }
 
@@ -3688,11 +3705,73 @@ IValue const *DAG_node_factory_impl::evaluate_constructor(
     return NULL;
 }
 
+// Hash a Fold_key.
+size_t DAG_node_factory_impl::Hash_fold_key::operator()(Fold_key const &key) const
+{
+    size_t hash = size_t(key.sema) * 9 + key.n_args;
+    for (size_t i = 0; i < key.n_args; ++i) {
+        hash = hash * 3 ^ Hash_ptr<IValue>()(key.args[i]);
+    }
+    return hash;
+}
+
+// Compare two Fold_keys.
+bool DAG_node_factory_impl::Equal_fold_key::operator()(
+    Fold_key const &a,
+    Fold_key const &b) const
+{
+    if (a.sema != b.sema || a.n_args != b.n_args) {
+        return false;
+    }
+    for (size_t i = 0; i < a.n_args; ++i) {
+        if (a.args[i] != b.args[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Set the current call evaluator.
+void DAG_node_factory_impl::set_call_evaluator(ICall_evaluator *evaluator)
+{
+    // the results depend on the state of the evaluator (e.g. its transaction and the resources
+    // visible to it), which might have changed even if the same evaluator is set again
+    clear_fold_cache();
+    m_call_evaluator = evaluator;
+}
+
 // Evaluate an intrinsic function call.
 IValue const *DAG_node_factory_impl::evaluate_intrinsic_function(
     IDefinition::Semantics sema,
     IValue const * const   arguments[],
     size_t                 n_args) const
+{
+    if (sema == IDefinition::DS_UNKNOWN) {
+        return NULL;
+    }
+
+    // the same uniform computation is often folded several times, for instance if it is
+    // used by several arguments of a material, so remember the results
+    Fold_key key = { sema, n_args, arguments };
+    Fold_cache::const_iterator it = m_fold_cache.find(key);
+    if (it != m_fold_cache.end()) {
+        return it->second;
+    }
+
+    IValue const *res = evaluate_intrinsic_function_uncached(sema, arguments, n_args);
+
+    Memory_arena &arena = m_dag_unit.get_arena();
+    key.args = static_cast<IValue const * const *>(
+        Arena_memdup(arena, arguments, n_args * sizeof(arguments[0])));
+    m_fold_cache[key] = res;
+    return res;
+}
+
+// Evaluate an intrinsic function call without consulting the fold cache.
+IValue const *DAG_node_factory_impl::evaluate_intrinsic_function_uncached(
+    IDefinition::Semantics sema,
+    IValue const * const   arguments[],
+    size_t                 n_args) const
 {
     switch (sema) {
     case IDefinition::DS_UNKNOWN:
@@ -3744,6 +3823,7 @@ void DAG_node_factory_impl::enable_unit_conv_fold(float mdl_meters_per_scene_uni
 {
     m_enable_scene_conv_fold    = true;
     m_mdl_meters_per_scene_unit = mdl_meters_per_scene_unit;
+    clear_fold_cache();
 }
 
 // Enable the folding of state::wavelength_[min|max] functions.
@@ -3754,6 +3834,7 @@ void DAG_node_factory_impl::enable_wavelength_fold(
     m_enable_wavelength_fold = true;
     m_state_wavelength_min   = wavelength_min;
     m_state_wavelength_max   = wavelength_max;
+    clear_fold_cache();
 }
 
 
@@ -4934,11 +5015,14 @@ DAG_node *DAG_node_factory_impl::identify_remember(
     DAG_node *node)
 {
     if (!m_cse_enabled) {
+        internalize_names(node);
         return node;
     }
 
     Value_table::iterator it = m_value_table.find(node);
     if (it == m_value_table.end()) {
+        // only new nodes need the shared names, so hits do not lock the string table
+        internalize_names(node);
         m_value_table.insert(node);
         return node;
     }
@@ -4953,6 +5037,14 @@ DAG_node *DAG_node_factory_impl::identify_remember(
     return *it;
 }
 
+// Replace the names of a new call node by their internalized copies.
+void DAG_node_factory_impl::internalize_names(DAG_node *node)
+{
+    if (node->get_kind() == DAG_node::EK_CALL) {
+        static_cast<Call_impl *>(node)->internalize_names(m_shared_strings);
+    }
+}
+
 // Create a df::*_mix() call.
 DAG_node const *DAG_node_factory_impl::create_mix_call(
     char const             *name,
@@ -4988,12 +5080,12 @@ Call_impl *DAG_node_factory_impl::alloc_call(
     IType const                   *ret_type,
     DAG_DbgInfo                   dbg_info)
 {
-    ISymbol const *shared = m_dag_unit.get_shared_symbol(name);
+    // the names are internalized by identify_remember() if the node is new
     return m_builder.create<Call_impl>(
         m_next_id++,
         dbg_info,
         m_builder.get_arena(),
-        shared->get_name(),
+        name,
         sema,
         call_args,
         num_call_args,
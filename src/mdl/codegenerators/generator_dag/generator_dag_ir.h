@@ -45,6 +45,7 @@ class IMDL;
 class IType_df;
 class Value_factory;
 class IValue_matrix;
+class Shared_string_table;
 
 /// The node factory for DAG IR nodes.
 class DAG_node_factory_impl : public IGenerated_code_dag::DAG_node_factory
@@ -298,8 +299,17 @@ public:
 
     /// Set the current call evaluator.
     ///
+    /// Clears the memoized results of constant folded calls, even if \p evaluator is the current
+    /// call evaluator.
+    ///
     /// \param evaluator  the new call evaluator
-    void set_call_evaluator(ICall_evaluator *evaluator) { m_call_evaluator = evaluator; }
+    void set_call_evaluator(ICall_evaluator *evaluator);
+
+    /// Clear the memoized results of constant folded intrinsic function calls.
+    void clear_fold_cache() { m_fold_cache.clear(); }
+
+    /// Get the number of memoized results of constant folded intrinsic function calls.
+    size_t get_fold_cache_size() const { return m_fold_cache.size(); }
 
     /// Enable the folding of scene unit conversion functions.
     ///
@@ -363,6 +373,17 @@ public:
         DAG_constant const *c);
 
 private:
+    /// Evaluate an intrinsic function call without consulting the fold cache.
+    ///
+    /// \param sema                The semantic of the intrinsic function.
+    /// \param arguments           The arguments of the intrinsic function call.
+    /// \param n_args              The number of arguments
+    /// \returns                   The value returned by function call or NULL.
+    IValue const *evaluate_intrinsic_function_uncached(
+        IDefinition::Semantics sema,
+        IValue const * const   arguments[],
+        size_t                 n_args) const;
+
     /// Build a call to a conversion from a ::tex::gamma value to int.
     ///
     /// \param x         the value to convert
@@ -526,6 +547,11 @@ private:
     /// Returns node or an identical IR node.
     DAG_node *identify_remember(DAG_node *node);
 
+    /// Replace the names of a new call node by their internalized copies.
+    ///
+    /// \param node  the new node, if it is not a call, nothing is done
+    void internalize_names(DAG_node *node);
+
     /// Get the field index from a getter function call name.
     ///
     /// \param type       a compound type
@@ -582,6 +608,9 @@ private:
     /// The DAG unit to fill.
     DAG_unit &m_dag_unit;
 
+    /// The compiler wide table for call and parameter names.
+    Shared_string_table &m_shared_strings;
+
     /// The internal space for which to compile.
     char const *m_internal_space;
 
@@ -665,6 +694,35 @@ private:
 
     /// The Value table for common subexpression elimination.
     Value_table m_value_table;
+
+    /// The key of an intrinsic function call with constant arguments.
+    struct Fold_key {
+        IDefinition::Semantics sema;
+        size_t                 n_args;
+        IValue const * const   *args;
+    };
+
+    /// A hash functor for Fold_keys.
+    struct Hash_fold_key {
+        size_t operator()(Fold_key const &key) const;
+    };
+
+    /// An Equal functor for Fold_keys.
+    struct Equal_fold_key {
+        bool operator()(Fold_key const &a, Fold_key const &b) const;
+    };
+
+    typedef hash_map<
+        Fold_key,
+        IValue const *,
+        Hash_fold_key,
+        Equal_fold_key
+    >::Type Fold_cache;
+
+    /// Memoized results of constant folded intrinsic function calls. Values are owned by the
+    /// value factory of the DAG unit and hence unique, so the argument pointers identify the
+    /// arguments. A \c NULL result marks a call that could not be folded.
+    mutable Fold_cache m_fold_cache;
 };
 
 /// RAII scope "NO-CSE"
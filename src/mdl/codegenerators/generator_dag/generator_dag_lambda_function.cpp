@@ -338,6 +338,20 @@ DAG_unit const &Lambda_function::get_dag_unit() const
     return m_dag_unit;
 }
 
+// Returns the amount of used memory by this lambda function.
+size_t Lambda_function::get_memory_size() const
+{
+    size_t res = sizeof(*this);
+
+    res += dynamic_memory_consumption(m_dag_unit.get_arena());
+    res += m_roots.capacity() * sizeof(m_roots[0]);
+    res += m_params.capacity() * sizeof(m_params[0]);
+    res += dynamic_memory_consumption(m_name);
+
+    // the nodes and values are on the arena
+    return res;
+}
+
 // Get the type factory of this builder.
 Type_factory *Lambda_function::get_type_factory()
 {
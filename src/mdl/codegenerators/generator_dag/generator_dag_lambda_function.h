@@ -166,6 +166,9 @@ public:
     /// Get the DAG_unit of this lambda function.
     DAG_unit const &get_dag_unit() const MDL_FINAL;
 
+    /// Returns the amount of used memory by this lambda function.
+    size_t get_memory_size() const MDL_FINAL;
+
     /// Get the type factory of this function.
     Type_factory *get_type_factory() MDL_FINAL;
 
@@ -396,6 +396,14 @@ void Dag_hasher::hash_instance(
 void Dag_hasher::hash_instance_slot(
     Generated_code_dag::Material_instance       *instance,
     Generated_code_dag::Material_instance::Slot slot)
+{
+    hash_dag(get_instance_slot_root(instance, slot));
+}
+
+// Get the root node of an instance material slot.
+DAG_node const *Dag_hasher::get_instance_slot_root(
+    Generated_code_dag::Material_instance       *instance,
+    Generated_code_dag::Material_instance::Slot slot)
 {
     DAG_node const *node = NULL;
     IValue const   *v    = NULL;
@@ -499,10 +507,7 @@ void Dag_hasher::hash_instance_slot(
         // create a temporary Const node, so we can visit it.
         node = instance->create_temp_constant(v);
     }
-
-    m_node_counter = 0;
-    m_marker.clear();
-    do_hash_dag(node);
+    return node;
 }
 
 // Walk a DAG IR node.
@@ -170,6 +170,17 @@ public:
         Generated_code_dag::Material_instance       *instance,
         Generated_code_dag::Material_instance::Slot slot);
 
+    /// Get the root node of an instance material slot.
+    ///
+    /// \param instance   the instance
+    /// \param slot       the material slot
+    ///
+    /// \note If the slot was folded into a constant, a temporary constant is created in the
+    ///       instance, so this must not run concurrently with other node creations.
+    static DAG_node const *get_instance_slot_root(
+        Generated_code_dag::Material_instance       *instance,
+        Generated_code_dag::Material_instance::Slot slot);
+
     /// Hash a DAG IR staring at a given node.
     ///
     /// \param node  the root node
@@ -35,6 +35,8 @@
 
 #include <mi/mdl/mdl_translator_plugin.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
 #include "compilercore_cc_conf.h"
 #include "compilercore_mdl.h"
 #include "compilercore_allocator.h"
@@ -90,6 +92,8 @@ char const *MDL::option_state_wavelength_base_max     = MDL_OPTION_STATE_WAVELEN
 char const *MDL::option_user_data                     = MDL_OPTION_USER_DATA;
 char const *MDL::option_keep_original_resource_file_paths
                                                   = MDL_OPTION_KEEP_ORIGINAL_RESOURCE_FILE_PATHS;
+char const *MDL::option_instance_hash_threads         = MDL_OPTION_INSTANCE_HASH_THREADS;
+char const *MDL::option_instance_hash_threshold       = MDL_OPTION_INSTANCE_HASH_THRESHOLD;
 
 // forward
 class Jitted_code;
@@ -411,11 +415,13 @@ MDL::MDL(
     bool       mat_ior_is_varying)
 : Base(alloc)
 , m_builder(alloc)
+, m_chunk_pool_guard(alloc)
 , m_next_module_id(0)
 , m_mat_ior_is_varying(mat_ior_is_varying)
 , m_type_factory_is_valid(false)
 , m_arena(alloc)
 , m_sym_tab(m_arena)
+, m_shared_strings(alloc)
 , m_type_factory(m_arena, *this, m_sym_tab)
 , m_options(alloc)
 , m_builtin_module_indexes(0, Module_map::hasher(), Module_map::key_equal(), alloc)
@@ -1126,6 +1132,12 @@ void MDL::create_options()
 
     m_options.add_option(option_keep_original_resource_file_paths, "false",
         "Keep original resource file paths as is.");
+    m_options.add_option(option_instance_hash_threads, "1",
+        "The maximum number of threads hashing the material slots of a material instance "
+        "(experimental, off by default)");
+    m_options.add_option(option_instance_hash_threshold, "16384",
+        "The minimum number of DAG nodes of a material instance to hash it on several threads "
+        "(experimental, only used if " MDL_OPTION_INSTANCE_HASH_THREADS " is larger than 1)");
     m_options.add_interface_option(option_user_data,
         "User data interface passed to callbacks.");
 
@@ -1180,7 +1192,10 @@ Module *MDL::load_module(
         get_compiler_bool_option(ctx, option_experimental_features, false);
 
     parser.set_module(mod, enable_mdl_next, enable_experimental);
-    parser.Parse();
+    {
+        MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_MODULE_PARSE);
+        parser.Parse();
+    }
 
     mi::base::Handle<IArchive_input_stream> iarchvice_s(s->get_interface<IArchive_input_stream>());
     if (iarchvice_s.is_valid_interface()) {
@@ -1199,7 +1214,10 @@ Module *MDL::load_module(
         }
     }
 
-    mod->analyze(cache, ctx);
+    {
+        MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_MODULE_ANALYSIS);
+        mod->analyze(cache, ctx);
+    }
     return mod;
 }
 
@@ -1390,6 +1408,7 @@ Module const *MDL::compile_module(
                 cached_mod->release();
                 return NULL;
             }
+            MI::PROFILER::increment(MI::PROFILER::COUNTER_MODULE_CACHE_HITS);
             return cached_mod;
         } else if (cb.is_valid() && !cb.is_processing()) {
             // loading failed on different thread
@@ -1450,6 +1469,7 @@ Module const *MDL::compile_foreign_module(
                 cached_mod->release();
                 return NULL;
             }
+            MI::PROFILER::increment(MI::PROFILER::COUNTER_MODULE_CACHE_HITS);
             return cached_mod;
         } else if (cb.is_valid() && !cb.is_processing()) {
             // loading failed on different thread
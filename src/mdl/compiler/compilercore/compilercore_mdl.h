@@ -212,9 +212,18 @@ public:
     /// The name of the option to keep resource file paths as is.
     static char const *option_keep_original_resource_file_paths;
 
+    /// The maximum number of threads hashing the material slots of a material instance.
+    static char const *option_instance_hash_threads;
+
+    /// The minimum number of DAG nodes of a material instance to hash it on several threads.
+    static char const *option_instance_hash_threshold;
+
     /// Get the type factory.
     Type_factory *get_type_factory() const MDL_FINAL;
 
+    /// Get the thread safe string table shared by all DAG units of this compiler.
+    Shared_string_table &get_shared_string_table() const { return m_shared_strings; }
+
     /// Create a module.
     ///
     /// \param context      the thread context for this operation
@@ -880,6 +889,9 @@ private:
     /// The builder for all created interface.
     mutable Allocator_builder m_builder;
 
+    /// Returns the pooled arena chunks to the allocator after all members are destroyed.
+    Arena_chunk_pool_guard m_chunk_pool_guard;
+
     /// Next unique module id.
     size_t m_next_module_id;
 
@@ -895,6 +907,9 @@ private:
     /// The compiler owned symbol table, necessary for compiler owned types.
     mutable Symbol_table m_sym_tab;
 
+    /// The string table shared by all DAG units of this compiler.
+    mutable Shared_string_table m_shared_strings;
+
     /// The global type factory of this compiler.
     mutable Type_factory m_type_factory;
 
@@ -28,11 +28,17 @@
 
 #include "pch.h"
 
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <thread>
+#include <mi/base/lock.h>
 #include <mi/base/iallocator.h>
 #include <mi/base/handle.h>
 #include <mi/mdl/mdl_iowned.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
 #include "compilercore_memory_arena.h"
 #include "compilercore_assert.h"
 
@@ -87,24 +93,252 @@ static inline size_t start_offset(unsigned char *p, size_t a)
     return (0 - adr) & (a-1);
 }
 
+namespace {
+
+/// A chunk in the free-chunk pools. Overlays the arena chunk header.
+struct Pooled_chunk {
+    Pooled_chunk *next;     ///< The next pooled chunk.
+    IAllocator   *alloc;    ///< The (retained) allocator this chunk was allocated from.
+};
+
+/// The smallest pooled chunk size, the default arena chunk size.
+static size_t const POOLED_CHUNK_SIZE = 4096;
+
+/// The pooled chunk sizes are POOLED_CHUNK_SIZE << i for i < N_SIZE_CLASSES.
+static size_t const N_SIZE_CLASSES = 5;
+
+/// The number of allocator buckets per size class.
+static size_t const N_ALLOC_BUCKETS = 8;
+
+/// Get the bucket of the chunks allocated by alloc.
+static size_t get_alloc_bucket(IAllocator *alloc)
+{
+    // allocators are at least 16 byte aligned objects
+    return (reinterpret_cast<size_t>(alloc) >> 4) % N_ALLOC_BUCKETS;
+}
+
+/// A free-chunk pool, holding up to a limited number of chunks per size class.
+///
+/// The chunks of a size class are kept in lists keyed by allocator bucket, so taking a chunk
+/// usually finds a matching one at the front of its list.
+struct Chunk_pool {
+    mi::base::Lock lock;
+    Pooled_chunk   *chunks[N_SIZE_CLASSES][N_ALLOC_BUCKETS];
+    size_t         count[N_SIZE_CLASSES];
+
+    Chunk_pool()
+    {
+        for (size_t i = 0; i < N_SIZE_CLASSES; ++i) {
+            for (size_t j = 0; j < N_ALLOC_BUCKETS; ++j)
+                chunks[i][j] = NULL;
+            count[i] = 0;
+        }
+    }
+};
+
+/// The number of per-thread pools.
+static size_t const N_THREAD_POOLS = 16;
+
+/// The maximum number of chunks per size class in a per-thread pool.
+static size_t const THREAD_POOL_LIMIT = 16;
+
+/// The maximum number of chunks per size class in the global pool.
+static size_t const GLOBAL_POOL_LIMIT = 256;
+
+/// All free-chunk pools.
+struct Chunk_pools {
+    Chunk_pool   thread_pools[N_THREAD_POOLS];
+    Chunk_pool   global_pool;
+    std::atomic<size_t> n_reused;
+
+    Chunk_pools() : n_reused(0) {}
+
+    ~Chunk_pools() { release(NULL); }
+
+    /// Get the pool of the calling thread.
+    Chunk_pool &get_thread_pool()
+    {
+        size_t h = std::hash<std::thread::id>()(std::this_thread::get_id());
+        return thread_pools[h % N_THREAD_POOLS];
+    }
+
+    /// Take a chunk of the given size class allocated by alloc from a pool.
+    static Pooled_chunk *take(Chunk_pool &pool, size_t cls, IAllocator *alloc)
+    {
+        mi::base::Lock::Block block(&pool.lock);
+
+        Pooled_chunk **head = &pool.chunks[cls][get_alloc_bucket(alloc)];
+        for (Pooled_chunk **pp = head; *pp != NULL; pp = &(*pp)->next) {
+            Pooled_chunk *c = *pp;
+            if (c->alloc == alloc) {
+                *pp = c->next;
+                --pool.count[cls];
+                return c;
+            }
+        }
+        return NULL;
+    }
+
+    /// Put a chunk of the given size class into a pool if it is not full.
+    static bool put(Chunk_pool &pool, size_t cls, size_t limit, Pooled_chunk *c)
+    {
+        mi::base::Lock::Block block(&pool.lock);
+
+        if (pool.count[cls] >= limit)
+            return false;
+        Pooled_chunk *&head = pool.chunks[cls][get_alloc_bucket(c->alloc)];
+        c->next = head;
+        head    = c;
+        ++pool.count[cls];
+        return true;
+    }
+
+    /// Free all chunks of the given allocator (or all chunks if NULL) in a pool.
+    static void release(Chunk_pool &pool, IAllocator *alloc)
+    {
+        Pooled_chunk *freed = NULL;
+        {
+            mi::base::Lock::Block block(&pool.lock);
+
+            for (size_t cls = 0; cls < N_SIZE_CLASSES; ++cls) {
+                for (size_t b = 0; b < N_ALLOC_BUCKETS; ++b) {
+                    if (alloc != NULL && b != get_alloc_bucket(alloc))
+                        continue;
+                    for (Pooled_chunk **pp = &pool.chunks[cls][b]; *pp != NULL;) {
+                        Pooled_chunk *c = *pp;
+                        if (alloc == NULL || c->alloc == alloc) {
+                            *pp = c->next;
+                            --pool.count[cls];
+                            c->next = freed;
+                            freed   = c;
+                        } else {
+                            pp = &c->next;
+                        }
+                    }
+                }
+            }
+        }
+        // free outside the lock, the allocator might be destroyed here
+        for (Pooled_chunk *c = freed, *n; c != NULL; c = n) {
+            n = c->next;
+            IAllocator *a = c->alloc;
+            a->free(c);
+            a->release();
+        }
+    }
+
+    /// Free all pooled chunks of the given allocator (or all chunks if NULL).
+    void release(IAllocator *alloc)
+    {
+        for (size_t i = 0; i < N_THREAD_POOLS; ++i)
+            release(thread_pools[i], alloc);
+        release(global_pool, alloc);
+    }
+};
+
+/// Get the free-chunk pools.
+static Chunk_pools &get_chunk_pools()
+{
+    static Chunk_pools pools;
+    return pools;
+}
+
+/// Get the size class of a chunk size or N_SIZE_CLASSES if it is not pooled.
+static size_t get_size_class(size_t chunk_size)
+{
+    for (size_t i = 0; i < N_SIZE_CLASSES; ++i) {
+        if (chunk_size == (POOLED_CHUNK_SIZE << i))
+            return i;
+    }
+    return N_SIZE_CLASSES;
+}
+
+}  // anonymous
+
 Memory_arena::Memory_arena(IAllocator *alloc, size_t chunk_size)
 : m_alloc(alloc, mi::base::DUP_INTERFACE)
 , m_chunk_size(chunk_size)
+, m_next_chunk_size(chunk_size)
 , m_chunks(NULL)
+, m_large_chunks(NULL)
 , m_next(NULL)
 , m_curr_size(0)
+, m_chunks_size(0)
 {
     MDL_ASSERT(alloc && chunk_size > 16);
 }
+
 /// Destructs the memory arena and frees ALL memory.
 Memory_arena::~Memory_arena()
 {
     for (Header *p = m_chunks, *q; p != NULL; p = q) {
         q = p->next;
 
-        m_alloc->free((void *)p);
+        free_chunk(p);
     }
     m_chunks = NULL;
+    for (Header *p = m_large_chunks, *q; p != NULL; p = q) {
+        q = p->next;
+
+        free_chunk(p);
+    }
+    m_large_chunks = NULL;
+}
+
+// Allocate a chunk of the given size, from the pools if possible.
+Memory_arena::Header *Memory_arena::allocate_chunk(size_t chunk_size)
+{
+    size_t cls = get_size_class(chunk_size);
+    if (cls < N_SIZE_CLASSES) {
+        Chunk_pools &pools = get_chunk_pools();
+        IAllocator  *alloc = m_alloc.get();
+
+        Pooled_chunk *c = Chunk_pools::take(pools.get_thread_pool(), cls, alloc);
+        if (c == NULL)
+            c = Chunk_pools::take(pools.global_pool, cls, alloc);
+        if (c != NULL) {
+            // the pool retained the allocator
+            alloc->release();
+            pools.n_reused.fetch_add(1, std::memory_order_relaxed);
+            Header *h = reinterpret_cast<Header *>(c);
+            h->chunk_size = chunk_size;
+            m_chunks_size += chunk_size;
+            return h;
+        }
+    }
+
+    Header *h = (Header *)m_alloc->malloc(chunk_size);
+    // printf("Allocated chunk %p\n", h);
+    if (h == NULL)
+        return NULL;
+    MI::PROFILER::increment(MI::PROFILER::COUNTER_ARENA_CHUNK_ALLOCATIONS);
+    h->chunk_size = chunk_size;
+    m_chunks_size += chunk_size;
+    return h;
+}
+
+// Free a chunk, into the pools if possible.
+void Memory_arena::free_chunk(Header *h)
+{
+    size_t chunk_size = h->chunk_size;
+    MDL_ASSERT(m_chunks_size >= chunk_size);
+    m_chunks_size -= chunk_size;
+
+    size_t cls = get_size_class(chunk_size);
+    if (cls < N_SIZE_CLASSES) {
+        Chunk_pools  &pools = get_chunk_pools();
+        Pooled_chunk *c     = reinterpret_cast<Pooled_chunk *>(h);
+
+        c->alloc = m_alloc.get();
+        c->alloc->retain();
+
+        if (Chunk_pools::put(pools.get_thread_pool(), cls, THREAD_POOL_LIMIT, c))
+            return;
+        if (Chunk_pools::put(pools.global_pool, cls, GLOBAL_POOL_LIMIT, c))
+            return;
+        c->alloc->release();
+    }
+    m_alloc->free(h);
 }
 
 /// Allocates size bytes from the memory area.
@@ -118,17 +352,37 @@ void *Memory_arena::allocate(size_t o_size, size_t o_align)
     if (size > m_curr_size) {
         // allocate a new chunk
         size_t load_ofs = align(((Header *)0)->load - (Byte *)0, a);
+        size_t needed   = o_size + (a-1) + load_ofs;
+
+        if (needed > m_next_chunk_size / 2) {
+            // large object: put it into its own chunk and keep the current one
+            Header *h = allocate_chunk(needed);
+            if (h == NULL)
+                return NULL;
+            h->next        = m_large_chunks;
+            h->used        = needed;
+            h->mark_chunk  = m_chunks;
+            h->mark_next   = m_next;
+            m_large_chunks = h;
+
+            void *res = align(h->load, a);
+            MDL_ASSERT((Byte *)res + o_size <= (Byte *)h + needed);
+            return res;
+        }
 
-        size_t chunk_size = m_chunk_size;
-        if (o_size + (a-1) > chunk_size - load_ofs)
-            chunk_size = o_size + (a-1) + load_ofs;
+        size_t chunk_size = m_next_chunk_size;
+        if (chunk_size < MAX_CHUNK_SIZE)
+            m_next_chunk_size = chunk_size * 2;
 
-        Header *h = (Header *)m_alloc->malloc(chunk_size);
-        // printf("Allocated chunk %p\n", h);
+        Header *h = allocate_chunk(chunk_size);
         if (h == NULL)
             return NULL;
+        if (m_chunks != NULL)
+            m_chunks->used = m_next - (Byte *)m_chunks;
         h->next       = m_chunks;
-        h->chunk_size = chunk_size;
+        h->used       = 0;
+        h->mark_chunk = NULL;
+        h->mark_next  = NULL;
         m_chunks      = h;
 
         m_next = align(h->load, a);
@@ -156,47 +410,104 @@ void Memory_arena::drop(void *obj)
         // drop the whole
         for (Header *p = m_chunks; p != NULL; p = m_chunks) {
             m_chunks = p->next;
-            m_alloc->free(p);
+            free_chunk(p);
         }
-        m_next      = NULL;
-        m_curr_size = 0;
+        for (Header *p = m_large_chunks; p != NULL; p = m_large_chunks) {
+            m_large_chunks = p->next;
+            free_chunk(p);
+        }
+        m_next            = NULL;
+        m_curr_size       = 0;
+        m_next_chunk_size = m_chunk_size;
         return;
     }
 
-    // check current chunk first
-    if (m_chunks->load <= obj && obj <= m_next) {
-        m_next = (Byte *)obj;
-        m_curr_size = (char *)m_chunks + m_chunks->chunk_size - (char *)obj;
-    } else {
-        MDL_ASSERT(!(m_chunks->load <= obj && obj < m_chunks->load + m_chunk_size));
+    // check large objects: they start their chunk
+    for (Header *l = m_large_chunks; l != NULL; l = l->next) {
+        if (l->load <= obj && obj < (Byte *)l + l->chunk_size) {
+            Header *mark_chunk = l->mark_chunk;
+            Byte   *mark_next  = l->mark_next;
+
+            // drop it and all later allocated large objects
+            Header *p = m_large_chunks;
+            do {
+                m_large_chunks = p->next;
+                free_chunk(p);
+                if (p == l)
+                    break;
+                p = m_large_chunks;
+            } while (true);
+
+            // and all objects allocated after it
+            drop_chunks_after(mark_chunk, mark_next);
+            return;
+        }
+    }
 
-        // try to find the old chunk
-        Header *stop = NULL;
+    // find the chunk of the object, check current chunk first
+    Header *stop = m_chunks;
+    if (stop != NULL && (stop->load > obj || obj > m_next)) {
         do {
-            stop = m_chunks->next;
+            stop = stop->next;
         } while (stop != NULL &&
-                (stop->load > obj || ((char *)stop + stop->chunk_size) <= obj));
+            (stop->load > obj || ((char *)stop + stop->chunk_size) <= obj));
+    }
+    if (stop == NULL) {
+        MDL_ASSERT(!"dropped object from wrong Memory Arena");
+        return;
+    }
 
-        // drop chunks until old one is reached
-        if (stop != NULL) {
-            Header *p = m_chunks;
-            do {
-                m_chunks = p->next;
-                m_alloc->free(p);
-            } while (m_chunks != stop);
-
-            // now we could drop it in the current chunk
-            m_next = (Byte *)obj;
-            m_curr_size = (char *)m_chunks + m_chunks->chunk_size - (char *)obj;
-        } else {
-            MDL_ASSERT(!"dropped object from wrong Memory Arena");
-        }
+    // drop the large objects allocated after it, the list is ordered newest first
+    while (m_large_chunks != NULL && is_allocated_after(m_large_chunks, stop, (Byte *)obj)) {
+        Header *p = m_large_chunks;
+        m_large_chunks = p->next;
+        free_chunk(p);
+    }
+
+    // drop chunks until old one is reached, then drop it in the current chunk
+    drop_chunks_after(stop, (Byte *)obj);
+}
+
+// Check if a large object chunk was allocated after the given position.
+bool Memory_arena::is_allocated_after(
+    Header const *l,
+    Header const *chunk,
+    Byte const   *pos) const
+{
+    if (l->mark_chunk == chunk)
+        return l->mark_next > pos;
+
+    // otherwise it was allocated after pos if its current chunk is newer than chunk
+    for (Header const *h = m_chunks; h != chunk; h = h->next) {
+        MDL_ASSERT(h != NULL);
+        if (h == l->mark_chunk)
+            return true;
     }
+    return false;
+}
+
+// Drop all (non-large) chunks allocated after the given one and continue at pos.
+void Memory_arena::drop_chunks_after(Header *chunk, Byte *pos)
+{
+    while (m_chunks != chunk) {
+        Header *p = m_chunks;
+        MDL_ASSERT(p != NULL && "chunk is not part of this Memory Arena");
+        m_chunks = p->next;
+        free_chunk(p);
+    }
+    m_next      = pos;
+    m_curr_size = chunk != NULL ? (Byte *)chunk + chunk->chunk_size - pos : 0;
 }
 
 // Check if an object lies in this memory arena.
 bool Memory_arena::contains(void const *obj) const
 {
+    for (Header const *l = m_large_chunks; l != NULL; l = l->next) {
+        if (l->load <= obj && obj < (Byte const *)l + l->chunk_size)
+            return true;
+    }
+    if (m_chunks == NULL)
+        return false;
     if (m_chunks->load <= obj && obj < m_next) {
         return true;
     } else {
@@ -210,25 +521,68 @@ bool Memory_arena::contains(void const *obj) const
     }
 }
 
-// Return the size of the allocated memory arena chunks.
-size_t Memory_arena::get_chunks_size() const
+// Return the memory statistics of this arena.
+Memory_arena::Statistics Memory_arena::get_statistics() const
 {
-    size_t size = 0;
+    Statistics stat;
+    stat.n_chunks    = 0;
+    stat.chunks_size = m_chunks_size;
+    stat.used_size   = 0;
+    stat.n_large     = 0;
+    stat.large_size  = 0;
 
     for (Header const *h = m_chunks; h != NULL; h = h->next) {
-        size += h->chunk_size;
+        ++stat.n_chunks;
+        stat.used_size += h == m_chunks ? size_t(m_next - (Byte const *)h) : h->used;
+    }
+    for (Header const *h = m_large_chunks; h != NULL; h = h->next) {
+        ++stat.n_chunks;
+        ++stat.n_large;
+        stat.used_size  += h->used;
+        stat.large_size += h->chunk_size;
     }
-    return size;
+    return stat;
 }
 
 // Swap this memory arena content with another.
 void Memory_arena::swap(Memory_arena &other)
 {
-    std::swap(m_alloc,      other.m_alloc);
-    std::swap(m_chunk_size, other.m_chunk_size);
-    std::swap(m_chunks,     other.m_chunks);
-    std::swap(m_next,       other.m_next);
-    std::swap(m_curr_size,  other.m_curr_size);
+    std::swap(m_alloc,           other.m_alloc);
+    std::swap(m_chunk_size,      other.m_chunk_size);
+    std::swap(m_next_chunk_size, other.m_next_chunk_size);
+    std::swap(m_chunks,          other.m_chunks);
+    std::swap(m_large_chunks,    other.m_large_chunks);
+    std::swap(m_next,            other.m_next);
+    std::swap(m_curr_size,       other.m_curr_size);
+    std::swap(m_chunks_size,     other.m_chunks_size);
+}
+
+// Return the statistics of the free-chunk pools.
+Memory_arena::Pool_statistics Memory_arena::get_pool_statistics()
+{
+    Chunk_pools &pools = get_chunk_pools();
+
+    Pool_statistics stat;
+    stat.n_chunks    = 0;
+    stat.chunks_size = 0;
+
+    for (size_t i = 0; i <= N_THREAD_POOLS; ++i) {
+        Chunk_pool &pool = i < N_THREAD_POOLS ? pools.thread_pools[i] : pools.global_pool;
+
+        mi::base::Lock::Block block(&pool.lock);
+        for (size_t cls = 0; cls < N_SIZE_CLASSES; ++cls) {
+            stat.n_chunks    += pool.count[cls];
+            stat.chunks_size += pool.count[cls] * (POOLED_CHUNK_SIZE << cls);
+        }
+    }
+    stat.n_reused = pools.n_reused.load(std::memory_order_relaxed);
+    return stat;
+}
+
+// Return all pooled chunks allocated from the given allocator to it.
+void Memory_arena::release_pooled_chunks(IAllocator *alloc)
+{
+    get_chunk_pools().release(alloc);
 }
 
 // Put a C-string into the memory arena.
@@ -55,6 +55,14 @@ namespace mi {
 namespace mdl {
 
 /// Implementation of the memory arena.
+///
+/// The arena allocates memory chunks from its allocator. The size of the chunks grows
+/// geometrically from the initial chunk size up to MAX_CHUNK_SIZE, so big arenas need only a few
+/// chunks. Objects larger than half of the next chunk size are allocated in their own chunks
+/// without wasting the rest of the current chunk.
+///
+/// Chunks of the default sizes are not returned to the allocator but recycled: freed chunks are
+/// kept in free-chunk pools, first in a pool local to the calling thread, then in a global pool.
 class Memory_arena
 {
     typedef unsigned char Byte;
@@ -62,15 +70,35 @@ class Memory_arena
     struct Header {
         Header *next;
         size_t chunk_size;
+        size_t used;        ///< Used bytes of a retired chunk.
+        Header *mark_chunk; ///< Large chunks only: the current chunk when it was allocated.
+        Byte   *mark_next;  ///< Large chunks only: the next free byte when it was allocated.
 
         Byte load[1];
     };
 
     enum sizes {
-        CHUNK_SIZE = 4096   ///< The default size of the arena memory chunks.
+        CHUNK_SIZE     = 4096,          ///< The default size of the arena memory chunks.
+        MAX_CHUNK_SIZE = 16 * 4096      ///< The maximum size of the chunks due to growth.
     };
 
 public:
+    /// Memory statistics of an arena.
+    struct Statistics {
+        size_t n_chunks;        ///< The number of chunks, including the large object chunks.
+        size_t chunks_size;     ///< The total size of all chunks.
+        size_t used_size;       ///< The number of bytes allocated from the chunks.
+        size_t n_large;         ///< The number of objects allocated in their own chunks.
+        size_t large_size;      ///< The total size of the large object chunks.
+    };
+
+    /// Statistics of the free-chunk pools shared by all arenas.
+    struct Pool_statistics {
+        size_t n_chunks;        ///< The number of pooled chunks.
+        size_t chunks_size;     ///< The total size of the pooled chunks.
+        size_t n_reused;        ///< The number of chunk allocations served from the pools.
+    };
+
     /// Constructs a new memory arena.
     ///
     /// \param alloc       the allocator
@@ -100,6 +128,8 @@ public:
 
     /// Drop the given object AND all later allocated objects from the arena.
     ///
+    /// This includes the later allocated large objects in their own chunks.
+    ///
     /// \param obj  the address of the object to drop, NULL drops the whole memory arena
     void drop(void *obj);
 
@@ -112,11 +142,46 @@ public:
     bool contains(void const *obj) const;
 
     /// Return the size of the allocated memory arena chunks.
-    size_t get_chunks_size() const;
+    size_t get_chunks_size() const { return m_chunks_size; }
+
+    /// Return the memory statistics of this arena.
+    Statistics get_statistics() const;
 
     /// Swap this memory arena content with another.
     void swap(Memory_arena &other);
 
+    /// Return the statistics of the free-chunk pools.
+    static Pool_statistics get_pool_statistics();
+
+    /// Return all pooled chunks allocated from the given allocator to it.
+    ///
+    /// The pools retain the allocators of pooled chunks, so this must be called before the
+    /// allocator is expected to be destroyed, after all arenas using it are destroyed.
+    /// See Arena_chunk_pool_guard.
+    ///
+    /// \param alloc  the allocator, NULL for all allocators
+    static void release_pooled_chunks(IAllocator *alloc);
+
+private:
+    /// Allocate a chunk of the given size, from the pools if possible.
+    Header *allocate_chunk(size_t chunk_size);
+
+    /// Free a chunk, into the pools if possible.
+    void free_chunk(Header *h);
+
+    /// Check if a large object chunk was allocated after the given position.
+    ///
+    /// \param l      a large object chunk
+    /// \param chunk  a (non-large) chunk of this arena
+    /// \param pos    a position inside chunk
+    bool is_allocated_after(Header const *l, Header const *chunk, Byte const *pos) const;
+
+    /// Drop all (non-large) chunks allocated after the given one and continue at pos.
+    ///
+    /// \param chunk  the new current chunk, NULL drops all chunks
+    /// \param pos    the new position of the next free memory inside chunk
+    void drop_chunks_after(Header *chunk, Byte *pos);
+
 private:
 
     /// The allocator.
@@ -125,17 +190,57 @@ private:
     /// The size of the chunks
     size_t m_chunk_size;
 
+    /// The size of the next (non-large) chunk.
+    size_t m_next_chunk_size;
+
     /// The chunk list.
     Header *m_chunks;
 
+    /// The list of chunks of large objects.
+    Header *m_large_chunks;
+
     /// Pointer to the next free memory.
     Byte *m_next;
 
     /// size of the current chunk
     size_t m_curr_size;
+
+    /// The total size of all chunks.
+    size_t m_chunks_size;
 };
 
 
+/// Returns the pooled arena chunks of an allocator to it when destroyed.
+///
+/// The owner of an allocator should declare this guard before all arenas it owns, so the chunks
+/// of these arenas are pooled first and released after that.
+class Arena_chunk_pool_guard
+{
+public:
+    /// Constructor.
+    ///
+    /// \param alloc  the allocator, not retained
+    explicit Arena_chunk_pool_guard(IAllocator *alloc)
+    : m_alloc(alloc)
+    {
+    }
+
+    /// Destructor, returns the pooled chunks.
+    ~Arena_chunk_pool_guard()
+    {
+        Memory_arena::release_pooled_chunks(m_alloc);
+    }
+
+private:
+    // non copyable
+    Arena_chunk_pool_guard(Arena_chunk_pool_guard const &) MDL_DELETED_FUNCTION;
+    Arena_chunk_pool_guard &operator=(Arena_chunk_pool_guard const &) MDL_DELETED_FUNCTION;
+
+private:
+    /// The allocator.
+    IAllocator *m_alloc;
+};
+
 /// A standards-compliant allocator using a Memory area.
 template<typename T>
 class Memory_arena_allocator
@@ -453,6 +558,13 @@ typedef std::basic_string<
     std::char_traits<char>, 
     Memory_arena_allocator<char> > Arena_string;
 
+// Helper for dynamic memory consumption: the chunks of a memory arena, including the chunks
+// of large objects.
+inline bool has_dynamic_memory_consumption(Memory_arena const &) { return true; }
+inline size_t dynamic_memory_consumption(Memory_arena const &arena) {
+    return arena.get_statistics().chunks_size;
+}
+
 // Helper for dynamic memory consumption: Arena strings have no EXTRA memory allocated.
 inline bool has_dynamic_memory_consumption(Arena_string const &) { return false; }
 inline size_t dynamic_memory_consumption(Arena_string const &) { return 0; }
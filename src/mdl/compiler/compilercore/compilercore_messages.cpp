@@ -369,7 +369,7 @@ size_t Messages_impl::register_fname(
 // Get the dynamic memory consumption of this message list.
 size_t Messages_impl::get_dynamic_memory_consumption() const
 {
-    size_t res = m_msg_arena.get_chunks_size();
+    size_t res = dynamic_memory_consumption(m_msg_arena);
     res += dynamic_memory_consumption(m_msgs);
     res += dynamic_memory_consumption(m_err);
     res += dynamic_memory_consumption(m_filenames);
@@ -844,7 +844,7 @@ size_t Module::get_memory_size() const
 {
     size_t res = sizeof(*this);
 
-    res += m_arena.get_chunks_size();
+    res += dynamic_memory_consumption(m_arena);
     res += m_def_tab.get_memory_size() - sizeof(m_def_tab);
     res += dynamic_memory_consumption(m_msg_list);
     res += dynamic_memory_consumption(m_declarations);
@@ -454,5 +454,84 @@ Symbol::Symbol(size_t id, char const *name)
 {
 }
 
+/// A shard of the shared string table.
+struct Shared_string_table::Shard {
+    typedef Arena_hash_set<
+        char const *,
+        cstring_hash,
+        cstring_equal_to
+    >::Type String_set;
+
+    /// Constructor.
+    explicit Shard(IAllocator *alloc)
+    : m_lock()
+    , m_arena(alloc)
+    , m_strings(64, String_set::hasher(), String_set::key_equal(), &m_arena)
+    {
+    }
+
+    /// The lock protecting this shard.
+    mi::base::Lock m_lock;
+
+    /// The arena holding the strings of this shard.
+    Memory_arena m_arena;
+
+    /// The strings of this shard.
+    String_set m_strings;
+};
+
+// Constructor.
+Shared_string_table::Shared_string_table(IAllocator *alloc)
+: m_builder(alloc)
+{
+    for (size_t i = 0; i < N_SHARDS; ++i) {
+        m_shards[i] = m_builder.create<Shard>(alloc);
+    }
+}
+
+// Destructor.
+Shared_string_table::~Shared_string_table()
+{
+    for (size_t i = 0; i < N_SHARDS; ++i) {
+        m_builder.destroy(m_shards[i]);
+    }
+}
+
+// Get the internalized copy of a string, creates one if not exists.
+char const *Shared_string_table::internalize(char const *s)
+{
+    if (s == NULL) {
+        return NULL;
+    }
+
+    size_t h = cstring_hash()(s);
+    Shard  &shard = *m_shards[(h ^ (h >> 16)) % N_SHARDS];
+
+    mi::base::Lock::Block block(&shard.m_lock);
+
+    Shard::String_set::const_iterator it = shard.m_strings.find(s);
+    if (it != shard.m_strings.end()) {
+        return *it;
+    }
+
+    char const *res = Arena_strdup(shard.m_arena, s);
+    shard.m_strings.insert(res);
+    return res;
+}
+
+// Return the amount of memory used by this table.
+size_t Shared_string_table::get_memory_size() const
+{
+    size_t res = sizeof(*this);
+
+    for (size_t i = 0; i < N_SHARDS; ++i) {
+        Shard &shard = *m_shards[i];
+
+        mi::base::Lock::Block block(&shard.m_lock);
+        res += sizeof(shard) + dynamic_memory_consumption(shard.m_arena);
+    }
+    return res;
+}
+
 }  // mdl
 }  // mi
@@ -31,6 +31,7 @@
 
 #include <cstring>
 
+#include <mi/base/lock.h>
 #include <mi/mdl/mdl_symbols.h>
 #include <mi/mdl/mdl_expressions.h>
 
@@ -255,6 +256,52 @@ private:
     size_t m_next_id;
 };
 
+/// A thread safe table of internalized strings, shared by all units of one compiler.
+///
+/// The table is split into shards selected by the string hash. Every shard is protected by its
+/// own lock, so threads internalizing different strings rarely contend.
+///
+/// Strings are never removed, the table lives as long as its owner. Hence it should only hold
+/// strings of a bounded set, like the names of definitions and their parameters.
+class Shared_string_table
+{
+public:
+    /// Get the internalized copy of a string, creates one if not exists.
+    ///
+    /// \param s  the C-string to internalize, may be NULL
+    ///
+    /// \return the unique copy of s owned by this table, NULL if s is NULL
+    char const *internalize(char const *s);
+
+    /// Return the amount of memory used by this table.
+    size_t get_memory_size() const;
+
+public:
+    /// Constructor.
+    ///
+    /// \param alloc  the allocator
+    explicit Shared_string_table(IAllocator *alloc);
+
+    /// Destructor.
+    ~Shared_string_table();
+
+private:
+    // non copyable
+    Shared_string_table(Shared_string_table const &) MDL_DELETED_FUNCTION;
+    Shared_string_table &operator=(Shared_string_table const &) MDL_DELETED_FUNCTION;
+
+private:
+    enum { N_SHARDS = 32 };
+
+    struct Shard;
+
+    /// The builder for the shards.
+    Allocator_builder m_builder;
+
+    /// The shards.
+    Shard *m_shards[N_SHARDS];
+};
+
 }  // mdl
 }  // mi
 
@@ -0,0 +1,273 @@
+/******************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "pch.h"
+
+#define MI_TEST_AUTO_SUITE_NAME "Regression Test Suite for mdl/compiler/compilercore"
+
+#include <base/system/test/i_test_auto_driver.h>
+#include <base/system/test/i_test_auto_case.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <mi/base/handle.h>
+#include <mi/base/interface_implement.h>
+
+#include "compilercore_memory_arena.h"
+#include "compilercore_symbols.h"
+
+using namespace mi::mdl;
+
+namespace {
+
+// an allocator counting its allocations
+class Counting_allocator : public mi::base::Interface_implement<IAllocator>
+{
+public:
+    Counting_allocator() : m_n_mallocs( 0), m_n_live( 0) { }
+
+    void* malloc( mi::Size size) { ++m_n_mallocs; ++m_n_live; return std::malloc( size); }
+
+    void free( void* memory) { if( memory) { --m_n_live; std::free( memory); } }
+
+    size_t m_n_mallocs;
+    size_t m_n_live;
+};
+
+} // namespace
+
+MI_TEST_AUTO_FUNCTION( test_arena_growth )
+{
+    mi::base::Handle<Counting_allocator> alloc( new Counting_allocator);
+    {
+        Memory_arena arena( alloc.get());
+
+        size_t total = 0;
+        for( size_t i = 0; i < 4000; ++i) {
+            void* p = arena.allocate( 64);
+            MI_CHECK( p);
+            MI_CHECK( arena.contains( p));
+            total += 64;
+        }
+
+        // the chunks grow geometrically: 4K + 8K + 16K + 32K + 64K + 64K + ...
+        Memory_arena::Statistics stat = arena.get_statistics();
+        MI_CHECK_LESS_OR_EQUAL( stat.n_chunks, 8u);
+        MI_CHECK_EQUAL( stat.n_large, 0u);
+        MI_CHECK_EQUAL( stat.chunks_size, arena.get_chunks_size());
+        MI_CHECK_EQUAL( stat.chunks_size, dynamic_memory_consumption( arena));
+        MI_CHECK_GREATER_OR_EQUAL( stat.used_size, total);
+        MI_CHECK_LESS_OR_EQUAL( stat.used_size, stat.chunks_size);
+    }
+    Memory_arena::release_pooled_chunks( alloc.get());
+    MI_CHECK_EQUAL( alloc->m_n_live, 0u);
+}
+
+MI_TEST_AUTO_FUNCTION( test_arena_large_objects )
+{
+    mi::base::Handle<Counting_allocator> alloc( new Counting_allocator);
+    {
+        Memory_arena arena( alloc.get());
+
+        void* a = arena.allocate( 16);
+        void* l = arena.allocate( 100000);
+        void* b = arena.allocate( 16);
+
+        // the large object gets its own chunk and the current chunk is kept
+        Memory_arena::Statistics stat = arena.get_statistics();
+        MI_CHECK_EQUAL( stat.n_chunks, 2u);
+        MI_CHECK_EQUAL( stat.n_large, 1u);
+        MI_CHECK_GREATER_OR_EQUAL( stat.large_size, 100000u);
+        MI_CHECK_EQUAL( (char*) b, (char*) a + 16);
+        MI_CHECK( arena.contains( l));
+
+        // dropping a large object drops the objects allocated after it
+        arena.drop( l);
+        MI_CHECK( !arena.contains( l));
+        MI_CHECK( !arena.contains( b));
+        MI_CHECK( arena.contains( a));
+        MI_CHECK_EQUAL( arena.get_statistics().n_large, 0u);
+        MI_CHECK_EQUAL( arena.allocate( 16), b);
+
+        // dropping an object drops the large objects allocated after it
+        void* c = arena.allocate( 16);
+        void* l1 = arena.allocate( 100000);
+        void* d = arena.allocate( 16);
+        void* l2 = arena.allocate( 200000);
+        MI_CHECK_EQUAL( arena.get_statistics().n_large, 2u);
+
+        arena.drop( d);
+        MI_CHECK( arena.contains( l1));
+        MI_CHECK( !arena.contains( l2));
+        MI_CHECK_EQUAL( arena.get_statistics().n_large, 1u);
+
+        arena.drop( c);
+        MI_CHECK( !arena.contains( l1));
+        MI_CHECK( arena.contains( a));
+        MI_CHECK_EQUAL( arena.get_statistics().n_large, 0u);
+
+        // also over chunk boundaries
+        void* e = arena.allocate( 16);
+        void* l3 = arena.allocate( 100000);
+        for( size_t i = 0; i < 1000; ++i)
+            arena.allocate( 64);
+        MI_CHECK_GREATER( arena.get_statistics().n_chunks, 3u);
+
+        arena.drop( e);
+        MI_CHECK( !arena.contains( l3));
+        Memory_arena::Statistics stat2 = arena.get_statistics();
+        MI_CHECK_EQUAL( stat2.n_chunks, 1u);
+        MI_CHECK_EQUAL( stat2.n_large, 0u);
+
+        arena.drop( 0);
+        MI_CHECK_EQUAL( arena.get_chunks_size(), 0u);
+    }
+    Memory_arena::release_pooled_chunks( alloc.get());
+    MI_CHECK_EQUAL( alloc->m_n_live, 0u);
+}
+
+MI_TEST_AUTO_FUNCTION( test_arena_chunk_pools )
+{
+    mi::base::Handle<Counting_allocator> alloc( new Counting_allocator);
+    {
+        Arena_chunk_pool_guard guard( alloc.get());
+
+        {
+            Memory_arena arena( alloc.get());
+            for( size_t i = 0; i < 1000; ++i)
+                arena.allocate( 64);
+        }
+        size_t n_mallocs = alloc->m_n_mallocs;
+        MI_CHECK_GREATER( n_mallocs, 1u);
+
+        // the chunks are pooled, not freed
+        Memory_arena::Pool_statistics pool_stat = Memory_arena::get_pool_statistics();
+        MI_CHECK_GREATER_OR_EQUAL( pool_stat.n_chunks, n_mallocs);
+        MI_CHECK_EQUAL( alloc->m_n_live, n_mallocs);
+
+        // and reused by the next arena
+        {
+            Memory_arena arena( alloc.get());
+            for( size_t i = 0; i < 1000; ++i)
+                arena.allocate( 64);
+            MI_CHECK_EQUAL( alloc->m_n_mallocs, n_mallocs);
+        }
+        MI_CHECK_GREATER_OR_EQUAL(
+            Memory_arena::get_pool_statistics().n_reused, pool_stat.n_reused + n_mallocs);
+
+        // large objects are not pooled
+        {
+            Memory_arena arena( alloc.get());
+            arena.allocate( 100000);
+        }
+        MI_CHECK_EQUAL( alloc->m_n_live, n_mallocs);
+    }
+    // the guard returned the pooled chunks
+    MI_CHECK_EQUAL( alloc->m_n_live, 0u);
+}
+
+MI_TEST_AUTO_FUNCTION( test_arena_swap )
+{
+    mi::base::Handle<Counting_allocator> alloc( new Counting_allocator);
+    {
+        Memory_arena arena1( alloc.get());
+        Memory_arena arena2( alloc.get());
+
+        void* p = arena1.allocate( 16);
+        void* l = arena1.allocate( 100000);
+        size_t size1 = arena1.get_chunks_size();
+
+        arena1.swap( arena2);
+        MI_CHECK( !arena1.contains( p));
+        MI_CHECK( !arena1.contains( l));
+        MI_CHECK( arena2.contains( p));
+        MI_CHECK( arena2.contains( l));
+        MI_CHECK_EQUAL( arena1.get_chunks_size(), 0u);
+        MI_CHECK_EQUAL( arena2.get_chunks_size(), size1);
+
+        // the swapped arenas stay usable
+        void* q = arena1.allocate( 16);
+        MI_CHECK( arena1.contains( q));
+        arena2.drop( l);
+        MI_CHECK( arena2.contains( p));
+        MI_CHECK_EQUAL( arena2.get_statistics().n_large, 0u);
+    }
+    Memory_arena::release_pooled_chunks( alloc.get());
+    MI_CHECK_EQUAL( alloc->m_n_live, 0u);
+}
+
+MI_TEST_AUTO_FUNCTION( test_shared_string_table )
+{
+    mi::base::Handle<Counting_allocator> alloc( new Counting_allocator);
+    {
+        Arena_chunk_pool_guard guard( alloc.get());
+        Shared_string_table table( alloc.get());
+
+        const size_t n_threads = 8;
+        const size_t n_strings = 2048;
+
+        // all threads internalize the same strings from private buffers
+        std::vector<std::vector<const char*> > results( n_threads);
+        std::vector<std::thread> threads;
+        for( size_t t = 0; t < n_threads; ++t)
+            threads.emplace_back( [&table, &results, t, n_strings]() {
+                std::vector<const char*>& res = results[t];
+                res.resize( n_strings);
+                for( size_t j = 0; j < n_strings; ++j) {
+                    // vary the order between the threads, 2t+1 is coprime to n_strings
+                    size_t i = (j * (2 * t + 1)) % n_strings;
+                    char buf[32];
+                    snprintf( buf, sizeof( buf), "::df::name_%u", unsigned( i));
+                    res[i] = table.internalize( buf);
+                }
+            });
+        for( std::thread& thread : threads)
+            thread.join();
+
+        // equal strings have equal pointers, different strings have different ones
+        for( size_t i = 0; i < n_strings; ++i) {
+            char buf[32];
+            snprintf( buf, sizeof( buf), "::df::name_%u", unsigned( i));
+            MI_CHECK_EQUAL_CSTR( results[0][i], buf);
+            MI_CHECK( results[0][i] != buf);
+            MI_CHECK_EQUAL( table.internalize( buf), results[0][i]);
+            for( size_t t = 1; t < n_threads; ++t)
+                MI_CHECK_EQUAL( results[t][i], results[0][i]);
+            if( i > 0)
+                MI_CHECK( results[0][i] != results[0][i-1]);
+        }
+
+        MI_CHECK( !table.internalize( nullptr));
+        MI_CHECK_GREATER( table.get_memory_size(), n_strings * 12);
+    }
+    MI_CHECK_EQUAL( alloc->m_n_live, 0u);
+}
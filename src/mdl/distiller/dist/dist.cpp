@@ -34,6 +34,7 @@
 #include <base/hal/time/i_time.h>
 #include <base/lib/log/i_log_assert.h>
 #include <base/lib/log/i_log_logger.h>
+#include <base/lib/profiler/i_profiler.h>
 #include <mi/base/handle.h>
 #include <mi/mdl/mdl_mdl.h>
 #include <mi/mdl/mdl_distiller_plugin.h>
@@ -52,6 +53,8 @@ const mi::mdl::IMaterial_instance* Dist_module_impl::distill(
     mi::mdl::Distiller_options* options,
     mi::Sint32* p_error) const
 {
+    PROFILER::Scoped_phase phase( PROFILER::PHASE_DISTILL);
+
     TIME::Stopwatch stopwatch;
     stopwatch.start();
 
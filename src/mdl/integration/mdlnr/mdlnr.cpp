@@ -235,6 +235,18 @@ bool Mdlc_module_impl::init()
             mi::mdl::MDL::option_opt_level, std::to_string(opt_level).c_str());
     }
 
+    int hash_threads = 0;
+    if (registry.get_value("mdl_instance_hash_threads", hash_threads)) {
+        options.set_option(
+            mi::mdl::MDL::option_instance_hash_threads, std::to_string(hash_threads).c_str());
+    }
+
+    int hash_threshold = 0;
+    if (registry.get_value("mdl_instance_hash_threshold", hash_threshold)) {
+        options.set_option(
+            mi::mdl::MDL::option_instance_hash_threshold, std::to_string(hash_threshold).c_str());
+    }
+
     // neuray always runs in "relaxed" mode for compatibility with old releases
     options.set_option(mi::mdl::MDL::option_strict, "false");
 
@@ -36,6 +36,8 @@
 
 #include <llvm/IR/Module.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
 #include "mdl/compiler/compilercore/compilercore_errors.h"
 #include "mdl/compiler/compilercore/compilercore_mdl.h"
 #include "mdl/compiler/compilercore/compilercore_tools.h"
@@ -290,6 +292,10 @@ static void fill_default_cg_options(
         MDL_JIT_OPTION_SL_USE_RESOURCE_DATA,
         "false",
         "GLSL/HLSL: Pass an extra user defined resource data struct to resource callbacks");
+    options.add_option(
+        MDL_JIT_OPTION_SL_MERGE_FUNCTIONS,
+        "false",
+        "GLSL/HLSL: Merge internal functions with identical bodies");
     options.add_option(
         MDL_JIT_OPTION_SL_CORE_STATE_API_NAME,
         "",
@@ -1095,6 +1101,9 @@ IGenerated_code_executable *Code_generator_jit::compile_into_switch_function_for
         hasher.final(cache_key);
 
         ICode_cache::Entry const *entry = code_cache->lookup(cache_key);
+        MI::PROFILER::increment(entry != NULL
+            ? MI::PROFILER::COUNTER_CODE_CACHE_HITS
+            : MI::PROFILER::COUNTER_CODE_CACHE_MISSES);
 
         if (entry != NULL) {
             // found a hit
@@ -1917,6 +1926,9 @@ IGenerated_code_executable *Code_generator_jit::compile_into_source(
         hasher.final(cache_key);
 
         ICode_cache::Entry const *entry = code_cache->lookup(cache_key);
+        MI::PROFILER::increment(entry != NULL
+            ? MI::PROFILER::COUNTER_CODE_CACHE_HITS
+            : MI::PROFILER::COUNTER_CODE_CACHE_MISSES);
 
         if (entry != NULL) {
             // found a hit
@@ -2155,6 +2167,8 @@ IGenerated_code_executable *Code_generator_jit::compile_unit(
     ILink_unit const               *iunit,
     bool                           llvm_ir_output)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_LINK);
+
     if (iunit == NULL) {
         return NULL;
     }
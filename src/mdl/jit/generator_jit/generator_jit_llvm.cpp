@@ -33,6 +33,7 @@
 
 #include <base/system/stlext/i_stlext_restore.h>
 #include <base/system/stlext/i_stlext_binary_cast.h>
+#include <base/lib/profiler/i_profiler.h>
 
 #include <vector>
 #include <algorithm>
@@ -1977,6 +1978,8 @@ bool LLVM_code_generator::optimize(llvm::Function *func)
 // Optimize LLVM code.
 bool LLVM_code_generator::optimize(llvm::Module *module)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_LLVM_OPTIMIZE);
+
     if (m_target_lang == ICode_generator::TL_PTX) {
         // already remove any unreferenced libDevice functions to avoid
         // LLVM optimizing them for nothing and mark uses ones as internal
@@ -10128,6 +10131,8 @@ llvm::Module *LLVM_code_generator::finalize_module()
 // JIT compile all functions of the given module.
 MDL_JIT_module_key LLVM_code_generator::jit_compile(llvm::Module *module)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_CODE_GENERATION);
+
     // check that all functions exists
     for (auto &func : module->functions()) {
         if (func.isDeclaration() && !func.isIntrinsic()) {
@@ -10210,6 +10215,8 @@ void LLVM_code_generator::ptx_compile(
     llvm::Module *module,
     string       &code)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_CODE_GENERATION);
+
     {
         raw_string_ostream SOut(code);
         llvm::buffer_ostream Out(SOut);
@@ -10368,6 +10375,8 @@ void LLVM_code_generator::ptx_compile(
 // Compile the given module into LLVM-IR code.
 void LLVM_code_generator::llvm_ir_compile(llvm::Module *module, string &code)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_CODE_GENERATION);
+
     raw_string_ostream SOut(code);
 
     // just print it
@@ -10377,6 +10386,8 @@ void LLVM_code_generator::llvm_ir_compile(llvm::Module *module, string &code)
 // Compile the given module into LLVM-BC code.
 void LLVM_code_generator::llvm_bc_compile(llvm::Module *module, string &code)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_CODE_GENERATION);
+
     raw_string_ostream Out(code);
     llvm::WriteBitcodeToFile(*module, Out);
 }
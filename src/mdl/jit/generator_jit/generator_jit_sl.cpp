@@ -36,6 +36,8 @@
 #include <llvm/IR/IRPrintingPasses.h>
 #include <llvm/Support/SourceMgr.h>
 
+#include <base/lib/profiler/i_profiler.h>
+
 #include "generator_jit_llvm.h"
 #include "generator_jit_ast_compute.h"
 #include "generator_jit_cns_pass.h"
@@ -53,6 +55,8 @@ void LLVM_code_generator::sl_compile(
     Options_impl const    &options,
     Generated_code_source &code)
 {
+    MI::PROFILER::Scoped_phase phase(MI::PROFILER::PHASE_CODE_GENERATION);
+
     char const *store_env = nullptr;
 
     switch (target) {
@@ -120,6 +124,15 @@ void LLVM_code_generator::sl_compile(
         mpm.add(llvm::sl::createLoopExitEnumerationPass());  // ensure all loops have <= 1 exits
         mpm.add(llvm::sl::createRemovePointerPHIsPass());
         mpm.add(llvm::sl::createHandlePointerSelectsPass());
+        if (!m_enable_full_debug && options.get_bool_option(MDL_JIT_OPTION_SL_MERGE_FUNCTIONS)) {
+            // remove duplicate function bodies, for instance helpers shared by several
+            // functions of a link unit
+            llvm::SmallVector<llvm::Function *, 8> exported_funcs;
+            for (Exported_function const &exp_func : m_exported_func_list) {
+                exported_funcs.push_back(exp_func.func);
+            }
+            mpm.add(llvm::sl::createMergeIdenticalFunctionsPass(exported_funcs));
+        }
         mpm.add(llvm::sl::createASTComputePass(m_type_mapper));
         switch (target) {
         case ICode_generator::TL_HLSL:
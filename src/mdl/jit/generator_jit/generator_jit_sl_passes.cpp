@@ -28,7 +28,9 @@
 
 #include "pch.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/EquivalenceClasses.h>
+#include <llvm/ADT/SmallPtrSet.h>
 
 #if defined(__GNUC__) && (__GNUC__ >= 7)
 #pragma GCC diagnostic push
@@ -43,6 +45,7 @@
 #include <llvm/Pass.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include <llvm/Transforms/Utils/FunctionComparator.h>
 
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/IRPrintingPasses.h>
@@ -999,6 +1002,186 @@ llvm::Pass *createRemoveBoolVectorOPsPass(
     return new RemoveBoolVectorOPs(code_gen);
 }
 
+// ------------------------------------------------------------------------------------------
+
+/// This pass merges internal functions with identical bodies.
+class MergeIdenticalFunctions : public llvm::ModulePass
+{
+public:
+    static char ID;
+
+public:
+    /// Constructor.
+    ///
+    /// \param exported_funcs  functions that must not be removed
+    MergeIdenticalFunctions(
+        llvm::ArrayRef<llvm::Function *> exported_funcs);
+
+    /// Process a module.
+    ///
+    /// \param M  the module to process
+    ///
+    /// \return true if the IR was modified
+    bool runOnModule(llvm::Module &M) final;
+
+    /// Return a nice clean name for a pass.
+    llvm::StringRef getPassName() const final;
+
+private:
+    /// Check if the given function is a candidate for merging.
+    bool is_candidate(llvm::Function const &func) const;
+
+    /// Check if two structurally equal functions also use exactly the same types.
+    ///
+    /// The LLVM function comparator considers all pointers of the same address space
+    /// to be equal, which is not sufficient for the typed SL backends.
+    static bool have_identical_types(
+        llvm::Function const &f,
+        llvm::Function const &g);
+
+    /// Run one merge round over the module.
+    ///
+    /// \return true if any function was merged
+    bool merge_round(llvm::Module &M);
+
+private:
+    /// The functions that must not be removed.
+    llvm::SmallPtrSet<llvm::Function const *, 8> m_exported_funcs;
+};
+
+// Constructor.
+MergeIdenticalFunctions::MergeIdenticalFunctions(
+    llvm::ArrayRef<llvm::Function *> exported_funcs)
+: ModulePass(ID)
+, m_exported_funcs(exported_funcs.begin(), exported_funcs.end())
+{
+}
+
+// Return a nice clean name for a pass.
+llvm::StringRef MergeIdenticalFunctions::getPassName() const {
+    return "MergeIdenticalFunctions";
+}
+
+// Check if the given function is a candidate for merging.
+bool MergeIdenticalFunctions::is_candidate(llvm::Function const &func) const
+{
+    if (func.isDeclaration() || !func.hasLocalLinkage() || func.hasAddressTaken()) {
+        return false;
+    }
+    return m_exported_funcs.count(&func) == 0;
+}
+
+// Check if two structurally equal functions also use exactly the same types.
+bool MergeIdenticalFunctions::have_identical_types(
+    llvm::Function const &f,
+    llvm::Function const &g)
+{
+    if (f.getFunctionType() != g.getFunctionType()) {
+        return false;
+    }
+
+    // the comparator already ensured the same CFG and instruction sequence
+    for (auto f_bb = f.begin(), g_bb = g.begin(); f_bb != f.end(); ++f_bb, ++g_bb) {
+        for (auto f_it = f_bb->begin(), g_it = g_bb->begin(); f_it != f_bb->end(); ++f_it, ++g_it) {
+            llvm::Instruction const &f_inst = *f_it;
+            llvm::Instruction const &g_inst = *g_it;
+
+            if (f_inst.getType() != g_inst.getType() ||
+                f_inst.getNumOperands() != g_inst.getNumOperands())
+            {
+                return false;
+            }
+            for (unsigned i = 0, n = f_inst.getNumOperands(); i < n; ++i) {
+                if (f_inst.getOperand(i)->getType() != g_inst.getOperand(i)->getType()) {
+                    return false;
+                }
+            }
+
+            if (auto *f_gep = llvm::dyn_cast<llvm::GetElementPtrInst>(&f_inst)) {
+                auto *g_gep = llvm::cast<llvm::GetElementPtrInst>(&g_inst);
+                if (f_gep->getSourceElementType() != g_gep->getSourceElementType()) {
+                    return false;
+                }
+            } else if (auto *f_alloca = llvm::dyn_cast<llvm::AllocaInst>(&f_inst)) {
+                auto *g_alloca = llvm::cast<llvm::AllocaInst>(&g_inst);
+                if (f_alloca->getAllocatedType() != g_alloca->getAllocatedType()) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Run one merge round over the module.
+bool MergeIdenticalFunctions::merge_round(llvm::Module &M)
+{
+    typedef llvm::SmallVector<llvm::Function *, 4> Function_list;
+
+    // bucket all candidates by their structural hash
+    llvm::DenseMap<llvm::FunctionComparator::FunctionHash, Function_list> buckets;
+    for (llvm::Function &func : M.functions()) {
+        if (is_candidate(func)) {
+            buckets[llvm::FunctionComparator::functionHash(func)].push_back(&func);
+        }
+    }
+
+    llvm::GlobalNumberState global_numbers;
+    llvm::SmallVector<llvm::Function *, 8> to_remove;
+
+    for (auto &bucket : buckets) {
+        Function_list &funcs = bucket.second;
+        if (funcs.size() < 2) {
+            continue;
+        }
+
+        for (size_t i = 0, n = funcs.size(); i < n; ++i) {
+            llvm::Function *f = funcs[i];
+            if (f == nullptr) {
+                continue;
+            }
+            for (size_t j = i + 1; j < n; ++j) {
+                llvm::Function *g = funcs[j];
+                if (g == nullptr) {
+                    continue;
+                }
+
+                llvm::FunctionComparator cmp(f, g, &global_numbers);
+                if (cmp.compare() != 0 || !have_identical_types(*f, *g)) {
+                    continue;
+                }
+
+                g->replaceAllUsesWith(f);
+                to_remove.push_back(g);
+                funcs[j] = nullptr;
+            }
+        }
+    }
+
+    for (llvm::Function *func : to_remove) {
+        func->eraseFromParent();
+    }
+    return !to_remove.empty();
+}
+
+// Process a module.
+bool MergeIdenticalFunctions::runOnModule(llvm::Module &M)
+{
+    // merging functions can make their callers identical, so iterate until nothing changes
+    bool changed = false;
+    while (merge_round(M)) {
+        changed = true;
+    }
+    return changed;
+}
+
+char MergeIdenticalFunctions::ID = 0;
+
+llvm::Pass *createMergeIdenticalFunctionsPass(
+    llvm::ArrayRef<llvm::Function *> exported_funcs)
+{
+    return new MergeIdenticalFunctions(exported_funcs);
+}
 
 }  // sl
 }  // llvm
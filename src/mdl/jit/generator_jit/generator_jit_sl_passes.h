@@ -35,7 +35,10 @@ class LLVM_code_generator;
 } // mdl
 } // mi
 
+#include <llvm/ADT/ArrayRef.h>
+
 namespace llvm {
+class Function;
 class Pass;
 
 namespace sl {
@@ -61,6 +64,15 @@ llvm::Pass *createRemovePointerPHIsPass();
 llvm::Pass *createRemoveBoolVectorOPsPass(
     mi::mdl::LLVM_code_generator &code_gen);
 
+/// Creates a pass that merges internal functions with identical bodies.
+/// In contrast to LLVM's MergeFunctions pass, functions are only merged if all involved
+/// types are identical, so no pointer casts are introduced which would not be expressible
+/// in HLSL/GLSL. All calls to a duplicate are redirected to the remaining function.
+///
+/// \param exported_funcs  functions that must not be removed
+llvm::Pass *createMergeIdenticalFunctionsPass(
+    llvm::ArrayRef<llvm::Function *> exported_funcs);
+
 }  // sl
 }  // llvm
 
@@ -34,6 +34,8 @@
 
 #include "spectral_tables.h"
 
+#include <cstddef>
+
 namespace mi {
 namespace mdl {
 namespace spectral {
@@ -145,6 +147,52 @@ void cs_emission_to_spectrum(
     Color_space_id cs);
 
 
+// batched conversions for whole tiles of colors or spectra:
+// - all data is stored as structure-of-arrays, a batch of 'count' elements keeps each channel
+//   (color component or spectral sample) in its own plane of 'count' consecutive floats, i.e.
+//   channel c of element i is found at data[c * count + i]
+// - setup work (selecting tables, resampling the color matching functions, computing
+//   interpolation weights) is done once per batch, the inner loops run over the elements of a
+//   plane (or over the wavelengths of the reconstructed spectra) and are simple enough to be
+//   vectorized by the compiler
+// - the scalar functions are batches of one element, except for spectrum_to_XYZ() which is used
+//   by spectrum_to_XYZ_batch() for small batches
+
+// convert a batch of spectra to XYZ (3 planes), see spectrum_to_XYZ()
+void spectrum_to_XYZ_batch(
+    float *XYZ,
+    const float *spectra, size_t count, unsigned int num_values,
+    float lambda_min, float lambda_max);
+
+// convert a batch of spectra to colors in a color space (3 planes), i.e. spectrum_to_XYZ()
+// followed by convert_XYZ_to_cs()
+void spectrum_to_cs_batch(
+    float *color,
+    const float *spectra, size_t count, unsigned int num_values,
+    float lambda_min, float lambda_max,
+    Color_space_id cs);
+
+// change number of point samples and range for a batch of spectra, see spectrum_resample()
+void spectrum_resample_batch(
+    float *target, unsigned int target_num_values, float target_lambda_min, float target_lambda_max,
+    const float *source, size_t count, unsigned int source_num_values, float source_lambda_min,
+    float source_lambda_max);
+
+// conversion of a batch of colors from and to CIE XYZ (3 planes each)
+void convert_XYZ_to_cs_batch(
+    float *target, const float *source, size_t count, Color_space_id target_id);
+void convert_cs_to_XYZ_batch(
+    float *target, const float *source, size_t count, Color_space_id source_id);
+
+// re-construct a batch of reflectivity spectra (SPECTRAL_XYZ_RES planes) from a batch of
+// color reflectivities (3 planes), see cs_refl_to_spectrum()
+void cs_refl_to_spectrum_batch(
+    float *values,
+    const float *colors, size_t count,
+    Color_space_id cs,
+    bool aggressive = false,
+    bool ignore_scale = false);
+
 } // namespace spectral
 } // namespace mdl
 } // namespace mi
@@ -40,6 +40,7 @@
 #include <cstring>
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 namespace mi {
 namespace mdl {
@@ -251,14 +252,10 @@ void spectrum_resample(
     const float *const source, unsigned int const source_num_values, 
     const float source_lambda_min, const float source_lambda_max)
 {
-    MDL_ASSERT(target_num_values > 1);
-    const float step = (target_lambda_max - target_lambda_min) / (float)(target_num_values - 1);
-    for (unsigned int i = 0; i < target_num_values; ++i)
-    {
-        const float lambda = target_lambda_min + (float)i * step;
-        target[i] = 
-            get_value_lerp(source, source_num_values, source_lambda_min, source_lambda_max, lambda);
-    }
+    // a single spectrum is a batch with planes of one element
+    spectrum_resample_batch(
+        target, target_num_values, target_lambda_min, target_lambda_max,
+        source, 1, source_num_values, source_lambda_min, source_lambda_max);
 }
 
 // helper for function below
@@ -427,44 +424,12 @@ const float *get_cs_to_XYZ(const Color_space_id cs)
 
 void convert_XYZ_to_cs(float target[3], const float source[3], const Color_space_id cs)
 {
-    const float *const m = get_XYZ_to_cs(cs);
-    if (!cs)
-    {
-        target[0] = source[0];
-        target[1] = source[1];
-        target[2] = source[2];
-        return;
-    }
-
-    target[0] = source[0] * m[0];
-    target[1] = source[0] * m[3];
-    target[2] = source[0] * m[6];
-    for (unsigned int i = 1; i < 3; ++i) {
-        target[0] += source[i] * m[i];
-        target[1] += source[i] * m[3 + i];
-        target[2] += source[i] * m[6 + i];
-    }
+    convert_XYZ_to_cs_batch(target, source, 1, cs);
 }
 
 void convert_cs_to_XYZ(float target[3], const float source[3], const Color_space_id cs)
 {
-    const float *const m = get_cs_to_XYZ(cs);
-    if (!m)
-    {
-        target[0] = source[0];
-        target[1] = source[1];
-        target[2] = source[2];
-        return;
-    }
-
-    target[0] = source[0] * m[0];
-    target[1] = source[0] * m[3];
-    target[2] = source[0] * m[6];
-    for (unsigned int i = 1; i < 3; ++i) {
-        target[0] += source[i] * m[i];
-        target[1] += source[i] * m[3 + i];
-        target[2] += source[i] * m[6 + i];
-    }
+    convert_cs_to_XYZ_batch(target, source, 1, cs);
 }
 
 /// The MDL blackbody function implementation.
@@ -646,58 +611,66 @@ static void cs_refl_to_spectrum_smits(
 }
 
 
-void cs_refl_to_spectrum(
-    float values[SPECTRAL_XYZ_RES],
-    const float color[3],
-    const Color_space_id cs,
-    const bool aggressive,
-    const bool ignore_scale)
+// select the chromaticity grid for the white point of a color space
+static void get_chroma_grid(
+    const Chroma_grid_info **chroma_grid_info,
+    const Chroma_cell **chroma_cells,
+    const float **chroma_spectra,
+    float *illum_cs, // illuminant in color space (is 'white' in that color space, so only scalar)
+    const Color_space_id cs)
 {
-    if (aggressive && (cs == CS_sRGB))
-    {
-        cs_refl_to_spectrum_smits(values, color, cs);
-        return;
-    }
-
-    memset(values, 0, SPECTRAL_XYZ_RES * sizeof(float));
-
-    const Chroma_grid_info *chroma_grid_info;
-    const Chroma_cell *chroma_cells;
-    const float *chroma_spectra;
-    float illum_cs; // illuminant in color space (is 'white' in that color space, so only scalar)
     switch (cs)
     {
         default:
         case CS_XYZ:
-            chroma_grid_info = &chroma_grid_info_e;
-            chroma_cells = chroma_cells_e;
-            chroma_spectra = chroma_spectra_e;
-            illum_cs = (float)(1.0 / 3.0);
+            *chroma_grid_info = &chroma_grid_info_e;
+            *chroma_cells = chroma_cells_e;
+            *chroma_spectra = chroma_spectra_e;
+            *illum_cs = (float)(1.0 / 3.0);
             break;
         case CS_ACES:
         case CS_ACEScg:
-            chroma_grid_info = &chroma_grid_info_d60;
-            chroma_cells = chroma_cells_d60;
-            chroma_spectra = chroma_spectra_d60;
-            illum_cs = 0.337670f;
+            *chroma_grid_info = &chroma_grid_info_d60;
+            *chroma_cells = chroma_cells_d60;
+            *chroma_spectra = chroma_spectra_d60;
+            *illum_cs = 0.337670f;
             break;
         case CS_sRGB:
         case CS_Rec2020:
-            chroma_grid_info = &chroma_grid_info_d65;
-            chroma_cells = chroma_cells_d65;
-            chroma_spectra = chroma_spectra_d65;
-            illum_cs = 0.329000f;
+            *chroma_grid_info = &chroma_grid_info_d65;
+            *chroma_cells = chroma_cells_d65;
+            *chroma_spectra = chroma_spectra_d65;
+            *illum_cs = 0.329000f;
             break;
     }
+}
 
-    const float val_cs[3] = {
-        color[0] * illum_cs,
-        color[1] * illum_cs,
-        color[2] * illum_cs
-    };
+void cs_refl_to_spectrum(
+    float values[SPECTRAL_XYZ_RES],
+    const float color[3],
+    const Color_space_id cs,
+    const bool aggressive,
+    const bool ignore_scale)
+{
+    cs_refl_to_spectrum_batch(values, color, 1, cs, aggressive, ignore_scale);
+}
+
+
+void cs_emission_to_spectrum(
+    float values[SPECTRAL_XYZ_RES],
+    const float color[3],
+    const Color_space_id cs)
+{
+    memset(values, 0, SPECTRAL_XYZ_RES * sizeof(float));
+
+    const Chroma_grid_info *chroma_grid_info;
+    const Chroma_cell *chroma_cells;
+    const float *chroma_spectra;
+    float illum_cs;
+    get_chroma_grid(&chroma_grid_info, &chroma_cells, &chroma_spectra, &illum_cs, cs);
 
     float val_XYZ[3];
-    convert_cs_to_XYZ(val_XYZ, val_cs, cs);
+    convert_cs_to_XYZ(val_XYZ, color, cs);
 
     const float sum = val_XYZ[0] + val_XYZ[1] + val_XYZ[2];
     const float x = val_XYZ[0] / sum;
@@ -709,92 +682,288 @@ void cs_refl_to_spectrum(
     if (num == 0)
         return;
 
-    const float *illum = &chroma_spectra[chroma_grid_info->white_idx * (SPECTRAL_XYZ_RES + 1) + 1];
-
-    float max_refl = 0.0f;
     for (unsigned int j = 0; j < num; ++j)
     {
         const float *s = &chroma_spectra[idx[j] * (SPECTRAL_XYZ_RES + 1) + 1];
-        max_refl += w[j] * s[-1];
 
         for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
-            values[k] += w[j] * s[k] / illum[k];
+            values[k] += w[j] * s[k];
     }
 
-    float scale = val_XYZ[1] / y;
-    if (ignore_scale)
+    // do scaling since tables were constructed for simple matrix product "M_srgb * (x,y,z) * spectrum = color", not for integral spectral radiometric -> photometric
+    const float scale = sum * (float)(1.0 / (683.002 * (SPECTRAL_XYZ_LAMBDA_STEP)));
+    for (unsigned int j = 0; j < SPECTRAL_XYZ_RES; ++j)
+        values[j] *= scale;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// batched conversions
+// ------------------------------------------------------------------------------------------------
+
+// compute the linear map from a spectrum with the given sampling to XYZ, i.e. XYZ[c] is
+// sum_k proj[c * num_values + k] * spectrum[k]
+// (dot_lerp is linear in the spectrum, so the weights are obtained from the unit spectra)
+static void get_XYZ_projection(
+    float *const proj,
+    const unsigned int num_values,
+    const float lambda_min, const float lambda_max)
+{
+    const float *const cmf[3] = { SPECTRAL_XYZ1931_X, SPECTRAL_XYZ1931_Y, SPECTRAL_XYZ1931_Z };
+
+    std::vector<float> unit(num_values, 0.0f);
+    for (unsigned int k = 0; k < num_values; ++k)
     {
-        for (unsigned int j = 0; j < SPECTRAL_XYZ_RES; ++j)
-            values[j] *= scale;
+        unit[k] = 1.0f;
+        for (unsigned int c = 0; c < 3; ++c) {
+            // conversion from Watt to lumen
+            proj[c * num_values + k] = 683.002f * dot_lerp(
+                unit.data(), num_values, lambda_min, lambda_max,
+                cmf[c], SPECTRAL_XYZ_RES, SPECTRAL_XYZ_LAMBDA_MIN, SPECTRAL_XYZ_LAMBDA_MAX);
+        }
+        unit[k] = 0.0f;
     }
-    else
-    {
-        const float max_scale = max_refl > 0.0f ? 1.0f / max_refl : 0.0f;
-        scale = std::min(scale, max_scale);
+}
 
-        for (unsigned int j = 0; j < SPECTRAL_XYZ_RES; ++j)
-            values[j] = std::min(1.0f, values[j] * scale); //!! paranoia clamp to 1.0
+// apply a 3x3 matrix to a batch of colors
+static void transform_batch(
+    float *const target,
+    const float *const source,
+    const size_t count,
+    const float *const m)
+{
+    const float *const s0 = source;
+    const float *const s1 = source + count;
+    const float *const s2 = source + 2 * count;
+    float t[3];
+    for (size_t i = 0; i < count; ++i) {
+        t[0] = s0[i] * m[0] + s1[i] * m[1] + s2[i] * m[2];
+        t[1] = s0[i] * m[3] + s1[i] * m[4] + s2[i] * m[5];
+        t[2] = s0[i] * m[6] + s1[i] * m[7] + s2[i] * m[8];
+        // write after reading to allow in-place conversion
+        target[i] = t[0];
+        target[count + i] = t[1];
+        target[2 * count + i] = t[2];
     }
 }
 
+void spectrum_to_XYZ_batch(
+    float *const XYZ,
+    const float *const spectra, const size_t count, const unsigned int num_values,
+    const float lambda_min, const float lambda_max)
+{
+    MDL_ASSERT(num_values > 1);
 
-void cs_emission_to_spectrum(
-    float values[SPECTRAL_XYZ_RES],
-    const float color[3],
+    // setting up the projection costs about as much as converting num_values spectra directly
+    if (count < num_values)
+    {
+        std::vector<float> spectrum(num_values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (unsigned int k = 0; k < num_values; ++k)
+                spectrum[k] = spectra[k * count + i];
+
+            float val[3];
+            spectrum_to_XYZ(val, spectrum.data(), num_values, lambda_min, lambda_max);
+            XYZ[i] = val[0];
+            XYZ[count + i] = val[1];
+            XYZ[2 * count + i] = val[2];
+        }
+        return;
+    }
+
+    std::vector<float> proj(3 * num_values);
+    get_XYZ_projection(proj.data(), num_values, lambda_min, lambda_max);
+
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+        float *const out = XYZ + c * count;
+        std::fill(out, out + count, 0.0f);
+
+        const float *const w = &proj[c * num_values];
+        for (unsigned int k = 0; k < num_values; ++k)
+        {
+            const float wk = w[k];
+            if (wk == 0.0f)
+                continue;
+
+            const float *const s = spectra + k * count;
+            for (size_t i = 0; i < count; ++i)
+                out[i] += wk * s[i];
+        }
+    }
+}
+
+void spectrum_to_cs_batch(
+    float *const color,
+    const float *const spectra, const size_t count, const unsigned int num_values,
+    const float lambda_min, const float lambda_max,
     const Color_space_id cs)
 {
-    memset(values, 0, SPECTRAL_XYZ_RES * sizeof(float));
+    spectrum_to_XYZ_batch(color, spectra, count, num_values, lambda_min, lambda_max);
+    convert_XYZ_to_cs_batch(color, color, count, cs);
+}
 
-    const Chroma_grid_info *chroma_grid_info;
-    const Chroma_cell *chroma_cells;
-    const float *chroma_spectra;
-    switch (cs)
+void spectrum_resample_batch(
+    float *const target, const unsigned int target_num_values,
+    const float target_lambda_min, const float target_lambda_max,
+    const float *const source, const size_t count, const unsigned int source_num_values,
+    const float source_lambda_min, const float source_lambda_max)
+{
+    MDL_ASSERT(target_num_values > 1);
+    MDL_ASSERT(source_num_values > 1);
+
+    const float step = (target_lambda_max - target_lambda_min) / (float)(target_num_values - 1);
+    for (unsigned int j = 0; j < target_num_values; ++j)
     {
-        default:
-        case CS_XYZ:
-            chroma_grid_info = &chroma_grid_info_e;
-            chroma_cells = chroma_cells_e;
-            chroma_spectra = chroma_spectra_e;
-            break;
-        case CS_ACES:
-        case CS_ACEScg:
-            chroma_grid_info = &chroma_grid_info_d60;
-            chroma_cells = chroma_cells_d60;
-            chroma_spectra = chroma_spectra_d60;
-            break;
-        case CS_sRGB:
-        case CS_Rec2020:
-            chroma_grid_info = &chroma_grid_info_d65;
-            chroma_cells = chroma_cells_d65;
-            chroma_spectra = chroma_spectra_d65;
-            break;
+        // same lookup as get_value_lerp, but computed once for all spectra of the batch
+        const float lambda = target_lambda_min + (float)j * step;
+        const float f = std::max(
+            (lambda - source_lambda_min) / (source_lambda_max - source_lambda_min) *
+            (float)(source_num_values - 1), 0.0f);
+        unsigned int b0 = (unsigned int)(std::max(floorf(f), 0.0f));
+        if (b0 >= source_num_values)
+            b0 = source_num_values - 1;
+        const unsigned int b1 = (b0 == source_num_values - 1) ? b0 : b0 + 1;
+        const float f1 = f - (float)b0;
+        const float f0 = 1.0f - f1;
+
+        const float *const s0 = source + b0 * count;
+        const float *const s1 = source + b1 * count;
+        float *const out = target + j * count;
+        for (size_t i = 0; i < count; ++i)
+            out[i] = s0[i] * f0 + s1[i] * f1;
     }
+}
 
-    float val_XYZ[3];
-    convert_cs_to_XYZ(val_XYZ, color, cs);
+void convert_XYZ_to_cs_batch(
+    float *const target, const float *const source, const size_t count,
+    const Color_space_id cs)
+{
+    const float *const m = get_XYZ_to_cs(cs);
+    if (!m)
+    {
+        if (target != source)
+            memcpy(target, source, 3 * count * sizeof(float));
+        return;
+    }
+    transform_batch(target, source, count, m);
+}
 
-    const float sum = val_XYZ[0] + val_XYZ[1] + val_XYZ[2];
-    const float x = val_XYZ[0] / sum;
-    const float y = val_XYZ[1] / sum;
+void convert_cs_to_XYZ_batch(
+    float *const target, const float *const source, const size_t count,
+    const Color_space_id cs)
+{
+    const float *const m = get_cs_to_XYZ(cs);
+    if (!m)
+    {
+        if (target != source)
+            memcpy(target, source, 3 * count * sizeof(float));
+        return;
+    }
+    transform_batch(target, source, count, m);
+}
 
-    unsigned int idx[4];
-    float w[4];
-    const unsigned int num = get_spectra(idx, w, x, y, chroma_grid_info, chroma_cells);
-    if (num == 0)
+void cs_refl_to_spectrum_batch(
+    float *const values,
+    const float *const colors, const size_t count,
+    const Color_space_id cs,
+    const bool aggressive,
+    const bool ignore_scale)
+{
+    if (aggressive && (cs == CS_sRGB))
+    {
+        // Smits' method is cheap and branchy, simply scatter the scalar results
+        float spectrum[SPECTRAL_XYZ_RES];
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float color[3] = { colors[i], colors[count + i], colors[2 * count + i] };
+            cs_refl_to_spectrum_smits(spectrum, color, cs);
+            for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+                values[k * count + i] = spectrum[k];
+        }
         return;
+    }
 
-    for (unsigned int j = 0; j < num; ++j)
+    const Chroma_grid_info *chroma_grid_info;
+    const Chroma_cell *chroma_cells;
+    const float *chroma_spectra;
+    float illum_cs;
+    get_chroma_grid(&chroma_grid_info, &chroma_cells, &chroma_spectra, &illum_cs, cs);
+
+    const float *const m = get_cs_to_XYZ(cs);
+    static const float identity[9] = {
+        1.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 1.0f
+    };
+    const float *const tf = m ? m : identity;
+
+    // the division by the illuminant is the same for all elements
+    const unsigned int stride = SPECTRAL_XYZ_RES + 1;
+    const float *const illum = &chroma_spectra[chroma_grid_info->white_idx * stride + 1];
+    float inv_illum[SPECTRAL_XYZ_RES];
+    for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+        inv_illum[k] = 1.0f / illum[k];
+
+    float spectrum[SPECTRAL_XYZ_RES];
+    for (size_t e = 0; e < count; ++e)
     {
-        const float *s = &chroma_spectra[idx[j] * (SPECTRAL_XYZ_RES + 1) + 1];
+        // chromaticity grid lookup
+        const float val_cs[3] = {
+            colors[e] * illum_cs,
+            colors[count + e] * illum_cs,
+            colors[2 * count + e] * illum_cs
+        };
+        const float val_XYZ[3] = {
+            val_cs[0] * tf[0] + val_cs[1] * tf[1] + val_cs[2] * tf[2],
+            val_cs[0] * tf[3] + val_cs[1] * tf[4] + val_cs[2] * tf[5],
+            val_cs[0] * tf[6] + val_cs[1] * tf[7] + val_cs[2] * tf[8]
+        };
+
+        const float sum = val_XYZ[0] + val_XYZ[1] + val_XYZ[2];
+        const float x = val_XYZ[0] / sum;
+        const float y = val_XYZ[1] / sum;
+
+        unsigned int idx[4];
+        float w[4];
+        const unsigned int num = get_spectra(idx, w, x, y, chroma_grid_info, chroma_cells);
+        if (num == 0)
+        {
+            for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+                values[k * count + e] = 0.0f;
+            continue;
+        }
+
+        // weighted sum of the grid spectra, the inner loops run over consecutive wavelengths
+        float max_refl = 0.0f;
+        std::fill(spectrum, spectrum + SPECTRAL_XYZ_RES, 0.0f);
+        for (unsigned int j = 0; j < num; ++j)
+        {
+            const float *const s = &chroma_spectra[idx[j] * stride + 1];
+            const float wj = w[j];
+            max_refl += wj * s[-1];
+
+            for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+                spectrum[k] += wj * s[k];
+        }
+
+        float scale = val_XYZ[1] / y;
+        if (!ignore_scale)
+            scale = std::min(scale, max_refl > 0.0f ? 1.0f / max_refl : 0.0f);
 
         for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
-            values[k] += w[j] * s[k];
-    }
+            spectrum[k] *= inv_illum[k] * scale;
+        if (!ignore_scale)
+        {
+            for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+                spectrum[k] = std::min(1.0f, spectrum[k]); //!! paranoia clamp to 1.0
+        }
 
-    // do scaling since tables were constructed for simple matrix product "M_srgb * (x,y,z) * spectrum = color", not for integral spectral radiometric -> photometric
-    const float scale = sum * (float)(1.0 / (683.002 * (SPECTRAL_XYZ_LAMBDA_STEP)));
-    for (unsigned int j = 0; j < SPECTRAL_XYZ_RES; ++j)
-        values[j] *= scale;
+        // store into the planes, contiguous for a single element
+        for (unsigned int k = 0; k < SPECTRAL_XYZ_RES; ++k)
+            values[k * count + e] = spectrum[k];
+    }
 }
 
 
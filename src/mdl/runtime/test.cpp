@@ -0,0 +1,212 @@
+/******************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "pch.h"
+
+#define MI_TEST_AUTO_SUITE_NAME "Regression Test Suite for mdl/runtime"
+
+#include <base/system/test/i_test_auto_driver.h>
+#include <base/system/test/i_test_auto_case.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "spectral/i_spectral.h"
+
+using namespace mi::mdl::spectral;
+
+namespace {
+
+// simple deterministic random numbers in [0, 1)
+float next_random( unsigned& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return float( state >> 8) / float( 1u << 24);
+}
+
+// fills a batch of count elements with num_planes planes
+std::vector<float> random_batch( size_t count, unsigned num_planes, float scale)
+{
+    std::vector<float> data( count * num_planes);
+    unsigned state = 42u;
+    for( float& v : data)
+        v = next_random( state) * scale;
+    return data;
+}
+
+// checks that two values are equal up to a relative tolerance
+void check_close( float a, float b, float eps)
+{
+    MI_CHECK_CLOSE( a, b, eps * std::max( 1.0f, std::max( std::abs( a), std::abs( b))));
+}
+
+const Color_space_id color_spaces[] = { CS_XYZ, CS_sRGB, CS_ACES, CS_ACEScg, CS_Rec2020 };
+
+// batch sizes with single elements, small batches and non-power-of-two large batches
+const size_t batch_sizes[] = { 1, 3, 17, 150 };
+
+} // namespace
+
+MI_TEST_AUTO_FUNCTION( test_spectrum_to_XYZ_batch )
+{
+    // sampling coarser and finer than the color matching functions
+    const unsigned num_values[] = { 8, 40, 120 };
+    for( unsigned n : num_values) {
+        for( size_t count : batch_sizes) {
+            const std::vector<float> spectra = random_batch( count, n, 1.0f);
+            std::vector<float> XYZ( 3 * count);
+            spectrum_to_XYZ_batch( XYZ.data(), spectra.data(), count, n, 380.0f, 780.0f);
+
+            std::vector<float> color( 3 * count);
+            spectrum_to_cs_batch( color.data(), spectra.data(), count, n, 380.0f, 780.0f, CS_sRGB);
+
+            std::vector<float> spectrum( n);
+            for( size_t i = 0; i < count; ++i) {
+                for( unsigned k = 0; k < n; ++k)
+                    spectrum[k] = spectra[k * count + i];
+                float ref[3];
+                spectrum_to_XYZ( ref, spectrum.data(), n, 380.0f, 780.0f);
+                float ref_cs[3];
+                convert_XYZ_to_cs( ref_cs, ref, CS_sRGB);
+                for( unsigned c = 0; c < 3; ++c) {
+                    check_close( XYZ[c * count + i], ref[c], 1e-4f);
+                    check_close( color[c * count + i], ref_cs[c], 1e-4f);
+                }
+            }
+        }
+    }
+}
+
+MI_TEST_AUTO_FUNCTION( test_spectrum_resample_batch )
+{
+    const unsigned source_n = 31;
+    const unsigned target_n = 57;
+    for( size_t count : batch_sizes) {
+        const std::vector<float> source = random_batch( count, source_n, 2.0f);
+        std::vector<float> target( count * target_n);
+        spectrum_resample_batch(
+            target.data(), target_n, 360.0f, 830.0f,
+            source.data(), count, source_n, 400.0f, 700.0f);
+
+        std::vector<float> spectrum( source_n);
+        const float step = (830.0f - 360.0f) / float( target_n - 1);
+        for( size_t i = 0; i < count; ++i) {
+            for( unsigned k = 0; k < source_n; ++k)
+                spectrum[k] = source[k * count + i];
+            for( unsigned j = 0; j < target_n; ++j) {
+                const float ref = get_value_lerp(
+                    spectrum.data(), source_n, 400.0f, 700.0f, 360.0f + float( j) * step);
+                check_close( target[j * count + i], ref, 1e-5f);
+            }
+        }
+    }
+}
+
+MI_TEST_AUTO_FUNCTION( test_convert_batch )
+{
+    for( Color_space_id cs : color_spaces) {
+        for( size_t count : batch_sizes) {
+            const std::vector<float> XYZ = random_batch( count, 3, 1.0f);
+
+            // in-place round trip
+            std::vector<float> data = XYZ;
+            convert_XYZ_to_cs_batch( data.data(), data.data(), count, cs);
+            for( size_t i = 0; i < count; ++i) {
+                const float xyz[3] = { XYZ[i], XYZ[count + i], XYZ[2 * count + i] };
+                float ref[3];
+                convert_XYZ_to_cs( ref, xyz, cs);
+                for( unsigned c = 0; c < 3; ++c)
+                    check_close( data[c * count + i], ref[c], 1e-5f);
+            }
+            convert_cs_to_XYZ_batch( data.data(), data.data(), count, cs);
+            for( size_t i = 0; i < 3 * count; ++i)
+                check_close( data[i], XYZ[i], 1e-3f);
+        }
+    }
+}
+
+MI_TEST_AUTO_FUNCTION( test_cs_refl_to_spectrum_batch )
+{
+    for( Color_space_id cs : color_spaces) {
+        for( size_t count : batch_sizes) {
+            std::vector<float> colors = random_batch( count, 3, 1.0f);
+            colors[0] = colors[count] = colors[2 * count] = 0.0f; // black
+
+            for( unsigned mode = 0; mode < 3; ++mode) {
+                const bool aggressive = mode == 1;
+                const bool ignore_scale = mode == 2;
+
+                std::vector<float> spectra( count * SPECTRAL_XYZ_RES);
+                cs_refl_to_spectrum_batch(
+                    spectra.data(), colors.data(), count, cs, aggressive, ignore_scale);
+
+                for( size_t i = 0; i < count; ++i) {
+                    const float color[3] = { colors[i], colors[count + i], colors[2 * count + i] };
+                    float ref[SPECTRAL_XYZ_RES];
+                    cs_refl_to_spectrum( ref, color, cs, aggressive, ignore_scale);
+                    for( unsigned k = 0; k < SPECTRAL_XYZ_RES; ++k) {
+                        const float v = spectra[k * count + i];
+                        check_close( v, ref[k], 1e-5f);
+                        MI_CHECK( v >= 0.0f);
+                        if( !ignore_scale)
+                            MI_CHECK( v <= 1.0f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+MI_TEST_AUTO_FUNCTION( test_cs_refl_to_spectrum_round_trip )
+{
+    // reconstructed spectra reproduce their (in-gamut) colors relative to white
+    const float white[3] = { 1.0f, 1.0f, 1.0f };
+    float spectrum[SPECTRAL_XYZ_RES];
+    cs_refl_to_spectrum( spectrum, white, CS_sRGB);
+    for( unsigned k = 0; k < SPECTRAL_XYZ_RES; ++k)
+        MI_CHECK_CLOSE( spectrum[k], 1.0f, 1e-3f);
+
+    float refl_white[3];
+    spectrum_to_cs_refl(
+        refl_white, spectrum, SPECTRAL_XYZ_RES,
+        SPECTRAL_XYZ_LAMBDA_MIN, SPECTRAL_XYZ_LAMBDA_MAX, CS_sRGB);
+
+    const float colors[][3] = {
+        { 0.5f, 0.5f, 0.5f }, { 0.6f, 0.3f, 0.2f }, { 0.2f, 0.4f, 0.3f }, { 0.1f, 0.2f, 0.5f } };
+    for( const float* color : colors) {
+        cs_refl_to_spectrum( spectrum, color, CS_sRGB);
+
+        float refl[3];
+        spectrum_to_cs_refl(
+            refl, spectrum, SPECTRAL_XYZ_RES,
+            SPECTRAL_XYZ_LAMBDA_MIN, SPECTRAL_XYZ_LAMBDA_MAX, CS_sRGB);
+        for( unsigned c = 0; c < 3; ++c)
+            MI_CHECK_CLOSE( refl[c] / refl_white[c], color[c], 0.02f);
+    }
+}
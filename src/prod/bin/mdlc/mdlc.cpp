@@ -47,6 +47,10 @@
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <thread>
 #include <vector>
 
 #include <mi/base/handle.h>
@@ -62,6 +66,7 @@
 
 #include <string>
 #include <algorithm>
+#include <base/lib/profiler/i_profiler.h>
 #include <base/system/version/i_version.h>
 
 #include <mdl/compiler/compilercore/compilercore_mdl.h>
@@ -95,21 +100,253 @@ using mi::mdl::IOutput_stream;
 using mi::mdl::IInput_stream;
 using mi::mdl::IThread_context;
 using mi::mdl::IMDL_module_transformer;
+using mi::mdl::IModule_cache;
+using mi::mdl::IModule_cache_lookup_handle;
+using mi::mdl::IModule_loaded_callback;
 
 using namespace std;
 
-/// Print messages to a printer.
+/// A thread-safe module cache shared by all threads of the compiler.
 ///
-/// \param msgs     the messages
-/// \param printer  the printer
-static void print_messages(Messages const &msgs, IPrinter *printer)
+/// Every module is compiled at most once. A thread importing a module that is currently compiled
+/// by another thread waits for the result.
+class Mdlc_module_cache : public IModule_cache, public IModule_loaded_callback
 {
-    for (size_t i = 0, n = msgs.get_message_count(); i < n; ++i) {
-        IMessage const *msg = msgs.get_message(i);
-        printer->print(msg, /*include_notes=*/true);
+    /// The lookup handle, one per module load.
+    class Lookup_handle : public IModule_cache_lookup_handle
+    {
+    public:
+        /// Constructor.
+        Lookup_handle()
+        : m_name()
+        , m_processing(false)
+        {
+        }
+
+        /// Get an identifier to be used throughout the loading of a module.
+        char const *get_lookup_name() const MDL_FINAL { return m_name.c_str(); }
+
+        /// Returns true if this handle belongs to context that loads module.
+        bool is_processing() const MDL_FINAL { return m_processing; }
+
+        /// The absolute name of the module.
+        std::string m_name;
+
+        /// True if the owning thread loads the module.
+        bool m_processing;
+    };
+
+    /// A cache entry.
+    struct Entry {
+        /// Constructor.
+        Entry()
+        : m_module()
+        , m_owner()
+        , m_failed(false)
+        {
+        }
+
+        /// The module, once loaded.
+        mi::base::Handle<IModule const> m_module;
+
+        /// The thread loading the module, or the default id if none.
+        std::thread::id m_owner;
+
+        /// True if loading the module failed.
+        bool m_failed;
+    };
+
+    typedef std::map<std::string, Entry> Entry_map;
+
+public:
+    /// Create a lookup handle.
+    IModule_cache_lookup_handle *create_lookup_handle() const MDL_FINAL
+    {
+        return new Lookup_handle();
+    }
+
+    /// Free a handle created by create_lookup_handle().
+    void free_lookup_handle(IModule_cache_lookup_handle *handle) const MDL_FINAL
+    {
+        delete static_cast<Lookup_handle *>(handle);
+    }
+
+    /// Lookup a module.
+    ///
+    /// If the module is not yet known, the calling thread becomes responsible for loading it.
+    /// If it is currently loaded by another thread, wait until that thread has finished.
+    IModule const *lookup(
+        char const                  *absname,
+        IModule_cache_lookup_handle *handle) const MDL_FINAL
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        if (handle == NULL) {
+            // just check if the module is loaded
+            Entry_map::const_iterator it(m_entries.find(absname));
+            if (it == m_entries.end() || !it->second.m_module.is_valid_interface()) {
+                return NULL;
+            }
+            it->second.m_module->retain();
+            return it->second.m_module.get();
+        }
+
+        Lookup_handle *lookup_handle = static_cast<Lookup_handle *>(handle);
+        lookup_handle->m_name = absname;
+
+        std::string name(absname);
+        std::thread::id self(std::this_thread::get_id());
+        for (;;) {
+            Entry &entry = m_entries[name];
+            if (entry.m_module.is_valid_interface()) {
+                entry.m_module->retain();
+                return entry.m_module.get();
+            }
+            if (entry.m_failed) {
+                return NULL;
+            }
+            if (entry.m_owner == std::thread::id()) {
+                // load it on this thread
+                entry.m_owner = self;
+                lookup_handle->m_processing = true;
+                return NULL;
+            }
+            if (waits_for(entry.m_owner, self)) {
+                // an import cycle, waiting would never end
+                return NULL;
+            }
+            m_waiting[self] = name;
+            m_cond.wait(lock);
+            m_waiting.erase(self);
+        }
+    }
+
+    /// Get the module loading callback.
+    IModule_loaded_callback *get_module_loading_callback() const MDL_FINAL
+    {
+        return const_cast<Mdlc_module_cache *>(this);
+    }
+
+    /// Called when a module was loaded successfully.
+    bool register_module(IModule const *module) MDL_FINAL
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        Entry &entry = m_entries[module->get_name()];
+        if (!entry.m_module.is_valid_interface()) {
+            entry.m_module = mi::base::make_handle_dup(module);
+        }
+        entry.m_owner = std::thread::id();
+        m_cond.notify_all();
+        return true;
     }
+
+    /// Called when a module was not found or when loading failed.
+    void module_loading_failed(IModule_cache_lookup_handle const &handle) MDL_FINAL
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        Entry &entry = m_entries[handle.get_lookup_name()];
+        entry.m_owner = std::thread::id();
+        entry.m_failed = true;
+        m_cond.notify_all();
+    }
+
+    /// Check if a built-in module is already registered.
+    bool is_builtin_module_registered(char const *absname) const MDL_FINAL
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        Entry_map::const_iterator it(m_entries.find(absname));
+        return it != m_entries.end() && it->second.m_module.is_valid_interface();
+    }
+
+private:
+    /// Check if the given thread (transitively) waits for a module loaded by the thread other.
+    ///
+    /// \note The lock must be held.
+    bool waits_for(std::thread::id owner, std::thread::id other) const
+    {
+        for (size_t i = 0, n = m_waiting.size(); i <= n; ++i) {
+            if (owner == other) {
+                return true;
+            }
+            std::map<std::thread::id, std::string>::const_iterator it(m_waiting.find(owner));
+            if (it == m_waiting.end()) {
+                return false;
+            }
+            Entry_map::const_iterator e(m_entries.find(it->second));
+            if (e == m_entries.end()) {
+                return false;
+            }
+            owner = e->second.m_owner;
+        }
+        return true;
+    }
+
+private:
+    /// Protects all members.
+    mutable std::mutex m_lock;
+
+    /// Signaled when a module was loaded or failed to load.
+    mutable std::condition_variable m_cond;
+
+    /// All modules known to the cache.
+    mutable Entry_map m_entries;
+
+    /// The module each waiting thread waits for.
+    mutable std::map<std::thread::id, std::string> m_waiting;
+};
+
+namespace {
+
+/// Escape a string for use in JSON.
+std::string json_escape(std::string const &s)
+{
+    std::string res;
+    for (size_t i = 0, n = s.size(); i < n; ++i) {
+        char c = s[i];
+        switch (c) {
+        case '"':  res += "\\\""; break;
+        case '\\': res += "\\\\"; break;
+        case '\n': res += "\\n"; break;
+        case '\t': res += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", unsigned(c));
+                res += buf;
+            } else {
+                res += c;
+            }
+            break;
+        }
+    }
+    return res;
 }
 
+/// Convert a module name into a file name.
+std::string module_file_name(char const *module_name)
+{
+    std::string res;
+    for (char const *p = module_name; *p != '\0'; ++p) {
+        char c = *p;
+        if (c == ':' && p[1] == ':') {
+            ++p;
+            if (!res.empty()) {
+                res += '.';
+            }
+        } else if (c == '/' || c == '\\' || c == ':') {
+            res += '_';
+        } else {
+            res += c;
+        }
+    }
+    return res;
+}
+
+} // anonymous
+
 
 Mdlc::Mdlc(char const *program_name)
 : m_program(program_name)
@@ -131,6 +368,11 @@ Mdlc::Mdlc(char const *program_name)
 , m_target_lang(TL_NONE)
 , m_input_modules()
 , m_inline(false)
+, m_jobs(1)
+, m_output_dir()
+, m_timing_report()
+, m_module_cache(NULL)
+, m_output_lock()
 {
 }
 
@@ -221,6 +463,17 @@ void Mdlc::usage()
         "  --plugin <filename>\n"
         "  -l <filename>\n"
         "\tLoads the given plugin.\n"
+        "  --jobs <n>\n"
+        "  -j <n>\n"
+        "\tCompile up to <n> modules in parallel (0 for the number of CPUs).\n"
+        "\tImported modules are compiled only once and shared by all threads.\n"
+        "\tIn parallel mode all modules are compiled even if some fail.\n"
+        "  --output-dir <dir>\n"
+        "  -o <dir>\n"
+        "\tWrite the target code of each module into a file in <dir>\n"
+        "\tinstead of printing it to stdout.\n"
+        "  --timing-report <filename>\n"
+        "\tWrite a JSON report with the per-module and per-phase timings.\n"
         "  --help\n"
         "  -?"
         "\tThis help.\n",
@@ -253,8 +506,11 @@ int Mdlc::run(int argc, char *argv[])
         /*20*/ { "plugin",                 mi::getopt::REQUIRED_ARGUMENT, NULL, 'l' },
         /*21*/ { "varying-ior",            mi::getopt::NO_ARGUMENT,       NULL, 0 },
         /*22*/ { "uniform-ior",            mi::getopt::NO_ARGUMENT,       NULL, 0 },
-        /*22*/ { "help",                   mi::getopt::NO_ARGUMENT,       NULL, '?' },
-        /*23*/ { NULL,                     0,                             NULL, 0 }
+        /*23*/ { "jobs",                   mi::getopt::REQUIRED_ARGUMENT, NULL, 'j' },
+        /*24*/ { "output-dir",             mi::getopt::REQUIRED_ARGUMENT, NULL, 'o' },
+        /*25*/ { "timing-report",          mi::getopt::REQUIRED_ARGUMENT, NULL, 0 },
+        /*26*/ { "help",                   mi::getopt::NO_ARGUMENT,       NULL, '?' },
+        /*27*/ { NULL,                     0,                             NULL, 0 }
     };
 
     bool opt_error = false;
@@ -269,7 +525,7 @@ int Mdlc::run(int argc, char *argv[])
     std::vector<std::string> plugin_filenames;
 
     while (
-        (c = mi::getopt::getopt_long(argc, argv, "O:W:Vvip:Ct:d:B:l:Ne?", long_options, &longidx)) != -1
+        (c = mi::getopt::getopt_long(argc, argv, "O:W:Vvip:Ct:d:B:l:Nej:o:?", long_options, &longidx)) != -1
     ) {
         switch (c) {
         case 'O':
@@ -392,6 +648,28 @@ int Mdlc::run(int argc, char *argv[])
         case 'l':
             plugin_filenames.push_back(mi::getopt::optarg);
             break;
+        case 'j':
+            {
+                char const *s = mi::getopt::optarg;
+                char *end = NULL;
+                unsigned long jobs = strtoul(s, &end, 10);
+                if (end == s || *end != '\0' || jobs > 1024) {
+                    fprintf(
+                        stderr,
+                        "%s error: invalid number of jobs (%s)\n",
+                        argv[0],
+                        s);
+                    opt_error = true;
+                } else if (jobs == 0) {
+                    m_jobs = std::max(1u, std::thread::hardware_concurrency());
+                } else {
+                    m_jobs = unsigned(jobs);
+                }
+            }
+            break;
+        case 'o':
+            m_output_dir = mi::getopt::optarg;
+            break;
         case '?':
             usage();
             return EXIT_SUCCESS;
@@ -444,6 +722,9 @@ int Mdlc::run(int argc, char *argv[])
             case 22:
                 m_mat_ior_is_varying = false;
                 break;
+            case 25:
+                m_timing_report = mi::getopt::optarg;
+                break;
             default:
                 fprintf(
                     stderr,
@@ -530,33 +811,50 @@ int Mdlc::run(int argc, char *argv[])
         m_input_modules.push_back(argv[i]);
     }
 
+    if (!m_timing_report.empty()) {
+        MI::PROFILER::reset();
+        MI::PROFILER::set_enabled(/*enabled=*/true, /*tracing=*/true);
+    }
+
+    Mdlc_module_cache module_cache;
+    m_module_cache = &module_cache;
+
+    std::vector<Module_result> results;
     for (String_list::const_iterator it(m_input_modules.begin()), end(m_input_modules.end());
          it != end;
          ++it)
     {
-        std::string const &input_module = *it;
+        results.push_back(Module_result(*it));
+    }
 
-        size_t errors = 0;
-        mi::base::Handle<IModule const> module;
+    unsigned long long start_us = MI::PROFILER::get_time_us();
+    process_modules(results);
+    unsigned long long total_us = MI::PROFILER::get_time_us() - start_us;
 
-        if (is_binary(input_module.c_str())) {
-            module = mi::base::make_handle(load_binary(input_module.c_str(), errors));
-        } else {
-            module = mi::base::make_handle(compile(input_module.c_str(), errors));
-        }
-        if (!module.is_valid_interface()) {
-            return EXIT_FAILURE;
-        }
-        err_count += errors;
+    m_module_cache = NULL;
 
-        if (m_check_root.empty()) {
-            // compile
-            if (!backend(module.get())) {
-                return EXIT_FAILURE;
-            }
+    bool failed = false;
+    for (size_t i = 0, n = results.size(); i < n; ++i) {
+        err_count += unsigned(results[i].m_errors);
+        failed = failed || results[i].m_failed;
+    }
+
+    if (!m_timing_report.empty()) {
+        MI::PROFILER::set_enabled(/*enabled=*/false, /*tracing=*/false);
+        if (!write_timing_report(results, total_us)) {
+            fprintf(
+                stderr,
+                "%s error: could not write timing report '%s'\n",
+                m_program,
+                m_timing_report.c_str());
+            failed = true;
         }
     }
 
+    if (failed) {
+        return EXIT_FAILURE;
+    }
+
     if (!m_check_root.empty()) {
         if (err_count > 0) {
             fprintf(
@@ -577,11 +875,177 @@ int Mdlc::run(int argc, char *argv[])
     return err_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+// Compile one input module and run the backend on it.
+void Mdlc::process_module(Module_result &result)
+{
+    result.m_thread_id = MI::PROFILER::get_thread_id();
+    result.m_start_us  = MI::PROFILER::get_time_us();
+
+    char const *input_module = result.m_name.c_str();
+
+    size_t errors = 0;
+    mi::base::Handle<IModule const> module;
+
+    if (is_binary(input_module)) {
+        module = mi::base::make_handle(load_binary(input_module, errors));
+    } else {
+        module = mi::base::make_handle(compile(input_module, errors));
+    }
+    result.m_errors = errors;
+
+    if (!module.is_valid_interface()) {
+        result.m_failed = true;
+    } else if (m_check_root.empty()) {
+        // compile
+        if (!backend(module.get())) {
+            result.m_failed = true;
+        }
+    }
+
+    result.m_end_us = MI::PROFILER::get_time_us();
+}
+
+// Process all input modules.
+void Mdlc::process_modules(std::vector<Module_result> &results)
+{
+    size_t n = results.size();
+
+    if (m_jobs <= 1 || n <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            process_module(results[i]);
+            if (results[i].m_failed) {
+                // stop at the first serious error
+                break;
+            }
+        }
+        return;
+    }
+
+    // the modules are distributed dynamically, so long running modules do not block others
+    std::atomic<size_t> next(0);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0, n_threads = std::min(size_t(m_jobs), n); t < n_threads; ++t) {
+        threads.push_back(std::thread([this, &results, &next, n]() {
+            for (size_t i = next++; i < n; i = next++) {
+                process_module(results[i]);
+            }
+        }));
+    }
+    for (size_t t = 0, n_threads = threads.size(); t < n_threads; ++t) {
+        threads[t].join();
+    }
+}
+
+// Write the timing report as JSON.
+bool Mdlc::write_timing_report(
+    std::vector<Module_result> const &results,
+    unsigned long long               total_us)
+{
+    FILE *f = fopen(m_timing_report.c_str(), "w");
+    if (f == NULL) {
+        return false;
+    }
+
+    typedef MI::PROFILER::Trace_event Trace_event;
+    std::vector<Trace_event> events(MI::PROFILER::get_trace_events());
+
+    // sort by thread and start time, so the events of a module are adjacent
+    std::sort(events.begin(), events.end(), [](Trace_event const &a, Trace_event const &b) {
+        return a.m_thread_id != b.m_thread_id
+            ? a.m_thread_id < b.m_thread_id
+            : a.m_start_us < b.m_start_us;
+    });
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"jobs\": %u,\n", m_jobs);
+    fprintf(f, "  \"total_ms\": %.3f,\n", total_us / 1000.0);
+    fprintf(f, "  \"modules\": [");
+
+    for (size_t i = 0, n = results.size(); i < n; ++i) {
+        Module_result const &res = results[i];
+
+        // Attribute all events of the processing thread within the processing time to the
+        // module. Phases nest (e.g. the analysis of a module includes its imports), only the
+        // outermost event of each phase is counted.
+        unsigned long long phase_us[MI::PROFILER::PHASE_COUNT] = { 0 };
+        unsigned long long phase_end[MI::PROFILER::PHASE_COUNT] = { 0 };
+
+        Trace_event key;
+        key.m_phase       = MI::PROFILER::PHASE_COUNT;
+        key.m_thread_id   = res.m_thread_id;
+        key.m_start_us    = res.m_start_us;
+        key.m_duration_us = 0;
+        std::vector<Trace_event>::const_iterator it(std::lower_bound(
+            events.begin(), events.end(), key, [](Trace_event const &a, Trace_event const &b) {
+                return a.m_thread_id != b.m_thread_id
+                    ? a.m_thread_id < b.m_thread_id
+                    : a.m_start_us < b.m_start_us;
+            }));
+        for (; it != events.end(); ++it) {
+            if (it->m_thread_id != res.m_thread_id || it->m_start_us > res.m_end_us) {
+                break;
+            }
+            unsigned phase = unsigned(it->m_phase);
+            if (it->m_start_us < phase_end[phase]) {
+                continue;
+            }
+            phase_us[phase] += it->m_duration_us;
+            phase_end[phase] = it->m_start_us + it->m_duration_us;
+        }
+
+        char const *status = res.m_failed ? "failed" : (res.m_errors > 0 ? "errors" : "ok");
+
+        fprintf(f, "%s\n    {\n", i > 0 ? "," : "");
+        fprintf(f, "      \"name\": \"%s\",\n", json_escape(res.m_name).c_str());
+        fprintf(f, "      \"status\": \"%s\",\n", status);
+        fprintf(f, "      \"errors\": %u,\n", unsigned(res.m_errors));
+        fprintf(f, "      \"total_ms\": %.3f,\n", (res.m_end_us - res.m_start_us) / 1000.0);
+        fprintf(f, "      \"phases_ms\": {");
+        bool first = true;
+        for (unsigned phase = 0; phase < MI::PROFILER::PHASE_COUNT; ++phase) {
+            if (phase_us[phase] == 0) {
+                continue;
+            }
+            fprintf(f, "%s\n        \"%s\": %.3f",
+                first ? "" : ",",
+                MI::PROFILER::get_phase_name(MI::PROFILER::Phase(phase)),
+                phase_us[phase] / 1000.0);
+            first = false;
+        }
+        fprintf(f, "%s}\n    }", first ? "" : "\n      ");
+    }
+
+    fprintf(f, "\n  ],\n");
+    fprintf(f, "  \"counters\": {");
+    for (unsigned counter = 0; counter < MI::PROFILER::COUNTER_COUNT; ++counter) {
+        MI::PROFILER::Counter c = MI::PROFILER::Counter(counter);
+        fprintf(f, "%s\n    \"%s\": %llu",
+            counter > 0 ? "," : "",
+            MI::PROFILER::get_counter_name(c),
+            (unsigned long long)MI::PROFILER::get_counter(c));
+    }
+    fprintf(f, "\n  }\n}\n");
+
+    return fclose(f) == 0;
+}
+
+// Print messages (serialized between threads).
+void Mdlc::print_messages(Messages const &msgs, IPrinter *printer)
+{
+    std::lock_guard<std::mutex> lock(m_output_lock);
+
+    for (size_t i = 0, n = msgs.get_message_count(); i < n; ++i) {
+        IMessage const *msg = msgs.get_message(i);
+        printer->print(msg, /*include_notes=*/true);
+    }
+}
+
 // Compile one module.
 IModule const *Mdlc::compile(char const *module_name, size_t &errors)
 {
     mi::base::Handle<IThread_context> ctx(m_imdl->create_thread_context());
-    IModule const *module = m_imdl->load_module(ctx.get(), module_name, /*cache=*/NULL);
+    IModule const *module = m_imdl->load_module(ctx.get(), module_name, m_module_cache);
 
     mi::base::Handle<IOutput_stream> os_stderr(m_imdl->create_std_stream(IMDL::OS_STDERR));
     mi::base::Handle<IPrinter> printer(m_imdl->create_printer(os_stderr.get()));
@@ -646,7 +1110,7 @@ bool Mdlc::backend(IModule const *module)
             mi::base::Handle<IModule const> inlined_module(
                 transformer->inline_imports(module));
             if (inlined_module.is_valid_interface()) {
-                print_generated_code(inlined_module.get());
+                print_generated_code(inlined_module.get(), ".mdl");
             } else {
                 fprintf(
                     stderr,
@@ -659,7 +1123,7 @@ bool Mdlc::backend(IModule const *module)
                 return false;
             }
         } else {
-            print_generated_code(module);
+            print_generated_code(module, ".mdl");
         }
         break;
     case TL_DAG:
@@ -712,7 +1176,7 @@ bool Mdlc::backend(IModule const *module)
                                 m_program, unsigned(err_count), module->get_name());
                 return false;
             } else {
-                print_generated_code(dag.get());
+                print_generated_code(dag.get(), module->get_name(), ".dag");
             }
         }
         break;
@@ -739,25 +1203,30 @@ bool Mdlc::backend(IModule const *module)
             apply_backend_options(jit_opts);
 
             ICode_generator::Target_language be_target_lang;
+            char const *extension;
             switch (m_target_lang) {
             case TL_JIT:
                 be_target_lang = ICode_generator::TL_NATIVE;
+                extension = ".jit";
                 break;
             case TL_PTX:
                 be_target_lang = ICode_generator::TL_PTX;
+                extension = ".ptx";
                 break;
             case TL_HLSL:
                 be_target_lang = ICode_generator::TL_HLSL;
+                extension = ".hlsl";
                 break;
             case TL_GLSL:
                 be_target_lang = ICode_generator::TL_GLSL;
+                extension = ".glsl";
                 break;
             default:
                 return false;
             }
 
             mi::base::Handle<IGenerated_code_executable> exe_code(
-                generator->compile(module, /*module_cache=*/NULL, be_target_lang, /*ctx=*/NULL));
+                generator->compile(module, m_module_cache, be_target_lang, /*ctx=*/NULL));
             if (!exe_code.is_valid_interface()) {
                 fprintf(stderr, "%s error: failed to generate executable code for module %s\n",
                     m_program, module->get_name());
@@ -773,7 +1242,7 @@ bool Mdlc::backend(IModule const *module)
                     m_program, unsigned(err_count), module->get_name());
                 return false;
             } else {
-                print_generated_code(exe_code.get());
+                print_generated_code(exe_code.get(), module->get_name(), extension);
             }
         }
         break;
@@ -789,7 +1258,19 @@ bool Mdlc::backend(IModule const *module)
 #endif // defined(MDLC_WITH_BACKENDS)
     case TL_BIN:
         if (module->is_valid()) {
-            mi::base::Handle<IOutput_stream> os(m_imdl->create_file_output_stream("output.bin"));
+            std::string filename("output.bin");
+            if (!m_output_dir.empty()) {
+                filename = m_output_dir + "/" + module_file_name(module->get_name()) + ".bin";
+            }
+
+            // without an output directory all modules are written to the same file
+            std::unique_lock<std::mutex> lock(m_output_lock, std::defer_lock);
+            if (m_output_dir.empty()) {
+                lock.lock();
+            }
+
+            mi::base::Handle<IOutput_stream> os(
+                m_imdl->create_file_output_stream(filename.c_str()));
             mi::mdl::Stream_serializer stream_serializer(os.get());
 
             if (os.is_valid_interface()) {
@@ -839,18 +1320,46 @@ IModule const *Mdlc::load_binary(char const *filename, size_t &errors)
 }
 
 
-// Prints colorized code to stdout.
-void Mdlc::print_generated_code(IModule const *mod)
+// Creates the output stream for the target code of a module.
+IOutput_stream *Mdlc::create_output_stream(
+    char const *module_name,
+    char const *extension)
 {
-    mi::base::Handle<IOutput_stream> os_stdout(m_imdl->create_std_stream(IMDL::OS_STDOUT));
+    if (m_output_dir.empty()) {
+        return m_imdl->create_std_stream(IMDL::OS_STDOUT);
+    }
+
+    std::string filename(m_output_dir + "/" + module_file_name(module_name) + extension);
+    IOutput_stream *os = m_imdl->create_file_output_stream(filename.c_str());
+    if (os == NULL) {
+        fprintf(stderr, "%s error: could not create output file '%s'\n",
+            m_program, filename.c_str());
+    }
+    return os;
+}
+
+// Prints colorized code to stdout or the output directory.
+void Mdlc::print_generated_code(IModule const *mod, char const *extension)
+{
+    mi::base::Handle<IOutput_stream> os(create_output_stream(mod->get_name(), extension));
+    if (!os.is_valid_interface()) {
+        return;
+    }
+
+    // keep the output of one module together
+    std::unique_lock<std::mutex> lock(m_output_lock, std::defer_lock);
+    if (m_output_dir.empty()) {
+        lock.lock();
+    }
+
     if (mod->is_valid() && !(m_show_positions || m_show_resource_table)) {
         // use the exporter
         mi::base::Handle<IMDL_exporter> exporter(m_imdl->create_exporter());
         exporter->enable_color(m_syntax_coloring);
-        exporter->export_module(os_stdout.get(), mod, /*resource_cb=*/NULL);
+        exporter->export_module(os.get(), mod, /*resource_cb=*/NULL);
     } else if (m_verbose || m_show_positions || m_show_resource_table) {
         // use the printer, this module contains errors
-        mi::base::Handle<IPrinter> printer(m_imdl->create_printer(os_stdout.get()));
+        mi::base::Handle<IPrinter> printer(m_imdl->create_printer(os.get()));
         printer->enable_color(m_syntax_coloring);
         printer->show_positions(m_show_positions);
         printer->show_resource_table(m_show_resource_table);
@@ -858,11 +1367,24 @@ void Mdlc::print_generated_code(IModule const *mod)
     }
 }
 
-// Prints colorized code to stdout.
-void Mdlc::print_generated_code(IGenerated_code const *code)
+// Prints colorized code to stdout or the output directory.
+void Mdlc::print_generated_code(
+    IGenerated_code const *code,
+    char const            *module_name,
+    char const            *extension)
 {
-    mi::base::Handle<IOutput_stream> os_stdout(m_imdl->create_std_stream(IMDL::OS_STDOUT));
-    mi::base::Handle<IPrinter> printer(m_imdl->create_printer(os_stdout.get()));
+    mi::base::Handle<IOutput_stream> os(create_output_stream(module_name, extension));
+    if (!os.is_valid_interface()) {
+        return;
+    }
+
+    // keep the output of one module together
+    std::unique_lock<std::mutex> lock(m_output_lock, std::defer_lock);
+    if (m_output_dir.empty()) {
+        lock.lock();
+    }
+
+    mi::base::Handle<IPrinter> printer(m_imdl->create_printer(os.get()));
     printer->enable_color(m_syntax_coloring);
     printer->show_positions(m_show_positions);
     printer->show_resource_table(m_show_resource_table);
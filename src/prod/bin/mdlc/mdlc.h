@@ -31,19 +31,26 @@
 
 #include <mi/base/handle.h>
 
+#include <mutex>
 #include <string>
 #include <list>
+#include <vector>
 
 namespace mi {
     namespace mdl {
         class IMDL;
         class IModule;
         class IGenerated_code;
+        class IOutput_stream;
+        class IPrinter;
         class ISyntax_coloring;
+        class Messages;
         class Options;
     }
 }
 
+class Mdlc_module_cache;
+
 /// The MDL command line compiler application.
 class Mdlc
 {
@@ -81,9 +88,65 @@ public:
     int run(int argc, char *argv[]);
 
 private:
+    /// The result of processing one input module.
+    struct Module_result {
+        /// Constructor.
+        explicit Module_result(std::string const &name)
+        : m_name(name)
+        , m_errors(0)
+        , m_failed(false)
+        , m_thread_id(0)
+        , m_start_us(0)
+        , m_end_us(0)
+        {
+        }
+
+        /// The module name (or the file name of a module binary).
+        std::string m_name;
+
+        /// The number of errors detected during compilation.
+        size_t m_errors;
+
+        /// True if some serious error occurred (no module created or backend failure).
+        bool m_failed;
+
+        /// The profiler id of the thread that processed the module.
+        unsigned long long m_thread_id;
+
+        /// Start of the processing in profiler time (microseconds).
+        unsigned long long m_start_us;
+
+        /// End of the processing in profiler time (microseconds).
+        unsigned long long m_end_us;
+    };
+
     /// Prints usage.
     void usage();
 
+    /// Compile one input module and run the backend on it.
+    ///
+    /// \param result  Receives the result, its name selects the module.
+    void process_module(Module_result &result);
+
+    /// Process all input modules, using m_jobs threads.
+    ///
+    /// \param results  Receives the results, one per input module.
+    void process_modules(std::vector<Module_result> &results);
+
+    /// Write the timing report as JSON.
+    ///
+    /// \param results   The results of all processed modules.
+    /// \param total_us  The total wall clock time in microseconds.
+    ///
+    /// \returns         true on success, false if the report file could not be written.
+    bool write_timing_report(std::vector<Module_result> const &results, unsigned long long total_us);
+
+    /// Print messages (serialized between threads).
+    ///
+    /// \param msgs     the messages
+    /// \param printer  the printer
+    void print_messages(mi::mdl::Messages const &msgs, mi::mdl::IPrinter *printer);
+
     /// Compile one module.
     /// \param      module_name     The name of the module to compile.
     /// \param      errors          The number of errors detected during compilation.
@@ -114,11 +177,25 @@ private:
         char const *filename,
         size_t     &errors);
 
-    /// Prints colorized code to stdout.
-    void print_generated_code(mi::mdl::IModule const *mod);
+    /// Creates the output stream for the target code of a module.
+    ///
+    /// \param module_name  The name of the module.
+    /// \param extension    The file extension used if an output directory is set.
+    ///
+    /// \returns  stdout or a stream writing to a file in the output directory,
+    ///           NULL if that file could not be created.
+    mi::mdl::IOutput_stream *create_output_stream(
+        char const *module_name,
+        char const *extension);
+
+    /// Prints colorized code to stdout or the output directory.
+    void print_generated_code(mi::mdl::IModule const *mod, char const *extension);
 
-    /// Prints colorized code to stdout.
-    void print_generated_code(mi::mdl::IGenerated_code const *code);
+    /// Prints colorized code to stdout or the output directory.
+    void print_generated_code(
+        mi::mdl::IGenerated_code const *code,
+        char const                     *module_name,
+        char const                     *extension);
 
     /// Find all modules in a library.
     void find_all_modules(char const *root, char const *package);
@@ -184,6 +261,21 @@ private:
 
     /// If set and target equals MDL, inline all imports except for stdlib/builtins
     bool m_inline;
+
+    /// The number of modules processed in parallel.
+    unsigned m_jobs;
+
+    /// If non empty, target code is written to files in this directory instead of stdout.
+    std::string m_output_dir;
+
+    /// If non empty, a JSON timing report is written to this file.
+    std::string m_timing_report;
+
+    /// The module cache shared by all threads, so imports are compiled only once.
+    Mdlc_module_cache *m_module_cache;
+
+    /// Serializes output to stdout/stderr between threads.
+    std::mutex m_output_lock;
 };
 
 #endif
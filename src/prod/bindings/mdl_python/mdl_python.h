@@ -27,6 +27,7 @@
  **************************************************************************************************/
 
 #include <iostream>
+#include <atomic>
 #include <string>
 #include <mutex>
 #include <map>
@@ -129,7 +130,7 @@ private:
 
     static std::mutex s_lock_open_handles;
     static std::map<void*, Open_handle> s_open_handles;
-    static bool s_print_ref_counts;
+    static std::atomic<bool> s_print_ref_counts;
 };
 
  // Smart-pointer class
@@ -148,9 +149,13 @@ public:
     }
 
     SmartPtr(const SmartPtr<T>& toCopy)
-        : m_pointee(toCopy.m_pointee)
-        , m_dropped(!m_pointee)
+        : m_pointee(nullptr)
+        , m_dropped(true)
     {
+        // the source might be used concurrently by another thread that released the GIL
+        std::unique_lock<std::recursive_mutex> lock(toCopy.m_ref_mutex);
+        m_pointee = toCopy.m_pointee;
+        m_dropped = !m_pointee;
         _assign_open_handle_typename(m_pointee, toCopy.m_typename.c_str());
         increase_refcount("SmartPtr Copy Constructor");
     }
@@ -158,10 +163,12 @@ public:
     // Not picked up by SWIG but keep it as reference
     SmartPtr<T>& operator=(const SmartPtr<T>& toCopy)
     {
-        std::unique_lock<std::recursive_mutex> lock(m_ref_mutex);
         if (this == &toCopy)
             return *this;
 
+        std::unique_lock<std::recursive_mutex> lock(m_ref_mutex, std::defer_lock);
+        std::unique_lock<std::recursive_mutex> lock_copy(toCopy.m_ref_mutex, std::defer_lock);
+        std::lock(lock, lock_copy);
         decrease_refcount("Copy Assigned SmartPtr");
         m_pointee = toCopy.m_pointee;
         increase_refcount("Copy Assigned SmartPtr");
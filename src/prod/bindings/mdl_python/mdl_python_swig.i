@@ -6,7 +6,7 @@
 // 1- python instantiate_templates_inline.py example_swig.i "" ..\..\..\\include processed_headers processed_headers_dummy
 // 2- swig -I./processed_headers -I..\..\..\\include -c++ -python -cppext cpp example_swig.i
 
-%module pymdlsdk
+%module(threads="1") pymdlsdk
 
 %begin %{
 #ifdef _MSC_VER
@@ -21,6 +21,51 @@
 %include <std_string.i>
 %apply unsigned long long{ uint64_t };
 
+// Thread support
+// ----------------------------------------------------------------------------
+// The global interpreter lock is only released around SDK calls that potentially run for a long
+// time, such that other Python threads can proceed meanwhile, e.g., to compile several materials
+// in parallel. All other calls keep the lock since releasing and re-acquiring it is more expensive
+// than the call itself. None of the functions below calls back into Python.
+//
+// Note that only the C++ call itself runs without the lock. Argument conversion and the creation
+// of the returned handles still happens with the lock held. As in C++, the handles passed to such
+// a call must not be released by another thread while the call is running.
+//
+// Only wrapped interfaces can be listed here. The backend and MDLE APIs (imdl_backend.h and
+// imdle_api.h) are not part of this module.
+%nothread;
+%thread mi::neuraylib::INeuray::start;
+%thread mi::neuraylib::INeuray::shutdown;
+%thread mi::neuraylib::ITransaction::commit;
+%thread mi::neuraylib::IMdl_impexp_api::load_module;
+%thread mi::neuraylib::IMdl_impexp_api::load_module_from_string;
+%thread mi::neuraylib::IMdl_impexp_api::export_module;
+%thread mi::neuraylib::IMdl_impexp_api::export_module_to_string;
+%thread mi::neuraylib::IMdl_impexp_api::export_canvas;
+%thread mi::neuraylib::IMdl_impexp_api::export_lightprofile;
+%thread mi::neuraylib::IMdl_impexp_api::export_bsdf_data;
+%thread mi::neuraylib::IModule::reload;
+%thread mi::neuraylib::IModule::reload_from_string;
+%thread mi::neuraylib::IMaterial_instance::create_compiled_material;
+%thread mi::neuraylib::IMdl_distiller_api::distill_material;
+%thread mi::neuraylib::IMdl_distiller_api::create_baker;
+%thread mi::neuraylib::IBaker::bake_texture;
+%thread mi::neuraylib::IBaker::bake_texture_with_constant_detection;
+%thread mi::neuraylib::IBaker::bake_constant;
+%thread mi::neuraylib::IMdl_module_builder::commit;
+%thread mi::neuraylib::IMdl_module_transformer::inline_imported_modules;
+%thread mi::neuraylib::IMdl_module_transformer::export_module;
+%thread mi::neuraylib::IMdl_module_transformer::export_module_to_string;
+%thread mi::neuraylib::IImage_api::create_mipmap;
+%thread mi::neuraylib::IImage_api::convert;
+%thread mi::neuraylib::IImage::reset_file;
+%thread mi::neuraylib::ILightprofile::reset_file;
+%thread mi::neuraylib::IBsdf_measurement::reset_file;
+%thread mi::neuraylib::IMdl_factory::create_texture;
+%thread mi::neuraylib::IMdl_factory::create_light_profile;
+%thread mi::neuraylib::IMdl_factory::create_bsdf_measurement;
+
 // TODO: Doxygen
 // Extrract aliases from Doxyfile automatically
 // Figure out: %base, %math, $(MI_PRODUCT_VERSION)
@@ -99,7 +144,7 @@ extern mi::neuraylib::INeuray* g_neuray;
 
 std::mutex SmartPtrBase::s_lock_open_handles;
 std::map<void*, SmartPtrBase::Open_handle>SmartPtrBase::s_open_handles;
-bool SmartPtrBase::s_print_ref_counts = false;
+std::atomic<bool> SmartPtrBase::s_print_ref_counts(false);
 
 void _print_open_handle_statistic()
 {
@@ -131,6 +176,7 @@ extern bool unload();
     import gc
     import sys
     import ctypes
+    import struct
     from typing import Callable, TypeVar
     if sys.version_info >= (3, 10):
         from typing import ParamSpec  # pragma: no cover
@@ -167,6 +213,61 @@ extern bool unload();
         def decorator(func):
             return func
         return decorator
+
+    # Maps pixel types to the format character of the 'struct' module and the number of channels.
+    _pixel_type_formats: dict[str, tuple[str, int]] = {
+        "Sint8":      ("b", 1),
+        "Sint32":     ("i", 1),
+        "Float32":    ("f", 1),
+        "Float32<2>": ("f", 2),
+        "Float32<3>": ("f", 3),
+        "Float32<4>": ("f", 4),
+        "Rgb":        ("B", 3),
+        "Rgba":       ("B", 4),
+        "Rgbe":       ("B", 4),
+        "Rgbea":      ("B", 5),
+        "Rgb_16":     ("H", 3),
+        "Rgba_16":    ("H", 4),
+        "Rgb_fp":     ("f", 3),
+        "Color":      ("f", 4),
+    }
+
+    def _create_buffer_view(owner, address: int, size: int, format: str = "B", shape: tuple = None, readonly: bool = False) -> memoryview:
+        """Helper to expose native memory as memoryview without copying.
+
+        The view keeps ``owner`` alive, i.e., the native memory stays valid as long as the view
+        (or any object created from it, e.g. a numpy array) is referenced. Empty buffers yield an
+        empty view with the same format and writability, but one-dimensional since memoryview
+        does not support dimensions of size zero."""
+        if address == 0 or size == 0:
+            view = memoryview(bytearray()).cast(format)
+        else:
+            raw = (ctypes.c_uint8 * size).from_address(address)
+            raw._owner = owner
+            view = memoryview(raw).cast("B")
+            if shape is not None:
+                view = view.cast(format, shape)
+            elif format != "B":
+                view = view.cast(format)
+        return view.toreadonly() if readonly else view
+
+    def _get_buffer_address(buffer, writable: bool) -> tuple:
+        """Helper to get the address and the size in bytes of a C-contiguous object supporting the
+        buffer protocol.
+
+        Returns a tuple (address, size, keep_alive). The memory is only valid as long as
+        ``keep_alive`` is referenced. Read-only buffers are copied (unless ``writable`` is set, in
+        which case a TypeError is raised)."""
+        view = memoryview(buffer).cast("B")
+        if view.nbytes == 0:
+            return (0, 0, None)
+        if not view.readonly:
+            raw = (ctypes.c_uint8 * view.nbytes).from_buffer(view)
+        elif writable:
+            raise TypeError("The buffer is read-only.")
+        else:
+            raw = (ctypes.c_uint8 * view.nbytes).from_buffer_copy(view)
+        return (ctypes.addressof(raw), view.nbytes, raw)
 %}
 
 // this adds 'with` support to the smart pointer
@@ -914,6 +1015,8 @@ EXTEND_FUNCTION_AS(mi::IArray, get_element)
 EXTEND_FUNCTION_AS(mi::IDynamic_array, get_element)
 EXTEND_FUNCTION_AS(mi::IDynamic_array, front)
 EXTEND_FUNCTION_AS(mi::IDynamic_array, back)
+%ignore mi::IArray::get_data;
+%ignore mi::IDynamic_array::get_data;
 
 %include "mi/neuraylib/vector_typedefs.h"
 %include "mi/neuraylib/typedefs.h"
@@ -1381,6 +1484,7 @@ EXTEND_FUNCTION_AS(mi::neuraylib::IExpression_list, get_expression)
 %ignore mi::neuraylib::IMdl_distiller_api::distill_material(ICompiled_material const*, char const*) const;
 %ignore mi::neuraylib::IMdl_distiller_api::distill_material(ICompiled_material const*, char const*, IMap const*) const;
 %rename(_distill_material) mi::neuraylib::IMdl_distiller_api::distill_material(ICompiled_material const*, char const*, IMap const*, Sint32*) const;
+%ignore mi::neuraylib::IMdl_distiller_api::distill_materials;
 %extend SmartPtr<mi::neuraylib::IMdl_distiller_api> {
     %pythoncode {
         @_post_swig_move_to_end_of_class
@@ -1433,6 +1537,7 @@ EXTEND_FUNCTION_AS(mi::neuraylib::IExpression_list, get_expression)
 // special handling for: mi::neuraylib::IMdl_evaluator_api
 // ----------------------------------------------------------------------------
 %ignore mi::neuraylib::IMdl_evaluator_api::is_function_parameter_enabled(ITransaction*, IValue_factory*, IFunction_call const*, Size) const;
+%ignore mi::neuraylib::IMdl_evaluator_api::are_function_parameters_enabled;
 %rename(_is_function_parameter_enabled) mi::neuraylib::IMdl_evaluator_api::is_function_parameter_enabled(ITransaction*, IValue_factory*, IFunction_call const*, Size, Sint32*) const;
 %extend SmartPtr<mi::neuraylib::IMdl_evaluator_api> {
     %pythoncode {
@@ -1539,6 +1644,8 @@ EXTEND_FUNCTION_AS(mi::neuraylib::IValue_color, get_value)
 EXTEND_FUNCTION_AS(mi::neuraylib::IValue_vector, get_value)
 EXTEND_FUNCTION_AS(mi::neuraylib::IValue_matrix, get_value)
 EXTEND_FUNCTION_AS(mi::neuraylib::IValue_array, get_value)
+%ignore mi::neuraylib::IValue_array::get_data;
+%ignore mi::neuraylib::IValue_array::set_data;
 EXTEND_FUNCTION_AS(mi::neuraylib::IValue_structure, get_value)
 EXTEND_FUNCTION_AS(mi::neuraylib::IValue_structure, get_field)
 
@@ -1627,12 +1734,92 @@ EXTEND_FUNCTION_AS(mi::neuraylib::ITransaction, edit)
 // special handling for: mi::neuraylib::Image_api
 // ----------------------------------------------------------------------------
 %ignore mi::neuraylib::IImage_api::create_canvas_cuda;
-%ignore mi::neuraylib::IImage_api::read_raw_pixels;  // Not supported at this point, TODO involve numpy here
-%ignore mi::neuraylib::IImage_api::write_raw_pixels;  // Not supported at this point, TODO involve numpy here
+%ignore mi::neuraylib::IImage_api::read_raw_pixels;
+%ignore mi::neuraylib::IImage_api::write_raw_pixels;
+%extend SmartPtr<mi::neuraylib::IImage_api> {
+
+    mi::Sint32 _read_raw_pixels(
+        mi::Uint32 width, mi::Uint32 height, const mi::neuraylib::ICanvas* canvas,
+        mi::Uint32 canvas_x, mi::Uint32 canvas_y, mi::Uint32 canvas_layer,
+        uint64_t buffer, bool buffer_topdown, const char* buffer_pixel_type,
+        mi::Uint32 buffer_padding) const
+    {
+        return $self->get()->read_raw_pixels(
+            width, height, canvas, canvas_x, canvas_y, canvas_layer,
+            reinterpret_cast<void*>(buffer), buffer_topdown, buffer_pixel_type, buffer_padding);
+    }
+
+    mi::Sint32 _write_raw_pixels(
+        mi::Uint32 width, mi::Uint32 height, mi::neuraylib::ICanvas* canvas,
+        mi::Uint32 canvas_x, mi::Uint32 canvas_y, mi::Uint32 canvas_layer,
+        uint64_t buffer, bool buffer_topdown, const char* buffer_pixel_type,
+        mi::Uint32 buffer_padding) const
+    {
+        return $self->get()->write_raw_pixels(
+            width, height, canvas, canvas_x, canvas_y, canvas_layer,
+            reinterpret_cast<const void*>(buffer), buffer_topdown, buffer_pixel_type, buffer_padding);
+    }
+
+    %pythoncode %{
+        def _get_raw_buffer_size(self, width: int, height: int, buffer_pixel_type: str, buffer_padding: int) -> int:
+            bytesPerPixel: int = self.get_components_per_pixel(buffer_pixel_type) * self.get_bytes_per_component(buffer_pixel_type)
+            return width * height * bytesPerPixel + max(height - 1, 0) * buffer_padding
+
+        def read_raw_pixels(self, width: int, height: int, canvas: "ICanvas", canvas_x: int, canvas_y: int, canvas_layer: int, buffer, buffer_topdown: bool, buffer_pixel_type: str, buffer_padding: int = 0) -> int:
+            r"""
+            Reads raw pixel data from a canvas.
+
+            Same as the C++ function, but ``buffer`` is a writable, C-contiguous object supporting the
+            buffer protocol, e.g., a 'bytearray' or a 'numpy.ndarray'. The pixel data is written to
+            the buffer directly, without intermediate copies. Raises a ValueError if the buffer is too
+            small for the requested area.
+            """
+            address, size, keepAlive = _get_buffer_address(buffer, writable=True)
+            if size < self._get_raw_buffer_size(width, height, buffer_pixel_type, buffer_padding):
+                raise ValueError("The buffer is too small for the requested pixel area.")
+            return self._read_raw_pixels(width, height, canvas, canvas_x, canvas_y, canvas_layer, address, buffer_topdown, buffer_pixel_type, buffer_padding)
+
+        def write_raw_pixels(self, width: int, height: int, canvas: "ICanvas", canvas_x: int, canvas_y: int, canvas_layer: int, buffer, buffer_topdown: bool, buffer_pixel_type: str, buffer_padding: int = 0) -> int:
+            r"""
+            Writes raw pixel data to a canvas.
+
+            Same as the C++ function, but ``buffer`` is a C-contiguous object supporting the buffer
+            protocol, e.g., 'bytes', a 'bytearray' or a 'numpy.ndarray'. Writable buffers are read
+            directly, read-only buffers are copied once. Raises a ValueError if the buffer is too small
+            for the requested area.
+            """
+            address, size, keepAlive = _get_buffer_address(buffer, writable=False)
+            if size < self._get_raw_buffer_size(width, height, buffer_pixel_type, buffer_padding):
+                raise ValueError("The buffer is too small for the requested pixel area.")
+            return self._write_raw_pixels(width, height, canvas, canvas_x, canvas_y, canvas_layer, address, buffer_topdown, buffer_pixel_type, buffer_padding)
+    %}
+}
 
 // special handling for: mi::neuraylib::IBuffer
 // ----------------------------------------------------------------------------
-%ignore mi::neuraylib::IBuffer::get_data;  // Not supported at this point, TODO involve numpy here
+%ignore mi::neuraylib::IBuffer::get_data;
+%extend SmartPtr<mi::neuraylib::IBuffer> {
+
+    uint64_t _get_data() const
+    {
+        return reinterpret_cast<uint64_t>($self->get()->get_data());
+    }
+
+    %pythoncode %{
+        def get_data_view(self) -> memoryview:
+            r"""
+            Returns a read-only view of the buffer contents without copying them.
+
+            The view is one-dimensional with one byte per element and keeps the buffer alive. It can be
+            passed to all functions accepting objects that support the buffer protocol, e.g.
+            'numpy.frombuffer()' or 'bytes()'.
+            """
+            return _create_buffer_view(self, self._get_data(), self.get_data_size(), readonly=True)
+
+        def __buffer__(self, flags: int) -> memoryview:
+            return self.get_data_view()
+    %}
+}
 // special handling for: mi::neuraylib::IBsdf_buffer
 //
 // ----------------------------------------------------------------------------
@@ -1740,6 +1927,32 @@ EXTEND_FUNCTION_AS(mi::neuraylib::ITransaction, edit)
 // ----------------------------------------------------------------------------
 %ignore mi::neuraylib::get_resolution;
 
+// special handling for: mi::neuraylib::ICanvas
+// ----------------------------------------------------------------------------
+%extend SmartPtr<mi::neuraylib::ICanvas> {
+    %pythoncode %{
+        def get_data_view(self, layer: int = 0) -> memoryview:
+            r"""
+            Returns a writable view of the pixel data of a layer without copying it.
+
+            See 'ITile.get_data_view()' for the layout of the view. Returns None if the layer does not
+            exist or the pixel type is not supported.
+            """
+            tile: ITile = self.get_tile(layer)
+            if not tile.is_valid_interface():
+                return None
+            return tile.get_data_view()
+
+        def __buffer__(self, flags: int) -> memoryview:
+            if self.get_layers_size() != 1:
+                raise BufferError("The buffer protocol is only supported for canvases with a single layer.")
+            view = self.get_data_view(0)
+            if view is None:
+                raise BufferError(f"The pixel type '{self.get_type()}' is not supported.")
+            return view
+    %}
+}
+
 // special handling for: mi::neuraylib::ITile
 // ----------------------------------------------------------------------------
 %ignore mi::neuraylib::ITile::get_pixel const;
@@ -1771,11 +1984,37 @@ EXTEND_FUNCTION_AS(mi::neuraylib::ITransaction, edit)
             """
             return self._get_data()
 
+        def get_data_view(self) -> memoryview:
+            r"""
+            Returns a writable view of the raw tile data without copying it.
+
+            The view has the shape (height, width, channels) and an element format according to the
+            pixel type of the tile, e.g., 'f' for "Color" and "Float32<3>", or 'B' for "Rgba". Rows
+            are stored bottom-up as in 'get_data()'. The view keeps the tile alive and supports the
+            buffer protocol, i.e., 'numpy.asarray(view)' creates an array sharing the tile data.
+            Returns None if the pixel type is not supported.
+            """
+            pixelFormat = _pixel_type_formats.get(self.get_type())
+            if pixelFormat is None:  # pragma: no cover
+                return None
+            format, channels = pixelFormat
+            width: int = self.get_resolution_x()
+            height: int = self.get_resolution_y()
+            size: int = width * height * channels * struct.calcsize(format)
+            return _create_buffer_view(self, self._get_data(), size, format, (height, width, channels))
+
+        def __buffer__(self, flags: int) -> memoryview:
+            view = self.get_data_view()
+            if view is None:  # pragma: no cover
+                raise BufferError(f"The pixel type '{self.get_type()}' is not supported.")
+            return view
+
         def get_data_numpy(self) -> "numpy.ndarray":
             r"""
             Returns a 3D numpy array to the raw tile data with an element type according to the pixel type of the tile.
 
-            This is method is based on 'get_data()' and only adds the mapping to a numpy structure.
+            This is method is based on 'get_data_view()' and only adds the mapping to a numpy structure.
+            The array shares the tile data and keeps the tile alive.
             Note, for most efficient operations use in-place operators:
 
                 imageData += 1.0
@@ -1791,77 +2030,10 @@ EXTEND_FUNCTION_AS(mi::neuraylib::ITransaction, edit)
                 warnings.warn("The numpy package required by this function was not found. Returning None.", RuntimeWarning)
                 return None
 
-            channels : int = 0
-            bytesPerChannel : int = 0
-            pixelType: str = self.get_type()
-            numpyElementType = None
-            if pixelType == "Sint8":  # pragma: no cover
-                channels = 1
-                bytesPerChannel = 1
-                numpyElementType = numpy.int8
-            elif pixelType == "Sint32":  # pragma: no cover
-                channels = 1
-                bytesPerChannel = 4
-                numpyElementType = numpy.int32
-            elif pixelType == "Float32":  # pragma: no cover
-                channels = 1
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            elif pixelType == "Float32<2>":  # pragma: no cover
-                channels = 2
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            elif pixelType == "Float32<3>":
-                channels = 3
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            elif pixelType == "Float32<4>":  # pragma: no cover
-                channels = 4
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            elif pixelType == "Rgb":  # pragma: no cover
-                channels = 3
-                bytesPerChannel = 1
-                numpyElementType = numpy.uint8
-            elif pixelType == "Rgba":  # pragma: no cover
-                channels = 4
-                bytesPerChannel = 1
-                numpyElementType = numpy.uint8
-            elif pixelType == "Rgbe":  # pragma: no cover
-                channels = 4
-                bytesPerChannel = 1
-                numpyElementType = numpy.uint8
-            elif pixelType == "Rgbea":  # pragma: no cover
-                channels = 5
-                bytesPerChannel = 1
-                numpyElementType = numpy.uint8
-            elif pixelType == "Rgb_16":  # pragma: no cover
-                channels = 3
-                bytesPerChannel = 2
-                numpyElementType = numpy.uint16
-            elif pixelType == "Rgba_16":  # pragma: no cover
-                channels = 4
-                bytesPerChannel = 3
-                numpyElementType = numpy.uint16
-            elif pixelType == "Rgb_fp":  # pragma: no cover
-                channels = 3
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            elif pixelType == "Color":  # pragma: no cover
-                channels = 4
-                bytesPerChannel = 4
-                numpyElementType = numpy.float32
-            else:  # pragma: no cover
+            view = self.get_data_view()
+            if view is None:  # pragma: no cover
                 return None
-
-            width: int = self.get_resolution_x()
-            height: int = self.get_resolution_y()
-            byteBufferSize: int = width * height * channels * bytesPerChannel
-            byteBuffer = ctypes.cast(self._get_data(), ctypes.POINTER(ctypes.c_uint8 * byteBufferSize))
-            typedBufferSize: int = width * height * channels
-            typedBuffer = numpy.frombuffer(byteBuffer.contents, dtype=numpyElementType, count=typedBufferSize)
-
-            return typedBuffer.reshape(height, width, channels)
+            return numpy.asarray(view)
     %}
 
     mi::math::Color_struct get_pixel(mi::Uint32 x_offset, mi::Uint32 y_offset) const
@@ -47,7 +47,9 @@
 #include <mi/neuraylib/idebug_configuration.h>
 #include <mi/neuraylib/idynamic_array.h>
 #include <mi/neuraylib/iimage.h>
+#include <mi/neuraylib/imap.h>
 #include <mi/neuraylib/ineuray.h>
+#include <mi/neuraylib/inumber.h>
 #include <mi/neuraylib/iscope.h>
 #include <mi/neuraylib/istring.h>
 #include <mi/neuraylib/itexture.h>
@@ -197,6 +199,61 @@ void test_texture( mi::neuraylib::IScope* scope)
     MI_CHECK_EQUAL( 0, transaction->commit());
 }
 
+void test_change_feed( mi::neuraylib::IScope* scope)
+{
+    mi::base::Handle<mi::neuraylib::ITransaction> transaction( scope->create_transaction());
+
+    std::string time_stamp = transaction->get_time_stamp();
+
+    mi::base::Handle<const mi::IMap> changes(
+        transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), true));
+    MI_CHECK( changes);
+    MI_CHECK_EQUAL( 0, changes->get_length());
+
+    MI_CHECK( !transaction->get_changed_elements_since_time_stamp( nullptr, false));
+    MI_CHECK( !transaction->get_changed_elements_since_time_stamp( "foo", false));
+
+    // replace the image referenced by "texture_foo" and "texture_copy"
+
+    mi::base::Handle<mi::neuraylib::IImage> image( transaction->create<mi::neuraylib::IImage>( "Image"));
+    MI_CHECK( image);
+    MI_CHECK_EQUAL( 0, transaction->store( image.get(), "referenced_image_2"));
+    image = nullptr;
+
+    changes = transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), false);
+    MI_CHECK( changes);
+    MI_CHECK_EQUAL( 1, changes->get_length());
+    mi::base::Handle<const mi::IUint32> flags( changes->get_value<mi::IUint32>( "referenced_image_2"));
+    MI_CHECK( flags);
+    MI_CHECK_NOT_EQUAL( 0, flags->get_value<mi::Uint32>());
+
+    MI_CHECK_EQUAL( 0, transaction->commit());
+    transaction = scope->create_transaction();
+    MI_CHECK( transaction);
+
+    // dependents are reported with zero flags, also in later transactions
+
+    changes = transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), true);
+    MI_CHECK( changes);
+    MI_CHECK_EQUAL( 3, changes->get_length());
+    flags = changes->get_value<mi::IUint32>( "referenced_image_2");
+    MI_CHECK( flags);
+    MI_CHECK_NOT_EQUAL( 0, flags->get_value<mi::Uint32>());
+    flags = changes->get_value<mi::IUint32>( "texture_foo");
+    MI_CHECK( flags);
+    MI_CHECK_EQUAL( 0, flags->get_value<mi::Uint32>());
+    flags = changes->get_value<mi::IUint32>( "texture_copy");
+    MI_CHECK( flags);
+    MI_CHECK_EQUAL( 0, flags->get_value<mi::Uint32>());
+
+    time_stamp = transaction->get_time_stamp();
+    changes = transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), true);
+    MI_CHECK( changes);
+    MI_CHECK_EQUAL( 0, changes->get_length());
+
+    MI_CHECK_EQUAL( 0, transaction->commit());
+}
+
 void test_string( mi::neuraylib::IScope* scope)
 {
     mi::base::Handle<mi::neuraylib::ITransaction> transaction( scope->create_transaction());
@@ -232,6 +289,9 @@ void run_tests( mi::neuraylib::INeuray* neuray)
         // test an API class which references another DB element by tag
         test_texture( global_scope.get());
 
+        // test the change feed based on the DB journal
+        test_change_feed( global_scope.get());
+
         // test an API class without DB class counterpart
         test_string( global_scope.get());
 
@@ -251,6 +311,7 @@ MI_TEST_AUTO_FUNCTION( test_db_elements )
             neuray->get_api_component<mi::neuraylib::IDebug_configuration>());
         MI_CHECK_EQUAL( 0, debug_configuration->set_option( "check_serializer_store=1"));
         MI_CHECK_EQUAL( 0, debug_configuration->set_option( "check_serializer_edit=1"));
+        MI_CHECK_EQUAL( 0, debug_configuration->set_option( "dblight_journal=1"));
 
         run_tests( neuray.get());
         run_tests( neuray.get());
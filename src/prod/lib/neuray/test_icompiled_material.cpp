@@ -40,20 +40,24 @@
 #include <base/system/test/i_test_auto_case.h>
 
 #include <mi/neuraylib/argument_editor.h>
+#include <mi/neuraylib/ibuffer.h>
 #include <mi/neuraylib/icanvas.h>
 #include <mi/neuraylib/icolor.h>
 #include <mi/neuraylib/icompiled_material.h>
 #include <mi/neuraylib/idebug_configuration.h>
 #include <mi/neuraylib/iimage_api.h>
+#include <mi/neuraylib/imap.h>
 #include <mi/neuraylib/imaterial_instance.h>
 #include <mi/neuraylib/imdl_backend.h>
 #include <mi/neuraylib/imdl_backend_api.h>
 #include <mi/neuraylib/imdl_distiller_api.h>
 #include <mi/neuraylib/ineuray.h>
+#include <mi/neuraylib/inumber.h>
 #include <mi/neuraylib/iplugin_configuration.h>
 #include <mi/neuraylib/itile.h>
 
 #include <cctype>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -907,6 +911,259 @@ void check_connected_function_db_name(
     }
 }
 
+void check_change_feed( mi::neuraylib::ITransaction* transaction, mi::neuraylib::INeuray* neuray)
+{
+    mi::base::Handle<mi::neuraylib::IMdl_factory> mdl_factory(
+        neuray->get_api_component<mi::neuraylib::IMdl_factory>());
+
+    // Uses the calls created by check_connected_function_db_name():
+    //
+    // main_indirect(tint: extract_value(lookup: lookup_value(value: create_value(...))))
+    std::string mi_name = "mdl::test_class_param_paths::main_indirect";
+    std::string cm_name = "mdl::test_class_param_paths::main_indirect_compiled";
+    std::string create_value_fc_name = "mdl::test_class_param_paths::create_value";
+    {
+        mi::base::Handle<const mi::neuraylib::IMaterial_instance> mi(
+            transaction->access<const mi::neuraylib::IMaterial_instance>( mi_name.c_str()));
+        mi::base::Handle<mi::neuraylib::ICompiled_material> cm(
+            mi->create_compiled_material( mi::neuraylib::IMaterial_instance::CLASS_COMPILATION));
+        MI_CHECK( cm);
+        MI_CHECK_EQUAL( 0, transaction->store( cm.get(), cm_name.c_str()));
+    }
+
+    std::string time_stamp = transaction->get_time_stamp();
+    {
+        mi::neuraylib::Argument_editor ae(
+            transaction, create_value_fc_name.c_str(), mdl_factory.get(), true);
+        MI_CHECK_ZERO( ae.set_value( "scale", 2.0f));
+    }
+
+    mi::base::Handle<const mi::IMap> changes(
+        transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), false));
+    MI_CHECK( changes);
+    MI_CHECK_EQUAL( 1, changes->get_length());
+    mi::base::Handle<const mi::IUint32> flags(
+        changes->get_value<mi::IUint32>( create_value_fc_name.c_str()));
+    MI_CHECK( flags);
+    MI_CHECK_NOT_EQUAL( 0, flags->get_value<mi::Uint32>());
+
+    // The dependents reach the material instance via the chain of calls, and the compiled
+    // material created from the instance.
+    changes = transaction->get_changed_elements_since_time_stamp( time_stamp.c_str(), true);
+    MI_CHECK( changes);
+    for( const char* name: {
+            "mdl::test_class_param_paths::lookup_value",
+            "mdl::test_class_param_paths::extract_value",
+            "mdl::test_class_param_paths::main_indirect",
+            "mdl::test_class_param_paths::main_indirect_compiled"}) {
+        flags = changes->get_value<mi::IUint32>( name);
+        MI_CHECK( flags);
+        MI_CHECK_EQUAL( 0, flags->get_value<mi::Uint32>());
+    }
+}
+
+/// Resource callback mapping resources and strings known to the target code.
+class Known_resource_callback
+  : public mi::base::Interface_implement<mi::neuraylib::ITarget_resource_callback>
+{
+public:
+    Known_resource_callback(
+        mi::neuraylib::ITransaction* transaction, const mi::neuraylib::ITarget_code* code)
+      : m_transaction( transaction), m_code( code) { }
+
+    mi::Uint32 get_resource_index( const mi::neuraylib::IValue_resource* resource) final
+    { return m_code->get_known_resource_index( m_transaction, resource); }
+
+    mi::Uint32 get_string_index( const mi::neuraylib::IValue_string* s) final
+    {
+        for( mi::Size i = 1, n = m_code->get_string_constant_count(); i < n; ++i)
+            if( strcmp( m_code->get_string_constant( i), s->get_value()) == 0)
+                return static_cast<mi::Uint32>( i);
+        return 0;
+    }
+
+private:
+    mi::neuraylib::ITransaction* m_transaction;
+    const mi::neuraylib::ITarget_code* m_code;
+};
+
+/// Checks that write_argument_blocks() and update_argument_block() produce the same data as
+/// create_argument_block().
+void check_argument_blocks(
+    mi::neuraylib::ITransaction* transaction,
+    const mi::neuraylib::ITarget_code* code,
+    const mi::neuraylib::ICompiled_material* cm)
+{
+    MI_CHECK_EQUAL( 1, code->get_argument_block_count());
+    Known_resource_callback callback( transaction, code);
+
+    mi::base::Handle<const mi::neuraylib::ITarget_argument_block> block(
+        code->create_argument_block( 0, cm, &callback));
+    MI_CHECK( block);
+    mi::Size size = block->get_size();
+    MI_CHECK( size > 0);
+
+    // two blocks with padding in between, which must not be touched
+    mi::Size stride = size + 16;
+    std::vector<char> buffer( 2 * stride, '\x5a');
+    const mi::neuraylib::ICompiled_material* materials[2] = { cm, cm };
+    MI_CHECK_EQUAL( 0, code->write_argument_blocks(
+        0, materials, 2, &callback, buffer.data(), stride));
+    MI_CHECK_EQUAL( 0, memcmp( block->get_data(), buffer.data(), size));
+    MI_CHECK_EQUAL( 0, memcmp( block->get_data(), buffer.data() + stride, size));
+    for( mi::Size i = size; i < stride; ++i) {
+        MI_CHECK_EQUAL( '\x5a', buffer[i]);
+        MI_CHECK_EQUAL( '\x5a', buffer[stride + i]);
+    }
+
+    MI_CHECK_EQUAL( -1, code->write_argument_blocks(
+        0, materials, 2, nullptr, buffer.data(), stride));
+    MI_CHECK_EQUAL( -1, code->write_argument_blocks(
+        1, materials, 2, &callback, buffer.data(), stride));
+    MI_CHECK_EQUAL( -2, code->write_argument_blocks(
+        0, materials, 2, &callback, buffer.data(), size - 1));
+
+    // rewriting all parameters of a cleared block restores the data
+    mi::Size n = cm->get_parameter_count();
+    std::vector<mi::Size> indices( n);
+    for( mi::Size i = 0; i < n; ++i)
+        indices[i] = i;
+    std::vector<char> updated( size, 0);
+    MI_CHECK_EQUAL( 0, code->update_argument_block(
+        0, cm, indices.data(), n, &callback, updated.data()));
+    MI_CHECK_EQUAL( 0, memcmp( block->get_data(), updated.data(), size));
+
+    // rewriting a single parameter of a block restores only that parameter (skip compounds,
+    // their padding is not rewritten)
+    mi::base::Handle<mi::neuraylib::ITarget_argument_block> modified( block->clone());
+    mi::base::Handle<const mi::neuraylib::ITarget_value_layout> layout(
+        code->get_argument_block_layout( 0));
+    for( mi::Size i = 0; i < n; ++i) {
+        mi::neuraylib::IValue::Kind kind;
+        mi::Size arg_size;
+        mi::Size offset = layout->get_layout( kind, arg_size, layout->get_nested_state( i));
+        if(    kind == mi::neuraylib::IValue::VK_VECTOR || kind == mi::neuraylib::IValue::VK_MATRIX
+            || kind == mi::neuraylib::IValue::VK_ARRAY  || kind == mi::neuraylib::IValue::VK_COLOR
+            || kind == mi::neuraylib::IValue::VK_STRUCT)
+            continue;
+        memset( modified->get_data() + offset, 0x5a, arg_size);
+        MI_CHECK_EQUAL( 0, code->update_argument_block(
+            0, cm, &i, 1, &callback, modified->get_data()));
+        MI_CHECK_EQUAL( 0, memcmp( block->get_data(), modified->get_data(), size));
+    }
+
+    mi::Size invalid = n;
+    MI_CHECK_EQUAL( -2, code->update_argument_block(
+        0, cm, &invalid, 1, &callback, updated.data()));
+}
+
+bool equal_cstr( const char* lhs, const char* rhs)
+{
+    return lhs && rhs ? strcmp( lhs, rhs) == 0 : lhs == rhs;
+}
+
+/// Checks that deserializing the serialized \p code yields the same code, code segments,
+/// resource tables, string constants, and argument blocks and their layouts.
+void check_serialization(
+    mi::neuraylib::ITransaction* transaction,
+    const mi::neuraylib::IMdl_backend* be,
+    const mi::neuraylib::ITarget_code* code,
+    mi::neuraylib::IMdl_execution_context* context)
+{
+    MI_CHECK( code->supports_serialization());
+
+    mi::base::Handle<const mi::neuraylib::IBuffer> buffer( code->serialize( context));
+    MI_CHECK_CTX( context);
+    MI_CHECK( buffer);
+    MI_CHECK( buffer->get_data_size() > 0);
+
+    mi::base::Handle<const mi::neuraylib::ITarget_code> restored(
+        be->deserialize_target_code( transaction, buffer.get(), context));
+    MI_CHECK_CTX( context);
+    MI_CHECK( restored);
+
+    MI_CHECK_EQUAL( code->get_backend_kind(), restored->get_backend_kind());
+    MI_CHECK_EQUAL( code->get_code_size(), restored->get_code_size());
+    MI_CHECK_EQUAL( 0, memcmp( code->get_code(), restored->get_code(), code->get_code_size()));
+
+    mi::Size n = code->get_code_segment_count();
+    MI_CHECK_EQUAL( n, restored->get_code_segment_count());
+    for( mi::Size i = 0; i < n; ++i) {
+        mi::Size size = code->get_code_segment_size( i);
+        MI_CHECK_EQUAL( size, restored->get_code_segment_size( i));
+        MI_CHECK_EQUAL(
+            0, memcmp( code->get_code_segment( i), restored->get_code_segment( i), size));
+        MI_CHECK( equal_cstr(
+            code->get_code_segment_description( i), restored->get_code_segment_description( i)));
+    }
+
+    n = code->get_callable_function_count();
+    MI_CHECK_EQUAL( n, restored->get_callable_function_count());
+    for( mi::Size i = 0; i < n; ++i) {
+        MI_CHECK_EQUAL_CSTR( code->get_callable_function( i), restored->get_callable_function( i));
+        MI_CHECK_EQUAL( code->get_callable_function_argument_block_index( i),
+            restored->get_callable_function_argument_block_index( i));
+    }
+
+    n = code->get_texture_count();
+    MI_CHECK_EQUAL( n, restored->get_texture_count());
+    for( mi::Size i = 0; i < n; ++i) {
+        MI_CHECK( equal_cstr( code->get_texture( i), restored->get_texture( i)));
+        MI_CHECK( equal_cstr( code->get_texture_selector( i), restored->get_texture_selector( i)));
+        MI_CHECK_EQUAL( code->get_texture_gamma( i), restored->get_texture_gamma( i));
+        MI_CHECK_EQUAL( code->get_texture_shape( i), restored->get_texture_shape( i));
+    }
+
+    n = code->get_light_profile_count();
+    MI_CHECK_EQUAL( n, restored->get_light_profile_count());
+    for( mi::Size i = 0; i < n; ++i)
+        MI_CHECK( equal_cstr( code->get_light_profile( i), restored->get_light_profile( i)));
+
+    n = code->get_bsdf_measurement_count();
+    MI_CHECK_EQUAL( n, restored->get_bsdf_measurement_count());
+    for( mi::Size i = 0; i < n; ++i)
+        MI_CHECK( equal_cstr( code->get_bsdf_measurement( i), restored->get_bsdf_measurement( i)));
+
+    n = code->get_string_constant_count();
+    MI_CHECK_EQUAL( n, restored->get_string_constant_count());
+    for( mi::Size i = 0; i < n; ++i)
+        MI_CHECK( equal_cstr( code->get_string_constant( i), restored->get_string_constant( i)));
+
+    n = code->get_argument_layout_count();
+    MI_CHECK_EQUAL( n, restored->get_argument_layout_count());
+    for( mi::Size i = 0; i < n; ++i) {
+        mi::base::Handle<const mi::neuraylib::ITarget_value_layout> layout(
+            code->get_argument_block_layout( i));
+        mi::base::Handle<const mi::neuraylib::ITarget_value_layout> restored_layout(
+            restored->get_argument_block_layout( i));
+        MI_CHECK_EQUAL( layout->get_size(), restored_layout->get_size());
+        mi::Size m = layout->get_num_elements();
+        MI_CHECK_EQUAL( m, restored_layout->get_num_elements());
+        for( mi::Size j = 0; j < m; ++j) {
+            mi::neuraylib::Target_value_layout_state state = layout->get_nested_state( j);
+            mi::neuraylib::IValue::Kind kind, restored_kind;
+            mi::Size size = 0, restored_size = 0;
+            mi::Size offset = layout->get_layout( kind, size, state);
+            MI_CHECK_EQUAL(
+                offset, restored_layout->get_layout( restored_kind, restored_size, state));
+            MI_CHECK_EQUAL( kind, restored_kind);
+            MI_CHECK_EQUAL( size, restored_size);
+        }
+    }
+
+    n = code->get_argument_block_count();
+    MI_CHECK_EQUAL( n, restored->get_argument_block_count());
+    for( mi::Size i = 0; i < n; ++i) {
+        mi::base::Handle<const mi::neuraylib::ITarget_argument_block> block(
+            code->get_argument_block( i));
+        mi::base::Handle<const mi::neuraylib::ITarget_argument_block> restored_block(
+            restored->get_argument_block( i));
+        MI_CHECK_EQUAL( block->get_size(), restored_block->get_size());
+        MI_CHECK_EQUAL(
+            0, memcmp( block->get_data(), restored_block->get_data(), block->get_size()));
+    }
+}
+
 void check_backends_llvm( mi::neuraylib::ITransaction* transaction, mi::neuraylib::INeuray* neuray)
 {
     mi::base::Handle<mi::neuraylib::IMdl_backend_api> mdl_backend_api(
@@ -1000,6 +1257,24 @@ void check_backends_llvm( mi::neuraylib::ITransaction* transaction, mi::neurayli
 
         MI_CHECK_EQUAL( 0, code->get_string_constant_count());
     }
+    {
+        // Regular material part, class compilation
+        MI_CHECK_EQUAL( 0, be->set_option( "enable_simd", "off"));
+        MI_CHECK_EQUAL( 0, be->set_option( "enable_ro_segment", "off"));
+
+        mi::base::Handle<const mi::neuraylib::ITarget_code> code(
+            be->translate_material_expression(
+                transaction,
+                cm_cc.get(),
+                "surface.scattering.components.value0.component.tint",
+                "tint",
+                context.get()));
+        MI_CHECK_CTX( context);
+        MI_CHECK( code);
+
+        check_argument_blocks( transaction, code.get(), cm_cc.get());
+        check_serialization( transaction, be.get(), code.get(), context.get());
+    }
     {
         // Environment
         MI_CHECK_EQUAL( 0, be->set_option( "enable_simd", "off"));
@@ -1423,6 +1698,8 @@ void check_backends_glsl( mi::neuraylib::ITransaction* transaction, mi::neurayli
         MI_CHECK_EQUAL( 0, code->get_code_segment_count());
 
         MI_CHECK_EQUAL( 0, code->get_string_constant_count());
+
+        check_serialization( transaction, be.get(), code.get(), context.get());
     }
     {
         // Environment
@@ -1498,6 +1775,54 @@ void check_backends_glsl( mi::neuraylib::ITransaction* transaction, mi::neurayli
         MI_CHECK_EQUAL_CSTR( "something", code->get_string_constant( 1));
         MI_CHECK_EQUAL_CSTR( "abc",       code->get_string_constant( 2));
     }
+    {
+        // Merging of identical functions (without optimizations, such that the helpers are
+        // not inlined)
+        mi::base::Handle<const mi::neuraylib::IFunction_definition> fd_merge(
+            transaction->access<mi::neuraylib::IFunction_definition>(
+                "mdl::" TEST_MDL "::fd_merge(float)"));
+        MI_CHECK_EQUAL( 0, be->set_option( "opt_level", "0"));
+
+        mi::base::Handle<const mi::neuraylib::ITarget_code> code[2];
+        for( int merge = 0; merge < 2; ++merge) {
+            MI_CHECK_EQUAL( 0, be->set_option( "glsl_merge_functions", merge ? "on" : "off"));
+
+            mi::base::Handle<mi::neuraylib::ILink_unit> unit(
+                be->create_link_unit( transaction, context.get()));
+            MI_CHECK_CTX( context);
+            result = unit->add_function(
+                fd_merge.get(), mi::neuraylib::ILink_unit::FEC_CORE, "merge", context.get());
+            MI_CHECK_CTX( context);
+
+            code[merge] = be->translate_link_unit( unit.get(), context.get());
+            MI_CHECK_CTX( context);
+            MI_CHECK( code[merge]);
+            MI_CHECK_EQUAL( 1, code[merge]->get_callable_function_count());
+            MI_CHECK_EQUAL_CSTR( "merge", code[merge]->get_callable_function( 0));
+        }
+
+        // Both helpers are emitted without merging, only one with merging.
+        std::string unmerged( code[0]->get_code(), code[0]->get_code_size());
+        std::string merged( code[1]->get_code(), code[1]->get_code_size());
+        MI_CHECK( unmerged.find( "fd_merge_a") != std::string::npos);
+        MI_CHECK( unmerged.find( "fd_merge_b") != std::string::npos);
+        MI_CHECK( merged.find( "fd_merge_a") == std::string::npos
+            || merged.find( "fd_merge_b") == std::string::npos);
+        MI_CHECK_LESS( merged.size(), unmerged.size());
+
+        // The interface of the generated code is unchanged.
+        MI_CHECK_EQUAL( code[0]->get_texture_count(), code[1]->get_texture_count());
+        MI_CHECK_EQUAL(
+            code[0]->get_string_constant_count(), code[1]->get_string_constant_count());
+        MI_CHECK_EQUAL(
+            code[0]->get_callable_function_df_handle_count( 0),
+            code[1]->get_callable_function_df_handle_count( 0));
+        MI_CHECK_EQUAL(
+            code[0]->get_callable_function_kind( 0), code[1]->get_callable_function_kind( 0));
+
+        MI_CHECK_EQUAL( 0, be->set_option( "glsl_merge_functions", "off"));
+        MI_CHECK_EQUAL( 0, be->set_option( "opt_level", "2"));
+    }
 }
 
 void check_multiscatter_textures( mi::neuraylib::INeuray* neuray)
@@ -1557,6 +1882,30 @@ void check_distiller( mi::neuraylib::ITransaction* transaction, mi::neuraylib::I
     mi::base::Handle<mi::neuraylib::IMdl_execution_context> context(
         mdl_factory->create_execution_context());
 
+    // Distiller options enabling the distiller cache
+    mi::base::Handle<mi::IBoolean> cache( transaction->create<mi::IBoolean>( "Boolean"));
+    cache->set_value( true);
+    mi::base::Handle<mi::IMap> cache_options( transaction->create<mi::IMap>( "Map<Interface>"));
+    cache_options->insert( "cache", cache.get());
+
+    // Checks whether two distilled materials have the same structure and arguments.
+    mi::base::Handle<mi::neuraylib::IValue_factory> vf(
+        mdl_factory->create_value_factory( transaction));
+    auto check_same_distilled_material = [&vf](
+        const mi::neuraylib::ICompiled_material* lhs,
+        const mi::neuraylib::ICompiled_material* rhs,
+        bool expected)
+    {
+        bool same = lhs->get_hash() == rhs->get_hash()
+            && lhs->get_parameter_count() == rhs->get_parameter_count();
+        for( mi::Size i = 0; same && i < lhs->get_parameter_count(); ++i) {
+            mi::base::Handle<const mi::neuraylib::IValue> lhs_arg( lhs->get_argument( i));
+            mi::base::Handle<const mi::neuraylib::IValue> rhs_arg( rhs->get_argument( i));
+            same = vf->compare( lhs_arg.get(), rhs_arg.get()) == 0;
+        }
+        MI_CHECK_EQUAL( same, expected);
+    };
+
     {
         // Distill a compiled material from instance compilation
         mi::base::Handle<const mi::neuraylib::IMaterial_instance> mi(
@@ -1592,6 +1941,130 @@ void check_distiller( mi::neuraylib::ITransaction* transaction, mi::neuraylib::I
                 cm.get(), "diffuse", /*distiller_options*/ nullptr, &errors));
         MI_CHECK_EQUAL( errors, 0);
         MI_CHECK( new_cm);
+
+        // Distilling twice with the distiller cache (first a miss, then a hit) yields the same
+        // result as distilling without the cache
+        for( int i = 0; i < 2; ++i) {
+            mi::base::Handle<const mi::neuraylib::ICompiled_material> cached_cm(
+                mdl_distiller_api->distill_material(
+                    cm.get(), "diffuse", cache_options.get(), &errors));
+            MI_CHECK_EQUAL( errors, 0);
+            MI_CHECK( cached_cm);
+            check_same_distilled_material( new_cm.get(), cached_cm.get(), true);
+        }
+    }
+    {
+        // The distiller cache takes the arguments of class-compiled materials into account
+        const char* names[] = {
+            "mdl::" TEST_MDL "::distiller_cache_red",
+            "mdl::" TEST_MDL "::distiller_cache_green"
+        };
+        const mi::Color tints[] = { mi::Color( 1.0f, 0.0f, 0.0f), mi::Color( 0.0f, 1.0f, 0.0f) };
+
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> cms[2];
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> expected[2];
+        for( int i = 0; i < 2; ++i) {
+            do_create_function_call( transaction, "mdl::" TEST_MDL "::md_1(color)", names[i]);
+            {
+                mi::neuraylib::Argument_editor ae(
+                    transaction, names[i], mdl_factory.get(), true);
+                MI_CHECK_ZERO( ae.set_value( "tint", tints[i]));
+            }
+
+            mi::base::Handle<const mi::neuraylib::IMaterial_instance> mi(
+                transaction->access<mi::neuraylib::IMaterial_instance>( names[i]));
+            cms[i] = mi->create_compiled_material(
+                mi::neuraylib::IMaterial_instance::CLASS_COMPILATION, context.get());
+            MI_CHECK_CTX( context);
+            MI_CHECK( cms[i]);
+
+            mi::Sint32 errors;
+            expected[i] = mdl_distiller_api->distill_material(
+                cms[i].get(), "diffuse", /*distiller_options*/ nullptr, &errors);
+            MI_CHECK_EQUAL( errors, 0);
+            MI_CHECK( expected[i]);
+        }
+        MI_CHECK( cms[0]->get_hash() == cms[1]->get_hash());
+        check_same_distilled_material( expected[0].get(), expected[1].get(), false);
+
+        // Fill the cache with the first material, the second one must not hit that entry
+        for( int i = 0; i < 2; ++i) {
+            mi::Sint32 errors;
+            mi::base::Handle<const mi::neuraylib::ICompiled_material> cached_cm(
+                mdl_distiller_api->distill_material(
+                    cms[i].get(), "diffuse", cache_options.get(), &errors));
+            MI_CHECK_EQUAL( errors, 0);
+            check_same_distilled_material( expected[i].get(), cached_cm.get(), true);
+        }
+
+        // Different options must not hit the cached entries either
+        mi::base::Handle<mi::IBoolean> layer_normal( transaction->create<mi::IBoolean>( "Boolean"));
+        layer_normal->set_value( false);
+        mi::base::Handle<mi::IMap> options( transaction->create<mi::IMap>( "Map<Interface>"));
+        options->insert( "cache", cache.get());
+        options->insert( "layer_normal", layer_normal.get());
+
+        mi::base::Handle<mi::IMap> uncached_options(
+            transaction->create<mi::IMap>( "Map<Interface>"));
+        uncached_options->insert( "layer_normal", layer_normal.get());
+
+        mi::Sint32 errors;
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> uncached_cm(
+            mdl_distiller_api->distill_material(
+                cms[0].get(), "diffuse", uncached_options.get(), &errors));
+        MI_CHECK_EQUAL( errors, 0);
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> cached_cm(
+            mdl_distiller_api->distill_material(
+                cms[0].get(), "diffuse", options.get(), &errors));
+        MI_CHECK_EQUAL( errors, 0);
+        check_same_distilled_material( uncached_cm.get(), cached_cm.get(), true);
+    }
+    {
+        // Distill several compiled materials in one batch
+        const char* names[] = {
+            "mdl::" TEST_MDL "::mi_0",
+            "mdl::" TEST_MDL "::mi_1",
+            "mdl::" TEST_MDL "::mi_0"
+        };
+        const mi::Size n = sizeof( names) / sizeof( names[0]);
+
+        mi::base::Handle<const mi::neuraylib::ICompiled_material> cms[n];
+        const mi::neuraylib::ICompiled_material* inputs[n];
+        for( mi::Size i = 0; i < n; ++i) {
+            mi::base::Handle<const mi::neuraylib::IMaterial_instance> mi(
+                transaction->access<mi::neuraylib::IMaterial_instance>( names[i]));
+            cms[i] = mi->create_compiled_material(
+                mi::neuraylib::IMaterial_instance::CLASS_COMPILATION, context.get());
+            MI_CHECK_CTX( context);
+            MI_CHECK( cms[i]);
+            inputs[i] = cms[i].get();
+        }
+
+        mi::neuraylib::ICompiled_material* outputs[n];
+        mi::Sint32 errors[n];
+        mi::Sint32 result = mdl_distiller_api->distill_materials(
+            inputs, n, "diffuse", /*distiller_options*/ nullptr, outputs, errors);
+        MI_CHECK_EQUAL( result, 0);
+
+        for( mi::Size i = 0; i < n; ++i) {
+            mi::base::Handle<const mi::neuraylib::ICompiled_material> output( outputs[i]);
+            MI_CHECK_EQUAL( errors[i], 0);
+            MI_CHECK( output);
+
+            mi::base::Handle<const mi::neuraylib::ICompiled_material> expected(
+                mdl_distiller_api->distill_material(
+                    inputs[i], "diffuse", /*distiller_options*/ nullptr, &errors[i]));
+            MI_CHECK( expected);
+            MI_CHECK( output->get_hash() == expected->get_hash());
+        }
+
+        result = mdl_distiller_api->distill_materials(
+            inputs, n, "invalid_target", /*distiller_options*/ nullptr, outputs, errors);
+        MI_CHECK_EQUAL( result, -2);
+        for( mi::Size i = 0; i < n; ++i) {
+            MI_CHECK_EQUAL( errors[i], -2);
+            MI_CHECK( !outputs[i]);
+        }
     }
 }
 
@@ -1975,6 +2448,7 @@ void run_tests( mi::neuraylib::INeuray* neuray, bool first_run)
         check_type_binding( transaction.get(), mdl_factory.get());
         check_hashing( transaction.get(), neuray);
         check_connected_function_db_name( transaction.get(), neuray);
+        check_change_feed( transaction.get(), neuray);
         check_target_material_mode( database.get(), neuray); // uses separate scopes/transactions
 
         // Backends
@@ -2006,6 +2480,7 @@ MI_TEST_AUTO_FUNCTION( test_icompiled_material )
             neuray->get_api_component<mi::neuraylib::IDebug_configuration>());
         MI_CHECK_EQUAL( 0, debug_configuration->set_option( "check_serializer_store=1"));
         MI_CHECK_EQUAL( 0, debug_configuration->set_option( "check_serializer_edit=1"));
+        MI_CHECK_EQUAL( 0, debug_configuration->set_option( "dblight_journal=1"));
 
         // set MDL paths
         std::string path1 = MI::TEST::mi_src_path( "prod/lib/neuray");
@@ -49,6 +49,7 @@
 #include <mi/neuraylib/iimage_api.h>
 #include <mi/neuraylib/ilightprofile.h>
 #include <mi/neuraylib/imdl_configuration.h>
+#include <mi/neuraylib/imdl_evaluator_api.h>
 #include <mi/neuraylib/iplugin_configuration.h>
 #include <mi/neuraylib/ireader.h>
 
@@ -2460,6 +2461,120 @@ void load_secondary_modules_from_string(
 }
 
 
+void check_enable_if_batch(
+    mi::neuraylib::ITransaction* transaction, mi::neuraylib::INeuray* neuray)
+{
+    mi::base::Handle<mi::neuraylib::IMdl_factory> mdl_factory(
+        neuray->get_api_component<mi::neuraylib::IMdl_factory>());
+    mi::base::Handle<mi::neuraylib::IMdl_impexp_api> mdl_impexp_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_impexp_api>());
+    mi::base::Handle<mi::neuraylib::IMdl_evaluator_api> mdl_evaluator_api(
+        neuray->get_api_component<mi::neuraylib::IMdl_evaluator_api>());
+    mi::base::Handle<mi::neuraylib::IValue_factory> vf(
+        mdl_factory->create_value_factory( transaction));
+    mi::base::Handle<mi::neuraylib::IExpression_factory> ef(
+        mdl_factory->create_expression_factory( transaction));
+
+    const char* data =
+        "mdl 1.7;\n"
+        "import ::anno::*;\n"
+        "export int fd_enable_if(\n"
+        "    int mode = 0,\n"
+        "    float a = 1.0 [[ anno::enable_if(\"mode == 1\") ]],\n"
+        "    float b = 2.0 [[ anno::enable_if(\"mode == 1 || mode == 2\") ]],\n"
+        "    float c = 3.0 [[ anno::enable_if(\"a > 0.5\") ]],\n"
+        "    float d = 4.0)\n"
+        "{ return mode; }\n";
+    result = mdl_impexp_api->load_module_from_string( transaction, "::enable_if_batch", data);
+    MI_CHECK_EQUAL( 0, result);
+
+    mi::base::Handle<const mi::neuraylib::IFunction_definition> c_fd(
+        transaction->access<mi::neuraylib::IFunction_definition>(
+            "mdl::enable_if_batch::fd_enable_if(int,float,float,float,float)"));
+    MI_CHECK( c_fd);
+    mi::base::Handle<mi::neuraylib::IFunction_call> m_fc(
+        c_fd->create_function_call( nullptr, &result));
+    MI_CHECK_EQUAL( 0, result);
+    MI_CHECK( m_fc);
+
+    const mi::Size n = m_fc->get_parameter_count();
+    MI_CHECK_EQUAL( 5, n);
+
+    // The batched results agree with the results of the single-parameter method.
+    auto check_against_single = [&]( const mi::Sint32* results) {
+        for( mi::Size i = 0; i < n; ++i) {
+            mi::Sint32 errors = 0;
+            mi::base::Handle<const mi::neuraylib::IValue_bool> enabled(
+                mdl_evaluator_api->is_function_parameter_enabled(
+                    transaction, vf.get(), m_fc.get(), i, &errors));
+            MI_CHECK_EQUAL( 0, errors);
+            MI_CHECK( enabled);
+            MI_CHECK_EQUAL( enabled->get_value() ? 1 : 0, results[i]);
+        }
+    };
+
+    // Evaluate all conditions.
+    mi::Sint32 results[5] = { -1, -1, -1, -1, -1};
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), nullptr, 0, results, n);
+    MI_CHECK_EQUAL( 0, result);
+    MI_CHECK_EQUAL( 1, results[0]); // no condition
+    MI_CHECK_EQUAL( 0, results[1]);
+    MI_CHECK_EQUAL( 0, results[2]);
+    MI_CHECK_EQUAL( 1, results[3]);
+    MI_CHECK_EQUAL( 1, results[4]); // no condition
+    check_against_single( results);
+
+    // Change "mode" and re-evaluate only its users. Elements for other parameters are untouched
+    // (the sentinel values show that they were not evaluated).
+    mi::base::Handle<mi::neuraylib::IValue> mode( vf->create_int( 1));
+    mi::base::Handle<mi::neuraylib::IExpression> mode_expr( ef->create_constant( mode.get()));
+    MI_CHECK_EQUAL( 0, m_fc->set_argument( "mode", mode_expr.get()));
+
+    const mi::Size changed[] = { 0};
+    results[0] = 42;
+    results[3] = 42;
+    results[4] = 42;
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), changed, 1, results, n);
+    MI_CHECK_EQUAL( 0, result);
+    MI_CHECK_EQUAL( 42, results[0]);
+    MI_CHECK_EQUAL( 1, results[1]);
+    MI_CHECK_EQUAL( 1, results[2]);
+    MI_CHECK_EQUAL( 42, results[3]);
+    MI_CHECK_EQUAL( 42, results[4]);
+
+    // Change "a" such that the condition of "c" becomes false.
+    mi::base::Handle<mi::neuraylib::IValue> a( vf->create_float( 0.25f));
+    mi::base::Handle<mi::neuraylib::IExpression> a_expr( ef->create_constant( a.get()));
+    MI_CHECK_EQUAL( 0, m_fc->set_argument( "a", a_expr.get()));
+
+    const mi::Size changed_a[] = { 1};
+    results[0] = 1;
+    results[3] = 42;
+    results[4] = 1;
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), changed_a, 1, results, n);
+    MI_CHECK_EQUAL( 0, result);
+    MI_CHECK_EQUAL( 0, results[3]);
+    check_against_single( results);
+
+    // Invalid parameters
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, nullptr, nullptr, 0, results, n);
+    MI_CHECK_EQUAL( -1, result);
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), nullptr, 0, nullptr, n);
+    MI_CHECK_EQUAL( -1, result);
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), nullptr, 0, results, n-1);
+    MI_CHECK_EQUAL( -2, result);
+    const mi::Size out_of_bounds[] = { n};
+    result = mdl_evaluator_api->are_function_parameters_enabled(
+        transaction, m_fc.get(), out_of_bounds, 1, results, n);
+    MI_CHECK_EQUAL( -2, result);
+}
+
 void check_imodule_part2( mi::neuraylib::ITransaction* transaction, mi::neuraylib::INeuray* neuray)
 {
     mi::base::Handle<mi::neuraylib::IFactory> factory(
@@ -3179,6 +3294,7 @@ void run_tests( mi::neuraylib::INeuray* neuray)
         // Misc checks that requires a few more modules to load.
         load_secondary_modules( transaction.get(), neuray);
         load_secondary_modules_from_string( transaction.get(), neuray);
+        check_enable_if_batch( transaction.get(), neuray);
         check_imodule_part2( transaction.get(), neuray);
         check_mangled_names( transaction.get());
         check_implicit_casts( transaction.get(), neuray);
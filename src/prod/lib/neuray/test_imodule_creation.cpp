@@ -2273,6 +2273,76 @@ void check_module_builder_implicit_casts(
     MI_CHECK_EQUAL( 0, result);
 }
 
+void check_module_builder_deferred(
+    mi::neuraylib::ITransaction* transaction, mi::neuraylib::IMdl_factory* mdl_factory)
+{
+    mi::base::Handle<mi::neuraylib::IMdl_execution_context> context(
+        mdl_factory->create_execution_context());
+
+    // create module "mdl::deferred" with several variants in the deferred analysis mode
+
+    mi::base::Handle<mi::neuraylib::IMdl_module_builder> module_builder(
+        mdl_factory->create_module_builder(
+            transaction,
+            "mdl::deferred",
+            mi::neuraylib::MDL_VERSION_1_0,
+            mi::neuraylib::MDL_VERSION_LATEST,
+            context.get()));
+
+    result = module_builder->set_deferred_analysis( true, context.get());
+    MI_CHECK_CTX( context);
+    MI_CHECK_EQUAL( 0, result);
+
+    const char* names[] = { "md_1_v0", "md_1_v1", "md_1_v2" };
+    for( const char* name: names) {
+        result = module_builder->add_variant(
+            name,
+            "mdl::" TEST_MDL "::md_1(color)",
+            /*defaults*/ nullptr,
+            /*annotations*/ nullptr,
+            /*return_annotations*/ nullptr,
+            /*is_exported*/ true,
+            /*is_declarative*/ false,
+            context.get());
+        MI_CHECK_CTX( context);
+        MI_CHECK_EQUAL( 0, result);
+    }
+
+    {
+        // the module is not exported before the commit
+        mi::base::Handle<const mi::neuraylib::IModule> c_module(
+            transaction->access<mi::neuraylib::IModule>( "mdl::deferred"));
+        MI_CHECK( !c_module);
+    }
+
+    result = module_builder->commit( context.get());
+    MI_CHECK_CTX( context);
+    MI_CHECK_EQUAL( 0, result);
+
+    {
+        mi::base::Handle<const mi::neuraylib::IModule> c_module(
+            transaction->access<mi::neuraylib::IModule>( "mdl::deferred"));
+        MI_CHECK( c_module);
+        MI_CHECK_EQUAL( 3, c_module->get_material_count());
+    }
+
+    // another modification after the commit, committed by leaving the deferred mode
+    result = module_builder->remove_entity( "md_1_v2", 0, context.get());
+    MI_CHECK_CTX( context);
+    MI_CHECK_EQUAL( 0, result);
+
+    result = module_builder->set_deferred_analysis( false, context.get());
+    MI_CHECK_CTX( context);
+    MI_CHECK_EQUAL( 0, result);
+
+    {
+        mi::base::Handle<const mi::neuraylib::IModule> c_module(
+            transaction->access<mi::neuraylib::IModule>( "mdl::deferred"));
+        MI_CHECK( c_module);
+        MI_CHECK_EQUAL( 2, c_module->get_material_count());
+    }
+}
+
 void check_module_transformer(
     mi::neuraylib::ITransaction* transaction, mi::neuraylib::INeuray* neuray)
 {
@@ -3152,6 +3222,7 @@ void run_tests( mi::neuraylib::INeuray* neuray)
         check_module_builder_removed( transaction.get(), mdl_factory.get());
         check_module_builder_utf8( transaction.get(), neuray);
         check_module_builder_implicit_casts( transaction.get(), mdl_factory.get());
+        check_module_builder_deferred( transaction.get(), mdl_factory.get());
 
         // Module transformer
         check_module_transformer( transaction.get(), neuray);
@@ -45,6 +45,8 @@
 
 #include <mi/neuraylib/factory.h>
 #include <mi/neuraylib/iarray.h>
+#include <mi/neuraylib/iattribute_container.h>
+#include <mi/neuraylib/icolor.h>
 #include <mi/neuraylib/icompound.h>
 #include <mi/neuraylib/idatabase.h>
 #include <mi/neuraylib/idebug_configuration.h>
@@ -562,6 +564,116 @@ void test(
     MI_CHECK( !array4);
 }
 
+// Element handles of (non-proxy) arrays stay valid when the array grows or shrinks, and
+// set_element() stores the object itself.
+void test_element_handles( mi::neuraylib::ITransaction* transaction)
+{
+    mi::base::Handle<mi::IDynamic_array> array(
+        transaction->create<mi::IDynamic_array>( "Float32[]"));
+    array->set_length( 1);
+    mi::base::Handle<mi::IFloat32> first( array->get_element<mi::IFloat32>( 0));
+    first->set_value( 1.0f);
+
+    for( int i = 0; i < 100; ++i) {
+        mi::base::Handle<mi::IFloat32> element( transaction->create<mi::IFloat32>( "Float32"));
+        element->set_value( static_cast<mi::Float32>( i));
+        MI_CHECK_EQUAL( 0, array->push_back( element.get()));
+    }
+    array->set_length( 1000);
+
+    mi::base::Handle<mi::IFloat32> first2( array->get_element<mi::IFloat32>( 0));
+    MI_CHECK_EQUAL( first.get(), first2.get());
+    MI_CHECK_EQUAL( 1.0f, first->get_value<mi::Float32>());
+    first->set_value( 2.0f);
+    MI_CHECK_EQUAL( 2.0f, first2->get_value<mi::Float32>());
+
+    MI_CHECK_EQUAL( 0, array->erase( 0));
+    MI_CHECK_EQUAL( 0, array->insert( 0, first.get()));
+    array->set_length( 1);
+    MI_CHECK_EQUAL( 2.0f, first->get_value<mi::Float32>());
+
+    mi::base::Handle<mi::IColor> color( transaction->create<mi::IColor>( "Color"));
+    mi::base::Handle<mi::IDynamic_array> colors(
+        transaction->create<mi::IDynamic_array>( "Color[]"));
+    MI_CHECK_EQUAL( 0, colors->push_back( color.get()));
+    colors->set_length( 64);
+    color->set_value( mi::Color( 1.0f, 2.0f, 3.0f, 4.0f));
+    mi::base::Handle<mi::IColor> front( colors->front<mi::IColor>());
+    MI_CHECK_EQUAL( color.get(), front.get());
+    MI_CHECK_EQUAL( 4.0f, front->get_value().a);
+
+    // non-proxy arrays do not provide raw access
+    MI_CHECK( !colors->get_data<mi::Color>());
+}
+
+// Attribute arrays of numbers and compounds provide raw access to their elements.
+void test_raw_data( mi::neuraylib::ITransaction* transaction, mi::neuraylib::IFactory* factory)
+{
+    mi::base::Handle<mi::neuraylib::IAttribute_container> attribute_container(
+        transaction->create<mi::neuraylib::IAttribute_container>( "Attribute_container"));
+    MI_CHECK( attribute_container);
+
+    {
+        // static array of numbers
+        mi::base::Handle<mi::IArray> array(
+            attribute_container->create_attribute<mi::IArray>( "floats", "Float32[4]"));
+        MI_CHECK( array);
+        mi::Float32* data = array->get_data<mi::Float32>();
+        MI_CHECK( data);
+        MI_CHECK( !array->get_data<mi::Sint32>());
+        MI_CHECK( !array->get_data( "Float64"));
+
+        // writes via the raw pointer are visible via the elements and vice versa
+        data[1] = 42.0f;
+        mi::base::Handle<mi::IFloat32> element( array->get_element<mi::IFloat32>( 1));
+        MI_CHECK_EQUAL( 42.0f, element->get_value<mi::Float32>());
+        element->set_value( 43.0f);
+        MI_CHECK_EQUAL( 43.0f, data[1]);
+
+        // compare() and assign_from_to() between attribute arrays
+        mi::base::Handle<mi::IArray> other(
+            attribute_container->create_attribute<mi::IArray>( "other_floats", "Float32[4]"));
+        MI_CHECK_EQUAL( +1, factory->compare( array.get(), other.get()));
+        MI_CHECK_EQUAL( 0, factory->assign_from_to( array.get(), other.get()));
+        MI_CHECK_EQUAL( 0, factory->compare( array.get(), other.get()));
+        const mi::Float32* other_data = other->get_data<mi::Float32>();
+        MI_CHECK( other_data != data);
+        MI_CHECK_EQUAL( 43.0f, other_data[1]);
+
+        // clone() yields a regular array with the same elements
+        mi::base::Handle<mi::IArray> clone( factory->clone<mi::IArray>( array.get()));
+        MI_CHECK( !clone->get_data<mi::Float32>());
+        MI_CHECK_EQUAL( 0, factory->compare( array.get(), clone.get()));
+    }
+    {
+        // dynamic array of compounds
+        mi::base::Handle<mi::IDynamic_array> array(
+            attribute_container->create_attribute<mi::IDynamic_array>( "colors", "Color[]"));
+        MI_CHECK( array);
+        MI_CHECK( !array->get_data<mi::Color>());
+        array->set_length( 3);
+        mi::Color* data = array->get_data<mi::Color>();
+        MI_CHECK( data);
+        data[2].g = 0.5f;
+
+        mi::base::Handle<mi::IColor> element( array->back<mi::IColor>());
+        MI_CHECK_EQUAL( 0.5f, element->get_value().g);
+        element->set_value( mi::Color( 1.0f, 2.0f, 3.0f, 4.0f));
+        MI_CHECK_EQUAL( 4.0f, data[2].a);
+
+        MI_CHECK_EQUAL( 0, array->erase( 0));
+        MI_CHECK_EQUAL( 2, array->get_length());
+        data = array->get_data<mi::Color>();
+        MI_CHECK_EQUAL( 3.0f, data[1].b);
+    }
+    {
+        // attribute arrays of other element types do not provide raw access
+        mi::base::Handle<mi::IArray> array(
+            attribute_container->create_attribute<mi::IArray>( "strings", "String[2]"));
+        MI_CHECK( array);
+        MI_CHECK( !array->get_data( "String"));
+    }
+}
 
 void run_tests( mi::neuraylib::INeuray* neuray)
 {
@@ -582,6 +694,12 @@ void run_tests( mi::neuraylib::INeuray* neuray)
         test<mi::IString>( transaction.get(),  0, "String");
         test<mi::IRef>(    transaction.get(),  0, "Ref");
 
+        test_element_handles( transaction.get());
+
+        mi::base::Handle<mi::neuraylib::IFactory> factory(
+            neuray->get_api_component<mi::neuraylib::IFactory>());
+        test_raw_data( transaction.get(), factory.get());
+
         MI_CHECK_EQUAL( 0, transaction->commit());
     }
 
@@ -48,6 +48,7 @@ using namespace std::string_literals;
 
 #include <base/lib/log/i_log_logger.h>
 #include <base/data/db/i_db_access.h>
+#include <base/data/db/i_db_snapshot_transaction.h>
 #include <io/image/image/i_image.h>
 #include <io/image/image/i_image_mipmap.h>
 #include <io/scene/mdl_elements/mdl_elements_detail.h> // DETAIL::Type_binder
@@ -1738,6 +1739,204 @@ mi::neuraylib::ITarget_argument_block *Target_argument_block::clone() const
 
 // ---------------------- Target value layout class ---------------------
 
+namespace {
+
+/// Value types and resource callback used when writing API values.
+struct Api_value_types
+{
+    typedef mi::neuraylib::IValue                    IValue;
+    typedef mi::neuraylib::IValue_bool               IValue_bool;
+    typedef mi::neuraylib::IValue_int                IValue_int;
+    typedef mi::neuraylib::IValue_enum               IValue_enum;
+    typedef mi::neuraylib::IValue_float              IValue_float;
+    typedef mi::neuraylib::IValue_double             IValue_double;
+    typedef mi::neuraylib::IValue_string             IValue_string;
+    typedef mi::neuraylib::IValue_compound           IValue_compound;
+    typedef mi::neuraylib::IValue_resource           IValue_resource;
+    typedef mi::neuraylib::ITarget_resource_callback Resource_callback;
+};
+
+/// Value types and resource callback used when writing internal values.
+struct Int_value_types
+{
+    typedef MDL::IValue                              IValue;
+    typedef MDL::IValue_bool                         IValue_bool;
+    typedef MDL::IValue_int                          IValue_int;
+    typedef MDL::IValue_enum                         IValue_enum;
+    typedef MDL::IValue_float                        IValue_float;
+    typedef MDL::IValue_double                       IValue_double;
+    typedef MDL::IValue_string                       IValue_string;
+    typedef MDL::IValue_compound                     IValue_compound;
+    typedef MDL::IValue_resource                     IValue_resource;
+    typedef ITarget_resource_callback_internal       Resource_callback;
+};
+
+/// Walks the layout by querying the generated-code layout at every element.
+class Layout_state_cursor
+{
+public:
+    Layout_state_cursor(
+        Target_value_layout const                &layout,
+        mi::neuraylib::Target_value_layout_state state)
+    : m_layout(&layout)
+    , m_state(state)
+    {
+        mi::Size arg_size = 0;
+        m_offset = layout.get_layout(m_kind, arg_size, state);
+    }
+
+    mi::neuraylib::IValue::Kind get_kind() const { return m_kind; }
+
+    mi::Size get_offset() const { return m_offset; }
+
+    mi::Size get_num_elements() const { return m_layout->get_num_elements(m_state); }
+
+    Layout_state_cursor get_first_element() const { return get_next_element(*this, 0); }
+
+    Layout_state_cursor get_next_element(Layout_state_cursor const &, mi::Size i) const
+    {
+        return Layout_state_cursor(*m_layout, m_layout->get_nested_state(i, m_state));
+    }
+
+private:
+    Target_value_layout const                *m_layout;
+    mi::neuraylib::Target_value_layout_state m_state;
+    mi::neuraylib::IValue::Kind              m_kind;
+    mi::Size                                 m_offset;
+};
+
+/// Walks the precompiled writer plan of a layout.
+class Writer_op_cursor
+{
+public:
+    Writer_op_cursor(Target_value_layout::Writer_op const *ops, mi::Size pos)
+    : m_ops(ops)
+    , m_pos(pos)
+    {
+    }
+
+    mi::neuraylib::IValue::Kind get_kind() const { return m_ops[m_pos].m_kind; }
+
+    mi::Size get_offset() const { return m_ops[m_pos].m_offset; }
+
+    mi::Size get_num_elements() const { return m_ops[m_pos].m_num_elements; }
+
+    // the operations of the sub-elements directly follow in pre-order
+    Writer_op_cursor get_first_element() const { return Writer_op_cursor(m_ops, m_pos + 1); }
+
+    Writer_op_cursor get_next_element(Writer_op_cursor const &prev, mi::Size) const
+    {
+        return Writer_op_cursor(m_ops, prev.m_pos + m_ops[prev.m_pos].m_num_ops);
+    }
+
+private:
+    Target_value_layout::Writer_op const *m_ops;
+    mi::Size                             m_pos;
+};
+
+/// Writes the given value into the block at the element of the layout the cursor points to.
+///
+/// This is the common implementation of all Target_value_layout::set_value() and
+/// Target_value_layout::write_argument() variants and returns the same error codes.
+template <typename T, typename Cursor>
+mi::Sint32 write_value(
+    Cursor const                  &cursor,
+    char                          *block,
+    typename T::IValue const      *value,
+    typename T::Resource_callback *resource_callback,
+    bool                          strings_mapped_to_ids)
+{
+    mi::neuraylib::IValue::Kind kind = cursor.get_kind();
+
+    // MDL::IValue::Kind is identical to mi::neuraylib::IValue::Kind so just cast to compare.
+    if (mi::neuraylib::IValue::Kind(value->get_kind()) != kind)
+        return -3;
+
+    char *dst = block + cursor.get_offset();
+    switch (kind) {
+        case mi::neuraylib::IValue::VK_BOOL:
+            *reinterpret_cast<bool *>(dst) =
+                static_cast<typename T::IValue_bool const *>(value)->get_value();
+            return 0;
+
+        case mi::neuraylib::IValue::VK_INT:
+            *reinterpret_cast<mi::Sint32 *>(dst) =
+                static_cast<typename T::IValue_int const *>(value)->get_value();
+            return 0;
+
+        case mi::neuraylib::IValue::VK_ENUM:
+            *reinterpret_cast<mi::Sint32 *>(dst) =
+                static_cast<typename T::IValue_enum const *>(value)->get_value();
+            return 0;
+
+        case mi::neuraylib::IValue::VK_FLOAT:
+            *reinterpret_cast<mi::Float32 *>(dst) =
+                static_cast<typename T::IValue_float const *>(value)->get_value();
+            return 0;
+
+        case mi::neuraylib::IValue::VK_DOUBLE:
+            *reinterpret_cast<mi::Float64 *>(dst) =
+                static_cast<typename T::IValue_double const *>(value)->get_value();
+            return 0;
+
+        case mi::neuraylib::IValue::VK_STRING:
+            if (strings_mapped_to_ids) {
+                *reinterpret_cast<mi::Uint32 *>(dst) = resource_callback->get_string_index(
+                    static_cast<typename T::IValue_string const *>(value));
+            } else {
+                // unmapped string are not supported
+                *reinterpret_cast<char **>(dst) = nullptr;
+            }
+            return 0;
+
+        case mi::neuraylib::IValue::VK_VECTOR:
+        case mi::neuraylib::IValue::VK_MATRIX:
+        case mi::neuraylib::IValue::VK_ARRAY:
+        case mi::neuraylib::IValue::VK_COLOR:
+        case mi::neuraylib::IValue::VK_STRUCT:
+        {
+            typename T::IValue_compound const *comp_val =
+                static_cast<typename T::IValue_compound const *>(value);
+            mi::Size num = cursor.get_num_elements();
+            if (comp_val->get_size() != num)
+                return -4;
+            if (num == 0)
+                return 0;
+
+            // Set all nested values
+            Cursor sub_cursor = cursor.get_first_element();
+            for (mi::Size i = 0; i < num; ++i) {
+                if (i > 0)
+                    sub_cursor = cursor.get_next_element(sub_cursor, i);
+                mi::base::Handle<typename T::IValue const> sub_val(comp_val->get_value(i));
+                mi::Sint32 err = write_value<T>(
+                    sub_cursor, block, sub_val.get(), resource_callback, strings_mapped_to_ids);
+                if (err != 0)
+                    return err;
+            }
+            return 0;
+        }
+
+        case mi::neuraylib::IValue::VK_TEXTURE:
+        case mi::neuraylib::IValue::VK_LIGHT_PROFILE:
+        case mi::neuraylib::IValue::VK_BSDF_MEASUREMENT:
+            *reinterpret_cast<mi::Uint32 *>(dst) = resource_callback->get_resource_index(
+                static_cast<typename T::IValue_resource const *>(value));
+            return 0;
+
+        case mi::neuraylib::IValue::VK_INVALID_DF:
+        case mi::neuraylib::IValue::VK_FORCE_32_BIT:
+        {
+            ASSERT(M_BACKENDS, !"unexpected value type");
+            return -5;
+        }
+    }
+    ASSERT(M_BACKENDS, !"unsupported value type");
+    return -5;
+}
+
+} // anonymous
+
 // Constructor.
 Target_value_layout::Target_value_layout(
     mi::mdl::IGenerated_code_value_layout const *layout,
@@ -1745,6 +1944,86 @@ Target_value_layout::Target_value_layout(
 : m_layout(layout, mi::base::DUP_INTERFACE)
 , m_strings_mapped_to_ids(string_ids)
 {
+    if (!m_layout)
+        return;
+
+    // Flatten the layout once, so writing argument values does not need to query the
+    // layout for every element again.
+    mi::Size num_args = get_num_elements();
+    m_arg_ops.reserve(num_args);
+    for (mi::Size i = 0; i < num_args; ++i) {
+        m_arg_ops.push_back(m_writer_ops.size());
+        compile_writer_ops(get_nested_state(i));
+    }
+}
+
+// Appends the writer operations for the element at the given layout state and all its
+// sub-elements in pre-order to the writer plan.
+void Target_value_layout::compile_writer_ops(mi::neuraylib::Target_value_layout_state state)
+{
+    Writer_op op;
+    mi::Size arg_size = 0;
+    op.m_offset = get_layout(op.m_kind, arg_size, state);
+    op.m_num_elements = 0;
+    op.m_num_ops = 1;
+
+    switch (op.m_kind) {
+        case mi::neuraylib::IValue::VK_VECTOR:
+        case mi::neuraylib::IValue::VK_MATRIX:
+        case mi::neuraylib::IValue::VK_ARRAY:
+        case mi::neuraylib::IValue::VK_COLOR:
+        case mi::neuraylib::IValue::VK_STRUCT:
+            op.m_num_elements = get_num_elements(state);
+            break;
+        default:
+            break;
+    }
+    mi::Size pos = m_writer_ops.size();
+    m_writer_ops.push_back(op);
+
+    for (mi::Size i = 0; i < op.m_num_elements; ++i)
+        compile_writer_ops(get_nested_state(i, state));
+    m_writer_ops[pos].m_num_ops = m_writer_ops.size() - pos;
+}
+
+// Set the value of the i'th argument inside the given block.
+mi::Sint32 Target_value_layout::write_argument(
+    char                                     *block,
+    mi::Size                                 i,
+    mi::neuraylib::IValue const              *value,
+    mi::neuraylib::ITarget_resource_callback *resource_callback) const
+{
+    if (!block || !value || !resource_callback)
+        return -1;
+    if (i >= m_arg_ops.size())
+        return -2;
+
+    return write_value<Api_value_types>(
+        Writer_op_cursor(m_writer_ops.data(), m_arg_ops[i]),
+        block,
+        value,
+        resource_callback,
+        m_strings_mapped_to_ids);
+}
+
+// Set the value of the i'th argument inside the given block.
+mi::Sint32 Target_value_layout::write_argument(
+    char                               *block,
+    mi::Size                           i,
+    MDL::IValue const                  *value,
+    ITarget_resource_callback_internal *resource_callback) const
+{
+    if (!block || !value || !resource_callback)
+        return -1;
+    if (i >= m_arg_ops.size())
+        return -2;
+
+    return write_value<Int_value_types>(
+        Writer_op_cursor(m_writer_ops.data(), m_arg_ops[i]),
+        block,
+        value,
+        resource_callback,
+        m_strings_mapped_to_ids);
 }
 
 // Get the size of the target argument block.
@@ -1842,101 +2121,12 @@ mi::Sint32 Target_value_layout::set_value(
     if (!block || !value || !resource_callback)
         return -1;
 
-    mi::neuraylib::IValue::Kind kind;
-    mi::Size arg_size;
-    mi::Size offs = get_layout(kind, arg_size, state);
-    if (value->get_kind() != kind)
-        return -3;
-
-    switch (kind) {
-        case mi::neuraylib::IValue::VK_BOOL:
-            *reinterpret_cast<bool *>(block + offs) =
-                static_cast<mi::neuraylib::IValue_bool const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_INT:
-            *reinterpret_cast<mi::Sint32 *>(block + offs) =
-                static_cast<mi::neuraylib::IValue_int const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_ENUM:
-            *reinterpret_cast<mi::Sint32 *>(block + offs) =
-                static_cast<mi::neuraylib::IValue_enum const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_FLOAT:
-            *reinterpret_cast<mi::Float32 *>(block + offs) =
-                static_cast<mi::neuraylib::IValue_float const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_DOUBLE:
-            *reinterpret_cast<mi::Float64 *>(block + offs) =
-                static_cast<mi::neuraylib::IValue_double const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_STRING:
-        {
-            if (m_strings_mapped_to_ids)
-            {
-                mi::Uint32 id =
-                    resource_callback ?
-                    resource_callback->get_string_index(
-                        static_cast<mi::neuraylib::IValue_string const *>(value)) :
-                    0u;
-                *reinterpret_cast<mi::Uint32 *>(block + offs) = id;
-            }
-            else
-            {
-                // unmapped string are not supported
-                *reinterpret_cast<char **>(block + offs) = nullptr;
-            }
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_VECTOR:
-        case mi::neuraylib::IValue::VK_MATRIX:
-        case mi::neuraylib::IValue::VK_ARRAY:
-        case mi::neuraylib::IValue::VK_COLOR:
-        case mi::neuraylib::IValue::VK_STRUCT:
-        {
-            mi::neuraylib::IValue_compound const *comp_val =
-                static_cast<mi::neuraylib::IValue_compound const *>(value);
-            mi::Size num = get_num_elements(state);
-            if (comp_val->get_size() != num) return -4;
-
-            // Set all nested values
-            for (mi::Size i = 0; i < num; ++i) {
-                mi::base::Handle<const mi::neuraylib::IValue> sub_val(comp_val->get_value(i));
-                mi::Sint32 err = set_value(
-                    block,
-                    sub_val.get(),
-                    resource_callback,
-                    get_nested_state(i, state));
-                if (err != 0)
-                    return err;
-            }
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_TEXTURE:
-        case mi::neuraylib::IValue::VK_LIGHT_PROFILE:
-        case mi::neuraylib::IValue::VK_BSDF_MEASUREMENT:
-        {
-            mi::Uint32 index = resource_callback->get_resource_index(
-                static_cast<mi::neuraylib::IValue_resource const *>(value));
-            *reinterpret_cast<mi::Uint32 *>(block + offs) = index;
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_INVALID_DF:
-        case mi::neuraylib::IValue::VK_FORCE_32_BIT:
-        {
-            ASSERT(M_BACKENDS, !"unexpected value type");
-            return -5;
-        }
-    }
-    ASSERT(M_BACKENDS, !"unsupported value type");
-    return -5;
+    return write_value<Api_value_types>(
+        Layout_state_cursor(*this, state),
+        block,
+        value,
+        resource_callback,
+        m_strings_mapped_to_ids);
 }
 
 // Set the value inside the given block at the given layout state.
@@ -1949,101 +2139,12 @@ mi::Sint32 Target_value_layout::set_value(
     if (!block || !value || !resource_callback)
         return -1;
 
-    mi::neuraylib::IValue::Kind kind;
-    mi::Size arg_size;
-    mi::Size offs = get_layout(kind, arg_size, state);
-
-    // MDL::IValue::Kind is identical to mi::neuraylib::IValue::Kind so just cast to compare.
-    if (mi::neuraylib::IValue::Kind(value->get_kind()) != kind)
-        return -3;
-
-    switch (kind) {
-        case mi::neuraylib::IValue::VK_BOOL:
-            *reinterpret_cast<bool *>(block + offs) =
-                static_cast<MDL::IValue_bool const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_INT:
-            *reinterpret_cast<mi::Sint32 *>(block + offs) =
-                static_cast<MDL::IValue_int const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_ENUM:
-            *reinterpret_cast<mi::Sint32 *>(block + offs) =
-                static_cast<MDL::IValue_enum const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_FLOAT:
-            *reinterpret_cast<mi::Float32 *>(block + offs) =
-                static_cast<MDL::IValue_float const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_DOUBLE:
-            *reinterpret_cast<mi::Float64 *>(block + offs) =
-                static_cast<MDL::IValue_double const *>(value)->get_value();
-            return 0;
-
-        case mi::neuraylib::IValue::VK_STRING:
-        {
-            if (m_strings_mapped_to_ids) {
-                mi::Uint32 id =
-                    resource_callback ?
-                    resource_callback->get_string_index(
-                        static_cast<MDL::IValue_string const *>(value)) :
-                    0u;
-                *reinterpret_cast<mi::Uint32 *>(block + offs) = id;
-            } else {
-                // unmapped string are not supported
-                *reinterpret_cast<char **>(block + offs) = nullptr;
-            }
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_VECTOR:
-        case mi::neuraylib::IValue::VK_MATRIX:
-        case mi::neuraylib::IValue::VK_ARRAY:
-        case mi::neuraylib::IValue::VK_COLOR:
-        case mi::neuraylib::IValue::VK_STRUCT:
-        {
-            MDL::IValue_compound const *comp_val =
-                static_cast<MDL::IValue_compound const *>(value);
-            mi::Size num = get_num_elements(state);
-            if (comp_val->get_size() != num)
-                return -4;
-
-            // Set all nested values
-            for (mi::Size i = 0; i < num; ++i) {
-                mi::base::Handle<MDL::IValue const> sub_val(comp_val->get_value(i));
-                mi::Sint32 err = set_value(
-                    block,
-                    sub_val.get(),
-                    resource_callback,
-                    get_nested_state(i, state));
-                if (err != 0)
-                    return err;
-            }
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_TEXTURE:
-        case mi::neuraylib::IValue::VK_LIGHT_PROFILE:
-        case mi::neuraylib::IValue::VK_BSDF_MEASUREMENT:
-        {
-            mi::Uint32 index = resource_callback->get_resource_index(
-                static_cast<MDL::IValue_resource const *>(value));
-            *reinterpret_cast<mi::Uint32 *>(block + offs) = index;
-            return 0;
-        }
-
-        case mi::neuraylib::IValue::VK_INVALID_DF:
-        case mi::neuraylib::IValue::VK_FORCE_32_BIT:
-        {
-            ASSERT(M_BACKENDS, !"unexpected value type");
-            return -5;
-        }
-    }
-    ASSERT(M_BACKENDS, !"unsupported value type");
-    return -5;
+    return write_value<Int_value_types>(
+        Layout_state_cursor(*this, state),
+        block,
+        value,
+        resource_callback,
+        m_strings_mapped_to_ids);
 }
 
 // ------------------------- LLVM based link unit -------------------------
@@ -3083,7 +3184,8 @@ Mdl_llvm_backend::Mdl_llvm_backend(
     m_output_target_lang(true),
     m_strings_mapped_to_ids(string_ids),
     m_calc_derivatives(false),
-    m_use_builtin_resource_handler(true)
+    m_use_builtin_resource_handler(true),
+    m_use_alias_sampling(false)
 {
     mi::mdl::Options &options = m_jit->access_options();
 
@@ -3665,6 +3767,17 @@ mi::Sint32 Mdl_llvm_backend::set_option(
             jit_options.set_option(MDL_JIT_OPTION_SL_USE_RESOURCE_DATA, value);
             return 0;
         }
+        if (strcmp(name, "glsl_merge_functions") == 0) {
+            if (strcmp(value, "on") == 0) {
+                value = "true";
+            } else if (strcmp(value, "off") == 0) {
+                value = "false";
+            } else {
+                return -2;
+            }
+            jit_options.set_option(MDL_JIT_OPTION_SL_MERGE_FUNCTIONS, value);
+            return 0;
+        }
         break;
 
     case mi::neuraylib::IMdl_backend_api::MB_NATIVE:
@@ -3683,6 +3796,18 @@ mi::Sint32 Mdl_llvm_backend::set_option(
             jit_options.set_option(MDL_JIT_USE_BUILTIN_RESOURCE_HANDLER_CPU, value);
             return 0;
         }
+        if (strcmp(name, "use_alias_sampling") == 0) {
+            if (strcmp(value, "on") == 0) {
+                m_use_alias_sampling = true;
+            }
+            else if (strcmp(value, "off") == 0) {
+                m_use_alias_sampling = false;
+            }
+            else {
+                return -2;
+            }
+            return 0;
+        }
         break;
 
     case mi::neuraylib::IMdl_backend_api::MB_HLSL:
@@ -3697,6 +3822,17 @@ mi::Sint32 Mdl_llvm_backend::set_option(
             jit_options.set_option(MDL_JIT_OPTION_SL_USE_RESOURCE_DATA, value);
             return 0;
         }
+        if (strcmp(name, "hlsl_merge_functions") == 0) {
+            if (strcmp(value, "on") == 0) {
+                value = "true";
+            } else if (strcmp(value, "off") == 0) {
+                value = "false";
+            } else {
+                return -2;
+            }
+            jit_options.set_option(MDL_JIT_OPTION_SL_MERGE_FUNCTIONS, value);
+            return 0;
+        }
         if (strcmp(name, "hlsl_remap_functions") == 0) {
             jit_options.set_option(MDL_JIT_OPTION_REMAP_FUNCTIONS, value);
             return 0;
@@ -3877,6 +4013,7 @@ mi::neuraylib::ITarget_code const *Mdl_llvm_backend::translate_environment(
         m_strings_mapped_to_ids,
         m_calc_derivatives,
         m_use_builtin_resource_handler,
+        m_use_alias_sampling,
         m_kind);
 
     // Enter the resource-table here
@@ -4024,6 +4161,7 @@ mi::neuraylib::ITarget_code const *Mdl_llvm_backend::translate_material_expressi
         m_strings_mapped_to_ids,
         m_calc_derivatives,
         m_use_builtin_resource_handler,
+        m_use_alias_sampling,
         m_kind);
 
     // Enter the resource-table here
@@ -4186,6 +4324,7 @@ const mi::neuraylib::ITarget_code* Mdl_llvm_backend::translate_material_df(
         m_strings_mapped_to_ids,
         m_calc_derivatives,
         m_use_builtin_resource_handler,
+        m_use_alias_sampling,
         m_kind);
 
     // Enter the resource-table here
@@ -4260,8 +4399,11 @@ mi::neuraylib::ITarget_code const *Mdl_llvm_backend::translate_link_unit(
 
     update_jit_context_options(*cg_ctx.get(), lu->get_internal_space(), context);
 
+    // module lookups during compilation only read from the database
+    DB::Snapshot_transaction snapshot(lu->get_transaction());
+
     SYSTEM::Access_module<MDLC::Mdlc_module> mdlc_module(/*deferred=*/false);
-    MDL::Module_cache module_cache(lu->get_transaction(), mdlc_module->get_module_wait_queue(), {});
+    MDL::Module_cache module_cache(&snapshot, mdlc_module->get_module_wait_queue(), {});
 
 #ifdef ADD_EXTRA_TIMERS
     std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
@@ -4292,7 +4434,7 @@ mi::neuraylib::ITarget_code const *Mdl_llvm_backend::translate_link_unit(
 #endif
 
     mi::base::Handle<Target_code> tc(lu->get_target_code());
-    tc->finalize(code.get(), lu->get_transaction(), m_calc_derivatives);
+    tc->finalize(code.get(), lu->get_transaction(), m_calc_derivatives, m_use_alias_sampling);
 
 #ifdef ADD_EXTRA_TIMERS
     std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
@@ -222,6 +222,9 @@ private:
 
     /// If true, use the builtin resource handler when running native code
     bool m_use_builtin_resource_handler;
+
+    /// If true, the builtin resource handler samples with alias tables instead of CDFs.
+    bool m_use_alias_sampling;
 };
 
 /// Implementation of #mi::neuraylib::ITarget_argument_block.
@@ -395,6 +398,43 @@ public:
         mi::neuraylib::Target_value_layout_state state =
             mi::neuraylib::Target_value_layout_state()) const;
 
+    /// Set the value of the i'th argument inside the given block.
+    ///
+    /// Equivalent to #set_value() with the layout state returned by #get_nested_state(i), but
+    /// uses the precompiled writer plan instead of querying the layout for every element.
+    ///
+    /// \param[inout] block           The argument value block buffer to be modified.
+    /// \param[in] i                  The index of the argument.
+    /// \param[in] value              The value to be set. It has to match the expected kind.
+    /// \param[in] resource_callback  Callback for retrieving resource indices for resource values.
+    ///
+    /// \return the same error codes as #set_value(), -2 if \p i is out of range.
+    mi::Sint32 write_argument(
+        char *block,
+        mi::Size i,
+        mi::neuraylib::IValue const *value,
+        mi::neuraylib::ITarget_resource_callback *resource_callback) const;
+
+    /// Set the value of the i'th argument inside the given block.
+    ///
+    /// Equivalent to #set_value() with the layout state returned by #get_nested_state(i), but
+    /// uses the precompiled writer plan instead of querying the layout for every element.
+    ///
+    /// \param[inout] block           The argument value block buffer to be modified.
+    /// \param[in] i                  The index of the argument.
+    /// \param[in] value              The value to be set. It has to match the expected kind.
+    /// \param[in] resource_callback  Callback for retrieving resource indices for resource values.
+    ///
+    /// \return the same error codes as #set_value(), -2 if \p i is out of range.
+    mi::Sint32 write_argument(
+        char *block,
+        mi::Size i,
+        MDL::IValue const *value,
+        ITarget_resource_callback_internal *resource_callback) const;
+
+    /// Get the number of top-level arguments covered by the writer plan.
+    mi::Size get_argument_count() const { return m_arg_ops.size(); }
+
     /// Get the internal IGenerated_code_value_layout
     mi::mdl::IGenerated_code_value_layout const* get_internal_layout() const
     {
@@ -405,12 +445,39 @@ public:
     /// If true, string argument values are mapped to string identifiers.
     bool strings_mapped_to_ids() const { return m_strings_mapped_to_ids; }
 
+    /// An operation of the writer plan, i.e. one (nested) element of the layout.
+    struct Writer_op
+    {
+        /// The kind of the element.
+        mi::neuraylib::IValue::Kind m_kind;
+
+        /// The offset of the element inside the argument block.
+        mi::Size m_offset;
+
+        /// The number of direct sub-elements for compound elements, 0 otherwise.
+        mi::Size m_num_elements;
+
+        /// The number of writer operations of the element including all its sub-elements.
+        mi::Size m_num_ops;
+    };
+
+private:
+    /// Appends the writer operations for the element at the given layout state and all its
+    /// sub-elements in pre-order to the writer plan.
+    void compile_writer_ops(mi::neuraylib::Target_value_layout_state state);
+
 private:
     /// The MDL argument block.
     mi::base::Handle<mi::mdl::IGenerated_code_value_layout const> m_layout;
 
     /// If true, string argument values are mapped to string identifiers.
     bool m_strings_mapped_to_ids;
+
+    /// The writer plan: the flattened layout tree in pre-order.
+    std::vector<Writer_op> m_writer_ops;
+
+    /// The index of the first writer operation for each top-level argument.
+    std::vector<mi::Size> m_arg_ops;
 };
 
 /// Helper class to store bsdf data textures into the neuray database.
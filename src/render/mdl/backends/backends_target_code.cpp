@@ -140,13 +140,14 @@ Target_code::Target_code(
     bool string_ids,
     bool use_derivatives,
     bool use_builtin_resource_handler,
+    bool use_alias_sampling,
     mi::neuraylib::IMdl_backend_api::Mdl_backend_kind be_kind)
   : Target_code()
 {
     m_backend_kind = be_kind;
     m_string_args_mapped_to_ids = string_ids;
     m_use_builtin_resource_handler = use_builtin_resource_handler;
-    finalize(code, transaction, use_derivatives);
+    finalize(code, transaction, use_derivatives, use_alias_sampling);
 
     size_t num_layouts = code->get_captured_argument_layouts_count();
     m_cap_arg_blocks.resize(num_layouts); // already prepare the empty argument block slots
@@ -185,7 +186,8 @@ Target_code::~Target_code()
 void Target_code::finalize(
     mi::mdl::IGenerated_code_executable* code,
     DB::Transaction* transaction,
-    bool use_derivatives)
+    bool use_derivatives,
+    bool use_alias_sampling)
 {
     m_native_code = mi::base::make_handle(
         code->get_interface<mi::mdl::IGenerated_code_lambda_function>());
@@ -193,7 +195,7 @@ void Target_code::finalize(
 
     if (m_native_code.is_valid_interface()) {
         if(m_use_builtin_resource_handler)
-            m_rh = new MDLRT::Resource_handler(use_derivatives);
+            m_rh = new MDLRT::Resource_handler(use_derivatives, use_alias_sampling);
 
         m_native_code->init(transaction, NULL, m_rh);
     } else {
@@ -1006,26 +1008,92 @@ mi::neuraylib::ITarget_argument_block *Target_code::create_argument_block(
     if ( material == NULL || resource_callback == NULL || index >= m_cap_arg_layouts.size())
         return NULL;
 
-    mi::neuraylib::ITarget_value_layout const *layout = m_cap_arg_layouts[index].get();
+    Target_value_layout const *layout = m_cap_arg_layouts[index].get();
     mi::Size num_args = material->get_parameter_count();
-    if ( num_args != layout->get_num_elements())
+    if ( num_args != layout->get_argument_count())
         return NULL;
 
     Target_argument_block *arg_block = new Target_argument_block( layout->get_size());
 
     for ( mi::Size i = 0; i < num_args; ++i) {
-        mi::neuraylib::Target_value_layout_state state = layout->get_nested_state( i);
         mi::base::Handle<const mi::neuraylib::IValue> arg_val( material->get_argument( i));
-        layout->set_value(
-            arg_block->get_data(),
-            arg_val.get(),
-            resource_callback,
-            state);
+        if ( layout->write_argument(
+                arg_block->get_data(), i, arg_val.get(), resource_callback) != 0) {
+            arg_block->release();
+            return NULL;
+        }
     }
 
     return arg_block;
 }
 
+// Writes the target argument blocks of several class-compiled materials into a contiguous
+// buffer provided by the caller.
+Sint32 Target_code::write_argument_blocks(
+    Size index,
+    const mi::neuraylib::ICompiled_material* const* materials,
+    Size count,
+    mi::neuraylib::ITarget_resource_callback* resource_callback,
+    char* buffer,
+    Size stride) const
+{
+    if ( !materials || !resource_callback || !buffer || index >= m_cap_arg_layouts.size())
+        return -1;
+
+    Target_value_layout const *layout = m_cap_arg_layouts[index].get();
+    mi::Size block_size = layout->get_size();
+    if ( stride < block_size)
+        return -2;
+
+    mi::Size num_args = layout->get_argument_count();
+    for ( mi::Size m = 0; m < count; ++m) {
+        const mi::neuraylib::ICompiled_material* material = materials[m];
+        if ( !material)
+            return -1;
+        if ( material->get_parameter_count() != num_args)
+            return -3;
+
+        char* block = buffer + m * stride;
+        memset( block, 0, block_size);
+        for ( mi::Size i = 0; i < num_args; ++i) {
+            mi::base::Handle<const mi::neuraylib::IValue> arg_val( material->get_argument( i));
+            if ( layout->write_argument( block, i, arg_val.get(), resource_callback) != 0)
+                return -4;
+        }
+    }
+    return 0;
+}
+
+// Rewrites selected parameters in an existing target argument block.
+Sint32 Target_code::update_argument_block(
+    Size index,
+    const mi::neuraylib::ICompiled_material* material,
+    const Size* parameter_indices,
+    Size parameter_count,
+    mi::neuraylib::ITarget_resource_callback* resource_callback,
+    char* block) const
+{
+    if ( !material || !resource_callback || !block || index >= m_cap_arg_layouts.size())
+        return -1;
+    if ( parameter_count > 0 && !parameter_indices)
+        return -1;
+
+    Target_value_layout const *layout = m_cap_arg_layouts[index].get();
+    mi::Size num_args = layout->get_argument_count();
+    if ( material->get_parameter_count() != num_args)
+        return -3;
+
+    for ( mi::Size p = 0; p < parameter_count; ++p) {
+        mi::Size i = parameter_indices[p];
+        if ( i >= num_args)
+            return -2;
+        mi::base::Handle<const mi::neuraylib::IValue> arg_val( material->get_argument( i));
+        if ( layout->write_argument( block, i, arg_val.get(), resource_callback) != 0)
+            return -4;
+    }
+    return 0;
+}
+
 // Initializes the target argument block for the class-compiled material which was used
 // to generate this target code and adds all resources from the arguments to the target code
 // resource lists.
@@ -1060,13 +1128,11 @@ void Target_code::init_argument_block(
     Target_resource_callback_internal resource_callback(transaction, this);
 
     for (mi::Size i = 0; i < num_args; ++i) {
-        mi::neuraylib::Target_value_layout_state state = layout->get_nested_state( i);
         mi::base::Handle<const MDL::IValue> arg_val( args->get_value( i));
-        layout->set_value(
-            block->get_data(),
-            arg_val.get(),
-            &resource_callback,
-            state);
+        mi::Sint32 result =
+            layout->write_argument( block->get_data(), i, arg_val.get(), &resource_callback);
+        ASSERT(M_BACKENDS, result == 0 && "argument does not match the layout");
+        (void) result;
     }
 }
 
@@ -1379,8 +1445,16 @@ SERIAL::Serializable* Target_code::Texture_info::deserialize(
 
 bool Target_code::supports_serialization() const
 {
-    return m_backend_kind == mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_CUDA_PTX ||
-           m_backend_kind == mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_HLSL;
+    // Native code lives in the JIT of this process and is not serializable.
+    switch (m_backend_kind) {
+    case mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_CUDA_PTX:
+    case mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_LLVM_IR:
+    case mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_GLSL:
+    case mi::neuraylib::IMdl_backend_api::Mdl_backend_kind::MB_HLSL:
+        return true;
+    default:
+        return false;
+    }
 }
 
 const SERIAL::Serializable* Target_code::Segment::serialize(SERIAL::Serializer* serializer) const
@@ -1612,6 +1686,7 @@ bool Target_code::deserialize(
             case mi::neuraylib::IMdl_backend_api::MB_HLSL:
             case mi::neuraylib::IMdl_backend_api::MB_GLSL:
             case mi::neuraylib::IMdl_backend_api::MB_CUDA_PTX:
+            case mi::neuraylib::IMdl_backend_api::MB_LLVM_IR:
             {
                 mi::base::Handle<mi::mdl::ICode_generator_jit> code_gen_jit(
                     code_gen->get_interface<mi::mdl::ICode_generator_jit>());
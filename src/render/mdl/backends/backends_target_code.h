@@ -147,6 +147,8 @@ public:
     /// \param use_derivatives  True if derivative support is enabled for the generated code
     /// \param use_builtin_resource_handler True, if the builtin texture runtime is supposed to be
     ///                         used when running x86 code.
+    /// \param use_alias_sampling True, if the builtin texture runtime samples light profiles and
+    ///                         BSDF measurements with alias tables instead of CDFs.
     /// \param be_kind     Kind of back-end that created this target code object.
     Target_code(
         mi::mdl::IGenerated_code_executable* code,
@@ -154,6 +156,7 @@ public:
         bool string_ids,
         bool use_derivatives,
         bool use_builtin_resource_handler,
+        bool use_alias_sampling,
         mi::neuraylib::IMdl_backend_api::Mdl_backend_kind be_kind);
 
     /// Constructor for link mode.
@@ -168,7 +171,8 @@ public:
     /// Finalization method for link mode for executable code.
     void finalize( mi::mdl::IGenerated_code_executable* code,
         DB::Transaction* transaction,
-        bool use_derivatives);
+        bool use_derivatives,
+        bool use_alias_sampling);
 
     // API methods
 
@@ -364,6 +368,43 @@ public:
     const mi::neuraylib::ITarget_value_layout *get_argument_block_layout(
         Size index) const override;
 
+    /// Writes the target argument blocks of several class-compiled materials into a contiguous
+    /// buffer provided by the caller.
+    ///
+    /// \param index              The index of the base target argument block of this target code.
+    /// \param materials          The class-compiled MDL materials.
+    /// \param count              The number of materials.
+    /// \param resource_callback  Callback for retrieving resource indices for resource values.
+    /// \param buffer             The buffer receiving the target argument blocks.
+    /// \param stride             The distance in bytes between two consecutive blocks in \p buffer.
+    ///
+    /// \returns 0 on success or a negative error code.
+    Sint32 write_argument_blocks(
+        Size index,
+        const mi::neuraylib::ICompiled_material* const* materials,
+        Size count,
+        mi::neuraylib::ITarget_resource_callback* resource_callback,
+        char* buffer,
+        Size stride) const override;
+
+    /// Rewrites selected parameters in an existing target argument block.
+    ///
+    /// \param index              The index of the base target argument block of this target code.
+    /// \param material           The class-compiled MDL material.
+    /// \param parameter_indices  The indices of the parameters to rewrite.
+    /// \param parameter_count    The number of parameter indices.
+    /// \param resource_callback  Callback for retrieving resource indices for resource values.
+    /// \param block              The target argument block data to update.
+    ///
+    /// \returns 0 on success or a negative error code.
+    Sint32 update_argument_block(
+        Size index,
+        const mi::neuraylib::ICompiled_material* material,
+        const Size* parameter_indices,
+        Size parameter_count,
+        mi::neuraylib::ITarget_resource_callback* resource_callback,
+        char* block) const override;
+
     /// Returns the number of light profile resources used by the target code.
     Size get_light_profile_count() const override;
 
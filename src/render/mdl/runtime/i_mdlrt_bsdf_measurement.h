@@ -45,6 +45,8 @@ namespace DB { class Transaction; }
 
 namespace MDLRT {
 
+struct Alias_entry;
+
 class Bsdf_measurement
 {
 public:
@@ -52,7 +54,8 @@ public:
     typedef mi::mdl::stdlib::Mbsdf_part Mbsdf_part;
 
     Bsdf_measurement();
-    Bsdf_measurement(Tag_type const &tag, DB::Transaction *trans);
+    /// \param use_alias_sampling  sample with alias tables instead of the CDFs
+    Bsdf_measurement(Tag_type const &tag, DB::Transaction *trans, bool use_alias_sampling = false);
     virtual ~Bsdf_measurement();
 
     bool is_valid() const { return m_bsdf_measurement->is_valid(); }
@@ -75,7 +78,10 @@ public:
 
 protected:
 
-    void prepare_mbsdfs_part(Mbsdf_part part, const mi::neuraylib::IBsdf_isotropic_data*);
+    void prepare_mbsdfs_part(
+        Mbsdf_part part,
+        const mi::neuraylib::IBsdf_isotropic_data*,
+        bool use_alias_sampling);
     mi::Float32_2 albedo(const mi::Float32_2& theta_phi, Mbsdf_part part) const;
 
     DB::Access<BSDFM::Bsdf_measurement>      m_bsdf_measurement;      // the underlying bsdf meas.
@@ -85,6 +91,7 @@ protected:
     float*          m_eval_data[2];               // uses filter mode cudaFilterModeLinear
     float           m_max_albedo[2];              // max albedo used to limit the multiplier
     float*          m_sample_data[2];             // CDFs for sampling a BSDF measurement
+    Alias_entry*    m_alias_data[2];              // optional alias tables, same layout as CDFs
     float*          m_albedo_data[2];             // max albedo for each theta (isotropic)
 
     mi::Uint32_2    m_angular_resolution[2];      // size of the dataset, needed for texel access
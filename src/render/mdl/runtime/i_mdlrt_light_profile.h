@@ -44,6 +44,8 @@ namespace DB { class Transaction; }
 
 namespace MDLRT {
 
+struct Alias_entry;
+
 class Light_profile
 {
 public:
@@ -51,7 +53,8 @@ public:
 
     Light_profile() = default;
 
-    Light_profile(Tag_type const &tag, DB::Transaction *trans);
+    /// \param use_alias_sampling  sample with alias tables instead of the CDFs
+    Light_profile(Tag_type const &tag, DB::Transaction *trans, bool use_alias_sampling = false);
     virtual ~Light_profile();
 
     float get_power() const { return m_light_profile->get_power(); }
@@ -77,6 +80,7 @@ protected:
     float   m_total_power;                  // power of the light source to be able to rescale
 
     float*  m_cdf_data;                     // CDFs for sampling a light profile
+    Alias_entry* m_alias_data = nullptr;    // optional alias tables, same layout as the CDFs
 };
 
 }  // MDLRT
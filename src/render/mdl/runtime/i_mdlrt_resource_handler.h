@@ -47,9 +47,12 @@ class Resource_handler : public mi::mdl::IResource_handler {
 public:
     /// Constructor.
     ///
-    /// \param use_derivatives  true if derivative texturing functions will be used
-    Resource_handler(bool use_derivatives=false)
+    /// \param use_derivatives     true if derivative texturing functions will be used
+    /// \param use_alias_sampling  true if light profiles and BSDF measurements should be sampled
+    ///                            with alias tables instead of CDFs
+    Resource_handler(bool use_derivatives=false, bool use_alias_sampling=false)
         : m_use_derivatives(use_derivatives)
+        , m_use_alias_sampling(use_alias_sampling)
     {
     }
 
@@ -611,6 +614,9 @@ public:
 private:
     /// Specifies, whether derivative texture functions will be used.
     bool m_use_derivatives;
+
+    /// Specifies, whether alias tables will be used for sampling.
+    bool m_use_alias_sampling;
 };
 
 }  // MDLRT
@@ -33,6 +33,7 @@
 
 #include <base/data/db/i_db_access.h>
 #include "i_mdlrt_bsdf_measurement.h"
+#include "mdlrt_sampling.h"
 #include <mi/neuraylib/ibsdf_isotropic_data.h>
 
 #ifndef M_PI
@@ -51,6 +52,7 @@ Bsdf_measurement::Bsdf_measurement()
         m_has_data[i] = 0u;
         m_eval_data[i] = nullptr;
         m_sample_data[i] = nullptr;
+        m_alias_data[i] = nullptr;
         m_albedo_data[i] = nullptr;
         m_max_albedo[i] = 0.0f;
         m_angular_resolution[i] = mi::Uint32_2{0u, 0u};
@@ -59,7 +61,10 @@ Bsdf_measurement::Bsdf_measurement()
     }
 }
 
-Bsdf_measurement::Bsdf_measurement(Tag_type const  &bm_t, DB::Transaction *trans)
+Bsdf_measurement::Bsdf_measurement(
+    Tag_type const  &bm_t,
+    DB::Transaction *trans,
+    bool            use_alias_sampling)
     : Bsdf_measurement()
 {
     m_bsdf_measurement = DB::Access<BSDFM::Bsdf_measurement>(bm_t, trans);
@@ -70,13 +75,15 @@ Bsdf_measurement::Bsdf_measurement(Tag_type const  &bm_t, DB::Transaction *trans
     mi::base::Handle<const mi::neuraylib::IBsdf_isotropic_data> dataset(
         m_bsdf_measurement_impl->get_reflection<const mi::neuraylib::IBsdf_isotropic_data>());
     if(dataset)
-        prepare_mbsdfs_part(mi::mdl::stdlib::mbsdf_data_reflection, dataset.get());
+        prepare_mbsdfs_part(
+            mi::mdl::stdlib::mbsdf_data_reflection, dataset.get(), use_alias_sampling);
 
     // handle transmission
     dataset = mi::base::Handle<const mi::neuraylib::IBsdf_isotropic_data>(
         m_bsdf_measurement_impl->get_transmission<const mi::neuraylib::IBsdf_isotropic_data>());
     if (dataset)
-        prepare_mbsdfs_part(mi::mdl::stdlib::mbsdf_data_reflection, dataset.get());
+        prepare_mbsdfs_part(
+            mi::mdl::stdlib::mbsdf_data_reflection, dataset.get(), use_alias_sampling);
 }
 
 Bsdf_measurement::~Bsdf_measurement()
@@ -87,13 +94,15 @@ Bsdf_measurement::~Bsdf_measurement()
         {
             delete[] m_eval_data[i];
             delete[] m_sample_data[i];
+            delete[] m_alias_data[i];
             delete[] m_albedo_data[i];
         }
     }
 }
 
 void Bsdf_measurement::prepare_mbsdfs_part(Mbsdf_part part, 
-                                           const mi::neuraylib::IBsdf_isotropic_data* dataset)
+                                           const mi::neuraylib::IBsdf_isotropic_data* dataset,
+                                           bool use_alias_sampling)
 {
     unsigned part_idx = static_cast<unsigned>(part);
 
@@ -207,6 +216,21 @@ void Bsdf_measurement::prepare_mbsdfs_part(Mbsdf_part part,
     }
 
     m_sample_data[part_idx] = sample_data;
+
+    // optionally build alias tables from the CDFs, the pdf is still computed from the CDFs
+    if (use_alias_sampling)
+    {
+        Alias_entry* alias_data = new Alias_entry[sample_data_size];
+        for (unsigned int t_out = 0; t_out < res.x; ++t_out)
+            build_alias_table(
+                sample_data_theta + t_out * res.x, res.x, alias_data + t_out * res.x);
+        for (unsigned int i = 0; i < cdf_theta_size; ++i)
+            build_alias_table(
+                sample_data_phi + i * res.y,
+                res.y,
+                alias_data + cdf_theta_size + i * res.y);
+        m_alias_data[part_idx] = alias_data;
+    }
     m_albedo_data[part_idx] = albedo_data;
     m_max_albedo[part_idx] = max_albedo;
 
@@ -357,31 +381,6 @@ mi::Float32_3 Bsdf_measurement::evaluate(const mi::Float32_2& theta_phi_in,
 };
 
 
-// binary search through CDF
-namespace
-{
-    inline unsigned sample_cdf(
-        const float* cdf,
-        unsigned cdf_size,
-        float xi)
-    {
-        unsigned li = 0;
-        unsigned ri = cdf_size - 1;
-        unsigned m = (li + ri) / 2;
-        while (ri > li)
-        {
-            if (xi < cdf[m])
-                ri = m;
-            else
-                li = m + 1;
-
-            m = (li + ri) / 2;
-        }
-
-        return m;
-    }
-}
-
 mi::Float32_3 Bsdf_measurement::sample(const mi::Float32_2& theta_phi_out, 
                                        const mi::Float32_3& xi,
                                        Mbsdf_part part) const
@@ -406,16 +405,21 @@ mi::Float32_3 Bsdf_measurement::sample(const mi::Float32_2& theta_phi_out,
     //-------------------------------------------
     float xi0 = xi.x;
     const float* cdf_theta = sample_data + idx_theta_out * res.x;
-    unsigned idx_theta_in = sample_cdf(cdf_theta, res.x, xi0);       // binary search
+    const Alias_entry* alias_data = m_alias_data[part_index];
+    unsigned idx_theta_in = alias_data
+        ? sample_alias_table(alias_data + (cdf_theta - sample_data), res.x, xi0) // const. time
+        : sample_cdf(cdf_theta, res.x, xi0);                                    // binary search
 
     float prob_theta = cdf_theta[idx_theta_in];
     if (idx_theta_in > 0)
     {
         const float tmp = cdf_theta[idx_theta_in - 1];
         prob_theta -= tmp;
-        xi0 -= tmp;
+        if (!alias_data)
+            xi0 -= tmp;
     }
-    xi0 /= prob_theta; // rescale for re-usage
+    if (!alias_data)
+        xi0 /= prob_theta; // rescale for re-usage
 
     // sample phi
     //-------------------------------------------
@@ -430,15 +434,19 @@ mi::Float32_3 Bsdf_measurement::sample(const mi::Float32_2& theta_phi_out,
         xi1 = 1.0f - xi1;
     xi1 *= 2.0f;
 
-    unsigned idx_phi = sample_cdf(cdf_phi, res.y, xi1);           // binary search
+    unsigned idx_phi = alias_data
+        ? sample_alias_table(alias_data + (cdf_phi - sample_data), res.y, xi1) // const. time
+        : sample_cdf(cdf_phi, res.y, xi1);                                    // binary search
     float prob_phi = cdf_phi[idx_phi];
     if (idx_phi > 0)
     {
         const float tmp = cdf_phi[idx_phi - 1];
         prob_phi -= tmp;
-        xi1 -= tmp;
+        if (!alias_data)
+            xi1 -= tmp;
     }
-    xi1 /= prob_phi; // rescale for re-usage
+    if (!alias_data)
+        xi1 /= prob_phi; // rescale for re-usage
 
     // compute direction
     //-------------------------------------------
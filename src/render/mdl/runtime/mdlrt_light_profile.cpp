@@ -33,6 +33,7 @@
 
 #include <base/data/db/i_db_access.h>
 #include "i_mdlrt_light_profile.h"
+#include "mdlrt_sampling.h"
 
 #ifndef M_PI
     #define M_PI            3.14159265358979323846
@@ -44,7 +45,8 @@ namespace MDLRT {
 
 Light_profile::Light_profile(
     Tag_type const  &tex_t,
-    DB::Transaction *trans)
+    DB::Transaction *trans,
+    bool            use_alias_sampling)
 : m_light_profile(tex_t, trans)
 , m_light_profile_impl(m_light_profile->get_impl_tag(), trans)
 {
@@ -122,12 +124,26 @@ Light_profile::Light_profile(
         m_cdf_data[t] = sum_theta ? (m_cdf_data[t] / sum_theta) : m_cdf_data[t];
 
     m_cdf_data[m_res_t - 2] = 1.0f;
+
+    // optionally build alias tables from the CDFs, the pdf is still computed from the CDFs
+    if (use_alias_sampling)
+    {
+        m_alias_data = new Alias_entry[cdf_data_size];
+        build_alias_table(m_cdf_data, unsigned(m_res_t - 1), m_alias_data);
+        for (unsigned int t = 0; t < m_res_t - 1; ++t)
+        {
+            const size_t offset = (m_res_t - 1) + t * (m_res_p - 1);
+            build_alias_table(
+                m_cdf_data + offset, unsigned(m_res_p - 1), m_alias_data + offset);
+        }
+    }
 }
 
 Light_profile::~Light_profile()
 {
     if (m_cdf_data)
         delete[] m_cdf_data;
+    delete[] m_alias_data;
 }
 
 
@@ -178,28 +194,6 @@ mi::Float32 Light_profile::evaluate(const mi::Float32_2& theta_phi) const
     return value * m_candela_multiplier;
 }
 
-// binary search through CDF
-inline unsigned sample_cdf(
-    const float* cdf,
-    unsigned cdf_size,
-    float xi)
-{
-    unsigned li = 0;
-    unsigned ri = cdf_size - 1;
-    unsigned m = (li + ri) / 2;
-    while (ri > li)
-    {
-        if (xi < cdf[m])
-            ri = m;
-        else
-            li = m + 1;
-
-        m = (li + ri) / 2;
-    }
-
-    return m;
-}
-
 mi::Float32_3 Light_profile::sample(const mi::Float32_3& xi) const
 {
     mi::Float32_3 result;
@@ -211,16 +205,20 @@ mi::Float32_3 Light_profile::sample(const mi::Float32_3& xi) const
     //-------------------------------------------
     float xi0 = xi.x;
     const float* cdf_data_theta = m_cdf_data;                           // CDF theta
-    unsigned idx_theta = sample_cdf(cdf_data_theta, m_res_t - 1, xi0);  // binary search
+    unsigned idx_theta = m_alias_data
+        ? sample_alias_table(m_alias_data, unsigned(m_res_t - 1), xi0)  // constant time
+        : sample_cdf(cdf_data_theta, unsigned(m_res_t - 1), xi0);       // binary search
 
     float prob_theta = cdf_data_theta[idx_theta];
     if (idx_theta > 0)
     {
         const float tmp = cdf_data_theta[idx_theta - 1];
         prob_theta -= tmp;
-        xi0 -= tmp;
+        if (!m_alias_data)
+            xi0 -= tmp;
     }
-    xi0 /= prob_theta; // rescale for re-usage
+    if (!m_alias_data)
+        xi0 /= prob_theta; // rescale for re-usage
 
     // sample phi_out
     //-------------------------------------------
@@ -228,15 +226,21 @@ mi::Float32_3 Light_profile::sample(const mi::Float32_3& xi) const
     const float* cdf_data_phi = cdf_data_theta + (m_res_t - 1)          // CDF theta block
         + (idx_theta * (m_res_p - 1));                                  // selected CDF for phi
 
-    unsigned idx_phi = sample_cdf(cdf_data_phi, m_res_p - 1, xi1);      // binary search
+    const Alias_entry* alias_data_phi = m_alias_data
+        ? m_alias_data + (cdf_data_phi - m_cdf_data) : nullptr;
+    unsigned idx_phi = alias_data_phi
+        ? sample_alias_table(alias_data_phi, unsigned(m_res_p - 1), xi1) // constant time
+        : sample_cdf(cdf_data_phi, unsigned(m_res_p - 1), xi1);          // binary search
     float prob_phi = cdf_data_phi[idx_phi];
     if (idx_phi > 0)
     {
         const float tmp = cdf_data_phi[idx_phi - 1];
         prob_phi -= tmp;
-        xi1 -= tmp;
+        if (!alias_data_phi)
+            xi1 -= tmp;
     }
-    xi1 /= prob_phi; // rescale for re-usage
+    if (!alias_data_phi)
+        xi1 /= prob_phi; // rescale for re-usage
 
     // compute theta and phi
     //-------------------------------------------
@@ -284,7 +288,7 @@ mi::Float32 Light_profile::pdf(const mi::Float32_2& theta_phi) const
     const int idx_phi = int(phi * m_inv_delta_p);
 
     // wrap_mode: border black would be an alternative (but it produces artifacts at low res)
-    if (idx_theta < 0 || idx_theta >(m_res_t - 2) || idx_phi < 0 || idx_phi >(m_res_t - 2))
+    if (idx_theta < 0 || idx_theta >(m_res_t - 2) || idx_phi < 0 || idx_phi >(m_res_p - 2))
         return 0.0f;
 
     // get probability for theta
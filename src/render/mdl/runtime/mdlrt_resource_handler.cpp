@@ -809,7 +809,7 @@ void Resource_handler::lp_init(
     DB::Tag                                   tag(tag_v);
     DB::Typed_tag<LIGHTPROFILE::Lightprofile> typed_tag(tag);
 
-    new (data) Light_profile(typed_tag, (DB::Transaction *)ctx);
+    new (data) Light_profile(typed_tag, (DB::Transaction *)ctx, m_use_alias_sampling);
 }
 
 // Terminate a light profile data helper object.
@@ -896,7 +896,7 @@ void Resource_handler::bm_init(
     DB::Tag                                tag(tag_v);
     DB::Typed_tag<BSDFM::Bsdf_measurement> typed_tag(tag);
 
-    new (data) Bsdf_measurement(typed_tag, (DB::Transaction *)ctx);
+    new (data) Bsdf_measurement(typed_tag, (DB::Transaction *)ctx, m_use_alias_sampling);
 }
 
 // Terminate a bsdf measurement data helper object.
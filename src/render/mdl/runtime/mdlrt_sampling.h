@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+/** \file
+ ** \brief Sampling of discrete distributions via CDFs or alias tables.
+ **/
+
+#ifndef RENDER_MDL_RUNTIME_MDLRT_SAMPLING_H
+#define RENDER_MDL_RUNTIME_MDLRT_SAMPLING_H
+
+#include <algorithm>
+#include <vector>
+
+namespace MI {
+namespace MDLRT {
+
+// Binary search through a normalized CDF with cdf_size entries.
+// Returns the first entry larger than xi.
+inline unsigned sample_cdf(
+    const float* cdf,
+    unsigned cdf_size,
+    float xi)
+{
+    unsigned li = 0;
+    unsigned ri = cdf_size - 1;
+    unsigned m = (li + ri) / 2;
+    while (ri > li)
+    {
+        if (xi < cdf[m])
+            ri = m;
+        else
+            li = m + 1;
+
+        m = (li + ri) / 2;
+    }
+
+    return m;
+}
+
+// One cell of an alias table (Walker's alias method).
+//
+// A cell is selected uniformly, and then either kept with probability \c prob or replaced by
+// \c alias.
+struct Alias_entry
+{
+    float    prob;      // probability to keep this cell once it is selected uniformly
+    unsigned alias;     // cell to take instead
+};
+
+// Builds an alias table with n cells from a normalized CDF using Vose's algorithm.
+//
+// The table selects each cell with the same probability as sample_cdf() on that CDF, such that
+// the pdf can still be computed from the CDF.
+inline void build_alias_table(const float* cdf, unsigned n, Alias_entry* table)
+{
+    // scale the probabilities such that the average is one and split them into cells with less
+    // and more than average
+    std::vector<float> scaled(n);
+    std::vector<unsigned> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    float prev = 0.0f;
+    for (unsigned i = 0; i < n; ++i) {
+        scaled[i] = std::max(cdf[i] - prev, 0.0f) * float(n);
+        prev = cdf[i];
+        if (scaled[i] < 1.0f)
+            small.push_back(i);
+        else
+            large.push_back(i);
+    }
+
+    // fill up each small cell with the excess of a large cell
+    while (!small.empty() && !large.empty()) {
+        const unsigned s = small.back();
+        small.pop_back();
+        const unsigned l = large.back();
+
+        table[s].prob = scaled[s];
+        table[s].alias = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0f;
+        if (scaled[l] < 1.0f) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // the remaining cells are full (up to rounding errors)
+    for (unsigned i : large)
+        table[i] = Alias_entry{1.0f, i};
+    for (unsigned i : small)
+        table[i] = Alias_entry{1.0f, i};
+}
+
+// Samples a cell of an alias table with n cells in constant time.
+//
+// The random number xi in [0, 1) is rescaled to [0, 1) for re-usage. Unlike the rescaling after
+// sample_cdf(), this does not preserve the stratification of xi, which is why alias tables are
+// only used on request.
+inline unsigned sample_alias_table(const Alias_entry* table, unsigned n, float& xi)
+{
+    const float s = xi * float(n);
+    const unsigned i = std::min(unsigned(s), n - 1u);
+    const float f = std::min(s - float(i), 0.99999994f); // largest float less than one
+
+    const Alias_entry& entry = table[i];
+    const bool keep = f < entry.prob;
+    xi = keep ? f / entry.prob : (f - entry.prob) / (1.0f - entry.prob);
+    return keep ? i : entry.alias;
+}
+
+}  // MDLRT
+}  // MI
+
+#endif //RENDER_MDL_RUNTIME_MDLRT_SAMPLING_H
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *  * Neither the name of NVIDIA CORPORATION nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "pch.h"
+
+#define MI_TEST_AUTO_SUITE_NAME "Regression Test Suite for render/mdl/runtime"
+
+#include <base/system/test/i_test_auto_driver.h>
+#include <base/system/test/i_test_auto_case.h>
+
+#include <cmath>
+#include <vector>
+
+#include "mdlrt_sampling.h"
+
+using namespace MI;
+
+namespace {
+
+// Builds a normalized CDF from the given weights.
+std::vector<float> build_cdf(const std::vector<float>& weights)
+{
+    std::vector<float> cdf(weights.size());
+    float sum = 0.0f;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        sum += weights[i];
+        cdf[i] = sum;
+    }
+    for (size_t i = 0; i + 1 < cdf.size(); ++i)
+        cdf[i] /= sum;
+    cdf.back() = 1.0f;
+    return cdf;
+}
+
+// Returns the probability of cell i as used by the pdf functions of the runtime.
+float cdf_prob(const std::vector<float>& cdf, unsigned i)
+{
+    return i > 0 ? cdf[i] - cdf[i - 1] : cdf[0];
+}
+
+const std::vector<float> weights = { 1.0f, 0.0f, 3.0f, 2.0f, 0.0f, 4.0f, 0.5f };
+
+const unsigned num_samples = 70000;
+
+} // namespace
+
+MI_TEST_AUTO_FUNCTION( test_sample_cdf )
+{
+    const std::vector<float> cdf = build_cdf( weights);
+    const unsigned n = unsigned( cdf.size());
+
+    std::vector<unsigned> histogram( n, 0);
+    for (unsigned s = 0; s < num_samples; ++s) {
+        const float xi = (float( s) + 0.5f) / float( num_samples);
+        const unsigned i = MDLRT::sample_cdf( cdf.data(), n, xi);
+        MI_CHECK_LESS( i, n);
+        ++histogram[i];
+    }
+
+    // the frequencies match the pdf
+    for (unsigned i = 0; i < n; ++i)
+        MI_CHECK_CLOSE(
+            float( histogram[i]) / float( num_samples), cdf_prob( cdf, i), 1e-3f);
+}
+
+MI_TEST_AUTO_FUNCTION( test_sample_alias_table )
+{
+    const std::vector<float> cdf = build_cdf( weights);
+    const unsigned n = unsigned( cdf.size());
+
+    std::vector<MDLRT::Alias_entry> table( n);
+    MDLRT::build_alias_table( cdf.data(), n, table.data());
+
+    for (unsigned i = 0; i < n; ++i) {
+        MI_CHECK( table[i].prob >= 0.0f && table[i].prob <= 1.0f);
+        MI_CHECK_LESS( table[i].alias, n);
+    }
+
+    std::vector<unsigned> histogram( n, 0);
+    for (unsigned s = 0; s < num_samples; ++s) {
+        float xi = (float( s) + 0.5f) / float( num_samples);
+        const unsigned i = MDLRT::sample_alias_table( table.data(), n, xi);
+        MI_CHECK_LESS( i, n);
+        ++histogram[i];
+
+        // the rescaled random number can be re-used
+        MI_CHECK( xi >= 0.0f && xi < 1.0f);
+    }
+
+    // the frequencies match the pdf computed from the CDF, cells without weight are never taken
+    for (unsigned i = 0; i < n; ++i) {
+        MI_CHECK_CLOSE(
+            float( histogram[i]) / float( num_samples), cdf_prob( cdf, i), 1e-3f);
+        if (weights[i] == 0.0f)
+            MI_CHECK_EQUAL( histogram[i], 0u);
+    }
+}
+
+MI_TEST_AUTO_FUNCTION( test_sample_alias_table_degenerate )
+{
+    // a single cell and a distribution with all weight in one cell
+    const std::vector<float> single = build_cdf( { 2.0f});
+    MDLRT::Alias_entry single_table[1];
+    MDLRT::build_alias_table( single.data(), 1, single_table);
+    float xi = 0.75f;
+    MI_CHECK_EQUAL( MDLRT::sample_alias_table( single_table, 1, xi), 0u);
+    MI_CHECK_CLOSE( xi, 0.75f, 1e-6f);
+
+    const std::vector<float> peak = build_cdf( { 0.0f, 0.0f, 5.0f, 0.0f});
+    MDLRT::Alias_entry peak_table[4];
+    MDLRT::build_alias_table( peak.data(), 4, peak_table);
+    for (unsigned s = 0; s < 100; ++s) {
+        xi = (float( s) + 0.5f) / 100.0f;
+        MI_CHECK_EQUAL( MDLRT::sample_alias_table( peak_table, 4, xi), 2u);
+        MI_CHECK_EQUAL( MDLRT::sample_cdf( peak.data(), 4, (float( s) + 0.5f) / 100.0f), 2u);
+    }
+}
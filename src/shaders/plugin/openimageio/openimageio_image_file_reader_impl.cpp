@@ -35,9 +35,11 @@
 #include <mi/neuraylib/ireader.h>
 #include <mi/neuraylib/itile.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 #include <io/image/image/i_image_utilities.h>
 
@@ -91,6 +93,17 @@ Image_file_reader_impl::Image_file_reader_impl(
     }
 
     assert( m_resolution_z == 1); // see comment in read()
+
+    // Collect the native miplevels (e.g., of tiled EXR or TX files). OpenImageIO does not support
+    // retrieving this number without looping through the miplevels.
+    m_miplevel_resolutions.emplace_back( m_resolution_x, m_resolution_y);
+    for( int level = 1; m_image_input->seek_subimage( m_subimage, level); ++level) {
+        const OIIO::ImageSpec& spec = m_image_input->spec();
+        if( spec.width <= 0 || spec.height <= 0 || spec.depth != 1)
+            break;
+        m_miplevel_resolutions.emplace_back( spec.width, spec.height);
+    }
+    m_image_input->seek_subimage( m_subimage, 0);
 }
 
 const char* Image_file_reader_impl::get_type() const
@@ -100,30 +113,28 @@ const char* Image_file_reader_impl::get_type() const
 
 mi::Uint32 Image_file_reader_impl::get_resolution_x( mi::Uint32 level) const
 {
-    if( level > 0)
+    if( level >= get_miplevels())
         return 0;
-    return m_resolution_x;
+    return m_miplevel_resolutions[level].first;
 }
 
 mi::Uint32 Image_file_reader_impl::get_resolution_y( mi::Uint32 level) const
 {
-    if( level > 0)
+    if( level >= get_miplevels())
         return 0;
-    return m_resolution_y;
+    return m_miplevel_resolutions[level].second;
 }
 
 mi::Uint32 Image_file_reader_impl::get_layers_size( mi::Uint32 level) const
 {
-    if( level > 0)
+    if( level >= get_miplevels())
         return 0;
     return m_resolution_z;
 }
 
 mi::Uint32 Image_file_reader_impl::get_miplevels() const
 {
-    // Support only one miplevel for now. OpenImageIO does not support retrieving this number
-    // without looping through the miplevels.
-    return 1;
+    return static_cast<mi::Uint32>( m_miplevel_resolutions.size());
 }
 
 bool Image_file_reader_impl::get_is_cubemap() const
@@ -138,18 +149,24 @@ mi::Float32 Image_file_reader_impl::get_gamma() const
 
 mi::neuraylib::ITile* Image_file_reader_impl::read( mi::Uint32 z, mi::Uint32 level) const
 {
+    if( z >= get_layers_size( level))
+        return nullptr;
+
     if( !setup_image_input( /*from_constructor*/ false))
         return nullptr;
 
+    const mi::Uint32 resolution_x = get_resolution_x( level);
+    const mi::Uint32 resolution_y = get_resolution_y( level);
+
     const char* pixel_type = convert_pixel_type_enum_to_string( m_pixel_type);
     mi::base::Handle<mi::neuraylib::ITile> tile(
-        m_image_api->create_tile( pixel_type, m_resolution_x, m_resolution_y));
+        m_image_api->create_tile( pixel_type, resolution_x, resolution_y));
     if( !tile)
         return nullptr;
 
     int cpp = m_channel_end - m_channel_start;
     int bpc = IMAGE::get_bytes_per_component( m_pixel_type);
-    int bytes_per_row = m_resolution_x * cpp * bpc;
+    int bytes_per_row = resolution_x * cpp * bpc;
 
     OIIO::TypeDesc format( get_base_type( m_pixel_type));
     auto* data = static_cast<mi::Uint8*>( tile->get_data());
@@ -168,7 +185,7 @@ mi::neuraylib::ITile* Image_file_reader_impl::read( mi::Uint32 z, mi::Uint32 lev
             m_channel_start,
             m_channel_end,
             format,
-            data + (m_resolution_y - 1) * static_cast<size_t>( bytes_per_row),
+            data + (resolution_y - 1) * static_cast<size_t>( bytes_per_row),
             /*xstride*/ OIIO::AutoStride,
             /*ystride*/ -bytes_per_row,
             /*zstride*/ OIIO::AutoStride);
@@ -178,10 +195,131 @@ mi::neuraylib::ITile* Image_file_reader_impl::read( mi::Uint32 z, mi::Uint32 lev
         return nullptr;
     }
 
+    return finish_tile( tile.get());
+}
+
+mi::neuraylib::ITile* Image_file_reader_impl::read_region(
+    mi::Uint32 x, mi::Uint32 y, mi::Uint32 width, mi::Uint32 height,
+    mi::Uint32 z, mi::Uint32 level) const
+{
+    const mi::Uint32 resolution_x = get_resolution_x( level);
+    const mi::Uint32 resolution_y = get_resolution_y( level);
+    if(    z >= get_layers_size( level)
+        || width == 0 || height == 0
+        || x >= resolution_x || width  > resolution_x - x
+        || y >= resolution_y || height > resolution_y - y)
+        return nullptr;
+
+    if( width == resolution_x && height == resolution_y)
+        return read( z, level);
+
+    if( !setup_image_input( /*from_constructor*/ false))
+        return nullptr;
+
+    // See comment in read().
+    assert( m_resolution_z == 1);
+    if( m_resolution_z != 1)
+        return nullptr;
+
+    const char* pixel_type = convert_pixel_type_enum_to_string( m_pixel_type);
+    mi::base::Handle<mi::neuraylib::ITile> tile(
+        m_image_api->create_tile( pixel_type, width, height));
+    if( !tile)
+        return nullptr;
+
+    int cpp = m_channel_end - m_channel_start;
+    int bpc = IMAGE::get_bytes_per_component( m_pixel_type);
+    size_t bytes_per_row = static_cast<size_t>( width) * cpp * bpc;
+
+    OIIO::TypeDesc format( get_base_type( m_pixel_type));
+    auto* data = static_cast<mi::Uint8*>( tile->get_data());
+
+    const OIIO::ImageSpec spec = m_image_input->spec( m_subimage, level);
+
+    // OIIO uses top-down rows relative to the origin of the data window.
+    const int xbegin = static_cast<int>( x);
+    const int xend   = xbegin + static_cast<int>( width);
+    const int yend   = static_cast<int>( resolution_y - y);
+    const int ybegin = yend - static_cast<int>( height);
+
+    // Region to read from the file: tile boundaries for tiled images, entire scanlines otherwise.
+    int read_xbegin = 0;
+    int read_xend   = static_cast<int>( resolution_x);
+    int read_ybegin = ybegin;
+    int read_yend   = yend;
+    const bool tiled = spec.tile_width > 0 && spec.tile_height > 0;
+    if( tiled) {
+        const int tw = spec.tile_width;
+        const int th = spec.tile_height;
+        read_xbegin = xbegin - xbegin % tw;
+        read_ybegin = ybegin - ybegin % th;
+        read_xend   = std::min( (xend + tw - 1) / tw * tw, spec.width);
+        read_yend   = std::min( (yend + th - 1) / th * th, spec.height);
+    }
+
+    const size_t read_bytes_per_row = static_cast<size_t>( read_xend - read_xbegin) * cpp * bpc;
+
+    try {
+        std::vector<mi::Uint8> buffer( read_bytes_per_row * (read_yend - read_ybegin));
+
+        bool success = tiled
+            ? m_image_input->read_tiles(
+                m_subimage,
+                /*miplevel*/ level,
+                spec.x + read_xbegin,
+                spec.x + read_xend,
+                spec.y + read_ybegin,
+                spec.y + read_yend,
+                spec.z,
+                spec.z + 1,
+                m_channel_start,
+                m_channel_end,
+                format,
+                buffer.data(),
+                /*xstride*/ OIIO::AutoStride,
+                /*ystride*/ OIIO::AutoStride,
+                /*zstride*/ OIIO::AutoStride)
+            : m_image_input->read_scanlines(
+                m_subimage,
+                /*miplevel*/ level,
+                spec.y + read_ybegin,
+                spec.y + read_yend,
+                spec.z,
+                m_channel_start,
+                m_channel_end,
+                format,
+                buffer.data(),
+                /*xstride*/ OIIO::AutoStride,
+                /*ystride*/ OIIO::AutoStride);
+        if( !success)
+            return nullptr;
+
+        // Extract the region and flip it vertically.
+        const mi::Uint8* src = buffer.data()
+            + (ybegin - read_ybegin) * read_bytes_per_row
+            + static_cast<size_t>( xbegin - read_xbegin) * cpp * bpc;
+        for( mi::Uint32 row = 0; row < height; ++row)
+            memcpy(
+                data + (height - 1 - row) * bytes_per_row,
+                src + row * read_bytes_per_row,
+                bytes_per_row);
+    } catch( const std::bad_alloc&) {
+        return nullptr;
+    }
+
+    return finish_tile( tile.get());
+}
+
+mi::neuraylib::ITile* Image_file_reader_impl::finish_tile( mi::neuraylib::ITile* tile_in) const
+{
+    mi::base::Handle<mi::neuraylib::ITile> tile( tile_in, mi::base::DUP_INTERFACE);
+    int bpc = IMAGE::get_bytes_per_component( m_pixel_type);
+    auto* data = static_cast<mi::Uint8*>( tile->get_data());
+
     if( (m_channel_names.size() == 2)
         && (m_channel_names[0] == "Y")
         && ((m_channel_names[1] == "A") || (m_channel_names[1] == "Alpha")))
-        expand_ya_to_rgba( bpc, m_resolution_x, m_resolution_y, data);
+        expand_ya_to_rgba( bpc, tile->get_resolution_x(), tile->get_resolution_y(), data);
 
 #if defined(DUMP_PIXEL_X) && defined(DUMP_PIXEL_Y)
     mi::math::Color c;
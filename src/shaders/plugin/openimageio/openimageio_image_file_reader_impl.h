@@ -34,6 +34,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <OpenImageIO/imageio.h>
@@ -47,7 +48,8 @@ namespace MI {
 
 namespace MI_OIIO {
 
-class Image_file_reader_impl : public mi::base::Interface_implement<mi::neuraylib::IImage_file>
+class Image_file_reader_impl : public mi::base::Interface_implement_2<
+    mi::neuraylib::IImage_file, mi::neuraylib::IImage_file_region_reader>
 {
 public:
     /// Constructor.
@@ -79,6 +81,17 @@ public:
     /// Does nothing and returns always \false.
     bool write( const mi::neuraylib::ITile* tile, mi::Uint32 z, mi::Uint32 level) override;
 
+    // methods of mi::neuraylib::IImage_file_region_reader
+
+    /// Reads only the tiles (for tiled images) or scanlines (otherwise) covering the region.
+    mi::neuraylib::ITile* read_region(
+        mi::Uint32 x,
+        mi::Uint32 y,
+        mi::Uint32 width,
+        mi::Uint32 height,
+        mi::Uint32 z,
+        mi::Uint32 level) const override;
+
     // internal methods
 
     /// Indicates whether the constructor succeeded.
@@ -94,6 +107,10 @@ private:
     /// (and the constructor).
     bool setup_image_input( bool from_constructor) const;
 
+    /// Converts YA data to RGBA and unassociates alpha if necessary after reading pixel data
+    /// into \p tile. Used by read() and read_region().
+    mi::neuraylib::ITile* finish_tile( mi::neuraylib::ITile* tile) const;
+
     /// The OIIO format handled by this plugin.
     std::string m_oiio_format;
 
@@ -133,6 +150,10 @@ private:
     /// Resolution of the subimage in z-direction.
     mi::Uint32 m_resolution_z = 1;
 
+    /// Resolutions (x and y) of the native miplevels of the subimage. The first element matches
+    /// m_resolution_x and m_resolution_y.
+    std::vector<std::pair<mi::Uint32, mi::Uint32>> m_miplevel_resolutions;
+
     /// The pixel type of the subimage (after applying the selector).
     IMAGE::Pixel_type m_pixel_type = IMAGE::PT_UNDEF;
 